@@ -31,6 +31,7 @@
 #include "ApplicationManager.h"
 #include "BootupAnimation.h"
 #include "CpuAffinity.h"
+#include "CpuPolicy.h"
 //MDK-LAUNCHER #include "DockPositionManager.h"
 #include "HapticsController.h"
 #include "IpcServer.h"
@@ -47,6 +48,9 @@
 #include "EASPolicyManager.h"
 #include "Logging.h"
 #include "BackupManager.h"
+#include "HeapProfiler.h"
+#include "InitGraph.h"
+#include "StartupTracer.h"
 
 #include <ProcessKiller.h>
 
@@ -104,6 +108,8 @@ static gchar* s_debugTrapStr = NULL;
 static gboolean s_forceSoftwareRendering = false;
 static gchar* s_mallocStatsFileStr = NULL;
 static int s_mallocStatsInterval = -1;
+static int s_heapProfileSampleBytes = 0;
+static gchar* s_startupTraceFileStr = NULL;
 
 /**
  * Whether or not to debug crashes
@@ -334,6 +340,9 @@ static void installOuterCrashHandler(int sig)
 
 /**
  * Writes malloc statistics to stderr
+ *
+ * When the heap profiler runs, its profile goes next to the stats file as well
+ * (<file>.heap, overwritten every time).
  * 
  * @param	data			Data of some sort - currently unused
  * 
@@ -370,7 +379,11 @@ static gboolean mallocStatsCb(gpointer data)
 	fsync(STDERR_FILENO);
 
     flock(STDERR_FILENO, LOCK_UN);
-	
+
+	if (HeapProfiler::running() && s_mallocStatsFileStr) {
+		std::string heapFile = std::string(s_mallocStatsFileStr) + ".heap";
+		HeapProfiler::dump(heapFile.c_str());
+	}
 	
 	return TRUE;
 }
@@ -623,6 +636,8 @@ static void parseCommandlineOptions(int argc, char** argv)
 		{ "force-software-rendering", 'S', 0, G_OPTION_ARG_NONE, &s_forceSoftwareRendering, "Force Software rendering", NULL},
 		{ "malloc-stats-file", 'm', 0, G_OPTION_ARG_STRING,  &s_mallocStatsFileStr, "File for logging malloc stats", "file" },
 		{ "malloc-stats-interval", 'i', 0, G_OPTION_ARG_INT,  &s_mallocStatsInterval, "Interval at which to log malloc stats", "seconds" },
+		{ "heap-profile", 0, 0, G_OPTION_ARG_INT,  &s_heapProfileSampleBytes, "Sample one allocation per this many bytes (dump with com.palm.systemmanager/heapProfile)", "bytes" },
+		{ "startup-trace", 0, 0, G_OPTION_ARG_STRING,  &s_startupTraceFileStr, "File to write the startup timeline to (chrome trace format)", "file" },
 		{ NULL }
 	};
 
@@ -781,6 +796,112 @@ gboolean finishBootup(gpointer data)
     return FALSE;
 }
 
+/**
+ * Writes out the startup timeline once the main loop is up and running
+ */
+static gboolean writeStartupTrace(gpointer data)
+{
+	StartupTracer::instance()->mark("mainLoopStarted");
+	StartupTracer::instance()->write(s_startupTraceFileStr);
+	return FALSE;
+}
+
+/*
+ * Service initialization steps run by main() through an InitGraph. They all register
+ * on the bus or construct lazy instance() singletons, neither of which is known to be
+ * thread safe, so they run on the GUI thread one after the other.
+ */
+
+static void initPreferences()
+{
+	(void) Preferences::instance();
+
+	LocalePreferences* lp = LocalePreferences::instance();
+	QObject::connect(lp, SIGNAL(prefsLocaleChanged()), new ProcessKiller(), SLOT(localeChanged()));
+}
+
+static void initLocalization()
+{
+	(void) Localization::instance();
+}
+
+static void initHaptics()
+{
+	//Register vibration/haptics support
+	HapticsController::instance()->startService();
+}
+
+static void initDeviceInfo()
+{
+	(void) DeviceInfo::instance();
+}
+
+static void initSecurity()
+{
+	(void) Security::instance();
+}
+
+static void initBackupManager()
+{
+	BackupManager::instance()->init(HostBase::instance()->mainLoop());
+}
+
+static void initSystemService()
+{
+	SystemService::instance()->init();
+}
+
+static void initApplicationManager()
+{
+	ApplicationManager::instance()->init();
+}
+
+static void initApplicationInstaller()
+{
+	(void) ApplicationInstaller::instance();
+}
+
+/**
+ * Initializes the services WindowServer relies on, each traced as a startup phase
+ */
+static void initServices()
+{
+	InitGraph graph;
+
+	int prefs = graph.add("Preferences", initPreferences);
+	int localization = graph.add("Localization", initLocalization);
+	int haptics = graph.add("HapticsController", initHaptics);
+	int deviceInfo = graph.add("DeviceInfo", initDeviceInfo);
+	int security = graph.add("Security", initSecurity);
+	int backup = graph.add("BackupManager", initBackupManager);
+	int systemService = graph.add("SystemService", initSystemService);
+	int appManager = graph.add("ApplicationManager", initApplicationManager);
+	int installer = graph.add("ApplicationInstaller", initApplicationInstaller);
+
+	graph.dependsOn(localization, prefs);
+	graph.dependsOn(deviceInfo, localization);		// localized strings
+	graph.dependsOn(security, prefs);
+	graph.dependsOn(systemService, prefs);
+	graph.dependsOn(systemService, localization);
+	graph.dependsOn(systemService, deviceInfo);
+	graph.dependsOn(appManager, prefs);
+	graph.dependsOn(appManager, localization);
+	graph.dependsOn(appManager, deviceInfo);
+	graph.dependsOn(installer, appManager);
+
+	// and the order they have always come up in, which other services may rely on
+	// without saying so
+	graph.dependsOn(haptics, localization);
+	graph.dependsOn(deviceInfo, haptics);
+	graph.dependsOn(security, deviceInfo);
+	graph.dependsOn(backup, security);
+	graph.dependsOn(systemService, backup);
+	graph.dependsOn(appManager, systemService);
+
+	if (!graph.run())
+		g_critical("%s: some services failed to initialize", __PRETTY_FUNCTION__);
+}
+
 /**
  * Main program entry point
  *
@@ -825,6 +946,11 @@ int main( int argc, char** argv)
 	// Command-Line options
   	parseCommandlineOptions(argc, argv);
 
+	if (s_startupTraceFileStr) {
+		StartupTracer::instance()->setEnabled(true);
+		StartupTracer::instance()->mark("main");
+	}
+
     if (s_debugTrapStr && 0 == strcasecmp(s_debugTrapStr, "on")) {
         debugCrashes = true;
     }
@@ -833,6 +959,10 @@ int main( int argc, char** argv)
 		setupMallocStats(s_mallocStatsFileStr);
 	}
 
+	if (s_heapProfileSampleBytes > 0) {
+		HeapProfiler::start(s_heapProfileSampleBytes);
+	}
+
     sysmgrPid = getpid();
 
 	// Load Settings (first!)
@@ -854,7 +984,9 @@ int main( int argc, char** argv)
 	HostBase* host = HostBase::instance();
 	// the resolution is just a hint, the actual
 	// resolution may get picked up from the fb driver on arm
+	int phase = StartupTracer::instance()->begin("HostBase");
 	host->init(settings->displayWidth, settings->displayHeight);
+	StartupTracer::instance()->end(phase);
 
 #if defined(TARGET_DEVICE)
 	pid_t animPid= spawnBootupAnimationProcess();
@@ -883,11 +1015,17 @@ int main( int argc, char** argv)
 	// Tie LunaSysMgr to Processor 0
 	setCpuAffinity(getpid(), 1);
 
+	// app processes get placed around us as cards come and go (before any of our
+	// own threads start, as the policy applies to all of them)
+	CpuPolicy::instance()->setProcessClass(getpid(), CpuPolicy::Compositor);
+
 	// Safe to create logging threads now
 	logInit();
 
 	// Initialize Ipc Server
+	phase = StartupTracer::instance()->begin("IpcServer");
 	(void) IpcServer::instance();
+	StartupTracer::instance()->end(phase);
 
 #if !defined(TARGET_DESKTOP)
 	// Set "nice" property
@@ -900,6 +1038,7 @@ int main( int argc, char** argv)
     qInstallMessageHandler(qtMsgHandler);
 #endif
 
+	phase = StartupTracer::instance()->begin("QApplication");
 	QApplication app(argc, argv);
 	QApplication::setStartDragDistance(settings->tapRadius);
 	QApplication::setDoubleClickInterval (Settings::LunaSettings()->tapDoubleClickDuration);
@@ -908,42 +1047,20 @@ int main( int argc, char** argv)
 #endif
 
 	host->show();
+	StartupTracer::instance()->end(phase);
 
 	initMallocStatsCb(HostBase::instance()->mainLoop(), s_mallocStatsInterval);
 
 
-	// Initialize Preferences handler
-	(void) Preferences::instance();
-
-    LocalePreferences* lp = LocalePreferences::instance();
-    QObject::connect(lp, SIGNAL(prefsLocaleChanged()), new ProcessKiller(), SLOT(localeChanged()));
-
-	// Initialize Localization handler
-	(void) Localization::instance();
-
-	//Register vibration/haptics support
-	HapticsController::instance()->startService();
-
-	(void) DeviceInfo::instance();
-
-	// Initialize Security handler
-	(void) Security::instance();
-
-    // Initialize BackupManager
-    BackupManager::instance()->init(HostBase::instance()->mainLoop());
-
-	// Initialize the System Service
-	SystemService::instance()->init();
-
-	// Initialize the application mgr
-	ApplicationManager::instance()->init();
-
-	// Initialize the Application Installer
-	ApplicationInstaller::instance();
+	// Preferences, Localization, Security, BackupManager, SystemService,
+	// ApplicationManager and ApplicationInstaller
+	initServices();
 
 	// Start the window manager
+	phase = StartupTracer::instance()->begin("WindowServer");
 	WindowServer *windowServer = WindowServer::instance();
 	windowServer->installEventFilter(windowServer);
+	StartupTracer::instance()->end(phase);
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
     MouseEventEater *eater = new MouseEventEater();
@@ -951,10 +1068,14 @@ int main( int argc, char** argv)
 #endif
 
 	// Initialize the SysMgr MemoryMonitor
+	phase = StartupTracer::instance()->begin("MemoryMonitor");
 	MemoryMonitor::instance();
+	StartupTracer::instance()->end(phase);
 
 	// load all set policies
+	phase = StartupTracer::instance()->begin("EASPolicyManager");
 	EASPolicyManager::instance()->load();
+	StartupTracer::instance()->end(phase);
 
 	// Launching of the System UI launcher and headless apps has been moved to WebAppMgrProxy::connectWebAppMgr
 
@@ -964,6 +1085,9 @@ int main( int argc, char** argv)
 	}
 	else
 	    g_timeout_add_seconds(10, finishBootup, 0);
+
+	if (StartupTracer::instance()->enabled())
+		g_idle_add(writeStartupTrace, 0);
 	
 	app.exec();
 
@@ -0,0 +1,152 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include <math.h>
+
+#include "AlsFilter.h"
+
+// below this, differences in lux are sensor noise rather than light changes
+static const float kOutlierFloor = 10.0f;
+static const float kStableFloor = 2.0f;
+
+// how far a sample may be from the filtered value and still count as stable
+static const float kStableTolerance = 0.25f;
+
+static const uint32_t kDefaultBrightenMs = 1000;
+static const uint32_t kDefaultDarkenMs = 3000;
+
+AlsFilter::AlsFilter()
+	: m_numRegions(1)
+	, m_brightenMs(kDefaultBrightenMs)
+	, m_darkenMs(kDefaultDarkenMs)
+{
+	m_border[0] = -1;
+	m_margin[0] = 0;
+	reset(0);
+}
+
+void AlsFilter::setTimeConstants(uint32_t brightenMs, uint32_t darkenMs)
+{
+	m_brightenMs = MAX(brightenMs, 1u);
+	m_darkenMs = MAX(darkenMs, 1u);
+}
+
+void AlsFilter::setRegionBorder(int region, int32_t border, int32_t margin)
+{
+	if (region < 0 || region >= kMaxRegions)
+		return;
+
+	m_border[region] = border;
+	m_margin[region] = margin;
+	m_numRegions = MAX(m_numRegions, region + 1);
+}
+
+void AlsFilter::reset(int region)
+{
+	m_value = 0;
+	m_lastTime = 0;
+	m_lastSample = 0;
+	m_pending = 0;
+	m_hasPending = false;
+
+	m_region = region;
+	m_numSamples = 0;
+	m_numRejected = 0;
+	m_stableCount = 0;
+}
+
+bool AlsFilter::isOutlier(int32_t lux) const
+{
+	return lux > m_value * kOutlierRatio + kOutlierFloor
+		|| lux * kOutlierRatio + kOutlierFloor < m_value;
+}
+
+bool AlsFilter::addSample(int32_t lux, uint32_t time)
+{
+	if (lux < 0)
+		return false;
+
+	m_lastSample = lux;
+
+	if (m_numSamples == 0) {
+		m_value = lux;
+	}
+	else if (isOutlier(lux)) {
+		bool confirmed = m_hasPending && ((lux > m_value) == (m_pending > m_value));
+		if (!confirmed) {
+			// a spike until the next sample says otherwise
+			m_pending = lux;
+			m_hasPending = true;
+			m_numRejected++;
+			m_stableCount = 0;
+			return false;
+		}
+		// the light really changed: no point easing into it
+		m_value = lux;
+	}
+	else {
+		int32_t dt = (int32_t) (time - m_lastTime);
+		if (dt > 0) {
+			float tau = lux > m_value ? m_brightenMs : m_darkenMs;
+			m_value += (1.0f - expf(-dt / tau)) * (lux - m_value);
+		}
+	}
+
+	m_hasPending = false;
+	m_lastTime = time;
+	m_numSamples++;
+
+	bool changed = updateRegion();
+
+	if (!changed && fabsf(lux - m_value) <= m_value * kStableTolerance + kStableFloor) {
+		if (m_stableCount < kStableSamples)
+			m_stableCount++;
+	}
+	else {
+		m_stableCount = 0;
+	}
+
+	return changed;
+}
+
+bool AlsFilter::updateRegion()
+{
+	if (m_numSamples < kWarmupSamples || m_numRegions < 2)
+		return false;
+
+	int region = m_region;
+	if (region < 1 || region >= m_numRegions)
+		region = m_numRegions / 2;
+
+	while (region > 1 && m_value < m_border[region - 1] - m_margin[region - 1])
+		--region;
+
+	while (region < m_numRegions - 1 && m_value > m_border[region] + m_margin[region])
+		++region;
+
+	if (region == m_region)
+		return false;
+
+	m_region = region;
+	return true;
+}
@@ -0,0 +1,99 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef ALSFILTER_H
+#define ALSFILTER_H
+
+#include "Common.h"
+
+#include <stdint.h>
+
+/**
+ * Turns raw ambient light samples (lux) into a light region.
+ *
+ * Samples go through three stages:
+ *  - outlier rejection: a sample more than kOutlierRatio away from the filtered value is
+ *    held back. It only counts if the next sample confirms it, on the same side, in
+ *    which case the filter jumps straight to the new light level
+ *  - exponential smoothing over time, with separate time constants for getting
+ *    brighter and darker, so that the sample rate doesn't change the response
+ *  - region estimation with hysteresis: the region only changes when the filtered value
+ *    is past the region's border by more than that border's margin
+ *
+ * The filter also says when the readings have been stable for kStableSamples, which is
+ * when the sensor can be sampled at its slow rate.
+ */
+class AlsFilter
+{
+public:
+
+	static const int kMaxRegions = 8;
+	static const int kWarmupSamples = 3;
+	static const int kStableSamples = 10;
+	static const int kOutlierRatio = 4;
+
+	AlsFilter();
+
+	// in ms, the time for the filtered value to get 63% of the way to a new level
+	void setTimeConstants(uint32_t brightenMs, uint32_t darkenMs);
+
+	// region goes from the previous region's border to this one. Region 0 is undefined
+	void setRegionBorder(int region, int32_t border, int32_t margin);
+
+	// drops the history and starts again from region
+	void reset(int region);
+
+	// true if the region changed
+	bool addSample(int32_t lux, uint32_t time);
+
+	int region() const { return m_region; }
+	int32_t value() const { return (int32_t) (m_value + 0.5f); }
+	int32_t lastSample() const { return m_lastSample; }
+	bool stable() const { return m_stableCount >= kStableSamples; }
+
+	int numSamples() const { return m_numSamples; }
+	int numRejected() const { return m_numRejected; }
+
+private:
+
+	bool isOutlier(int32_t lux) const;
+	bool updateRegion();
+
+	int32_t		m_border[kMaxRegions];
+	int32_t		m_margin[kMaxRegions];
+	int			m_numRegions;
+
+	uint32_t	m_brightenMs;
+	uint32_t	m_darkenMs;
+
+	float		m_value;
+	uint32_t	m_lastTime;
+	int32_t		m_lastSample;
+	int32_t		m_pending;
+	bool		m_hasPending;
+
+	int			m_region;
+	int			m_numSamples;
+	int			m_numRejected;
+	int			m_stableCount;
+};
+
+#endif /* ALSFILTER_H */
@@ -59,19 +59,13 @@ AmbientLightSensor::AmbientLightSensor ()
     : m_service(NULL)
     , m_alsEnabled(false)
     , m_alsIsOn(false)
-    , m_alsPointer(0)
     , m_alsRegion(ALS_REGION_UNDEFINED)
-    , m_alsSum(0)
     , m_alsLastOff(0)
     , m_alsDisplayOn(false)
     , m_alsSubscriptions(0)
     , m_alsDisabled(0)
     , m_alsHiddOnline(false)
     , m_alsFastRate(false)
-    , m_alsSampleCount(0)
-    , m_alsCountInRegion(0)
-    , m_alsSamplesNeeded (ALS_INIT_SAMPLE_SIZE)
-    , m_alsLastSampleTs (0)
 {
     LSError lserror;
     LSErrorInit(&lserror);
@@ -127,18 +121,12 @@ AmbientLightSensor::AmbientLightSensor ()
 	g_warning ("ALSCal token found, expecting lux values in light events");
 
 
-	m_alsBorder[ALS_REGION_UNDEFINED] = -1;
-	m_alsBorder[ALS_REGION_DARK] = 6;
-	m_alsBorder[ALS_REGION_DIM] = 100;
-	m_alsBorder[ALS_REGION_INDOOR] = 1000;
-	m_alsBorder[ALS_REGION_OUTDOOR] = INT_MAX;
-
 	// margins are higher at lower lux values
-	m_alsMargin[ALS_REGION_UNDEFINED] = 0;
-	m_alsMargin[ALS_REGION_DARK] = 4;
-	m_alsMargin[ALS_REGION_DIM] = 10;
-	m_alsMargin[ALS_REGION_INDOOR] = 100;
-	m_alsMargin[ALS_REGION_OUTDOOR] = 0;
+	m_alsFilter.setRegionBorder (ALS_REGION_UNDEFINED, -1, 0);
+	m_alsFilter.setRegionBorder (ALS_REGION_DARK, 6, 4);
+	m_alsFilter.setRegionBorder (ALS_REGION_DIM, 100, 10);
+	m_alsFilter.setRegionBorder (ALS_REGION_INDOOR, 1000, 100);
+	m_alsFilter.setRegionBorder (ALS_REGION_OUTDOOR, INT_MAX, 0);
 
     }
     else {
@@ -212,10 +200,7 @@ bool AmbientLightSensor::on ()
 
     int timeSinceLastReading = Time::curTimeMs() - m_alsLastOff;
 
-    m_alsSampleCount = 0;
-    m_alsCountInRegion = 0;
-    m_alsSamplesNeeded = ALS_INIT_SAMPLE_SIZE;
-    m_alsSampleList.clear();
+    m_alsFilter.reset (ALS_REGION_INDOOR);
     m_alsRegion = ALS_REGION_INDOOR;
 
     /* fine-tuning support for NYX */
@@ -274,26 +259,13 @@ bool AmbientLightSensor::update (int intensity)
         return false;
 }
 
-bool sortIncr (int32_t alsVal1, int32_t alsVal2) 
-{
-    if (alsVal1 > alsVal2)
-	return false;
-    return true;
-}
-
-// this is the als region estimation for the newer sensors
-// the als region is estimated from  a fixed number of samples (m_alsSamplesNeeded).
-// once the als region is determined, all incoming values that fall in the current region are discarded
-// if an incoming value is outside the current region, we collect the samples again and re-estimate the region
-// this allows the als region to move directly to the current light condition.
+// the samples go through m_alsFilter, which smooths them, drops the odd spike and
+// keeps the region from flapping around its borders. Subscribers only hear about region
+// changes, and the sensor drops to its slow rate while the readings are stable.
 
 bool AmbientLightSensor::updateAls(int intensity)
 {
 #if defined(TARGET_DEVICE)
-    LSError lserror;
-    LSErrorInit(&lserror);
-    bool result = true;
-
     int current = m_alsRegion;
 
     if (m_alsDisabled > 0) {
@@ -318,104 +290,65 @@ bool AmbientLightSensor::updateAls(int intensity)
         return false;
     }
 
+    m_alsFilter.addSample (intensity, Time::curTimeMs());
+    m_alsRegion = m_alsFilter.region();
+
     if (m_alsRegion < ALS_REGION_UNDEFINED || m_alsRegion > ALS_REGION_OUTDOOR) {
         g_warning("%s: current region is invalid, resetting to indoor",
                 __PRETTY_FUNCTION__);
+        m_alsFilter.reset (ALS_REGION_INDOOR);
         m_alsRegion = ALS_REGION_INDOOR;
     }
 
-    if (m_alsSampleCount == 0)
-    {
-        m_alsSum = 0;
-    }
-
-    if (m_alsSampleCount == m_alsSamplesNeeded) {
-        m_alsSum -= m_alsSampleList.front();
-        m_alsSampleList.pop_front();
-        m_alsSampleCount--;
-    }
-
-    // start collecting samples
-    if (m_alsSampleCount < m_alsSamplesNeeded) {
-        // g_debug("%s: received sample %d", __PRETTY_FUNCTION__, intensity);
-        // maintaining a running sum of the last m_alsSamplesNeeded number of samples
-        // also maintaining the last m_alsSamplesNeeded values in an array
-        m_alsSampleList.push_back(intensity);
-        m_alsSum += intensity;
-        m_alsSampleCount++;
-    }
-
-    if (intensity < m_alsBorder[m_alsRegion - 1] - m_alsMargin[m_alsRegion - 1] || intensity > m_alsBorder[m_alsRegion] + m_alsMargin[m_alsRegion])
-    {
-        if (!m_alsFastRate)
-        {
-            m_alsCountInRegion = 0;
-            g_debug ("resetting ALS to sample at fast rate");
-            // switch to the slow mode
-            InputControl* ic = HostBase::instance()->getInputControlALS();
-            if (NULL != ic)
-            {
-                if (!ic->setRate(NYX_REPORT_RATE_HIGH))
-                    return false;
-            }
-            m_alsFastRate = true;
-        }
-    } else {
-        if (m_alsCountInRegion == ALS_INIT_SAMPLE_SIZE)
-        {
-            if (m_alsFastRate) {
-                g_debug ("resetting ALS to sample at slow rate");
-                // switch to the slow mode
-                InputControl* ic = HostBase::instance()->getInputControlALS();
-                if (NULL != ic)
-                {
-                    if (!ic->setRate(NYX_REPORT_RATE_LOW))
-                        return false;
-                }
-                m_alsFastRate = false;
-            }
-        }
-        if (m_alsCountInRegion <= ALS_INIT_SAMPLE_SIZE)
-            m_alsCountInRegion++;
-    }
-
-    if (m_alsSampleCount == m_alsSamplesNeeded) {
-        // sample count is now the required sample size, estimate ALS region
-        while (m_alsRegion > ALS_REGION_DARK && (m_alsSum / ALS_SAMPLE_SIZE)
-                < (m_alsBorder[m_alsRegion - 1] - m_alsMargin[m_alsRegion - 1])) {
-            --m_alsRegion;
-        }
-
-        while (m_alsRegion < ALS_REGION_OUTDOOR && (m_alsSum / ALS_SAMPLE_SIZE)
-                > (m_alsBorder[m_alsRegion] + m_alsMargin[m_alsRegion])) {
-            ++m_alsRegion;
-        }
-    }
+    if (!updateRate())
+        return false;
 
 end:
 
+    // if there was no change return false, no need to update anything
+    if (m_alsRegion == current)
+        return false;
+
     if (m_alsSubscriptions > 0) {
-        gchar *status = g_strdup_printf(
-                "{\"returnValue\":true,\"current\":%i,\"region\":%i}",
+        LSError lserror;
+        LSErrorInit(&lserror);
+
+        char status[96];
+        snprintf (status, sizeof(status), "{\"returnValue\":true,\"current\":%i,\"region\":%i}",
                 intensity, m_alsRegion);
 
-        if (NULL != status)
-            result = LSSubscriptionReply(m_service, "/control/status", status,
-                    &lserror);
-        if (!result) {
+        if (!LSSubscriptionReply(m_service, "/control/status", status, &lserror)) {
             LSErrorPrint(&lserror, stderr);
             LSErrorFree(&lserror);
         }
-        g_free(status);
     }
 
-    // if there was no change return false, no need to update anything
-    return (m_alsRegion != current);
+    return true;
 #else
     return false;
 #endif
 }
 
+// fast while the light is changing, slow once the filter has settled
+bool AmbientLightSensor::updateRate()
+{
+#if defined(TARGET_DEVICE)
+    bool fast = !m_alsFilter.stable();
+    if (fast == m_alsFastRate)
+        return true;
+
+    g_debug ("resetting ALS to sample at %s rate", fast ? "fast" : "slow");
+    InputControl* ic = HostBase::instance()->getInputControlALS();
+    if (NULL != ic)
+    {
+        if (!ic->setRate(fast ? NYX_REPORT_RATE_HIGH : NYX_REPORT_RATE_LOW))
+            return false;
+    }
+    m_alsFastRate = fast;
+#endif
+    return true;
+}
+
 /*!
 \page com_palm_ambient_light_sensor_control
 \n
@@ -456,6 +389,8 @@ Get status and optionally enable or disable the ambient light sensor.
 \param subscribed True if subscribed to receive status updates.
 
 \subsection com_palm_ambient_light_sensor_control_status_returns_status Returns for status updates:
+
+Status updates are sent when the light region changes.
 \code
 {
     "returnValue": boolean,
@@ -493,23 +428,13 @@ Example status updates:
 \code
 {
     "returnValue": true,
-    "current": 184,
-    "region": 3
-}
-{
-    "returnValue": true,
-    "current": 179,
-    "region": 3
-}
-{
-    "returnValue": true,
-    "current": 171,
-    "region": 3
+    "current": 1184,
+    "region": 4
 }
 {
     "returnValue": true,
     "current": 66,
-    "region": 3
+    "region": 2
 }
 \endcode
 */
@@ -559,20 +484,17 @@ bool AmbientLightSensor::controlStatus(LSHandle *sh, LSMessage *message, void *c
             als->m_alsDisabled++;
     }
 
-    int ptr = (als->m_alsPointer + als->m_alsSamplesNeeded - 1) % als->m_alsSamplesNeeded;
-    gchar *status = g_strdup_printf ("{\"returnValue\":true,\"current\":%i,\"average\":%i,\"disabled\":%s,\"subscribed\":%s}",
-            als->m_alsValue[ptr], als->m_alsSum / als->m_alsSamplesNeeded, als->m_alsDisabled > 0 ? "true" : "false", 
+    char status[128];
+    snprintf (status, sizeof(status), "{\"returnValue\":true,\"current\":%i,\"average\":%i,\"disabled\":%s,\"subscribed\":%s}",
+            als->m_alsFilter.lastSample(), als->m_alsFilter.value(), als->m_alsDisabled > 0 ? "true" : "false",
             subscribed ? "true" : "false");
 
-    if (NULL != status)
-        result = LSMessageReply(sh, message, status, &lserror);
+    result = LSMessageReply(sh, message, status, &lserror);
     if(!result)
     {
         LSErrorPrint (&lserror, stderr);
         LSErrorFree (&lserror);
     }
-
-    g_free(status);
 #endif
     return true;
 }
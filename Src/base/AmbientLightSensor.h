@@ -24,11 +24,10 @@
 
 #include "Common.h"
 
+#include "AlsFilter.h"
+
 #include "lunaservice.h"
-#include <list>
 
-#define ALS_INIT_SAMPLE_SIZE   10
-#define ALS_SAMPLE_SIZE 	   10
 #define ALS_REGION_COUNT       5
 
 #define ALS_REGION_UNDEFINED  0
@@ -62,23 +61,14 @@ private:
     LSHandle*              m_service;
     bool                   m_alsEnabled;
     bool                   m_alsIsOn;
-    int32_t                m_alsValue[ALS_SAMPLE_SIZE];
-    int32_t                m_alsBorder[ALS_REGION_COUNT];
-    int32_t                m_alsMargin[ALS_REGION_COUNT];
-    int32_t                m_alsPointer;
+    AlsFilter              m_alsFilter;
     int32_t                m_alsRegion;
-    int32_t                m_alsSum;
     uint32_t               m_alsLastOff;
     bool                   m_alsDisplayOn;
     int32_t                m_alsSubscriptions;
     int32_t                m_alsDisabled;
     bool                   m_alsHiddOnline;
     bool                   m_alsFastRate;
-    int32_t                m_alsSampleCount;
-    int32_t                m_alsCountInRegion;
-    int32_t                m_alsSamplesNeeded;
-    uint32_t               m_alsLastSampleTs;
-    std::list<int32_t>	   m_alsSampleList;
 
     static AmbientLightSensor * m_instance;
 
@@ -86,6 +76,7 @@ private:
     bool off ();
 
     bool updateAls (int intensity);
+    bool updateRate ();
 };
 
 #endif /* AMBIENTLIGHTSENSOR_H */
@@ -0,0 +1,511 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "CpuPolicy.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <glib.h>
+
+// nice values match what IpcClientHost used for active and inactive cards
+static const CpuPolicy::Rule kDefaultRules[CpuPolicy::NumClasses] = {
+	/* Compositor */	{ -1, CpuPolicy::KeepCpus,		0 },	// main() pins sysmgr already
+	/* Foreground */	{ -1, CpuPolicy::PreferredCpus,	400 },
+	/* Background */	{ 1,  CpuPolicy::SpareCpus,		25 },
+	/* Service */		{ 0,  CpuPolicy::KeepCpus,		100 }
+};
+
+static const char* kClassNames[CpuPolicy::NumClasses] = {
+	"compositor",
+	"foreground",
+	"background",
+	"service"
+};
+
+// -------------------------------------------------------------------------
+
+/**
+ * The real thing. nice and affinity are per thread on Linux, so both are applied to
+ * every thread of the process
+ */
+class LinuxCpuBackend : public CpuPolicy::Backend
+{
+public:
+
+	virtual int numCpus()
+	{
+		long count = ::sysconf(_SC_NPROCESSORS_ONLN);
+		return count > 0 ? (int) count : 1;
+	}
+
+	virtual bool getNice(int pid, int& nice)
+	{
+		errno = 0;
+		int value = ::getpriority(PRIO_PROCESS, pid);
+		if (value == -1 && errno != 0)
+			return false;
+
+		nice = value;
+		return true;
+	}
+
+	virtual bool setNice(int pid, int nice)
+	{
+		bool ok = true;
+		int numThreads = forEachThread(pid, &LinuxCpuBackend::setThreadNice, nice, ok);
+		if (numThreads == 0)
+			setThreadNice(pid, nice, ok);
+
+		return ok;
+	}
+
+	virtual bool getAffinity(int pid, unsigned long& mask)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (::sched_getaffinity(pid, sizeof(set), &set) != 0)
+			return false;
+
+		mask = 0;
+		for (unsigned int cpu = 0; cpu < sizeof(mask) * 8; cpu++) {
+			if (CPU_ISSET(cpu, &set))
+				mask |= (1UL << cpu);
+		}
+		return true;
+	}
+
+	virtual bool setAffinity(int pid, unsigned long mask)
+	{
+		bool ok = true;
+		int numThreads = forEachThread(pid, &LinuxCpuBackend::setThreadAffinity, mask, ok);
+		if (numThreads == 0)
+			setThreadAffinity(pid, mask, ok);
+
+		return ok;
+	}
+
+	virtual bool getCgroup(int pid, std::string& path)
+	{
+		char fileName[64];
+		snprintf(fileName, sizeof(fileName), "/proc/%d/cgroup", pid);
+
+		FILE* file = fopen(fileName, "r");
+		if (!file)
+			return false;
+
+		// the v2 hierarchy is the "0::<path>" line
+		char line[512];
+		bool found = false;
+		while (!found && fgets(line, sizeof(line), file)) {
+			if (strncmp(line, "0::", 3) == 0) {
+				path = line + 3;
+				if (!path.empty() && path[path.size() - 1] == '\n')
+					path.resize(path.size() - 1);
+				found = true;
+			}
+		}
+		fclose(file);
+
+		return found;
+	}
+
+	virtual bool setCgroup(int pid, const std::string& dir)
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%d", pid);
+		return writeFile(dir + "/cgroup.procs", buf);
+	}
+
+	virtual bool prepareCgroup(const std::string& dir, int cpuWeight)
+	{
+		if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+			g_warning("%s: failed to create %s: %s", __PRETTY_FUNCTION__, dir.c_str(), strerror(errno));
+			return false;
+		}
+
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%d", cpuWeight);
+		return writeFile(dir + "/cpu.weight", buf);
+	}
+
+private:
+
+	template <typename T>
+	static int forEachThread(int pid, void (*func)(int, T, bool&), T value, bool& ok)
+	{
+		char dirName[64];
+		snprintf(dirName, sizeof(dirName), "/proc/%d/task", pid);
+
+		DIR* dir = ::opendir(dirName);
+		if (!dir)
+			return 0;
+
+		int count = 0;
+		struct dirent* entry;
+		while ((entry = ::readdir(dir)) != 0) {
+			int tid = ::atoi(entry->d_name);
+			if (tid > 0) {
+				func(tid, value, ok);
+				count++;
+			}
+		}
+		::closedir(dir);
+
+		return count;
+	}
+
+	static void setThreadNice(int tid, int nice, bool& ok)
+	{
+		if (::setpriority(PRIO_PROCESS, tid, nice) != 0)
+			ok = false;
+	}
+
+	static void setThreadAffinity(int tid, unsigned long mask, bool& ok)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (unsigned int cpu = 0; cpu < sizeof(mask) * 8; cpu++) {
+			if (mask & (1UL << cpu))
+				CPU_SET(cpu, &set);
+		}
+
+		if (::sched_setaffinity(tid, sizeof(set), &set) != 0)
+			ok = false;
+	}
+
+	static bool writeFile(const std::string& fileName, const char* value)
+	{
+		FILE* file = fopen(fileName.c_str(), "w");
+		if (!file)
+			return false;
+
+		bool ok = (fputs(value, file) >= 0);
+		ok = (fclose(file) == 0) && ok;
+		return ok;
+	}
+};
+
+// -------------------------------------------------------------------------
+
+static CpuPolicy* s_instance = 0;
+
+CpuPolicy* CpuPolicy::instance()
+{
+	if (G_UNLIKELY(!s_instance))
+		s_instance = new CpuPolicy(new LinuxCpuBackend);
+
+	return s_instance;
+}
+
+CpuPolicy::CpuPolicy(Backend* backend)
+	: m_backend(backend)
+	, m_enabled(true)
+	, m_foregroundPid(-1)
+	, m_numCpus(backend->numCpus())
+	, m_compositorCpus(0)
+{
+	for (int i = 0; i < NumClasses; i++)
+		m_rules[i] = kDefaultRules[i];
+}
+
+CpuPolicy::~CpuPolicy()
+{
+	restoreAll();
+	delete m_backend;
+}
+
+const char* CpuPolicy::className(ProcessClass cls)
+{
+	if (cls < 0 || cls >= NumClasses)
+		return "untracked";
+
+	return kClassNames[cls];
+}
+
+void CpuPolicy::setEnabled(bool enabled)
+{
+	if (enabled == m_enabled)
+		return;
+
+	m_enabled = enabled;
+
+	if (!m_enabled) {
+		// put everybody back, but remember the classes for when we are enabled again
+		ProcessMap classes = m_processes;
+		int foregroundPid = m_foregroundPid;
+
+		restoreAll();
+		m_foregroundPid = foregroundPid;
+
+		for (ProcessMap::iterator it = classes.begin(); it != classes.end(); ++it) {
+			Process& proc = it->second;
+			proc.haveNice = proc.haveAffinity = proc.haveCgroup = false;
+			m_processes[it->first] = proc;
+		}
+	}
+	else {
+		prepareCgroups();
+		for (ProcessMap::iterator it = m_processes.begin(); it != m_processes.end(); ++it)
+			apply(it->first, it->second);
+	}
+}
+
+void CpuPolicy::setRule(ProcessClass cls, const Rule& rule)
+{
+	if (cls < 0 || cls >= NumClasses)
+		return;
+
+	m_rules[cls] = rule;
+
+	if (m_enabled && !m_cgroupMount.empty() && rule.cpuWeight > 0)
+		m_backend->prepareCgroup(cgroupFor(cls), rule.cpuWeight);
+
+	if (!m_enabled)
+		return;
+
+	unsigned long compositorCpus = m_compositorCpus;
+	for (ProcessMap::iterator it = m_processes.begin(); it != m_processes.end(); ++it) {
+		if (it->second.cls == cls)
+			apply(it->first, it->second);
+	}
+
+	if (m_compositorCpus != compositorCpus)
+		applyCpuSet(PreferredCpus);
+}
+
+void CpuPolicy::setCgroupRoot(const std::string& mountPoint, const std::string& group)
+{
+	m_cgroupMount = mountPoint;
+	m_cgroupGroup = group;
+
+	if (m_enabled)
+		prepareCgroups();
+}
+
+void CpuPolicy::prepareCgroups()
+{
+	if (m_cgroupMount.empty())
+		return;
+
+	if (!m_backend->prepareCgroup(m_cgroupMount + "/" + m_cgroupGroup, 100)) {
+		g_warning("%s: cgroups unavailable under %s, not using them", __PRETTY_FUNCTION__,
+				  m_cgroupMount.c_str());
+		m_cgroupMount.clear();
+		return;
+	}
+
+	for (int i = 0; i < NumClasses; i++) {
+		if (m_rules[i].cpuWeight > 0)
+			m_backend->prepareCgroup(cgroupFor((ProcessClass) i), m_rules[i].cpuWeight);
+	}
+}
+
+std::string CpuPolicy::cgroupFor(ProcessClass cls) const
+{
+	return m_cgroupMount + "/" + m_cgroupGroup + "/" + kClassNames[cls];
+}
+
+unsigned long CpuPolicy::maskFor(CpuSet cpus) const
+{
+	int numCpus = std::min<int>(m_numCpus, sizeof(unsigned long) * 8);
+	unsigned long all = (numCpus >= (int) sizeof(unsigned long) * 8) ? ~0UL : ((1UL << numCpus) - 1);
+	unsigned long last = 1UL << (numCpus - 1);
+
+	switch (cpus) {
+	case AllCpus:
+		return all;
+	case PreferredCpus: {
+		// main() pins sysmgr to a core: the foreground shouldn't have to share it
+		unsigned long free = all & ~m_compositorCpus;
+		if (!free)
+			free = all;
+
+		unsigned long preferred = free & ~last;
+		return preferred ? preferred : free;
+	}
+	case SpareCpus:
+		return last;
+	default:
+		return 0;
+	}
+}
+
+void CpuPolicy::setProcessClass(int pid, ProcessClass cls)
+{
+	if (pid <= 0)
+		return;
+
+	if (cls == Untracked) {
+		restore(pid);
+		return;
+	}
+
+	ProcessMap::iterator it = m_processes.find(pid);
+	if (it == m_processes.end()) {
+		Process proc;
+		proc.cls = cls;
+		proc.baseCls = Background;
+		proc.haveNice = proc.haveAffinity = proc.haveCgroup = false;
+		it = m_processes.insert(ProcessMap::value_type(pid, proc)).first;
+	}
+	else if (it->second.cls == cls) {
+		return;
+	}
+
+	// the foreground is temporary, everything else is what the process is
+	if (cls != Foreground)
+		it->second.baseCls = cls;
+
+	it->second.cls = cls;
+	if (cls != Foreground && m_foregroundPid == pid)
+		m_foregroundPid = -1;
+
+	if (!m_enabled)
+		return;
+
+	unsigned long compositorCpus = m_compositorCpus;
+	apply(pid, it->second);
+	if (m_compositorCpus != compositorCpus)
+		applyCpuSet(PreferredCpus);
+}
+
+void CpuPolicy::applyCpuSet(CpuSet cpus)
+{
+	for (ProcessMap::iterator it = m_processes.begin(); it != m_processes.end(); ++it) {
+		if (m_rules[it->second.cls].cpus == cpus)
+			apply(it->first, it->second);
+	}
+}
+
+CpuPolicy::ProcessClass CpuPolicy::processClass(int pid) const
+{
+	ProcessMap::const_iterator it = m_processes.find(pid);
+	if (it == m_processes.end())
+		return Untracked;
+
+	return it->second.cls;
+}
+
+void CpuPolicy::setForeground(int pid)
+{
+	if (pid == m_foregroundPid)
+		return;
+
+	int previous = m_foregroundPid;
+	m_foregroundPid = -1;
+
+	// a service (WebAppMgr renders every web card) must not end up in the background
+	ProcessMap::const_iterator it = m_processes.find(previous);
+	if (it != m_processes.end() && it->second.cls == Foreground)
+		setProcessClass(previous, it->second.baseCls);
+
+	if (pid > 0) {
+		setProcessClass(pid, Foreground);
+		m_foregroundPid = pid;
+	}
+}
+
+void CpuPolicy::apply(int pid, Process& proc)
+{
+	const Rule& rule = m_rules[proc.cls];
+
+	// remember the original values the first time we change them
+	if (!proc.haveNice)
+		proc.haveNice = m_backend->getNice(pid, proc.nice);
+
+	if (proc.haveNice && !m_backend->setNice(pid, rule.nice))
+		g_debug("%s: failed to set nice of %d to %d", __PRETTY_FUNCTION__, pid, rule.nice);
+
+	unsigned long mask = maskFor(rule.cpus);
+	if (mask || proc.haveAffinity) {
+		if (!proc.haveAffinity)
+			proc.haveAffinity = m_backend->getAffinity(pid, proc.affinity);
+
+		// KeepCpus after a class that moved it: back to what it had
+		if (!mask)
+			mask = proc.affinity;
+
+		if (proc.haveAffinity && !m_backend->setAffinity(pid, mask))
+			g_debug("%s: failed to set affinity of %d to 0x%lx", __PRETTY_FUNCTION__, pid, mask);
+	}
+
+	if (!m_cgroupMount.empty()) {
+		if (!proc.haveCgroup)
+			proc.haveCgroup = m_backend->getCgroup(pid, proc.cgroup);
+
+		std::string dir = rule.cpuWeight > 0 ? cgroupFor(proc.cls) : m_cgroupMount + proc.cgroup;
+		if (proc.haveCgroup && !m_backend->setCgroup(pid, dir))
+			g_debug("%s: failed to move %d to %s", __PRETTY_FUNCTION__, pid, dir.c_str());
+	}
+
+	if (proc.cls == Compositor) {
+		unsigned long cpus;
+		if (m_backend->getAffinity(pid, cpus))
+			m_compositorCpus = cpus;
+	}
+
+	g_debug("%s: %d is now %s", __PRETTY_FUNCTION__, pid, kClassNames[proc.cls]);
+}
+
+void CpuPolicy::removeProcess(int pid)
+{
+	m_processes.erase(pid);
+
+	if (pid == m_foregroundPid)
+		m_foregroundPid = -1;
+}
+
+void CpuPolicy::restore(int pid)
+{
+	ProcessMap::iterator it = m_processes.find(pid);
+	if (it == m_processes.end())
+		return;
+
+	const Process& proc = it->second;
+
+	if (proc.haveNice)
+		m_backend->setNice(pid, proc.nice);
+
+	if (proc.haveAffinity)
+		m_backend->setAffinity(pid, proc.affinity);
+
+	if (proc.haveCgroup && !m_cgroupMount.empty())
+		m_backend->setCgroup(pid, m_cgroupMount + proc.cgroup);
+
+	removeProcess(pid);
+}
+
+void CpuPolicy::restoreAll()
+{
+	while (!m_processes.empty())
+		restore(m_processes.begin()->first);
+}
@@ -0,0 +1,174 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef CPUPOLICY_H
+#define CPUPOLICY_H
+
+#include "Common.h"
+
+#include <map>
+#include <string>
+
+/**
+ * Places the processes sysmgr knows about on CPUs according to what they are doing.
+ *
+ * Each tracked process belongs to a class (the compositor, the app owning the
+ * maximized card, apps in the background, helper services). A table gives each class
+ * a nice value, the cores it may run on and, when a cgroup v2 hierarchy is configured,
+ * a cpu.weight. Changing the class of a process applies the new row; the settings a
+ * process had before sysmgr first touched it are remembered, so that restore() (or
+ * disabling the policy) puts everything back.
+ *
+ * All system calls go through a Backend, so that the policy can be exercised without
+ * touching real processes.
+ */
+class CpuPolicy
+{
+public:
+
+	enum ProcessClass {
+		Untracked = -1,
+		Compositor = 0,		// sysmgr itself
+		Foreground,			// owns the maximized card
+		Background,			// cards that aren't maximized, apps without cards
+		Service,			// WebAppMgr and other helpers
+
+		NumClasses
+	};
+
+	enum CpuSet {
+		KeepCpus = 0,		// leave affinity alone
+		AllCpus,
+		PreferredCpus,		// all but the last core and the compositor's (if that leaves none,
+							// all but the compositor's, then all)
+		SpareCpus			// the last core only
+	};
+
+	struct Rule
+	{
+		int			nice;
+		CpuSet		cpus;
+		int			cpuWeight;	// cgroup v2 cpu.weight (1-10000), 0 to leave alone
+	};
+
+	/**
+	 * The system interface. The default one uses setpriority, sched_setaffinity and
+	 * the cgroup v2 file system, and applies to every thread of the process
+	 */
+	class Backend
+	{
+	public:
+		virtual ~Backend() {}
+
+		virtual int		numCpus() = 0;
+
+		virtual bool	getNice(int pid, int& nice) = 0;
+		virtual bool	setNice(int pid, int nice) = 0;
+
+		// mask of the cores the process may run on, bit N for core N
+		virtual bool	getAffinity(int pid, unsigned long& mask) = 0;
+		virtual bool	setAffinity(int pid, unsigned long mask) = 0;
+
+		// getCgroup gives the path within the cgroup v2 hierarchy, as /proc/<pid>/cgroup
+		// does. The others take the directory of the group
+		virtual bool	getCgroup(int pid, std::string& path) = 0;
+		virtual bool	setCgroup(int pid, const std::string& dir) = 0;
+		virtual bool	prepareCgroup(const std::string& dir, int cpuWeight) = 0;
+	};
+
+	static CpuPolicy* instance();
+
+	// takes ownership of backend
+	CpuPolicy(Backend* backend);
+	~CpuPolicy();
+
+	// disabling restores every process the policy changed
+	void		setEnabled(bool enabled);
+	bool		enabled() const { return m_enabled; }
+
+	const Rule&	rule(ProcessClass cls) const { return m_rules[cls]; }
+	void		setRule(ProcessClass cls, const Rule& rule);
+
+	// cgroup v2 mount point (/sys/fs/cgroup) and the group to create the per class
+	// groups under. An empty mount point leaves cgroups alone (the default)
+	void		setCgroupRoot(const std::string& mountPoint, const std::string& group);
+
+	void			setProcessClass(int pid, ProcessClass cls);
+	ProcessClass	processClass(int pid) const;
+
+	// makes pid the only Foreground process; the previous one goes back to the class
+	// it had before it was promoted (Background if it wasn't tracked). pid <= 0 just
+	// demotes the current one
+	void		setForeground(int pid);
+	int			foreground() const { return m_foregroundPid; }
+
+	// the process is gone: forget it (nothing to restore)
+	void		removeProcess(int pid);
+
+	// puts pid back the way it was and stops tracking it
+	void		restore(int pid);
+	void		restoreAll();
+
+	int			numTracked() const { return m_processes.size(); }
+
+	static const char* className(ProcessClass cls);
+
+private:
+
+	struct Process
+	{
+		ProcessClass	cls;
+		ProcessClass	baseCls;	// where it goes back to when it leaves the foreground
+
+		// what the process had before we touched it
+		bool			haveNice;
+		int				nice;
+		bool			haveAffinity;
+		unsigned long	affinity;
+		bool			haveCgroup;
+		std::string		cgroup;
+	};
+
+	void			apply(int pid, Process& proc);
+	void			applyCpuSet(CpuSet cpus);
+	unsigned long	maskFor(CpuSet cpus) const;
+	std::string		cgroupFor(ProcessClass cls) const;
+	void			prepareCgroups();
+
+	typedef std::map<int, Process> ProcessMap;
+
+	Backend*		m_backend;
+	bool			m_enabled;
+	Rule			m_rules[NumClasses];
+	ProcessMap		m_processes;
+	int				m_foregroundPid;
+	int				m_numCpus;
+	unsigned long	m_compositorCpus;	// where the Compositor process runs, 0 if unknown
+	std::string		m_cgroupMount;
+	std::string		m_cgroupGroup;
+
+private:
+
+	CpuPolicy(const CpuPolicy&);
+	CpuPolicy& operator=(const CpuPolicy&);
+};
+
+#endif /* CPUPOLICY_H */
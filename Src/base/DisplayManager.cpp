@@ -27,6 +27,7 @@
 #include "HostBase.h"
 #include "IMEController.h"
 #include "JSONUtils.h"
+#include "JsonScanner.h"
 #include "Preferences.h"
 #include "Settings.h"
 #include "SystemService.h"
@@ -199,6 +200,38 @@ LSSignal displaySignals[] = {
     {},
 };
 
+// the display states arm their inactivity timeouts here rather than on timers of their
+// own, so that activity only has to move m_lastEvent
+class DisplayTimeoutTimer : public InactivityTimer
+{
+public:
+
+    DisplayTimeoutTimer (DisplayManager* dm)
+        : InactivityTimer (dm->m_lastEvent)
+        , m_dm (dm)
+        , m_timer (HostBase::instance()->masterTimer(), this, &DisplayTimeoutTimer::timerFired)
+    {
+    }
+
+protected:
+
+    uint32_t now() const { return Time::curTimeMs(); }
+    void startTimer (uint32_t delayMs) { m_timer.start (delayMs); }
+    void stopTimer() { m_timer.stop(); }
+    void timeoutExpired (int kind) { m_dm->timeoutExpired (kind); }
+
+private:
+
+    bool timerFired()
+    {
+        fire();
+        return false;
+    }
+
+    DisplayManager*             m_dm;
+    Timer<DisplayTimeoutTimer>  m_timer;
+};
+
 DisplayManager::DisplayManager()
     : m_palmService(0)
     , m_service(0)
@@ -247,6 +280,7 @@ DisplayManager::DisplayManager()
     , m_power(new Timer<DisplayManager>(HostBase::instance()->masterTimer(), this, &DisplayManager::power))
     , m_slider(new Timer<DisplayManager>(HostBase::instance()->masterTimer(), this, &DisplayManager::slider))
     , m_alertTimer(new Timer<DisplayManager>(HostBase::instance()->masterTimer(), this, &DisplayManager::alertTimerCallback))
+    , m_timeoutTimer(new DisplayTimeoutTimer(this))
     , m_maxBrightness(DEFAULT_BRIGHTNESS)
     , m_currentState (NULL)
     , m_displayStates (NULL)
@@ -929,147 +963,119 @@ error:
 
 bool DisplayManager::batteryCallback(LSHandle *sh, LSMessage *message, void *ctx)
 {
-    LSError lserror;
-    LSErrorInit(&lserror);
-    bool result = false;
-
     // {"percent": integer}
-    VALIDATE_SCHEMA_AND_RETURN(sh,
-                               message,
-                               SCHEMA_1(REQUIRED(percent, integer)));
-
-    DisplayManager *dm = (DisplayManager *)ctx;
-    json_object* root = 0;
+    // powerd sends these all the time: the payload is checked while scanning it,
+    // rather than with a schema and then a DOM
+    JsonField percent("percent");
     const char* str = LSMessageGetPayload(message);
-    if (str) {
-	root = json_tokener_parse(str);
-	result = (root && !is_error(root));
-    }
-
-    if (result)
-    {
-	json_object* label = json_object_object_get(root, "percent");
-	if (label) {
 
-	    dm->m_batteryL = json_object_get_int(label);
+    if (!JsonScanner::scan(str, &percent, 1) || percent.type != JsonField::Integer) {
+        g_warning("%s: unexpected payload '%s'", __PRETTY_FUNCTION__, str ? str : "");
+        return true;
+    }
 
-	    // if the brightness is changed because of the
-	    // battery level changing, update it.
-	    dm->updateBrightness();
-	}
+    DisplayManager *dm = (DisplayManager *)ctx;
+    dm->m_batteryL = percent.integer;
 
-	json_object_put(root);
-    }
+    // if the brightness is changed because of the
+    // battery level changing, update it.
+    dm->updateBrightness();
 
     return true;
 }
 
 bool DisplayManager::usbDockCallback(LSHandle *sh, LSMessage *message, void *ctx)
 {
-    LSError lserror;
-    LSErrorInit(&lserror);
-
     // {"Charging": boolean, "DockConnected": boolean, "DockPower": false, "DockSerialNo": string, "USBConnected": boolean, "USBName": string}
-    VALIDATE_SCHEMA_AND_RETURN(sh,
-                               message,
-                               SCHEMA_6(REQUIRED(Charging, boolean), REQUIRED(DockConnected, boolean), REQUIRED(DockPower, boolean), REQUIRED(DockSerialNo, string), REQUIRED(USBConnected, boolean), REQUIRED(USBName, string)));
+    enum { Charging = 0, DockConnected, DockPower, DockSerialNo, USBConnected, USBName, NumFields };
+    JsonField fields[NumFields] = {
+        JsonField("Charging"), JsonField("DockConnected"), JsonField("DockPower"),
+        JsonField("DockSerialNo"), JsonField("USBConnected"), JsonField("USBName")
+    };
+    static const JsonField::Type types[NumFields] = {
+        JsonField::Boolean, JsonField::Boolean, JsonField::Boolean,
+        JsonField::String, JsonField::Boolean, JsonField::String
+    };
+
+    const char* str = LSMessageGetPayload(message);
+    bool valid = JsonScanner::scan(str, fields, NumFields);
+    for (int i = 0; valid && i < NumFields; i++)
+        valid = (fields[i].type == types[i]);
+
+    if (!valid) {
+        g_warning("%s: unexpected payload '%s'", __PRETTY_FUNCTION__, str ? str : "");
+        return true;
+    }
 
     DisplayManager *dm = (DisplayManager *)ctx;
     int32_t newState = dm->m_chargerConnected;
 
-    bool usb = true;
     int event = DISPLAY_EVENT_NONE;
 
-    json_object* label = 0;
-    json_object* root = 0;
-    const char* str = LSMessageGetPayload(message);
-    bool charging = false;
+    bool charging = fields[Charging].boolean;
 
-    if (!str)
-            goto error;
+    bool dockConnected = fields[DockConnected].boolean;
+    if (dockConnected && charging) {
+        newState |= CHARGER_INDUCTIVE;
 
-    root = json_tokener_parse(str);
-    if (!root || is_error(root))
-            goto error;
-
-    label = json_object_object_get(root, "Charging");
-    if (label && !is_error (label)) {
-	    charging = json_object_get_boolean (label);
-    }
-
-    label = json_object_object_get(root, "DockConnected");
-    if (label && !is_error (label)) {
-	    bool dockConnected = json_object_get_boolean (label);
-	    if (dockConnected && charging) {
-		    newState |= CHARGER_INDUCTIVE;
-
-		    label = json_object_object_get(root, "DockSerialNo");
-		    if (label && !is_error (label)) {
-			    dm->m_puckId = json_object_get_string (label);
-			    if (dm->m_puckId == "NULL")
-				    dm->m_puckId.clear();
-		    }
-
-		    if (dm->m_chargerConnected != newState)
-		    {
-			    event = DISPLAY_EVENT_INDUCTIVE_CHARGER_CONNECTED;
-			    dm->updateState (event);
-		    }
-	    }
-	    else if (dm->m_chargerConnected & CHARGER_INDUCTIVE) {
-		    newState &= ~(CHARGER_INDUCTIVE);
-		    dm->m_puckId.clear();
-
-		    if (dm->m_chargerConnected != newState)
-		    {
-			    event = DISPLAY_EVENT_INDUCTIVE_CHARGER_DISCONNECTED;
-			    dm->updateState (event);
-		    }
-	    }
+        fields[DockSerialNo].getString(dm->m_puckId);
+        if (dm->m_puckId == "NULL")
+            dm->m_puckId.clear();
+
+        if (dm->m_chargerConnected != newState)
+        {
+            event = DISPLAY_EVENT_INDUCTIVE_CHARGER_CONNECTED;
+            dm->updateState (event);
+        }
     }
+    else if (dm->m_chargerConnected & CHARGER_INDUCTIVE) {
+        newState &= ~(CHARGER_INDUCTIVE);
+        dm->m_puckId.clear();
 
-    label = json_object_object_get(root, "USBConnected");
-    if (label && !is_error (label)) {
-	    bool usbConnected = json_object_get_boolean (label);
-	    if (usbConnected) {
-		    newState |= CHARGER_USB;
-		    if (dm->m_chargerConnected != newState
-				    && !(dm->m_chargerConnected & CHARGER_INDUCTIVE))
-		    {
-			    event = DISPLAY_EVENT_USB_CHARGER_CONNECTED;
-			    dm->updateState (event);
-		    }
-	    }
-	    else {
-		    newState &= ~(CHARGER_USB);
-		    if (dm->m_chargerConnected != newState
-				    && !(dm->m_chargerConnected & CHARGER_INDUCTIVE))
-		    {
-			    event = DISPLAY_EVENT_USB_CHARGER_DISCONNECTED;
-			    dm->updateState (event);
-		    }
-	    }
+        if (dm->m_chargerConnected != newState)
+        {
+            event = DISPLAY_EVENT_INDUCTIVE_CHARGER_DISCONNECTED;
+            dm->updateState (event);
+        }
+    }
+
+    bool usbConnected = fields[USBConnected].boolean;
+    if (usbConnected) {
+        newState |= CHARGER_USB;
+        if (dm->m_chargerConnected != newState
+                && !(dm->m_chargerConnected & CHARGER_INDUCTIVE))
+        {
+            event = DISPLAY_EVENT_USB_CHARGER_CONNECTED;
+            dm->updateState (event);
+        }
+    }
+    else {
+        newState &= ~(CHARGER_USB);
+        if (dm->m_chargerConnected != newState
+                && !(dm->m_chargerConnected & CHARGER_INDUCTIVE))
+        {
+            event = DISPLAY_EVENT_USB_CHARGER_DISCONNECTED;
+            dm->updateState (event);
+        }
     }
 
     dm->m_chargerConnected = newState;
     dm->updateBrightness ();
 
-error:
-
-	if (root && !is_error(root))
-		json_object_put(root);
-
     return true;
 }
+
 bool DisplayManager::chargerCallback(LSHandle *sh, LSMessage *message, void *ctx)
 {
-    LSError lserror;
-    LSErrorInit(&lserror);
-
     // {"type": string, "connected": boolean}
-    VALIDATE_SCHEMA_AND_RETURN(sh,
-                               message,
-                               SCHEMA_2(REQUIRED(type, string), REQUIRED(connected, boolean)));
+    JsonField fields[2] = { JsonField("type"), JsonField("connected") };
+    const char* str = LSMessageGetPayload(message);
+
+    if (!JsonScanner::scan(str, fields, 2) ||
+        fields[0].type != JsonField::String || fields[1].type != JsonField::Boolean) {
+        g_warning("%s: unexpected payload '%s'", __PRETTY_FUNCTION__, str ? str : "");
+        return true;
+    }
 
     DisplayManager *dm = (DisplayManager *)ctx;
     int32_t newState = dm->m_chargerConnected;
@@ -1077,38 +1083,20 @@ bool DisplayManager::chargerCallback(LSHandle *sh, LSMessage *message, void *ctx
     bool usb = true;
     int event = DISPLAY_EVENT_NONE;
 
-    json_object* label = 0;
-    json_object* root = 0;
-    const char* str = LSMessageGetPayload(message);
-    if (!str)
-            goto error;
-
-    root = json_tokener_parse(str);
-    if (!root || is_error(root))
-            goto error;
-
-    label = json_object_object_get(root, "type");
-    if (!label)
-            goto error;
-
-    if (0 == strcmp (json_object_get_string(label), "usb"))
+    if (fields[0].equals("usb"))
     {
         usb = true;
     }
-    else if (0 == strcmp (json_object_get_string(label), "inductive"))
+    else if (fields[0].equals("inductive"))
     {
         usb = false;
     }
     else
     {
-        goto error;
+        return true;
     }
 
-    label = json_object_object_get(root, "connected");
-    if (!label)
-        goto error;
-
-    if (json_object_get_boolean(label))
+    if (fields[1].boolean)
     {
         if (usb)
         {
@@ -1158,11 +1146,6 @@ bool DisplayManager::chargerCallback(LSHandle *sh, LSMessage *message, void *ctx
 
     dm->updateBrightness ();
 
-error:
-
-	if (root && !is_error(root))
-		json_object_put(root);
-
     return true;
 }
 
@@ -2917,6 +2900,13 @@ bool DisplayManager::alertTimerCallback ()
     return false;
 }
 
+void DisplayManager::timeoutExpired (int timeout)
+{
+    g_debug ("%s: timeout %d expired", __PRETTY_FUNCTION__, timeout);
+    if (m_currentState)
+        m_currentState->timeoutExpired ((DisplayTimeout) timeout);
+}
+
 bool DisplayManager::alert (int state)
 {
     g_debug ("%s: got the following message: %i", __FUNCTION__, state);
@@ -3439,6 +3429,9 @@ void DisplayManager::changeDisplayState (DisplayState newState, DisplayState old
     m_lastEvent = Time::curTimeMs();
     m_currentState = m_displayStates[newState];
 
+    // a timeout armed by the state just left is no longer meaningful
+    m_timeoutTimer->disarm();
+
     switch (newState) {
         case DisplayStateOff:
         case DisplayStateOffOnCall:
@@ -30,6 +30,7 @@
 #include "sptr.h"
 #include "AmbientLightSensor.h"
 #include "DisplayStates.h"
+#include "InactivityDeadline.h"
 
 #include <QEvent>
 #include <QObject>
@@ -222,6 +223,7 @@ private:
     Timer<DisplayManager>* m_power;
     Timer<DisplayManager>* m_slider;
     Timer<DisplayManager>* m_alertTimer;
+    InactivityTimer*       m_timeoutTimer;         // shared by the display states' inactivity timeouts
     int32_t                m_maxBrightness;
 
     std::string 	   m_puckId;
@@ -239,6 +241,7 @@ private:
     bool power();
     bool slider();
     bool alertTimerCallback();
+    void timeoutExpired (int timeout);
     bool updateTimeout(int timeoutInMs);
     bool setTimeout (int timeout);
     bool notifySubscribers(int type, sptr<Event> event = 0);
@@ -249,6 +252,7 @@ private:
     void setTouchpanelMode (bool active);
 
     friend class DisplayStateBase;
+    friend class DisplayTimeoutTimer;
 
     void	changeDisplayState (DisplayState newDisplayState, DisplayState oldDisplayState, DisplayEvent displayEvent, sptr<Event> event);
     void	updateLockState (DisplayLockState lockState, DisplayState state, DisplayEvent displayEvent);
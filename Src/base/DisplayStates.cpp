@@ -193,6 +193,34 @@ void DisplayStateBase::updateLastEvent()
     dm->m_lastEvent = Time::curTimeMs();
 }
 
+void DisplayStateBase::armTimeout (DisplayTimeout timeout, int timeoutMs)
+{
+    if (!dm)
+        dm = DisplayManager::instance();
+
+    dm->m_timeoutTimer->arm (timeout, timeoutMs);
+}
+
+void DisplayStateBase::disarmTimeout()
+{
+    if (!dm)
+        dm = DisplayManager::instance();
+
+    dm->m_timeoutTimer->disarm();
+}
+
+bool DisplayStateBase::isTimeoutArmed (DisplayTimeout timeout)
+{
+    if (!dm)
+        dm = DisplayManager::instance();
+
+    return dm->m_timeoutTimer->armed() == timeout;
+}
+
+void DisplayStateBase::timeoutExpired (DisplayTimeout timeout)
+{
+}
+
 void DisplayStateBase::displayOn(bool als)
 {
     if (!dm)
@@ -799,8 +827,6 @@ void DisplayOffOnCall::leave (DisplayState newState, DisplayEvent displayEvent,
 // ---------------------- DisplayOn ----------------------------------------
 
 DisplayOn::DisplayOn()
-    : m_timerUser (new Timer<DisplayOn>(HostBase::instance()->masterTimer(), this, &DisplayOn::timeoutUser))
-    , m_timerInternal (new Timer<DisplayOn>(HostBase::instance()->masterTimer(), this, &DisplayOn::timeoutInternal))
 {
 }
 
@@ -825,29 +851,25 @@ void DisplayOn::startInactivityTimer()
     startUserInactivityTimer();
 }
 
+// called for most events: it only moves the last event time, and arms the timeout
+// if it isn't already. The deadline timer catches up with the last event when it fires
 void DisplayOn::startUserInactivityTimer()
 {
-    if (m_timerInternal->running())
-        m_timerInternal->stop();
-
-    if (m_timerUser->running())
-        m_timerUser->stop();
+    updateLastEvent();
 
     if (isDNAST()) {
+        disarmTimeout();
         g_warning ("not starting timer due to DNAST enabled");
         return;
     }
 
 #if defined(HAS_DISPLAY_TIMEOUT) && !(defined(TARGET_DESKTOP) || defined(TARGET_EMULATOR))
-    g_debug("%s: %d ms", __PRETTY_FUNCTION__, dimTimeout());
-    if (isDemo()) {
-        g_warning("%s: in demo mode, inactivity timer started for %d", __PRETTY_FUNCTION__, dimTimeout() + offTimeout());
-        m_timerUser->start (dimTimeout() + offTimeout());
-    } else {
-        m_timerUser->start (dimTimeout());
-    }
+    if (isDemo())
+        armTimeout (DisplayTimeoutUser, dimTimeout() + offTimeout());
+    else
+        armTimeout (DisplayTimeoutUser, dimTimeout());
 #else
-    g_debug("%s: not starting display timeout timer, display timeouts disabled", __PRETTY_FUNCTION__);
+    disarmTimeout();
 #endif
 }
 
@@ -858,22 +880,28 @@ void DisplayOn::startInternalInactivityTimer()
         return;
     }
 
-    if (m_timerUser->running()) {
+    if (isTimeoutArmed (DisplayTimeoutUser)) {
         g_warning ("user inactivity timer is running, ignoring this");
         return;
     }
 
-    g_debug ("%s: %d ms", __PRETTY_FUNCTION__, dimTimeout());
-    m_timerInternal->start (lockedOffTimeout());
+    g_debug ("%s: %d ms", __PRETTY_FUNCTION__, lockedOffTimeout());
+    updateLastEvent();
+    armTimeout (DisplayTimeoutInternal, lockedOffTimeout());
 }
 
 void DisplayOn::stopInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timerUser->running())
-        m_timerUser->stop();
-    if (m_timerInternal->running())
-        m_timerInternal->stop();
+    disarmTimeout();
+}
+
+void DisplayOn::timeoutExpired (DisplayTimeout timeout)
+{
+    if (timeout == DisplayTimeoutUser)
+        timeoutUser();
+    else if (timeout == DisplayTimeoutInternal)
+        timeoutInternal();
 }
 
 bool DisplayOn::timeoutUser()
@@ -897,7 +925,7 @@ bool DisplayOn::timeoutUser()
     if (now <  (unsigned int) dimTimeout() + lastEvent())
     {
 	g_debug ("%s: restart the dim timer for %u ms", __PRETTY_FUNCTION__, dimTimeout() + lastEvent() - now);
-	m_timerUser->start (dimTimeout() + lastEvent() - now);
+	armTimeout (DisplayTimeoutUser, dimTimeout());
     }
     else
     {
@@ -931,7 +959,7 @@ bool DisplayOn::timeoutInternal()
     if (now <  (unsigned int) lockedOffTimeout() + lastEvent())
     {
 	g_debug ("%s: restart the dim timer for %u ms", __PRETTY_FUNCTION__, dimTimeout() + lastEvent() - now);
-	m_timerInternal->start (lockedOffTimeout() + lastEvent() - now);
+	armTimeout (DisplayTimeoutInternal, lockedOffTimeout());
     }
     else
     {
@@ -1083,7 +1111,6 @@ bool DisplayOn::updateBrightness (int alsRegion)
 
 // ---------------------- DisplayOnLocked ----------------------------------------
 DisplayOnLocked::DisplayOnLocked()
-    : m_timer (new Timer<DisplayOnLocked>(HostBase::instance()->masterTimer(), this, &DisplayOnLocked::timeout))
 {
 }
 
@@ -1102,23 +1129,27 @@ void DisplayOnLocked::enter (DisplayState state, DisplayEvent displayEvent, sptr
 void DisplayOnLocked::startInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
-
     if (isDNAST()) {
+	disarmTimeout();
 	g_warning ("not starting timer due to DNAST enabled");
 	return;
     }
     g_debug ("%s: %d ms", __PRETTY_FUNCTION__, lockedOffTimeout());
 
-    m_timer->start (lockedOffTimeout());
+    updateLastEvent();
+    armTimeout (DisplayTimeoutLocked, lockedOffTimeout());
 }
 
 void DisplayOnLocked::stopInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
+    disarmTimeout();
+}
+
+void DisplayOnLocked::timeoutExpired (DisplayTimeout timeout)
+{
+    if (timeout == DisplayTimeoutLocked)
+        this->timeout();
 }
 
 bool DisplayOnLocked::timeout()
@@ -1142,7 +1173,7 @@ bool DisplayOnLocked::timeout()
     if (now <  (unsigned int) lockedOffTimeout() + lastEvent())
     {
 	g_debug ("%s: restart the dim timer for %u ms", __PRETTY_FUNCTION__, lockedOffTimeout() + lastEvent() - now);
-	m_timer->start (lockedOffTimeout() + lastEvent() - now);
+	armTimeout (DisplayTimeoutLocked, lockedOffTimeout());
     }
     else
     {
@@ -1305,25 +1336,26 @@ bool DisplayOnLocked::updateBrightness (int alsRegion)
 // ---------------------- DisplayDim ----------------------------------------
 
 DisplayDim::DisplayDim()
-    : m_timer (new Timer<DisplayDim>(HostBase::instance()->masterTimer(), this, &DisplayDim::timeout))
 {
 }
 
 void DisplayDim::startInactivityTimer()
 {
-    g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
-
     g_debug ("%s: %d ms", __PRETTY_FUNCTION__, offTimeout());
-    m_timer->start (offTimeout());
+    updateLastEvent();
+    armTimeout (DisplayTimeoutDim, offTimeout());
 }
 
 void DisplayDim::stopInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
+    disarmTimeout();
+}
+
+void DisplayDim::timeoutExpired (DisplayTimeout timeout)
+{
+    if (timeout == DisplayTimeoutDim)
+        this->timeout();
 }
 
 bool DisplayDim::timeout()
@@ -1347,7 +1379,7 @@ bool DisplayDim::timeout()
     if (now <  (unsigned int) offTimeout() + lastEvent())
     {
 	g_debug ("%s: restart the dim timer for %u ms", __PRETTY_FUNCTION__, dimTimeout() + lastEvent() - now);
-	m_timer->start (offTimeout() + lastEvent() - now);
+	armTimeout (DisplayTimeoutDim, offTimeout());
     }
     else {
 	g_message ("%s: calling off() in on or onpuck state", __PRETTY_FUNCTION__);
@@ -1544,7 +1576,6 @@ void DisplayDim::leave (DisplayState newState, DisplayEvent displayEvent, sptr<E
 // ---------------------- DisplayOnPuck ----------------------------------------
 
 DisplayOnPuck::DisplayOnPuck()
-    : m_timer (new Timer<DisplayOnPuck>(HostBase::instance()->masterTimer(), this, &DisplayOnPuck::timeout))
 {
 
 }
@@ -1566,23 +1597,27 @@ void DisplayOnPuck::enter (DisplayState state, DisplayEvent displayEvent, sptr<E
 void DisplayOnPuck::startInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
-
     if (isOnCall() || isDNAST()) {
+	disarmTimeout();
 	g_warning ("not starting timer due to DNAST enabled or onCall");
 	return;
     }
 
     g_debug ("%s: %d ms", __PRETTY_FUNCTION__, dimTimeout() + offTimeout());
-    m_timer->start (dimTimeout() + offTimeout());
+    updateLastEvent();
+    armTimeout (DisplayTimeoutPuck, dimTimeout() + offTimeout());
 }
 
 void DisplayOnPuck::stopInactivityTimer()
 {
     g_debug ("%s: ", __PRETTY_FUNCTION__);
-    if (m_timer->running())
-        m_timer->stop();
+    disarmTimeout();
+}
+
+void DisplayOnPuck::timeoutExpired (DisplayTimeout timeout)
+{
+    if (timeout == DisplayTimeoutPuck)
+        this->timeout();
 }
 
 bool DisplayOnPuck::timeout()
@@ -1608,7 +1643,7 @@ bool DisplayOnPuck::timeout()
     if (now <  (unsigned int) (dimTimeout() + offTimeout()) + lastEvent())
     {
 	g_debug ("%s: restart the dim timer for %u ms", __PRETTY_FUNCTION__, dimTimeout() + lastEvent() - now);
-	m_timer->start ((dimTimeout() + offTimeout()) + lastEvent() - now);
+	armTimeout (DisplayTimeoutPuck, dimTimeout() + offTimeout());
     }
     else {
 	g_message ("%s: going to dockmode", __PRETTY_FUNCTION__);
@@ -82,6 +82,17 @@ enum DisplayLockState {
     DisplayLockDockMode
 };
 
+// DisplayTimeout: the inactivity timeouts of the display states. Only one is armed at a
+// time, on DisplayManager's single deadline timer, counted from the last user activity
+enum DisplayTimeout {
+    DisplayTimeoutNone,
+    DisplayTimeoutUser,
+    DisplayTimeoutInternal,
+    DisplayTimeoutLocked,
+    DisplayTimeoutDim,
+    DisplayTimeoutPuck
+};
+
 // forward declaration needed to use display manager
 class DisplayManager;
 
@@ -128,6 +139,11 @@ class DisplayStateBase {
         virtual void stopInactivityTimer();
         virtual void startInactivityTimer();
 
+	void armTimeout (DisplayTimeout timeout, int timeoutMs);
+	void disarmTimeout();
+	bool isTimeoutArmed (DisplayTimeout timeout);
+	virtual void timeoutExpired (DisplayTimeout timeout);
+
 	void displayOn(bool als);
 	void displayDim();
 	void displayOff();
@@ -192,9 +208,6 @@ class DisplayOffOnCall : public DisplayStateBase {
 
 class DisplayOn : public DisplayStateBase {
     private:
-	Timer<DisplayOn> *m_timerUser;
-	Timer<DisplayOn> *m_timerInternal;
-
         void startUserInactivityTimer();
         void startInternalInactivityTimer();
     public:
@@ -210,6 +223,7 @@ class DisplayOn : public DisplayStateBase {
         bool updateBrightness (int alsRegion);
 	bool timeoutUser();
 	bool timeoutInternal();
+	void timeoutExpired (DisplayTimeout timeout);
         void stopInactivityTimer();
         void startInactivityTimer();
 };
@@ -225,9 +239,6 @@ class DisplayOn : public DisplayStateBase {
 // any change in als will cause brightness and core navi update
 
 class DisplayOnLocked : public DisplayStateBase {
-    private:
-	Timer<DisplayOnLocked> *m_timer;
-
     public:
         DisplayOnLocked();
 
@@ -240,6 +251,7 @@ class DisplayOnLocked : public DisplayStateBase {
 
         bool updateBrightness (int alsRegion);
 	bool timeout();
+	void timeoutExpired (DisplayTimeout timeout);
         void stopInactivityTimer();
         void startInactivityTimer();
 };
@@ -254,9 +266,6 @@ class DisplayOnLocked : public DisplayStateBase {
 // als events are ignored
 
 class DisplayDim : public DisplayStateBase {
-    private:
-	Timer<DisplayDim> *m_timer;
-
     public:
         DisplayDim();
 	DisplayState state() const { return DisplayStateDim; }
@@ -266,6 +275,7 @@ class DisplayDim : public DisplayStateBase {
 
 	void handleEvent (DisplayEvent displayEvent, sptr<Event> event = NULL);
 	bool timeout();
+	void timeoutExpired (DisplayTimeout timeout);
 
         void stopInactivityTimer();
         void startInactivityTimer();
@@ -279,9 +289,6 @@ class DisplayDim : public DisplayStateBase {
 // all other events do not cause change in state
 
 class DisplayOnPuck : public DisplayStateBase {
-    private:
-	Timer<DisplayOnPuck> *m_timer;
-
     public:
         DisplayOnPuck();
 	DisplayState state() const { return DisplayStateOnPuck; }
@@ -293,6 +300,7 @@ class DisplayOnPuck : public DisplayStateBase {
 
         bool updateBrightness (int alsRegion);
 	bool timeout();
+	void timeoutExpired (DisplayTimeout timeout);
 
         void stopInactivityTimer();
         void startInactivityTimer();
@@ -30,6 +30,9 @@
 
 static EventThrottler* s_instance = 0;
 
+// frame period moves are resampled to, on the clock of Event::time
+static const uint32_t kFramePeriodMs = 16;
+
 	EventThrottler::EventThrottler()
 	: m_penTracking (false)
 	, m_lastPostedPenMoveTime(0)
@@ -81,6 +84,8 @@ void EventThrottler::updatePenLocation (Event* event)
 		m_lastPostedPenDownTime = event->time;
 		m_lastPostedPenMoveTime = event->time;
 		m_penTracking = true;
+		m_penResampler.reset();
+		m_penResampler.addSample(event->x, event->y, event->time);
 	}
 	if (event->type == Event::PenUp) {
 
@@ -94,6 +99,7 @@ void EventThrottler::updatePenLocation (Event* event)
 		m_lastPostedPenDownTime = 0;
 		m_lastPostedPenMoveTime = 0;
 		m_penTracking = false;
+		m_penResampler.reset();
 	}
 }
 
@@ -120,6 +126,8 @@ bool EventThrottler::shouldDropMove(Event* event)
 	if( event->type != Event::PenMove )
 		return false;
 
+	m_penResampler.addSample(event->x, event->y, event->time);
+
 	int delta_ms = event->time - m_lastPostedPenMoveTime;
 	int hz = 0;
 
@@ -170,6 +178,25 @@ bool EventThrottler::shouldDropMove(Event* event)
 	return false;
 }
 
+bool EventThrottler::resampleMove(Event* event)
+{
+	if (event->type != Event::PenMove)
+		return true;
+
+	// the web app can't show moves faster than it renders frames
+	uint32_t sinceDown = event->time - m_lastPostedPenDownTime;
+	uint32_t frameTime = m_lastPostedPenDownTime + (sinceDown / kFramePeriodMs + 1) * kFramePeriodMs;
+
+	int x, y;
+	if (!m_penResampler.resample(frameTime, &x, &y))
+		return false;
+
+	event->x = x;
+	event->y = y;
+	event->time = frameTime;
+	return true;
+}
+
 bool EventThrottler::shouldDropGestureChange(Event* event)
 {
 	int hz=0;
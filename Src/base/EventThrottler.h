@@ -25,6 +25,7 @@
 #include "Common.h"
 
 #include "Event.h"
+#include "PenMoveResampler.h"
 
 class QEvent;
 class QTouchEvent;
@@ -38,6 +39,11 @@ public:
 	static EventThrottler* instance();
 
 	bool shouldDropEvent(Event* e);
+
+	// for a pen move that is going out: moves it to where the pen will be at the next frame
+	// deadline (frames counted from pen down), from every move seen since pen down, dropped
+	// or not. False to drop it: a move already went out for that frame, or the pen hasn't moved
+	bool resampleMove(Event* e);
 	bool shouldDropEvent(QEvent* e);
 
 private:
@@ -47,6 +53,7 @@ private:
 	uint32_t m_lastPostedPenDownTime;
 	int m_lastPostedPenMoveX;
 	int m_lastPostedPenMoveY;
+	PenMoveResampler m_penResampler;
 
 	int m_lastPostedGestureChangeX;
 	int m_lastPostedGestureChangeY;
@@ -0,0 +1,118 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "InactivityDeadline.h"
+
+// clock values wrap: compare them by difference
+static inline bool before(uint32_t a, uint32_t b)
+{
+	return (int32_t) (a - b) < 0;
+}
+
+InactivityDeadline::InactivityDeadline()
+	: m_kind(0)
+	, m_timeout(0)
+	, m_running(false)
+	, m_fireTime(0)
+{
+}
+
+bool InactivityDeadline::arm(int kind, uint32_t timeoutMs, uint32_t lastActivity, uint32_t now, uint32_t* delayMs)
+{
+	m_kind = kind;
+	m_timeout = timeoutMs;
+
+	// a timer firing early only checks again: leave it be
+	uint32_t deadline = lastActivity + timeoutMs;
+	if (m_running && !before(deadline, m_fireTime))
+		return false;
+
+	m_fireTime = before(deadline, now) ? now : deadline;
+	m_running = true;
+	*delayMs = m_fireTime - now;
+	return true;
+}
+
+bool InactivityDeadline::disarm()
+{
+	bool wasRunning = m_running;
+	m_kind = 0;
+	m_running = false;
+	return wasRunning;
+}
+
+bool InactivityDeadline::expired(uint32_t lastActivity, uint32_t now, uint32_t* delayMs)
+{
+	m_running = false;
+	if (!m_kind)
+		return false;
+
+	uint32_t deadline = lastActivity + m_timeout;
+	if (before(now, deadline)) {
+		m_fireTime = deadline;
+		m_running = true;
+		*delayMs = deadline - now;
+		return false;
+	}
+
+	m_kind = 0;
+	return true;
+}
+
+InactivityTimer::InactivityTimer(const uint32_t& lastActivity)
+	: m_lastActivity(lastActivity)
+{
+}
+
+InactivityTimer::~InactivityTimer()
+{
+}
+
+void InactivityTimer::arm(int kind, uint32_t timeoutMs)
+{
+	bool wasRunning = m_deadline.timerRunning();
+	uint32_t delay = 0;
+
+	if (m_deadline.arm(kind, timeoutMs, m_lastActivity, now(), &delay)) {
+		if (wasRunning)
+			stopTimer();
+		startTimer(delay);
+	}
+}
+
+void InactivityTimer::disarm()
+{
+	if (m_deadline.disarm())
+		stopTimer();
+}
+
+void InactivityTimer::fire()
+{
+	int kind = m_deadline.kind();
+	uint32_t delay = 0;
+
+	if (m_deadline.expired(m_lastActivity, now(), &delay))
+		timeoutExpired(kind);
+	else if (m_deadline.timerRunning())
+		startTimer(delay);
+}
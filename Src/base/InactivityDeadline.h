@@ -0,0 +1,111 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef INACTIVITYDEADLINE_H
+#define INACTIVITYDEADLINE_H
+
+#include "Common.h"
+
+#include <stdint.h>
+
+/**
+ * The bookkeeping behind a lazy inactivity timer.
+ *
+ * User activity only moves a last-activity timestamp, kept by the caller: nothing here
+ * runs per event. One timeout at a time is armed, counted from that timestamp. The
+ * timer is only (re)started when it would otherwise fire too late. When it fires,
+ * expired() checks the timestamp again: either the timeout has passed or the timer
+ * goes on to the new deadline. That is one timer start per timeout period at most,
+ * however much activity there is.
+ *
+ * The caller owns the timer and does what the return values say: arm() and expired()
+ * give the delay to start it with, and disarm() says whether to stop it. InactivityTimer
+ * below does that.
+ */
+class InactivityDeadline
+{
+public:
+
+	InactivityDeadline();
+
+	// which timeout is armed, 0 if none
+	int kind() const { return m_kind; }
+	bool timerRunning() const { return m_running; }
+
+	// arms timeoutMs after lastActivity, replacing whatever was armed. True if the
+	// timer has to be (re)started for *delayMs
+	bool arm(int kind, uint32_t timeoutMs, uint32_t lastActivity, uint32_t now, uint32_t* delayMs);
+
+	// true if the timer has to be stopped
+	bool disarm();
+
+	// the timer fired. True if the armed timeout has passed, which disarms it. Otherwise
+	// the timer has to be started again for *delayMs, unless nothing is armed
+	bool expired(uint32_t lastActivity, uint32_t now, uint32_t* delayMs);
+
+private:
+
+	int			m_kind;
+	uint32_t	m_timeout;
+	bool		m_running;
+	uint32_t	m_fireTime;
+};
+
+/**
+ * Runs an InactivityDeadline on a timer: starts and stops it as the deadline says and
+ * reports the timeout once it has passed. The subclass supplies the timer and the clock,
+ * and calls fire() when its timer goes off. The timeouts count from lastActivity, which
+ * the owner moves on every event.
+ */
+class InactivityTimer
+{
+public:
+
+	InactivityTimer(const uint32_t& lastActivity);
+	virtual ~InactivityTimer();
+
+	// which timeout is armed, 0 if none
+	int armed() const { return m_deadline.kind(); }
+	bool timerRunning() const { return m_deadline.timerRunning(); }
+
+	// arms timeoutMs after the last activity, replacing whatever was armed
+	void arm(int kind, uint32_t timeoutMs);
+	void disarm();
+
+	// the timer went off
+	void fire();
+
+protected:
+
+	virtual uint32_t now() const = 0;
+	virtual void startTimer(uint32_t delayMs) = 0;
+	virtual void stopTimer() = 0;
+
+	// the armed timeout has passed and is no longer armed
+	virtual void timeoutExpired(int kind) = 0;
+
+private:
+
+	const uint32_t&		m_lastActivity;
+	InactivityDeadline	m_deadline;
+};
+
+#endif /* INACTIVITYDEADLINE_H */
@@ -0,0 +1,84 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "InitGraph.h"
+#include "StartupTracer.h"
+
+#include <glib.h>
+
+int InitGraph::add(const char* name, InitFunc func)
+{
+	Step step;
+	step.name = name;
+	step.func = func;
+	step.numDependencies = 0;
+
+	m_steps.push_back(step);
+	return m_steps.size() - 1;
+}
+
+void InitGraph::dependsOn(int step, int dependency)
+{
+	m_steps[dependency].dependents.push_back(step);
+	m_steps[step].numDependencies++;
+}
+
+bool InitGraph::run()
+{
+	const int numSteps = m_steps.size();
+
+	// dependencies not done yet, per step; -1 once it ran
+	std::vector<int> remaining(numSteps);
+	for (int i = 0; i < numSteps; i++)
+		remaining[i] = m_steps[i].numDependencies;
+
+	m_startOrder.clear();
+	while ((int) m_startOrder.size() < numSteps) {
+		int step = 0;
+		while (step < numSteps && remaining[step] != 0)
+			step++;
+
+		if (step == numSteps)
+			break;
+
+		m_startOrder.push_back(step);
+		remaining[step] = -1;
+		{
+			StartupPhase phase(m_steps[step].name);
+			m_steps[step].func();
+		}
+
+		const std::vector<int>& dependents = m_steps[step].dependents;
+		for (size_t i = 0; i < dependents.size(); i++)
+			remaining[dependents[i]]--;
+	}
+
+	if ((int) m_startOrder.size() == numSteps)
+		return true;
+
+	for (int i = 0; i < numSteps; i++) {
+		if (remaining[i] > 0)
+			g_critical("%s: %s never ran: dependency cycle", __PRETTY_FUNCTION__, m_steps[i].name);
+	}
+	return false;
+}
@@ -0,0 +1,74 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef INITGRAPH_H
+#define INITGRAPH_H
+
+#include "Common.h"
+
+#include <vector>
+
+/**
+ * Runs a set of initialization steps in dependency order, on the calling thread.
+ *
+ * Of the steps whose dependencies are done, the one added first runs next. Each step
+ * is traced as a StartupTracer phase, so that the startup timeline shows what each
+ * service costs.
+ */
+class InitGraph
+{
+public:
+
+	typedef void (*InitFunc)();
+
+	InitGraph() {}
+
+	// returns the id of the step, for dependsOn(). name must outlive the graph
+	int			add(const char* name, InitFunc func);
+	void		dependsOn(int step, int dependency);
+
+	// returns false if some steps couldn't run (dependency cycle)
+	bool		run();
+
+	// order in which the steps were run, for diagnostics
+	const std::vector<int>& startOrder() const { return m_startOrder; }
+	const char*	name(int step) const { return m_steps[step].name; }
+
+private:
+
+	struct Step
+	{
+		const char*			name;
+		InitFunc			func;
+		std::vector<int>	dependents;
+		int					numDependencies;
+	};
+
+	std::vector<Step>	m_steps;
+	std::vector<int>	m_startOrder;
+
+private:
+
+	InitGraph(const InitGraph&);
+	InitGraph& operator=(const InitGraph&);
+};
+
+#endif /* INITGRAPH_H */
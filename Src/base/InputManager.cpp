@@ -24,6 +24,7 @@
 #include "CustomEvents.h"
 #include "HostBase.h"
 #include "JSONUtils.h"
+#include "JsonScanner.h"
 #include "Preferences.h"
 #include "SystemService.h"
 
@@ -370,16 +371,10 @@ Error:
 
 bool InputManager::processKeyState(LSHandle* handle, LSMessage* msg, void* userData)
 {
-    // {"get": string}
-    VALIDATE_SCHEMA_AND_RETURN(handle,
-                               msg,
-                               SCHEMA_1(REQUIRED(get, string)));
-
 	bool success = false;
-	const char* keyString = NULL;
+	char keyString[32];
 	QEvent::Type state = QEvent::None;
 	LSError err;
-	json_object* root = 0;
 
 	LSErrorInit(&err);
 
@@ -390,22 +385,21 @@ bool InputManager::processKeyState(LSHandle* handle, LSMessage* msg, void* userD
 		return false;
 	}
 
-	root = json_tokener_parse(str);
-	if (root && !is_error(root)) {
-
-		// Get the key name from the msg -- the format will be {"get":"NAME"},
-		// where NAME is something like ringer, slider, etc
-		keyString = json_object_get_string(json_object_object_get(root, "get"));
-		if (keyString) {
+	// Get the key name from the msg -- the format will be {"get":"NAME"},
+	// where NAME is something like ringer, slider, etc
+	JsonField get("get");
+	if (JsonScanner::scan(str, &get, 1) && get.copyString(keyString, sizeof(keyString)) >= 0) {
 
-			// lookup the state of the key
-			Qt::Key key = stringToKey(keyString);
-			state = getKeyState(key);
+		// lookup the state of the key
+		Qt::Key key = stringToKey(keyString);
+		state = getKeyState(key);
 
-			success = true;
-		}
+		success = true;
 	}
-	
+	else {
+		g_warning("%s: expected {\"get\": string}, got '%s'", __PRETTY_FUNCTION__, str);
+	}
+
 	json_object* response = 0;
 	if (success) {
 		response = createKeyJson(keyString, state);
@@ -420,9 +414,6 @@ bool InputManager::processKeyState(LSHandle* handle, LSMessage* msg, void* userD
 		LSErrorFree(&err);
 	}
 
-	if (root && !is_error(root))
-		json_object_put(root);
-
 	json_object_put(response);
 
 	return true;
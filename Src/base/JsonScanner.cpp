@@ -0,0 +1,599 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "JsonScanner.h"
+
+#include <limits.h>
+#include <string.h>
+
+void JsonField::reset()
+{
+	type = Missing;
+	boolean = false;
+	integer = 0;
+	number = 0;
+	start = 0;
+	length = 0;
+	escaped = false;
+}
+
+bool JsonField::getBool(bool& value) const
+{
+	if (type != Boolean)
+		return false;
+
+	value = boolean;
+	return true;
+}
+
+bool JsonField::getInt(int& value) const
+{
+	if (type != Integer)
+		return false;
+
+	value = integer;
+	return true;
+}
+
+bool JsonField::getDouble(double& value) const
+{
+	if (type != Integer && type != Double)
+		return false;
+
+	value = number;
+	return true;
+}
+
+static int hexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+static int readHex4(const char* p)
+{
+	int value = 0;
+	for (int i = 0; i < 4; i++) {
+		int digit = hexValue(p[i]);
+		if (digit < 0)
+			return -1;
+		value = (value << 4) | digit;
+	}
+	return value;
+}
+
+// decodes the character at p (past the string's end: 0), into out as UTF-8; returns
+// the number of bytes written, and moves p past what it read
+static int decodeChar(const char*& p, const char* end, char out[4])
+{
+	if (*p != '\\') {
+		out[0] = *p++;
+		return 1;
+	}
+
+	if (p + 1 >= end) {
+		p = end;
+		return 0;
+	}
+
+	char c = p[1];
+	p += 2;
+
+	switch (c) {
+	case 'b':	out[0] = '\b'; return 1;
+	case 'f':	out[0] = '\f'; return 1;
+	case 'n':	out[0] = '\n'; return 1;
+	case 'r':	out[0] = '\r'; return 1;
+	case 't':	out[0] = '\t'; return 1;
+	case 'u':	break;
+	default:	out[0] = c; return 1;
+	}
+
+	int code = (end - p >= 4) ? readHex4(p) : -1;
+	if (code < 0) {
+		p = end;
+		return 0;
+	}
+	p += 4;
+
+	// a surrogate pair
+	if (code >= 0xd800 && code < 0xdc00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+		int low = readHex4(p + 2);
+		if (low >= 0xdc00 && low < 0xe000) {
+			code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+			p += 6;
+		}
+	}
+
+	if (code < 0x80) {
+		out[0] = code;
+		return 1;
+	}
+	if (code < 0x800) {
+		out[0] = 0xc0 | (code >> 6);
+		out[1] = 0x80 | (code & 0x3f);
+		return 2;
+	}
+	if (code < 0x10000) {
+		out[0] = 0xe0 | (code >> 12);
+		out[1] = 0x80 | ((code >> 6) & 0x3f);
+		out[2] = 0x80 | (code & 0x3f);
+		return 3;
+	}
+	out[0] = 0xf0 | (code >> 18);
+	out[1] = 0x80 | ((code >> 12) & 0x3f);
+	out[2] = 0x80 | ((code >> 6) & 0x3f);
+	out[3] = 0x80 | (code & 0x3f);
+	return 4;
+}
+
+bool JsonField::equals(const char* str) const
+{
+	if (type != String || !str)
+		return false;
+
+	if (!escaped)
+		return (int) strlen(str) == length && memcmp(start, str, length) == 0;
+
+	const char* p = start;
+	const char* end = start + length;
+	while (p < end) {
+		char decoded[4];
+		int n = decodeChar(p, end, decoded);
+		if (strncmp(str, decoded, n) != 0)
+			return false;
+		str += n;
+	}
+
+	return *str == '\0';
+}
+
+int JsonField::copyString(char* buffer, int size) const
+{
+	if (type != String || size <= 0)
+		return -1;
+
+	int written = 0;
+	const char* p = start;
+	const char* end = start + length;
+	while (p < end) {
+		char decoded[4];
+		int n = decodeChar(p, end, decoded);
+		if (written + n >= size)
+			return -1;
+		memcpy(buffer + written, decoded, n);
+		written += n;
+	}
+
+	buffer[written] = '\0';
+	return written;
+}
+
+bool JsonField::getString(std::string& value) const
+{
+	if (type != String)
+		return false;
+
+	if (!escaped) {
+		value.assign(start, length);
+		return true;
+	}
+
+	value.clear();
+	value.reserve(length);
+
+	const char* p = start;
+	const char* end = start + length;
+	while (p < end) {
+		char decoded[4];
+		int n = decodeChar(p, end, decoded);
+		value.append(decoded, n);
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+namespace {
+
+struct Scanner
+{
+	const char*	p;
+	JsonField*	fields;
+	int			numFields;
+	int			remaining;
+
+	// the keys from the root to the current value
+	const char*	keys[JsonScanner::kMaxDepth];
+	int			keyLengths[JsonScanner::kMaxDepth];
+	int			depth;
+	int			arrayDepth;
+
+	bool		done;
+
+	void skipSpace()
+	{
+		while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+			p++;
+	}
+
+	bool matches(const char* path) const
+	{
+		for (int i = 0; i < depth; i++) {
+			if (strncmp(path, keys[i], keyLengths[i]) != 0)
+				return false;
+
+			path += keyLengths[i];
+			if (i == depth - 1)
+				return *path == '\0';
+			if (*path != '.')
+				return false;
+			path++;
+		}
+		return false;
+	}
+
+	JsonField* fieldForCurrentKey()
+	{
+		if (arrayDepth > 0)
+			return 0;
+
+		for (int i = 0; i < numFields; i++) {
+			if (!fields[i].found() && matches(fields[i].path))
+				return &fields[i];
+		}
+		return 0;
+	}
+
+	bool scanString(const char*& start, int& length, bool& escaped)
+	{
+		// p is on the opening quote
+		start = ++p;
+		escaped = false;
+
+		while (*p != '"') {
+			if ((unsigned char) *p < 0x20)
+				return false;	// includes the end of the payload
+
+			if (*p == '\\') {
+				escaped = true;
+				p++;
+				if (*p == 'u') {
+					if (readHex4(p + 1) < 0)
+						return false;
+					p += 4;
+				} else if (*p == '\0' || !strchr("\"\\/bfnrt", *p)) {
+					return false;
+				}
+			}
+			p++;
+		}
+
+		length = p - start;
+		p++;
+		return true;
+	}
+
+	bool scanNumber(JsonField* field)
+	{
+		const char* start = p;
+		bool negative = false;
+		bool integral = true;
+		long long mantissa = 0;
+		double value = 0;
+
+		if (*p == '-') {
+			negative = true;
+			p++;
+		}
+
+		if (*p < '0' || *p > '9')
+			return false;
+
+		while (*p >= '0' && *p <= '9') {
+			value = value * 10 + (*p - '0');
+			if (mantissa <= LLONG_MAX / 10)
+				mantissa = mantissa * 10 + (*p - '0');
+			p++;
+		}
+
+		if (*p == '.') {
+			integral = false;
+			p++;
+			if (*p < '0' || *p > '9')
+				return false;
+
+			double scale = 0.1;
+			while (*p >= '0' && *p <= '9') {
+				value += (*p - '0') * scale;
+				scale *= 0.1;
+				p++;
+			}
+		}
+
+		if (*p == 'e' || *p == 'E') {
+			integral = false;
+			p++;
+
+			bool negativeExponent = false;
+			if (*p == '+' || *p == '-')
+				negativeExponent = (*p++ == '-');
+			if (*p < '0' || *p > '9')
+				return false;
+
+			int exponent = 0;
+			while (*p >= '0' && *p <= '9') {
+				if (exponent < 1000)
+					exponent = exponent * 10 + (*p - '0');
+				p++;
+			}
+
+			// not as exact as strtod, but independent of the locale
+			for (int i = 0; i < exponent; i++)
+				value = negativeExponent ? value / 10 : value * 10;
+		}
+
+		if (field) {
+			field->type = integral ? JsonField::Integer : JsonField::Double;
+			field->number = negative ? -value : value;
+
+			if (integral) {
+				long long integer = negative ? -mantissa : mantissa;
+				field->integer = integer > INT_MAX ? INT_MAX : (integer < INT_MIN ? INT_MIN : (int) integer);
+			} else if (field->number >= INT_MAX) {
+				// out of range, or an exponent that overflowed to infinity: casting those is undefined
+				field->integer = INT_MAX;
+			} else if (field->number <= INT_MIN) {
+				field->integer = INT_MIN;
+			} else {
+				field->integer = (int) field->number;
+			}
+
+			field->start = start;
+			field->length = p - start;
+		}
+
+		return true;
+	}
+
+	bool scanLiteral(const char* literal)
+	{
+		size_t length = strlen(literal);
+		if (strncmp(p, literal, length) != 0)
+			return false;
+
+		p += length;
+		return true;
+	}
+
+	void found(JsonField* field)
+	{
+		if (field && --remaining == 0)
+			done = true;
+	}
+
+	bool scanValue(JsonField* field);
+	bool scanObject(JsonField* field);
+	bool scanArray(JsonField* field);
+};
+
+bool Scanner::scanObject(JsonField* field)
+{
+	const char* start = p;
+
+	// p is on the opening brace
+	p++;
+	skipSpace();
+
+	if (*p == '}') {
+		p++;
+	} else {
+		if (depth >= JsonScanner::kMaxDepth)
+			return false;
+
+		while (true) {
+			if (*p != '"')
+				return false;
+
+			bool escaped;
+			if (!scanString(keys[depth], keyLengths[depth], escaped))
+				return false;
+
+			skipSpace();
+			if (*p != ':')
+				return false;
+			p++;
+
+			depth++;
+			bool ok = scanValue(fieldForCurrentKey());
+			depth--;
+
+			if (!ok)
+				return false;
+			if (done)
+				return true;
+
+			skipSpace();
+			if (*p == '}') {
+				p++;
+				break;
+			}
+			if (*p != ',')
+				return false;
+			p++;
+			skipSpace();
+		}
+	}
+
+	if (field) {
+		field->type = JsonField::Object;
+		field->start = start;
+		field->length = p - start;
+	}
+
+	return true;
+}
+
+bool Scanner::scanArray(JsonField* field)
+{
+	const char* start = p;
+
+	// p is on the opening bracket
+	p++;
+	skipSpace();
+
+	if (*p == ']') {
+		p++;
+	} else {
+		// elements have no path: nothing in them is reachable
+		arrayDepth++;
+
+		bool ok = true;
+		while (ok) {
+			ok = scanValue(0);
+			if (!ok)
+				break;
+
+			skipSpace();
+			if (*p == ']') {
+				p++;
+				break;
+			}
+			if (*p != ',') {
+				ok = false;
+				break;
+			}
+			p++;
+		}
+
+		arrayDepth--;
+
+		if (!ok)
+			return false;
+	}
+
+	if (field) {
+		field->type = JsonField::Array;
+		field->start = start;
+		field->length = p - start;
+	}
+
+	return true;
+}
+
+bool Scanner::scanValue(JsonField* field)
+{
+	skipSpace();
+
+	bool ok = false;
+
+	switch (*p) {
+	case '{':
+		// the object itself is reported before what's in it
+		ok = scanObject(field);
+		break;
+
+	case '[':
+		ok = scanArray(field);
+		break;
+
+	case '"': {
+		const char* start;
+		int length;
+		bool escaped;
+		ok = scanString(start, length, escaped);
+		if (ok && field) {
+			field->type = JsonField::String;
+			field->start = start;
+			field->length = length;
+			field->escaped = escaped;
+		}
+		break;
+	}
+
+	case 't':
+	case 'f': {
+		bool value = (*p == 't');
+		ok = scanLiteral(value ? "true" : "false");
+		if (ok && field) {
+			field->type = JsonField::Boolean;
+			field->boolean = value;
+			field->start = p - (value ? 4 : 5);
+			field->length = value ? 4 : 5;
+		}
+		break;
+	}
+
+	case 'n':
+		ok = scanLiteral("null");
+		if (ok && field) {
+			field->type = JsonField::Null;
+			field->start = p - 4;
+			field->length = 4;
+		}
+		break;
+
+	default:
+		ok = scanNumber(field);
+		break;
+	}
+
+	if (ok)
+		found(field);
+
+	return ok;
+}
+
+}
+
+bool JsonScanner::scan(const char* payload, JsonField* fields, int numFields)
+{
+	for (int i = 0; i < numFields; i++)
+		fields[i].reset();
+
+	if (!payload)
+		return false;
+
+	Scanner scanner;
+	scanner.p = payload;
+	scanner.fields = fields;
+	scanner.numFields = numFields;
+	scanner.remaining = numFields;
+	scanner.depth = 0;
+	scanner.arrayDepth = 0;
+	scanner.done = (numFields == 0);
+
+	if (!scanner.scanValue(0))
+		return false;
+	if (scanner.done)
+		return true;
+
+	scanner.skipSpace();
+	return *scanner.p == '\0';
+}
@@ -0,0 +1,96 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef JSONSCANNER_H
+#define JSONSCANNER_H
+
+#include "Common.h"
+
+#include <string>
+
+/**
+ * A value to pick out of a JSON payload, by path: "percent", or "eventSignal.bars"
+ * for a key of a nested object. Values inside arrays can't be reached.
+ *
+ * Strings point into the payload (between the quotes, escapes left as they are),
+ * so a field is only good as long as the payload is.
+ */
+struct JsonField
+{
+	enum Type {
+		Missing = 0,
+		Null,
+		Boolean,
+		Integer,
+		Double,
+		String,
+		Object,
+		Array
+	};
+
+	JsonField(const char* path = 0) : path(path) { reset(); }
+
+	void reset();
+
+	bool found() const { return type != Missing; }
+
+	// true if the value has that type (an Integer is also a Double)
+	bool getBool(bool& value) const;
+	bool getInt(int& value) const;
+	bool getDouble(double& value) const;
+
+	// the string, with escapes decoded; no allocation except for getString()
+	bool equals(const char* str) const;
+	int  copyString(char* buffer, int size) const;	// -1 if it doesn't fit
+	bool getString(std::string& value) const;
+
+	const char*	path;
+
+	Type		type;
+	bool		boolean;
+	int			integer;	// a Double truncated; both clamped to the range of an int
+	double		number;
+	const char*	start;		// the raw value
+	int			length;
+	bool		escaped;	// a string with escapes in it
+};
+
+/**
+ * Extracts a few fields from a JSON payload without building a DOM.
+ *
+ * The payload is scanned once, in place, and only the requested fields are
+ * converted; nothing is allocated. For callbacks that only look at a handful of
+ * keys, this replaces json_tokener_parse() and the json_object lookups.
+ *
+ * The scan stops as soon as every field was found: what follows is not checked.
+ * Otherwise, a payload that isn't valid JSON makes scan() return false, with the
+ * fields seen before the error filled in.
+ */
+class JsonScanner
+{
+public:
+
+	static const int kMaxDepth = 16;
+
+	static bool scan(const char* payload, JsonField* fields, int numFields);
+};
+
+#endif /* JSONSCANNER_H */
@@ -0,0 +1,215 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include <math.h>
+
+#include "PenMoveResampler.h"
+
+// beyond this, a fitted acceleration is more likely noise than the finger (px/s^2)
+static const float kMaxAcceleration = 20000.0f;
+
+static inline int roundToInt(float v)
+{
+	return (int) floorf(v + 0.5f);
+}
+
+PenMoveResampler::PenMoveResampler()
+{
+	reset();
+}
+
+void PenMoveResampler::reset()
+{
+	m_newest = -1;
+	m_count = 0;
+	m_emitted = false;
+	m_lastFrameTime = 0;
+	m_lastX = 0;
+	m_lastY = 0;
+}
+
+const PenMoveResampler::Sample& PenMoveResampler::sample(int age) const
+{
+	return m_samples[(m_newest - age + kMaxSamples) % kMaxSamples];
+}
+
+void PenMoveResampler::addSample(int x, int y, uint32_t time)
+{
+	if (m_count) {
+		int dt = (int) (time - sample(0).time);
+		if (dt < 0) {
+			// the clock went back: whatever came before is useless
+			m_count = 0;
+			m_newest = -1;
+		}
+		else if (dt == 0) {
+			// the same instant: the latest position wins
+			Sample& s = m_samples[m_newest];
+			s.x = x;
+			s.y = y;
+			return;
+		}
+	}
+
+	m_newest = (m_newest + 1) % kMaxSamples;
+	Sample& s = m_samples[m_newest];
+	s.x = x;
+	s.y = y;
+	s.time = time;
+
+	if (m_count < kMaxSamples)
+		m_count++;
+}
+
+void PenMoveResampler::estimate(float* vx, float* vy, float* ax, float* ay) const
+{
+	*vx = *vy = *ax = *ay = 0;
+	if (m_count < 2)
+		return;
+
+	// least squares over the recent samples, in ms relative to the newest one:
+	// x(t) = x0 + vx t + ax t^2 / 2
+	const Sample& newest = sample(0);
+	double s[5] = { 0, 0, 0, 0, 0 };
+	double sx[3] = { 0, 0, 0 };
+	double sy[3] = { 0, 0, 0 };
+	int n = 0;
+	for (int age = 0; age < m_count; age++) {
+		const Sample& p = sample(age);
+		int dt = (int) (newest.time - p.time);
+		if (dt > kFitWindowMs)
+			break;
+
+		double t = -dt;
+		double dx = p.x - newest.x;
+		double dy = p.y - newest.y;
+		double tk = 1;
+		for (int k = 0; k < 5; k++) {
+			s[k] += tk;
+			if (k < 3) {
+				sx[k] += dx * tk;
+				sy[k] += dy * tk;
+			}
+			tk *= t;
+		}
+		n++;
+	}
+
+	if (n < 2)
+		return;
+
+	if (n == 2) {
+		// a line through both
+		*vx = 1000 * sx[1] / s[2];
+		*vy = 1000 * sy[1] / s[2];
+		return;
+	}
+
+	// the normal equations for (x0, vx, ax / 2)
+	double det = s[0] * (s[2] * s[4] - s[3] * s[3])
+			  - s[1] * (s[1] * s[4] - s[3] * s[2])
+			  + s[2] * (s[1] * s[3] - s[2] * s[2]);
+	if (fabs(det) < 1e-6)
+		return;
+
+	double b[2][3] = { { sx[0], sx[1], sx[2] }, { sy[0], sy[1], sy[2] } };
+	float* v[2] = { vx, vy };
+	float* a[2] = { ax, ay };
+	for (int i = 0; i < 2; i++) {
+		const double* r = b[i];
+		double detV = s[0] * (r[1] * s[4] - s[3] * r[2])
+				   - r[0] * (s[1] * s[4] - s[3] * s[2])
+				   + s[2] * (s[1] * r[2] - r[1] * s[2]);
+		double detA = s[0] * (s[2] * r[2] - r[1] * s[3])
+				   - s[1] * (s[1] * r[2] - r[1] * s[2])
+				   + r[0] * (s[1] * s[3] - s[2] * s[2]);
+		*v[i] = 1000 * detV / det;
+		*a[i] = 2 * 1000000 * detA / det;
+	}
+
+	float accel = sqrtf(*ax * *ax + *ay * *ay);
+	if (accel > kMaxAcceleration) {
+		*ax *= kMaxAcceleration / accel;
+		*ay *= kMaxAcceleration / accel;
+	}
+}
+
+bool PenMoveResampler::resample(uint32_t frameTime, int* x, int* y)
+{
+	if (!m_count)
+		return false;
+
+	if (m_emitted && frameTime == m_lastFrameTime)
+		return false;
+
+	float fx, fy;
+	const Sample& newest = sample(0);
+	int ahead = (int) (frameTime - newest.time);
+	if (ahead <= 0) {
+		// the frame is within the samples: interpolate between those around it
+		int age = 0;
+		while (age + 1 < m_count && (int) (frameTime - sample(age + 1).time) < 0)
+			age++;
+
+		if (age + 1 == m_count) {
+			fx = sample(age).x;
+			fy = sample(age).y;
+		}
+		else {
+			const Sample& before = sample(age + 1);
+			const Sample& after = sample(age);
+			float f = (float) (frameTime - before.time) / (float) (after.time - before.time);
+			fx = before.x + (after.x - before.x) * f;
+			fy = before.y + (after.y - before.y) * f;
+		}
+	}
+	else if (ahead > kFitWindowMs) {
+		// nothing recent: the pen has stopped where it was last seen
+		fx = newest.x;
+		fy = newest.y;
+	}
+	else {
+		// past the newest sample: predict, but not too far
+		float vx, vy, ax, ay;
+		estimate(&vx, &vy, &ax, &ay);
+
+		float t = MIN(ahead, kMaxPredictMs) / 1000.0f;
+		fx = newest.x + vx * t + ax * t * t / 2;
+		fy = newest.y + vy * t + ay * t * t / 2;
+	}
+
+	int rx = roundToInt(fx);
+	int ry = roundToInt(fy);
+	bool moved = !m_emitted || rx != m_lastX || ry != m_lastY;
+
+	m_emitted = true;
+	m_lastFrameTime = frameTime;
+	if (!moved)
+		return false;
+
+	m_lastX = rx;
+	m_lastY = ry;
+	*x = rx;
+	*y = ry;
+	return true;
+}
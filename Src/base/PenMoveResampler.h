@@ -0,0 +1,84 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef PENMOVERESAMPLER_H
+#define PENMOVERESAMPLER_H
+
+#include "Common.h"
+
+#include <stdint.h>
+
+/**
+ * Resamples a pen stroke to the display frames.
+ *
+ * Every move sample goes in, including those the throttling drops, and the last
+ * kMaxSamples are kept. At a frame deadline, resample() gives where the pen should be
+ * shown: interpolated between the samples around the deadline, or, when the deadline
+ * is past the latest sample, extrapolated from the velocity and acceleration fitted to
+ * the samples of the last kFitWindowMs, by no more than kMaxPredictMs.
+ *
+ * At most one move comes out per deadline, and none when the pen hasn't moved since
+ * the last one.
+ */
+class PenMoveResampler
+{
+public:
+
+	static const int kMaxSamples = 8;
+	static const int kFitWindowMs = 50;
+	static const int kMaxPredictMs = 16;
+
+	PenMoveResampler();
+
+	// a new stroke (pen down), or none (pen up)
+	void reset();
+
+	void addSample(int x, int y, uint32_t time);
+	int numSamples() const { return m_count; }
+
+	// the position for the frame at frameTime. False if there is nothing to move to
+	bool resample(uint32_t frameTime, int* x, int* y);
+
+	// fitted to the recent samples, in pixels per second (per second)
+	void estimate(float* vx, float* vy, float* ax, float* ay) const;
+
+private:
+
+	struct Sample
+	{
+		float		x;
+		float		y;
+		uint32_t	time;
+	};
+
+	const Sample& sample(int age) const;
+
+	Sample		m_samples[kMaxSamples];
+	int			m_newest;
+	int			m_count;
+
+	bool		m_emitted;
+	uint32_t	m_lastFrameTime;
+	int			m_lastX;
+	int			m_lastY;
+};
+
+#endif /* PENMOVERESAMPLER_H */
@@ -0,0 +1,200 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "QmlComponentCache.h"
+#include "SystemUiController.h"
+#include "Time.h"
+
+#include <QDeclarativeEngine>
+#include <QDeclarativeComponent>
+#include <QDeclarativeError>
+#include <QUrl>
+
+QmlComponentCache::QmlComponentCache(QDeclarativeEngine* engine, QObject* parent)
+	: QObject(parent)
+	, m_engine(engine)
+	, m_preloadSource(0)
+	, m_bootFinished(false)
+{
+	SystemUiController* suc = SystemUiController::instance();
+	if (suc->bootFinished())
+		m_bootFinished = true;
+	else
+		connect(suc, SIGNAL(signalBootFinished()), SLOT(slotBootFinished()));
+}
+
+QmlComponentCache::~QmlComponentCache()
+{
+	if (m_preloadSource)
+		g_source_remove(m_preloadSource);
+
+	// the components are our children
+	Q_FOREACH(Entry* entry, m_entries)
+		delete entry;
+}
+
+QDeclarativeComponent* QmlComponentCache::component(const QString& path)
+{
+	QHash<QString, Entry*>::const_iterator it = m_entries.constFind(path);
+	if (it != m_entries.constEnd())
+		return it.value()->component;
+
+	return compile(path)->component;
+}
+
+QObject* QmlComponentCache::create(QDeclarativeComponent* component)
+{
+	QHash<QDeclarativeComponent*, Entry*>::const_iterator it = m_byComponent.constFind(component);
+	if (G_UNLIKELY(it == m_byComponent.constEnd())) {
+		g_warning("%s: component %p is not from the cache", __PRETTY_FUNCTION__, component);
+		return component->create();
+	}
+
+	Entry* entry = it.value();
+	if (component->isError())
+		return 0;
+
+	// the first create of a component compiled on demand waited for the compile too
+	bool warm = entry->preloaded || entry->stats.numCreates > 0;
+	guint64 startMs = Time::curTimeMs();
+
+	QObject* obj = component->create();
+
+	guint64 endMs = Time::curTimeMs();
+	entry->stats.numCreates++;
+	if (warm)
+		entry->stats.numWarmCreates++;
+	entry->stats.lastCreateMs = endMs - startMs;
+
+	if (obj) {
+		PendingFrame pending;
+		pending.entry = entry;
+		pending.startMs = warm ? startMs : startMs - entry->stats.compileMs;
+		pending.warm = warm;
+		m_awaitingFrame.append(pending);
+	}
+
+	return obj;
+}
+
+void QmlComponentCache::preload(const QString& path)
+{
+	if (m_entries.contains(path) || m_preloadQueue.contains(path))
+		return;
+
+	m_preloadQueue.append(path);
+	if (m_bootFinished)
+		startPreloading();
+}
+
+const QmlComponentCache::Stats* QmlComponentCache::stats(const QString& path) const
+{
+	QHash<QString, Entry*>::const_iterator it = m_entries.constFind(path);
+	if (it == m_entries.constEnd())
+		return 0;
+
+	return &it.value()->stats;
+}
+
+void QmlComponentCache::slotBootFinished()
+{
+	m_bootFinished = true;
+	startPreloading();
+}
+
+QmlComponentCache::Entry* QmlComponentCache::compile(const QString& path)
+{
+	Entry* entry = new Entry;
+	entry->path = path;
+	entry->preloaded = false;
+	entry->stats.numCreates = 0;
+	entry->stats.numWarmCreates = 0;
+	entry->stats.lastCreateMs = 0;
+	entry->stats.lastFirstFrameMs = -1;
+	entry->stats.maxFirstFrameMs = -1;
+
+	guint64 startMs = Time::curTimeMs();
+	entry->component = new QDeclarativeComponent(m_engine, QUrl::fromLocalFile(path), this);
+	entry->stats.compileMs = Time::curTimeMs() - startMs;
+
+	if (entry->component->isError()) {
+		Q_FOREACH(const QDeclarativeError& error, entry->component->errors())
+			g_warning("%s: %s", __PRETTY_FUNCTION__, error.toString().toUtf8().constData());
+	}
+
+	m_entries.insert(path, entry);
+	m_byComponent.insert(entry->component, entry);
+
+	return entry;
+}
+
+void QmlComponentCache::recordFirstFrame()
+{
+	guint64 nowMs = Time::curTimeMs();
+
+	Q_FOREACH(const PendingFrame& pending, m_awaitingFrame) {
+		Stats& stats = pending.entry->stats;
+		stats.lastFirstFrameMs = nowMs - pending.startMs;
+		stats.maxFirstFrameMs = MAX(stats.maxFirstFrameMs, stats.lastFirstFrameMs);
+
+		g_message("SYSMGR PERF: QML %s first frame in %d ms (create %d ms, %s), worst %d ms over %d creates",
+				  pending.entry->path.toUtf8().constData(), stats.lastFirstFrameMs, stats.lastCreateMs,
+				  pending.warm ? "warm" : "cold", stats.maxFirstFrameMs, stats.numCreates);
+	}
+
+	m_awaitingFrame.clear();
+}
+
+void QmlComponentCache::startPreloading()
+{
+	if (m_preloadSource || m_preloadQueue.isEmpty())
+		return;
+
+	// below the default priority of input, timers and painting
+	m_preloadSource = g_idle_add_full(G_PRIORITY_LOW, preloadCallback, this, NULL);
+}
+
+gboolean QmlComponentCache::preloadCallback(gpointer data)
+{
+	QmlComponentCache* cache = static_cast<QmlComponentCache*>(data);
+
+	// one component per idle slot
+	while (!cache->m_preloadQueue.isEmpty()) {
+		QString path = cache->m_preloadQueue.takeFirst();
+		if (cache->m_entries.contains(path))
+			continue;
+
+		Entry* entry = cache->compile(path);
+		entry->preloaded = true;
+		g_debug("%s: compiled %s in %d ms", __PRETTY_FUNCTION__,
+				path.toUtf8().constData(), entry->stats.compileMs);
+		break;
+	}
+
+	if (cache->m_preloadQueue.isEmpty()) {
+		cache->m_preloadSource = 0;
+		return FALSE;
+	}
+
+	return TRUE;
+}
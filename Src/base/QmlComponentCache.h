@@ -0,0 +1,123 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef QMLCOMPONENTCACHE_H
+#define QMLCOMPONENTCACHE_H
+
+#include "Common.h"
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <glib.h>
+
+class QDeclarativeEngine;
+class QDeclarativeComponent;
+
+/**
+ * Keeps compiled QML components around for the life of the engine.
+ *
+ * Windows that come and go (alerts, dialogs) used to compile their QML every time
+ * they were shown. Here each file is compiled once, and the components that are
+ * likely to be needed can be compiled ahead of time, one per idle slot once boot
+ * has finished.
+ *
+ * Every create() is also timed up to the first frame painted after it (see
+ * frameRendered()), and logged, so that slow components show up in the perf logs.
+ */
+class QmlComponentCache : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	struct Stats
+	{
+		int		compileMs;
+		int		numCreates;
+		int		numWarmCreates;		// created from an already compiled component
+		int		lastCreateMs;
+		int		lastFirstFrameMs;	// -1 until a frame has been painted
+		int		maxFirstFrameMs;
+	};
+
+	QmlComponentCache(QDeclarativeEngine* engine, QObject* parent = 0);
+	~QmlComponentCache();
+
+	// the component for a local QML file, compiled now if it is not yet.
+	// Owned by the cache: callers must not delete it. Never NULL, but may have errors
+	QDeclarativeComponent*	component(const QString& path);
+
+	// component->create(), timed. NULL if the component has errors
+	QObject*	create(QDeclarativeComponent* component);
+
+	// compiles path in an idle slot after boot, unless it is needed before that
+	void		preload(const QString& path);
+
+	// the view calls this after each frame it has painted
+	void		frameRendered() { if (!m_awaitingFrame.isEmpty()) recordFirstFrame(); }
+
+	const Stats*	stats(const QString& path) const;
+
+private Q_SLOTS:
+
+	void		slotBootFinished();
+
+private:
+
+	struct Entry
+	{
+		QString					path;
+		QDeclarativeComponent*	component;
+		Stats					stats;
+		bool					preloaded;
+	};
+
+	struct PendingFrame
+	{
+		Entry*		entry;
+		guint64		startMs;
+		bool		warm;
+	};
+
+	Entry*		compile(const QString& path);
+	void		recordFirstFrame();
+	void		startPreloading();
+
+	static gboolean	preloadCallback(gpointer data);
+
+	QDeclarativeEngine*					m_engine;
+	QHash<QString, Entry*>				m_entries;
+	QHash<QDeclarativeComponent*, Entry*>	m_byComponent;
+	QList<PendingFrame>					m_awaitingFrame;
+	QStringList							m_preloadQueue;
+	guint								m_preloadSource;
+	bool								m_bootFinished;
+
+private:
+
+	QmlComponentCache(const QmlComponentCache&);
+	QmlComponentCache& operator=(const QmlComponentCache&);
+};
+
+#endif /* QMLCOMPONENTCACHE_H */
@@ -0,0 +1,169 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "StartupTracer.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+static StartupTracer* s_instance = 0;
+
+StartupTracer* StartupTracer::instance()
+{
+	if (G_UNLIKELY(!s_instance))
+		s_instance = new StartupTracer;
+
+	return s_instance;
+}
+
+StartupTracer::StartupTracer()
+	: m_enabled(false)
+	, m_pid(getpid())
+{
+	pthread_mutex_init(&m_mutex, NULL);
+	m_phases.reserve(64);
+}
+
+guint64 StartupTracer::currentTimeUs()
+{
+	struct timespec now;
+	::clock_gettime(CLOCK_MONOTONIC, &now);
+	return guint64(now.tv_sec) * 1000000ULL + guint64(now.tv_nsec) / 1000ULL;
+}
+
+int StartupTracer::begin(const char* name)
+{
+	if (!m_enabled)
+		return -1;
+
+	pthread_mutex_lock(&m_mutex);
+	int id = recordLocked(name, false);
+	pthread_mutex_unlock(&m_mutex);
+
+	return id;
+}
+
+void StartupTracer::end(int id)
+{
+	if (id < 0)
+		return;
+
+	guint64 now = currentTimeUs();
+
+	pthread_mutex_lock(&m_mutex);
+	if (id < (int) m_phases.size())
+		m_phases[id].endUs = now;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void StartupTracer::mark(const char* name)
+{
+	if (!m_enabled)
+		return;
+
+	pthread_mutex_lock(&m_mutex);
+	recordLocked(name, true);
+	pthread_mutex_unlock(&m_mutex);
+}
+
+int StartupTracer::recordLocked(const char* name, bool instant)
+{
+	Phase phase;
+	phase.name = name;
+	phase.startUs = currentTimeUs();
+	phase.endUs = 0;
+	phase.threadId = (int) ::syscall(SYS_gettid);
+	phase.instant = instant;
+
+	m_phases.push_back(phase);
+	return m_phases.size() - 1;
+}
+
+int StartupTracer::numPhases() const
+{
+	pthread_mutex_lock(&m_mutex);
+	int count = m_phases.size();
+	pthread_mutex_unlock(&m_mutex);
+
+	return count;
+}
+
+static void appendEscaped(std::string& out, const char* str)
+{
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			out += '\\';
+		out += *str;
+	}
+}
+
+std::string StartupTracer::toJson() const
+{
+	std::string out = "{\"traceEvents\":[";
+	char buf[160];
+
+	pthread_mutex_lock(&m_mutex);
+	for (size_t i = 0; i < m_phases.size(); i++) {
+		const Phase& phase = m_phases[i];
+
+		out += (i ? ",\n{\"name\":\"" : "\n{\"name\":\"");
+		appendEscaped(out, phase.name);
+
+		if (phase.instant) {
+			snprintf(buf, sizeof(buf), "\",\"cat\":\"startup\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%llu,\"pid\":%d,\"tid\":%d}",
+					 (unsigned long long) phase.startUs, m_pid, phase.threadId);
+		}
+		else {
+			// a phase that never ended lasts until now
+			guint64 endUs = phase.endUs ? phase.endUs : currentTimeUs();
+			snprintf(buf, sizeof(buf), "\",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%d,\"tid\":%d}",
+					 (unsigned long long) phase.startUs, (unsigned long long) (endUs - phase.startUs),
+					 m_pid, phase.threadId);
+		}
+		out += buf;
+	}
+	pthread_mutex_unlock(&m_mutex);
+
+	out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return out;
+}
+
+bool StartupTracer::write(const char* filePath) const
+{
+	FILE* file = fopen(filePath, "w");
+	if (!file) {
+		g_warning("%s: unable to open %s", __PRETTY_FUNCTION__, filePath);
+		return false;
+	}
+
+	std::string json = toJson();
+	bool ok = (fwrite(json.data(), 1, json.size(), file) == json.size());
+	ok = (fclose(file) == 0) && ok;
+
+	if (ok)
+		g_message("%s: %d startup phases written to %s", __PRETTY_FUNCTION__, numPhases(), filePath);
+
+	return ok;
+}
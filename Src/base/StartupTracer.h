@@ -0,0 +1,98 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef STARTUPTRACER_H
+#define STARTUPTRACER_H
+
+#include "Common.h"
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <glib.h>
+
+/**
+ * Records when each startup phase began and ended (monotonic clock, per thread), and
+ * writes them out in the Chrome trace event format (load the file in chrome://tracing).
+ *
+ * Disabled (and nearly free) until setEnabled(true). Phases can be recorded from any
+ * thread.
+ */
+class StartupTracer
+{
+public:
+
+	static StartupTracer* instance();
+
+	void		setEnabled(bool enabled) { m_enabled = enabled; }
+	bool		enabled() const { return m_enabled; }
+
+	// name must stay valid until the trace is written (string literals, typically).
+	// Returns the id to pass to end(), -1 when disabled
+	int			begin(const char* name);
+	void		end(int id);
+
+	// a point in time rather than a phase
+	void		mark(const char* name);
+
+	// the whole trace as a Chrome trace json document
+	std::string	toJson() const;
+	bool		write(const char* filePath) const;
+
+	int			numPhases() const;
+
+	static guint64 currentTimeUs();
+
+private:
+
+	struct Phase
+	{
+		const char*	name;
+		guint64		startUs;
+		guint64		endUs;		// 0 while running, and for marks
+		int			threadId;
+		bool		instant;
+	};
+
+	StartupTracer();
+
+	int			recordLocked(const char* name, bool instant);
+
+	bool				m_enabled;
+	int					m_pid;
+	std::vector<Phase>	m_phases;
+	mutable pthread_mutex_t	m_mutex;
+};
+
+/**
+ * Traces the enclosing scope as a phase
+ */
+class StartupPhase
+{
+public:
+	StartupPhase(const char* name) : m_id(StartupTracer::instance()->begin(name)) {}
+	~StartupPhase() { StartupTracer::instance()->end(m_id); }
+
+private:
+	int m_id;
+};
+
+#endif /* STARTUPTRACER_H */
@@ -58,6 +58,7 @@
 #include "cjson/json.h"
 #include <pbnjson.hpp>
 #include "JSONUtils.h"
+#include "HeapProfiler.h"
 
 #ifdef USE_HEAP_PROFILER
 #include <google/heap-profiler.h>
@@ -155,6 +156,9 @@ static bool cbDumpRasters(LSHandle* lsHandle, LSMessage *message,
 static bool cbDumpJemallocHeap(LSHandle* lsHandle, LSMessage *message,
 							   void *user_data);
 
+static bool cbHeapProfile(LSHandle* lsHandle, LSMessage *message,
+						  void *user_data);
+
 static bool cbTouchToShareDeviceInRange(LSHandle* lsHandle, LSMessage* message,
 									   void* user_data);
 
@@ -241,6 +245,7 @@ static LSMethod s_methods[]  = {
 	{ "systemUiDbg",	   cbSystemUiDbg },
 	{ "dumpRasters", cbDumpRasters },
 	{ "dumpJemallocHeap", cbDumpJemallocHeap },
+	{ "heapProfile", cbHeapProfile },
 	{ "touchToShareDeviceInRange", cbTouchToShareDeviceInRange },
 	{ "touchToShareAppUrlTransferred", cbTouchToShareAppUrlTransferred },
     { "getSystemStatus", cbGetSystemStatus },
@@ -5104,6 +5109,73 @@ Done:
 	return true;
 }
 
+static bool cbHeapProfile(LSHandle* lshandle, LSMessage *message,
+						  void *userData)
+{
+    LSError lsError;
+    LSErrorInit(&lsError);
+
+    // {"enable":boolean, "sampleBytes":integer, "path":string}, all optional
+    VALIDATE_SCHEMA_AND_RETURN(lshandle,
+                               message,
+                               SCHEMA_3(OPTIONAL(enable, boolean), OPTIONAL(sampleBytes, integer), OPTIONAL(path, string)));
+
+	const char* str = LSMessageGetPayload(message);
+	if (!str)
+		return false;
+
+	bool success = true;
+	struct json_object* root = json_tokener_parse(str);
+	struct json_object* label = 0;
+	size_t sampleBytes = HeapProfiler::sampleBytes();
+
+	if (!root || is_error(root)) {
+		root = 0;
+		success = false;
+		goto Done;
+	}
+
+	label = json_object_object_get(root, "sampleBytes");
+	if (label && json_object_get_int(label) > 0)
+		sampleBytes = json_object_get_int(label);
+
+	label = json_object_object_get(root, "enable");
+	if (label) {
+		if (!json_object_get_boolean(label))
+			HeapProfiler::stop();
+		else if (!HeapProfiler::running() || sampleBytes != HeapProfiler::sampleBytes())
+			success = HeapProfiler::start(sampleBytes);
+	}
+
+	// dump after stopping, so that the last samples can be collected
+	label = json_object_object_get(root, "path");
+	if (label) {
+		const char* path = json_object_get_string(label);
+		success = path && HeapProfiler::dump(path) && success;
+	}
+
+Done:
+
+	if (root)
+		json_object_put(root);
+
+	json_object* json = json_object_new_object();
+	json_object_object_add(json, "returnValue", json_object_new_boolean(success));
+	json_object_object_add(json, "running", json_object_new_boolean(HeapProfiler::running()));
+	json_object_object_add(json, "sampling", json_object_new_boolean(HeapProfiler::hooked()));
+	json_object_object_add(json, "sampleBytes", json_object_new_int(HeapProfiler::sampleBytes()));
+	json_object_object_add(json, "callSites", json_object_new_int(HeapProfiler::numSites()));
+	json_object_object_add(json, "inUseSamples", json_object_new_int(HeapProfiler::inUseSamples()));
+
+	if (!LSMessageReply( lshandle, message, json_object_to_json_string(json), &lsError )) {
+		LSErrorFree (&lsError);
+	}
+
+	json_object_put(json);
+
+	return true;
+}
+
 bool SystemService::touchToShareCanTapStatusCallback(LSHandle* handle, LSMessage* message, void* ctxt)
 {
 	return SystemService::instance()->touchToShareCanTapStatus(handle, message, ctxt);    
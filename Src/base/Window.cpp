@@ -53,7 +53,7 @@ Window::Window(WindowType::Type type, const uint32_t bufWidth, const uint32_t bu
 		QColor fillColor(255, 255, 255, hasAlpha ? 0 : 255);
 		m_screenPixmap.fill(fillColor);
 	}
-	WindowServer::registerWindow(this);
+	m_handle = WindowServer::registerWindow(this);
 }
 
 Window::Window(WindowType::Type type, const QPixmap& pix)
@@ -69,7 +69,7 @@ Window::Window(WindowType::Type type, const QPixmap& pix)
 {
 	setVisibleDimensions(m_bufWidth, m_bufHeight);
 
-	WindowServer::registerWindow(this);
+	m_handle = WindowServer::registerWindow(this);
 }
 
 Window::~Window()
@@ -24,6 +24,7 @@
 
 #include "Common.h"
 #include <WindowTypes.h>
+#include "SlotTable.h"
 
 #include <stdint.h>
 #include <string>
@@ -116,6 +117,9 @@ public:
 	inline int initialWidth() const { return m_initialWidth; }
 	inline int initialHeight() const { return m_initialHeight; }
 
+	// to refer to the window from where it may outlive it: see WindowServer::windowForHandle
+	inline SlotHandle handle() const { return m_handle; }
+
 protected:
 
 	virtual void lock() {}
@@ -136,6 +140,7 @@ protected:
 	int m_initialHeight;
 	QRectF m_visibleBounds;
 	QPixmap m_screenPixmap;
+	SlotHandle m_handle;
 
     friend class HostWindow;
 
@@ -36,7 +36,6 @@
 #include <cmath>
 
 #include <string>
-#include <tr1/unordered_set>
 
 #include <QApplication>
 #include <QGesture>
@@ -85,6 +84,7 @@
 #include "Preferences.h"            // Neeed for IME
 
 #include "NativeAlertManager.h"
+#include "QmlComponentCache.h"
 #include "SingleClickGesture.h"
 #include "SingleClickGestureRecognizer.h"
 #include "WebosTapAndHoldGesture.h"
@@ -122,7 +122,7 @@
 #endif
 
 static const char* kWindowSrvChnl = "WindowServer";
-static std::tr1::unordered_set<unsigned long> s_registeredWindows;
+static SlotTable<Window> s_registeredWindows;
 
 static const int kMaxPaintFPS = 120;
 static const int kMinPaintInterval = 1000 / kMaxPaintFPS;
@@ -896,6 +896,9 @@ bool WindowServer::viewportEvent(QEvent* event)
 
 			HostBase::instance()->flip();
 
+			if (QmlComponentCache* qmlCache = qmlComponentCache())
+				qmlCache->frameRendered();
+
 			break;
 		}
 		case QEvent::TouchBegin:
@@ -1296,19 +1299,25 @@ void WindowServer::setPaintingDisabled(bool val)
 	}
 }
 
-void WindowServer::registerWindow(Window* win)
+SlotHandle WindowServer::registerWindow(Window* win)
 {
-	s_registeredWindows.insert((unsigned long) win);
+	return s_registeredWindows.insert(win);
 }
 
 void WindowServer::unregisterWindow(Window* win)
 {
-	s_registeredWindows.erase((unsigned long) win);
+	s_registeredWindows.remove(win->handle());
 }
 
 bool WindowServer::windowIsRegistered(Window* win)
 {
-	return (s_registeredWindows.find((unsigned long) win) != s_registeredWindows.end());
+	// win must still be allocated: hold on to its handle() where it may not be
+	return win && s_registeredWindows.get(win->handle()) == win;
+}
+
+Window* WindowServer::windowForHandle(SlotHandle handle)
+{
+	return s_registeredWindows.get(handle);
 }
 
 void WindowServer::cancelVibrations()
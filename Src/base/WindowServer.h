@@ -62,6 +62,7 @@ class MetaKeyManager;
 class CoreNaviManager;
 class ReticleItem;
 class QDeclarativeEngine;
+class QmlComponentCache;
 class SharedGlobalProperties;
 
 class QGraphicsPixmapObject : public QGraphicsObject {
@@ -158,9 +159,11 @@ public:
 	static WindowServer* instance();
 	virtual ~WindowServer();
 
-	static void registerWindow(Window* win);
+	static SlotHandle registerWindow(Window* win);
 	static void unregisterWindow(Window* win);
 	static bool windowIsRegistered(Window* win);
+	// NULL once the window has been deleted
+	static Window* windowForHandle(SlotHandle handle);
 
 	virtual void addWindow(Window* win);
 	virtual void removeWindow(Window* win);
@@ -222,6 +225,7 @@ public:
 	bool deviceIsPortraitType() const { return m_deviceIsPortraitType; }
 
     virtual QDeclarativeEngine* declarativeEngine() { return NULL; }
+    virtual QmlComponentCache* qmlComponentCache() { return NULL; }
 
     // maps a rect given in item's coordinate space into 
     virtual QRectF mapRectToRoot(const QGraphicsItem* item, const QRectF& rect) const;
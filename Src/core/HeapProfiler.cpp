@@ -0,0 +1,432 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2009-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "HeapProfiler.h"
+
+#include <algorithm>
+#include <execinfo.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <glib.h>
+
+// Nothing in here may call malloc while holding s_lock, except with t_busy set: the
+// hooks of the calling thread then pass straight through.
+
+static const int kMaxDepth = 24;
+static const int kSkipFrames = 2;				// allocated() and the malloc hook
+static const unsigned int kMaxSites = 4096;		// powers of 2
+static const unsigned int kMaxLive = 65536;
+static const unsigned int kFilterBits = 1 << 20;
+
+struct CallSite
+{
+	uintptr_t	hash;
+	int			depth;
+	void*		frames[kMaxDepth];
+	size_t		allocSamples;
+	size_t		allocBytes;
+	size_t		inUseSamples;
+	size_t		inUseBytes;
+};
+
+struct LiveBlock
+{
+	void*		ptr;
+	size_t		size;
+	unsigned int site;
+};
+
+struct Tables
+{
+	CallSite	sites[kMaxSites];
+	LiveBlock	live[kMaxLive];
+	uint32_t	filter[kFilterBits / 32];	// bit set: ptr might be in live
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static Tables* s_tables = 0;
+static volatile bool s_running = false;
+static bool s_hooked = false;
+static size_t s_sampleBytes = HeapProfiler::kDefaultSampleBytes;
+static volatile long s_bytesUntilSample = 0;
+static uint32_t s_random = 1;
+static int s_numSites = 0;
+static unsigned int s_numLive = 0;
+static size_t s_numDropped = 0;
+
+static __thread int t_busy = 0;
+
+static inline unsigned int ptrHash(void* ptr)
+{
+	uintptr_t value = (uintptr_t) ptr;
+	value ^= value >> 16;
+	value *= 0x45d9f3b;
+	value ^= value >> 16;
+	return (unsigned int) value;
+}
+
+static inline bool filterTest(void* ptr)
+{
+	unsigned int bit = ptrHash(ptr) & (kFilterBits - 1);
+	return s_tables->filter[bit >> 5] & (1U << (bit & 31));
+}
+
+static inline void filterSet(void* ptr)
+{
+	unsigned int bit = ptrHash(ptr) & (kFilterBits - 1);
+	__sync_fetch_and_or(&s_tables->filter[bit >> 5], 1U << (bit & 31));
+}
+
+// next sampling distance: the rate, give or take half of it, so that periodic
+// allocation patterns don't alias with it
+static long nextSampleDistance()
+{
+	s_random = s_random * 1103515245 + 12345;
+	long jitter = (long) ((s_random >> 8) % s_sampleBytes) - (long) (s_sampleBytes / 2);
+	return std::max(1L, (long) s_sampleBytes + jitter);
+}
+
+static unsigned int findSiteLocked(void** frames, int depth)
+{
+	uintptr_t hash = depth;
+	for (int i = 0; i < depth; i++)
+		hash = hash * 31 + ((uintptr_t) frames[i] >> 2);
+
+	unsigned int index = hash & (kMaxSites - 1);
+	for (unsigned int probe = 0; probe < kMaxSites; probe++) {
+		CallSite& site = s_tables->sites[index];
+
+		if (site.depth == 0) {
+			if (s_numSites >= (int) (kMaxSites * 3 / 4))
+				return kMaxSites;
+
+			site.hash = hash;
+			site.depth = depth;
+			memcpy(site.frames, frames, depth * sizeof(void*));
+			s_numSites++;
+			return index;
+		}
+
+		if (site.hash == hash && site.depth == depth &&
+			memcmp(site.frames, frames, depth * sizeof(void*)) == 0)
+			return index;
+
+		index = (index + 1) & (kMaxSites - 1);
+	}
+
+	return kMaxSites;
+}
+
+static unsigned int findLiveLocked(void* ptr)
+{
+	unsigned int index = ptrHash(ptr) & (kMaxLive - 1);
+	while (s_tables->live[index].ptr) {
+		if (s_tables->live[index].ptr == ptr)
+			return index;
+		index = (index + 1) & (kMaxLive - 1);
+	}
+
+	return kMaxLive;
+}
+
+static bool insertLiveLocked(void* ptr, size_t size, unsigned int site)
+{
+	if (s_numLive >= kMaxLive * 3 / 4)
+		return false;
+
+	unsigned int index = ptrHash(ptr) & (kMaxLive - 1);
+	while (s_tables->live[index].ptr)
+		index = (index + 1) & (kMaxLive - 1);
+
+	s_tables->live[index].ptr = ptr;
+	s_tables->live[index].size = size;
+	s_tables->live[index].site = site;
+	s_numLive++;
+	return true;
+}
+
+// linear probing: shift the following entries back instead of leaving tombstones
+static void removeLiveLocked(unsigned int index)
+{
+	LiveBlock* live = s_tables->live;
+	live[index].ptr = 0;
+	s_numLive--;
+
+	unsigned int next = (index + 1) & (kMaxLive - 1);
+	while (live[next].ptr) {
+		unsigned int home = ptrHash(live[next].ptr) & (kMaxLive - 1);
+
+		// can the entry at next move to the hole at index?
+		bool movable = (index <= next) ? (home <= index || home > next)
+									   : (home <= index && home > next);
+		if (movable) {
+			live[index] = live[next];
+			live[next].ptr = 0;
+			index = next;
+		}
+		next = (next + 1) & (kMaxLive - 1);
+	}
+}
+
+// -------------------------------------------------------------------------
+
+bool HeapProfiler::start(size_t sampleBytes)
+{
+	if (s_running)
+		stop();
+
+	if (!s_tables) {
+		void* mem = ::mmap(0, sizeof(Tables), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mem == MAP_FAILED) {
+			g_warning("%s: failed to allocate the profiler tables", __PRETTY_FUNCTION__);
+			return false;
+		}
+		s_tables = (Tables*) mem;
+	}
+
+	// backtrace() loads libgcc the first time, which allocates: get that done now
+	void* frames[2];
+	::backtrace(frames, 2);
+
+	pthread_mutex_lock(&s_lock);
+	memset(s_tables, 0, sizeof(Tables));
+	s_sampleBytes = std::max<size_t>(sampleBytes, 1);
+	s_bytesUntilSample = nextSampleDistance();
+	s_numSites = 0;
+	s_numLive = 0;
+	s_numDropped = 0;
+	s_running = true;
+	pthread_mutex_unlock(&s_lock);
+
+	s_hooked = installHeapProfilerHooks(true);
+	if (!s_hooked)
+		g_warning("%s: malloc hooks unavailable, allocations won't be sampled", __PRETTY_FUNCTION__);
+
+	g_message("%s: sampling every %lu bytes", __PRETTY_FUNCTION__, (unsigned long) s_sampleBytes);
+	return true;
+}
+
+void HeapProfiler::stop()
+{
+	if (!s_running)
+		return;
+
+	if (s_hooked)
+		installHeapProfilerHooks(false);
+	s_hooked = false;
+
+	// keep the samples around, for a last dump
+	pthread_mutex_lock(&s_lock);
+	s_running = false;
+	pthread_mutex_unlock(&s_lock);
+}
+
+bool HeapProfiler::running()
+{
+	return s_running;
+}
+
+bool HeapProfiler::hooked()
+{
+	return s_hooked;
+}
+
+size_t HeapProfiler::sampleBytes()
+{
+	return s_sampleBytes;
+}
+
+void HeapProfiler::allocated(void* ptr, size_t size)
+{
+	if (!ptr || t_busy || !s_running)
+		return;
+
+	if (__sync_sub_and_fetch(&s_bytesUntilSample, (long) size) > 0)
+		return;
+
+	t_busy++;
+
+	void* frames[kMaxDepth + kSkipFrames];
+	int depth = ::backtrace(frames, kMaxDepth + kSkipFrames) - kSkipFrames;
+	if (depth < 0)
+		depth = 0;
+
+	pthread_mutex_lock(&s_lock);
+
+	// another thread may have taken this sample already
+	if (s_running && s_bytesUntilSample <= 0) {
+		s_bytesUntilSample = nextSampleDistance();
+
+		unsigned int index = depth ? findSiteLocked(frames + kSkipFrames, depth) : kMaxSites;
+		if (index < kMaxSites && insertLiveLocked(ptr, size, index)) {
+			CallSite& site = s_tables->sites[index];
+			site.allocSamples++;
+			site.allocBytes += size;
+			site.inUseSamples++;
+			site.inUseBytes += size;
+			filterSet(ptr);
+		}
+		else {
+			s_numDropped++;
+		}
+	}
+
+	pthread_mutex_unlock(&s_lock);
+
+	t_busy--;
+}
+
+void HeapProfiler::freed(void* ptr)
+{
+	if (!ptr || t_busy || !s_tables || !filterTest(ptr))
+		return;
+
+	pthread_mutex_lock(&s_lock);
+
+	unsigned int index = findLiveLocked(ptr);
+	if (index < kMaxLive) {
+		CallSite& site = s_tables->sites[s_tables->live[index].site];
+		site.inUseSamples--;
+		site.inUseBytes -= s_tables->live[index].size;
+		removeLiveLocked(index);
+	}
+
+	pthread_mutex_unlock(&s_lock);
+}
+
+int HeapProfiler::numSites()
+{
+	return s_numSites;
+}
+
+size_t HeapProfiler::inUseSamples()
+{
+	return s_numLive;
+}
+
+size_t HeapProfiler::inUseBytes()
+{
+	if (!s_tables)
+		return 0;
+
+	size_t bytes = 0;
+
+	pthread_mutex_lock(&s_lock);
+	for (unsigned int i = 0; i < kMaxSites; i++)
+		bytes += s_tables->sites[i].inUseBytes;
+	pthread_mutex_unlock(&s_lock);
+
+	return bytes;
+}
+
+size_t HeapProfiler::numDropped()
+{
+	return s_numDropped;
+}
+
+std::string HeapProfiler::profile()
+{
+	std::string out;
+	if (!s_tables)
+		return out;
+
+	t_busy++;
+
+	char buf[64];
+	std::string body;
+	size_t inUseSamples = 0, inUseBytes = 0, allocSamples = 0, allocBytes = 0;
+
+	pthread_mutex_lock(&s_lock);
+	for (unsigned int i = 0; i < kMaxSites; i++) {
+		const CallSite& site = s_tables->sites[i];
+		if (!site.depth)
+			continue;
+
+		inUseSamples += site.inUseSamples;
+		inUseBytes += site.inUseBytes;
+		allocSamples += site.allocSamples;
+		allocBytes += site.allocBytes;
+
+		snprintf(buf, sizeof(buf), "%lu: %lu [%lu: %lu] @",
+				 (unsigned long) site.inUseSamples, (unsigned long) site.inUseBytes,
+				 (unsigned long) site.allocSamples, (unsigned long) site.allocBytes);
+		body += buf;
+
+		for (int f = 0; f < site.depth; f++) {
+			snprintf(buf, sizeof(buf), " %p", site.frames[f]);
+			body += buf;
+		}
+		body += '\n';
+	}
+	size_t sampleBytes = s_sampleBytes;
+	pthread_mutex_unlock(&s_lock);
+
+	snprintf(buf, sizeof(buf), "heap profile: %lu: %lu [%lu: %lu] @ heap_v2/%lu\n",
+			 (unsigned long) inUseSamples, (unsigned long) inUseBytes,
+			 (unsigned long) allocSamples, (unsigned long) allocBytes,
+			 (unsigned long) sampleBytes);
+	out = buf;
+	out += body;
+
+	// pprof maps the addresses back to the binaries with these
+	out += "\nMAPPED_LIBRARIES:\n";
+	FILE* maps = fopen("/proc/self/maps", "r");
+	if (maps) {
+		char line[512];
+		while (fgets(line, sizeof(line), maps))
+			out += line;
+		fclose(maps);
+	}
+
+	t_busy--;
+
+	return out;
+}
+
+bool HeapProfiler::dump(const char* filePath)
+{
+	std::string data = profile();
+	if (data.empty())
+		return false;
+
+	t_busy++;
+
+	bool ok = false;
+	FILE* file = fopen(filePath, "w");
+	if (file) {
+		ok = (fwrite(data.data(), 1, data.size(), file) == data.size());
+		ok = (fclose(file) == 0) && ok;
+	}
+
+	t_busy--;
+
+	if (ok)
+		g_message("%s: heap profile written to %s", __PRETTY_FUNCTION__, filePath);
+	else
+		g_warning("%s: failed to write the heap profile to %s", __PRETTY_FUNCTION__, filePath);
+
+	return ok;
+}
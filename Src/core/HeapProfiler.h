@@ -0,0 +1,75 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2009-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef HEAPPROFILER_H
+#define HEAPPROFILER_H
+
+#include "Common.h"
+
+#include <stddef.h>
+#include <string>
+
+/**
+ * Sampling heap profiler.
+ *
+ * While running, about one allocation per sampleBytes allocated bytes is recorded with
+ * its backtrace. Samples are aggregated per call site, and sampled blocks are tracked
+ * until freed, so that the profile shows both what is in use and what has been
+ * allocated since start(). The profile is written in the legacy pprof heap format
+ * ("heap_v2"), which pprof scales back up by the sampling rate.
+ *
+ * The malloc hooks (MallocHooks.cpp) feed allocated() and freed() and are only
+ * installed while running: when stopped, allocations don't go through here at all.
+ * The hooks exist with glibc < 2.34 only; elsewhere, hooked() is false and the
+ * profile stays empty unless something else calls allocated()/freed().
+ */
+class HeapProfiler
+{
+public:
+
+	static const size_t kDefaultSampleBytes = 512 * 1024;
+
+	static bool		start(size_t sampleBytes = kDefaultSampleBytes);
+	static void		stop();
+	static bool		running();
+	static bool		hooked();
+
+	static size_t	sampleBytes();
+
+	// the profile, with the process mappings pprof needs for symbolization
+	static std::string profile();
+	static bool		dump(const char* filePath);
+
+	// totals over all call sites
+	static int		numSites();
+	static size_t	inUseSamples();
+	static size_t	inUseBytes();
+	static size_t	numDropped();
+
+	// called for every allocation and free while running
+	static void		allocated(void* ptr, size_t size);
+	static void		freed(void* ptr);
+};
+
+// MallocHooks.cpp
+bool installHeapProfilerHooks(bool install);
+
+#endif /* HEAPPROFILER_H */
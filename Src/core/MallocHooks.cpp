@@ -23,55 +23,79 @@
 
 #include <malloc.h>
 
-// We'll use LD_PRELOAD to use the malloc implementation of our choice.
+#include "HeapProfiler.h"
 
-#if 0
-//#if defined(TARGET_DEVICE)
+// We'll use LD_PRELOAD to use the malloc implementation of our choice. The hooks
+// below only exist for the heap profiler, and are only installed while it runs.
+// They call the glibc allocator directly, so they never need to uninstall
+// themselves to avoid recursing.
 
-static void  initHook(void);
-static void  freeHook(void*, const void*);
-static void* mallocHook(size_t, const void*);
-static void* reallocHook(void*, size_t, const void*);
-static void* memalignHook(size_t, size_t, const void*);
+#if defined(__GLIBC__) && !defined(__UCLIBC__) && (__GLIBC__ == 2) && (__GLIBC_MINOR__ < 34)
+#define HAS_MALLOC_HOOKS 1
+#endif
 
-extern "C" void* je_malloc(size_t size);
-extern "C" void  je_free(void* ptr);
-extern "C" void* je_realloc(void* ptr, size_t size);
-extern "C" void* je_memalign(size_t boundary, size_t size);
+#if defined(HAS_MALLOC_HOOKS)
 
-void (*__malloc_initialize_hook) (void) = initHook;
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-static void
-initHook(void)
-{
-	__free_hook = freeHook;
-    __malloc_hook = mallocHook;
-    __realloc_hook = reallocHook;
-    __memalign_hook = memalignHook;
-}
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void  __libc_free(void* ptr);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void* __libc_memalign(size_t boundary, size_t size);
 
 static void
 freeHook(void* ptr, const void*)
 {
-	je_free(ptr);
+	HeapProfiler::freed(ptr);
+	__libc_free(ptr);
 }
 
 static void*
 mallocHook(size_t size, const void*)
 {
-	return je_malloc(size);
+	void* ptr = __libc_malloc(size);
+	HeapProfiler::allocated(ptr, size);
+	return ptr;
 }
 
 static void*
 reallocHook(void* ptr, size_t size, const void*)
 {
-	return je_realloc(ptr, size);
+	void* newPtr = __libc_realloc(ptr, size);
+
+	// a failed realloc leaves the block where it was
+	if (newPtr || !size) {
+		HeapProfiler::freed(ptr);
+		HeapProfiler::allocated(newPtr, size);
+	}
+	return newPtr;
 }
 
 static void*
 memalignHook(size_t alignment, size_t size, const void*)
 {
-	return je_memalign(alignment, size);
+	void* ptr = __libc_memalign(alignment, size);
+	HeapProfiler::allocated(ptr, size);
+	return ptr;
+}
+
+bool installHeapProfilerHooks(bool install)
+{
+	// other threads may be allocating: each hook is swapped on its own, and they all
+	// work with or without the others
+	__free_hook = install ? freeHook : 0;
+	__memalign_hook = install ? memalignHook : 0;
+	__realloc_hook = install ? reallocHook : 0;
+	__malloc_hook = install ? mallocHook : 0;
+
+	return true;
+}
+
+#else
+
+bool installHeapProfilerHooks(bool install)
+{
+	return false;
 }
 
 #endif
@@ -24,148 +24,201 @@
 
 #include "Common.h"
 
+#include <vector>
 #include <glib.h>
 
+/**
+ * An ordered list of pointers, with a hash on the side.
+ *
+ * contains() is a hash lookup, and so is a miss in position(). A hit remembers where
+ * the pointer was found: the next lookup looks there first, then next to it, which is
+ * where inserts and removes elsewhere in the list move it. Moving one item around costs
+ * the others one or two compares on their next lookup, not a scan. addAfter() and
+ * addBefore() insert in place.
+ *
+ * The same pointer can be added more than once: remove() and position() go by the
+ * first occurrence, and addAfter()/addBefore() add newT next to every occurrence of t.
+ * Items are only changed through the methods below, which keep the hash up to date.
+ */
 template<class T>
 class PtrArray
 {
 public:
 
 	PtrArray() {
-		m_array = g_ptr_array_new();
+		init(0);
 	}
 
 	PtrArray(int initialSize) {
-		m_array = g_ptr_array_sized_new(initialSize);
+		init(initialSize);
 	}
 
 	~PtrArray() {
-		g_ptr_array_free(m_array, TRUE);
+		g_hash_table_destroy(m_count);
+		g_hash_table_destroy(m_found);
 	}
 
 	PtrArray(const PtrArray<T>& other) {
-		m_array = g_ptr_array_sized_new(other.m_array->len);
-		for (unsigned int i = 0; i < other.m_array->len; i++) {
-			g_ptr_array_add(m_array, g_ptr_array_index(other.m_array, i));
-		}
+		init(other.size());
+		for (int i = 0; i < other.size(); i++)
+			append(other.m_items[i]);
 	}
 
 	PtrArray<T>& operator=(const PtrArray<T>& other) {
 		if (this != &other) {
-			if (m_array)
-				g_ptr_array_free(m_array, TRUE);
-			m_array = g_ptr_array_sized_new(other.m_array->len);
-			for (unsigned int i = 0; i < other.m_array->len; i++) {
-				g_ptr_array_add(m_array, g_ptr_array_index(other.m_array, i));
-			}
+			clear();
+			for (int i = 0; i < other.size(); i++)
+				append(other.m_items[i]);
 		}
 		return *this;
 	}
 	
 	inline void append(T* t) {
-		g_ptr_array_add(m_array, t);
+		m_items.push_back(t);
+		addCount(t, 1);
 	}
 
-	inline bool remove(T* t) {
-		return g_ptr_array_remove(m_array, t);
+	bool remove(T* t) {
+		int i = position(t);
+		if (i < 0)
+			return false;
+
+		m_items.erase(m_items.begin() + i);
+		addCount(t, -1);
+		return true;
 	}
 
 	void addAfter(T* t, T* newT) {
-
-		if (empty() || !contains(t)) {
-			append(newT);
-			return;
-		}
-
-		GPtrArray* oldArray = m_array;
-		m_array = g_ptr_array_sized_new(oldArray->len + 1);
-
-		for (unsigned int i = 0; i < oldArray->len; i++) {
-			g_ptr_array_add(m_array, g_ptr_array_index(oldArray, i));
-			if (g_ptr_array_index(oldArray, i) == t)
-				g_ptr_array_add(m_array, newT);
-		}
-
-		g_ptr_array_free(oldArray, TRUE);
-		
+		addNextTo(t, newT, 1);
 	}
 
 	void addBefore(T* t, T* newT) {
-
-		if (empty() || !contains(t)) {
-			append(newT);
-			return;
-		}
-
-		GPtrArray* oldArray = m_array;
-		m_array = g_ptr_array_sized_new(oldArray->len + 1);
-
-		for (unsigned int i = 0; i < oldArray->len; i++) {
-			if (g_ptr_array_index(oldArray, i) == t)
-				g_ptr_array_add(m_array, newT);
-			g_ptr_array_add(m_array, g_ptr_array_index(oldArray, i));
-		}
-
-		g_ptr_array_free(oldArray, TRUE);		
+		addNextTo(t, newT, 0);
 	}
 	
 	inline bool empty() const {
-		return m_array->len == 0;
+		return m_items.empty();
 	}
 
 	inline int size() const {
-		return m_array->len;
+		return m_items.size();
 	}
 
 	inline void clear() {
-		g_ptr_array_free(m_array, TRUE);
-		m_array = g_ptr_array_new();
+		m_items.clear();
+		g_hash_table_remove_all(m_count);
+		g_hash_table_remove_all(m_found);
 	}
 
 	inline T* operator[](int i) const {
-//		if (i < 0 || i >= m_array->len)
-//			return 0;
-		return (T*) g_ptr_array_index(m_array, i);
+		return m_items[i];
 	}
 
-	inline T*& operator[](int i) {
-		return (T*&) g_ptr_array_index(m_array, i);
+	// read only: items are replaced by removing and adding them
+	inline T* const& operator[](int i) {
+		return m_items[i];
 	}
 
-	inline int position(T* t) const {
-		for (unsigned int i = 0; i < m_array->len; i++) {
-			if (g_ptr_array_index(m_array, i) == t)
-				return i;
-		}
+	int position(T* t) const {
+		int count = GPOINTER_TO_INT(g_hash_table_lookup(m_count, t));
+		if (!count)
+			return -1;
 
-		return -1;
+		// with duplicates, only a scan from the start finds the first one
+		int i = count == 1 ? findNear(t, lastFound(t)) : findFrom(t, 0);
+		g_hash_table_insert(m_found, t, GINT_TO_POINTER(i + 1));
+		return i;
 	}
 
 	inline bool contains(T* t) const {
-		for (unsigned int i = 0; i < m_array->len; i++) {
-			if (g_ptr_array_index(m_array, i) == t)
-				return true;
-		}
-
-		return false;
+		return g_hash_table_lookup(m_count, t) != 0;
 	}
-		
 
 	inline T* first() const {
-		if (m_array->len)
-			return (T*) g_ptr_array_index(m_array, 0);
+		if (!m_items.empty())
+			return m_items.front();
 		return 0;
 	}
 
 	inline T* last() const {
-		if (m_array->len)
-			return (T*) g_ptr_array_index(m_array, m_array->len - 1);
+		if (!m_items.empty())
+			return m_items.back();
 		return 0;
 	}
 	
 private:
 
-	GPtrArray* m_array;
+	void init(int initialSize) {
+		m_items.reserve(initialSize);
+		m_count = g_hash_table_new(g_direct_hash, g_direct_equal);
+		m_found = g_hash_table_new(g_direct_hash, g_direct_equal);
+	}
+
+	void addCount(T* t, int delta) {
+		int count = GPOINTER_TO_INT(g_hash_table_lookup(m_count, t)) + delta;
+		if (count > 0) {
+			g_hash_table_insert(m_count, t, GINT_TO_POINTER(count));
+		}
+		else {
+			g_hash_table_remove(m_count, t);
+			g_hash_table_remove(m_found, t);
+		}
+	}
+
+	void addNextTo(T* t, T* newT, int offset) {
+
+		if (empty() || !contains(t)) {
+			append(newT);
+			return;
+		}
+
+		int i = position(t);
+		int count = GPOINTER_TO_INT(g_hash_table_lookup(m_count, t));
+
+		// a new t (newT == t) isn't one of the occurrences to add next to
+		for (; count > 0; i++) {
+			if (m_items[i] != t)
+				continue;
+
+			m_items.insert(m_items.begin() + i + offset, newT);
+			addCount(newT, 1);
+			count--;
+			i++;
+		}
+	}
+
+	// where t was found last, stored off by one, 0 being never
+	int lastFound(T* t) const {
+		return GPOINTER_TO_INT(g_hash_table_lookup(m_found, t)) - 1;
+	}
+
+	int findFrom(T* t, int i) const {
+		int n = m_items.size();
+		for (; i < n; i++) {
+			if (m_items[i] == t)
+				return i;
+		}
+		return -1;
+	}
+
+	// t is in the list: look at hint, then further and further out on both sides
+	int findNear(T* t, int hint) const {
+		int n = m_items.size();
+		if (hint < 0 || hint >= n)
+			hint = 0;
+
+		for (int d = 0; d < n; d++) {
+			if (hint + d < n && m_items[hint + d] == t)
+				return hint + d;
+			if (d && hint - d >= 0 && m_items[hint - d] == t)
+				return hint - d;
+		}
+		return -1;
+	}
+
+	std::vector<T*>	m_items;
+	GHashTable*		m_count;
+	GHashTable*		m_found;
 };	
 
 #endif /* PTRARRAY_H */
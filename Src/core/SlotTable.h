@@ -0,0 +1,160 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef SLOTTABLE_H
+#define SLOTTABLE_H
+
+#include "Common.h"
+
+#include <vector>
+#include <glib.h>
+
+// An index in the low 16 bits, the slot's generation in the high 16 bits. Never 0
+typedef guint32 SlotHandle;
+
+/**
+ * Pointers addressed by generation-checked handles.
+ *
+ * insert() hands out the handle of a free slot. remove() frees the slot and bumps its
+ * generation, so a handle kept after its entry went away looks up as NULL, even once
+ * the slot (or the pointer's address) has been reused. Lookup, insert and remove are
+ * O(1). The table does not own the pointers.
+ *
+ * To iterate: for (int i = 0; i < table.capacity(); i++) if (T* t = table.at(i)) ...
+ */
+template<class T>
+class SlotTable
+{
+public:
+
+	typedef SlotHandle Handle;
+
+	static const Handle kInvalidHandle = 0;
+	static const int kMaxSlots = 1 << 16;
+
+	SlotTable() : m_freeHead(-1), m_size(0) {}
+
+	// value must not be NULL. kInvalidHandle if the table is full
+	Handle insert(T* value) {
+
+		int index = m_freeHead;
+		if (index >= 0) {
+			m_freeHead = m_slots[index].nextFree;
+		}
+		else {
+			if (G_UNLIKELY((int) m_slots.size() >= kMaxSlots)) {
+				g_critical("%s: table full (%d entries)", __PRETTY_FUNCTION__, m_size);
+				return kInvalidHandle;
+			}
+
+			Slot slot;
+			slot.generation = 1;
+			m_slots.push_back(slot);
+			index = m_slots.size() - 1;
+		}
+
+		Slot& slot = m_slots[index];
+		slot.value = value;
+		slot.nextFree = -1;
+		m_size++;
+
+		return makeHandle(index, slot.generation);
+	}
+
+	// false if the handle was stale already
+	bool remove(Handle handle) {
+
+		int index = indexOf(handle);
+		if (index < 0)
+			return false;
+
+		Slot& slot = m_slots[index];
+		slot.value = 0;
+		// 0 is left out so that no handle is ever kInvalidHandle
+		slot.generation = (slot.generation == 0xffff) ? 1 : slot.generation + 1;
+		slot.nextFree = m_freeHead;
+		m_freeHead = index;
+		m_size--;
+
+		return true;
+	}
+
+	// NULL for stale and invalid handles
+	inline T* get(Handle handle) const {
+		int index = indexOf(handle);
+		return index < 0 ? 0 : m_slots[index].value;
+	}
+
+	inline bool contains(Handle handle) const { return indexOf(handle) >= 0; }
+
+	inline int size() const { return m_size; }
+	inline bool empty() const { return m_size == 0; }
+
+	// every handle handed out so far becomes stale
+	void clear() {
+		for (int i = 0; i < capacity(); i++) {
+			if (m_slots[i].value)
+				remove(makeHandle(i, m_slots[i].generation));
+		}
+	}
+
+	inline int capacity() const { return m_slots.size(); }
+
+	// NULL for free slots
+	inline T* at(int index) const { return m_slots[index].value; }
+	inline Handle handleAt(int index) const {
+		return m_slots[index].value ? makeHandle(index, m_slots[index].generation) : kInvalidHandle;
+	}
+
+private:
+
+	struct Slot
+	{
+		T*		value;		// NULL while free
+		guint16	generation;
+		int		nextFree;
+	};
+
+	static inline Handle makeHandle(int index, guint16 generation) {
+		return (Handle(generation) << 16) | Handle(index);
+	}
+
+	inline int indexOf(Handle handle) const {
+		int index = handle & 0xffff;
+		if (index >= (int) m_slots.size())
+			return -1;
+
+		const Slot& slot = m_slots[index];
+		if (!slot.value || slot.generation != (handle >> 16))
+			return -1;
+
+		return index;
+	}
+
+	std::vector<Slot>	m_slots;
+	int					m_freeHead;
+	int					m_size;
+};
+
+template<class T> const SlotHandle SlotTable<T>::kInvalidHandle;
+template<class T> const int SlotTable<T>::kMaxSlots;
+
+#endif /* SLOTTABLE_H */
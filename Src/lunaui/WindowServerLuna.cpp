@@ -51,6 +51,7 @@
 #include "Preferences.h"
 #include "Localization.h"
 #include "MemoryMonitor.h"
+#include "QmlComponentCache.h"
 #include "UiNavigationController.h"
 
 #include <QEvent>
@@ -95,6 +96,7 @@ WindowServerLuna::WindowServerLuna()
 	, m_dockImageObject (NULL)
 	, m_dashboardOpenInDockMode (true)
 	, m_qmlEngine(0)
+	, m_qmlCache(0)
 	, m_inDockModeTransition(false)
 	, m_dockModeTransitionDirection(false)
 {
@@ -105,6 +107,13 @@ WindowServerLuna::WindowServerLuna()
 
 	m_qmlEngine->rootContext()->setContextProperty("runtime", Runtime::instance());
 
+	// the alerts are created every time they are shown: have them compiled before that
+	m_qmlCache = new QmlComponentCache(m_qmlEngine, this);
+	std::string qmlPath = Settings::LunaSettings()->lunaQmlUiComponentsPath;
+	m_qmlCache->preload((qmlPath + "MemoryAlert/alert.qml").c_str());
+	m_qmlCache->preload((qmlPath + "MsmEntryFailed/alert.qml").c_str());
+	m_qmlCache->preload((qmlPath + "DismissCardTutorial/dismissDialog.qml").c_str());
+
 	//the map is in the base class (WindowServerBase)
 	m_cardMgr = new CardWindowManager(m_screenWidth, m_screenHeight);
 	m_windowManagerMap.insert(QString(m_cardMgr->metaObject()->className()),m_cardMgr);
@@ -86,6 +86,7 @@ public:
 	virtual bool okToResizeUi(bool ignorePendingRequests=false);
 	void resizeWindowManagers(int width, int height);
     virtual QDeclarativeEngine* declarativeEngine() { return m_qmlEngine; }
+    virtual QmlComponentCache* qmlComponentCache() { return m_qmlCache; }
 
 	virtual QRectF mapRectToRoot(const QGraphicsItem* item, const QRectF& rect) const;
 
@@ -148,6 +149,7 @@ private:
 	WindowManagerBase* m_dockModeMgr;
 
     QDeclarativeEngine* m_qmlEngine;
+    QmlComponentCache* m_qmlCache;
 
 	QString  m_wallpaperFileName;
 	QPixmap  m_normalWallpaperImage, m_rotatedWallpaperImage;
@@ -43,6 +43,8 @@ CardGroup::CardGroup(qreal curScale, qreal nonCurScale)
 	, m_rightWidth(0)
 	, m_activeCard(0)
 	, m_currentPosition(0)
+	, m_closedLeftWidth(0)
+	, m_closedRightWidth(0)
 {
 	m_cardGroupRotFactor = Settings::LunaSettings()->cardGroupRotFactor;
 	m_cardGroupXDistanceFactor = Settings::LunaSettings()->cardGroupingXDistanceFactor;
@@ -238,9 +240,9 @@ QList<QPropertyAnimation*> CardGroup::animateOpen(int duration,
 
 QList<QPropertyAnimation*> CardGroup::animateClose(int duration, QEasingCurve::Type curve, bool useGroupPosition)
 {
-	static const qreal kCardWidth = m_cards[0]->boundingRect().width();
+	qreal cardWidth = m_cards[0]->boundingRect().width();
 
-	qreal activeCardWidth = kCardWidth * m_curScale;
+	qreal activeCardWidth = cardWidth * m_curScale;
 
 	QList<QPropertyAnimation*> anims;
 
@@ -251,7 +253,7 @@ QList<QPropertyAnimation*> CardGroup::animateClose(int duration, QEasingCurve::T
 	}
 
     // use a large size in the case of non group positioning to garuantee that the group is completely closed
-	QVector<CardWindow::Position> positions = calculateOpenedPositions(useGroupPosition ? m_pos.x() : kCardWidth);
+	QVector<CardWindow::Position> positions = calculateOpenedPositions(useGroupPosition ? m_pos.x() : cardWidth);
 
 	Q_ASSERT(positions.size() == m_cards.size());
 	for (int i = 0; i < m_cards.size(); i++) {
@@ -300,6 +302,16 @@ void CardGroup::setCardPositions(int groupXOffset)
     }
 }
 
+bool CardGroup::collapsedAt(int groupXOffset) const
+{
+	if (m_cards.empty())
+		return true;
+
+	// see amtToCollapse in calculateOpenedPositions
+	qreal activeCardWidth = m_cards[0]->boundingRect().width() * m_curScale;
+	return groupXOffset != 0 && activeCardWidth - qAbs(groupXOffset) <= 1.0;
+}
+
 void CardGroup::layoutCards(bool open, bool includeActiveCard)
 {
 	if(open) {
@@ -314,12 +326,26 @@ void CardGroup::layoutCards(bool open, bool includeActiveCard)
 			m_cards[i]->setPosition(positions[i]);
 		}
 	} else {
-		QVector<CardWindow::Position> positions = calculateClosedPositions();
+		// unless cards came, went or changed size, only those moved since need it
+		if (!closedPositionsValid()) {
+			m_closedPositions = calculateClosedPositions();
+			m_closedCards = m_cards;
+			m_closedFirstSize = m_cards.empty() ? QSizeF() : m_cards.first()->boundingRect().size();
+			m_closedLastSize = m_cards.empty() ? QSizeF() : m_cards.last()->boundingRect().size();
+			m_closedLeftWidth = m_leftWidth;
+			m_closedRightWidth = m_rightWidth;
+		}
+		else {
+			m_leftWidth = m_closedLeftWidth;
+			m_rightWidth = m_closedRightWidth;
+		}
+
+		const QVector<CardWindow::Position>& positions = m_closedPositions;
 
 		Q_ASSERT(positions.size() == m_cards.size());
 		for (int i = 0; i < m_cards.size(); i++) {
-			m_cards[i]->setPosition(positions[i]);
-
+			if (!(m_cards[i]->position() == positions[i]))
+				m_cards[i]->setPosition(positions[i]);
 		}
 	}
 }
@@ -597,7 +623,7 @@ void CardGroup::adjustHorizontally(qreal xDiff)
 		return;
 
 	// m_currentPosition can shift a total of 3 cards with one full drag
-	static const qreal pixelsPerPos = m_cards[0]->boundingRect().width() / kPositionsPerWidth;
+	qreal pixelsPerPos = m_cards[0]->boundingRect().width() / kPositionsPerWidth;
 	m_currentPosition += (-xDiff/pixelsPerPos);
 	clampCurrentPosition();
 }
@@ -701,10 +727,8 @@ QVector<CardWindow::Position> CardGroup::calculateOpenedPositions(qreal xOffset)
 	if (m_cards.empty())
 		return QVector<CardWindow::Position>();
 
-	static const qreal kCardWidth = m_cards[0]->boundingRect().width();
-
 	QVector<CardWindow::Position> positions(m_cards.size());
-	qreal activeCardWidth = kCardWidth * m_curScale;
+	qreal activeCardWidth = m_cards[0]->boundingRect().width() * m_curScale;
 
 	clampCurrentPosition();
 
@@ -742,6 +766,17 @@ QVector<CardWindow::Position> CardGroup::calculateOpenedPositions(qreal xOffset)
 	return positions;
 }
 
+bool CardGroup::closedPositionsValid() const
+{
+	if (m_closedCards != m_cards)
+		return false;
+
+	// the extents come from the first and last card
+	return m_cards.empty() ||
+		   (m_cards.first()->boundingRect().size() == m_closedFirstSize &&
+			m_cards.last()->boundingRect().size() == m_closedLastSize);
+}
+
 QVector<CardWindow::Position> CardGroup::calculateClosedPositions()
 {
 	if (m_cards.empty())
@@ -29,6 +29,7 @@
 #include <QEasingCurve>
 #include <QObject>
 #include <QPointF>
+#include <QSizeF>
 
 #include "CardWindow.h"
 
@@ -90,6 +91,9 @@ public:
     // Sets positions for the group and the cards based on groupXOffset
     // without creating any animations.
     void setCardPositions(int groupXOffset);
+    // true if the cards are fully collapsed at groupXOffset, where the card
+    // positions setCardPositions() picks don't depend on the offset anymore
+    bool collapsedAt(int groupXOffset) const;
 
 	QList<QPropertyAnimation*> maximizeActiveCard(qreal centerOffset);
 
@@ -164,6 +168,7 @@ private:
 
 	QVector<CardWindow::Position> calculateOpenedPositions(qreal xOffset = 0.0);
 	QVector<CardWindow::Position> calculateClosedPositions();
+	bool closedPositionsValid() const;
 
 	void clampCurrentPosition();
 
@@ -182,6 +187,14 @@ private:
 	// 1: 	3-4 cards with the second card being the center of the group
 	// N:	>4 cards where valid positions are between 1.0 and N - 4 + 1
 	qreal m_currentPosition;
+
+	// the closed layout only changes with the cards, and their size
+	QVector<CardWindow::Position> m_closedPositions;
+	QVector<CardWindow*> m_closedCards;
+	QSizeF m_closedFirstSize;
+	QSizeF m_closedLastSize;
+	int m_closedLeftWidth;
+	int m_closedRightWidth;
 };
 
 Q_DECLARE_METATYPE(CardWindow::Position)
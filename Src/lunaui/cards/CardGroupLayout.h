@@ -0,0 +1,188 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef CARDGROUPLAYOUT_H
+#define CARDGROUPLAYOUT_H
+
+#include "Common.h"
+
+#include <QVector>
+
+/**
+ * Lays out the card groups of the card view while it is dragged sideways.
+ *
+ * Dragging translates the row of groups. A group's cards only need laying out again
+ * when its fan changes: near the center of the screen, or when its membership changed.
+ * Away from the center the groups are fully collapsed, and moving one is a plain
+ * setX(). Groups that are off screen before and after a move are not touched at all:
+ * the walk out from the active group stops at the first of them, and flush() finishes
+ * it later from where it stopped, with the extents the groups cache.
+ *
+ * Group is CardGroup, or anything with the same left(), right(), x(), size(),
+ * collapsedAt(), setCardPositions() and setX().
+ */
+template<class Group>
+class CardGroupLayout
+{
+public:
+
+	CardGroupLayout() : m_gap(0), m_halfWidth(0), m_farLeft(-1), m_farRight(0),
+		m_farLeftCursor(0), m_farRightCursor(0), m_numPlaced(0), m_numMoved(0) {}
+
+	void setGap(int gap) { m_gap = gap; }
+	void setViewportWidth(int width) { m_halfWidth = width / 2; }
+
+	// a new drag: forget how the groups were laid out. Whatever slide() deferred is
+	// dropped, flush() first to keep it
+	void reset() {
+
+		m_entries.clear();
+		m_farLeft = -1;
+		m_farRight = 0;
+	}
+
+	// the active group is at activeX, the others in a row on both sides of it
+	void slide(const QVector<Group*>& groups, int activeIndex, int activeX) {
+
+		// groups came or went: the old entries may point to deleted ones, this walk
+		// and the next flush() cover all the new ones
+		if (changed(groups))
+			rebuild(groups);
+
+		Group* active = groups[activeIndex];
+		place(m_entries[activeIndex], activeX, true);
+
+		m_farLeft = walk(activeIndex - 1, -1, activeX - active->left() - m_gap, false, &m_farLeftCursor);
+		m_farRight = walk(activeIndex + 1, 1, activeX + active->right() + m_gap, false, &m_farRightCursor);
+	}
+
+	// lays out the groups slide() left off screen
+	void flush() {
+
+		int cursor;
+		if (m_farLeft >= 0)
+			walk(m_farLeft, -1, m_farLeftCursor, true, &cursor);
+		if (m_farRight < m_entries.size())
+			walk(m_farRight, 1, m_farRightCursor, true, &cursor);
+
+		m_farLeft = -1;
+		m_farRight = m_entries.size();
+	}
+
+	// groups waiting for flush()
+	int numDeferred() const { return (m_farLeft + 1) + (m_entries.size() - m_farRight); }
+
+	// setCardPositions() and setX() calls so far
+	int numPlaced() const { return m_numPlaced; }
+	int numMoved() const { return m_numMoved; }
+
+private:
+
+	struct Entry
+	{
+		Group*	group;
+		int		size;		// cards in the group when it was laid out
+		bool	collapsed;	// laid out fully collapsed: moving it is just setX()
+	};
+
+	bool changed(const QVector<Group*>& groups) const {
+
+		if (m_entries.size() != groups.size())
+			return true;
+		for (int i = 0; i < groups.size(); i++) {
+			if (m_entries[i].group != groups[i])
+				return true;
+		}
+		return false;
+	}
+
+	void rebuild(const QVector<Group*>& groups) {
+
+		m_entries.resize(groups.size());
+		for (int i = 0; i < groups.size(); i++) {
+			m_entries[i].group = groups[i];
+			m_entries[i].size = -1;
+			m_entries[i].collapsed = false;
+		}
+
+		m_farLeft = -1;
+		m_farRight = m_entries.size();
+	}
+
+	// lays out the groups from index on, in step's direction. cursor is the edge of
+	// the group before, plus the gap. Returns where it stopped, and the cursor there,
+	// or the index past the end
+	int walk(int index, int step, int cursor, bool always, int* stopCursor) {
+
+		for (; index >= 0 && index < m_entries.size(); index += step) {
+
+			Entry& e = m_entries[index];
+			int x = step < 0 ? cursor - e.group->right() : cursor + e.group->left();
+			if (!place(e, x, always)) {
+				*stopCursor = cursor;
+				return index;
+			}
+			cursor = step < 0 ? x - m_gap - e.group->left() : x + m_gap + e.group->right();
+		}
+
+		return index;
+	}
+
+	bool visible(const Group* group, int x) const {
+		return x + group->right() > -m_halfWidth && x - group->left() < m_halfWidth;
+	}
+
+	// false, without touching the group, if it is off screen before and after
+	bool place(Entry& e, int x, bool always) {
+
+		Group* group = e.group;
+		if (!always && !visible(group, (int) group->x()) && !visible(group, x))
+			return false;
+
+		bool collapsed = group->collapsedAt(x);
+		if (e.collapsed && collapsed && e.size == group->size()) {
+			if (group->x() != x) {
+				group->setX(x);
+				m_numMoved++;
+			}
+		}
+		else {
+			group->setCardPositions(x);
+			e.size = group->size();
+			e.collapsed = collapsed;
+			m_numPlaced++;
+		}
+
+		return true;
+	}
+
+	QVector<Entry> m_entries;
+	int m_gap;
+	int m_halfWidth;
+	int m_farLeft;			// groups [0, m_farLeft] wait for flush()
+	int m_farRight;			// groups [m_farRight, size) too
+	int m_farLeftCursor;
+	int m_farRightCursor;
+	int m_numPlaced;
+	int m_numMoved;
+};
+
+#endif /* CARDGROUPLAYOUT_H */
@@ -28,7 +28,6 @@
 
 #include "AnimationSettings.h"
 #include "BannerMessageHandler.h"
-#include "CardTransition.h"
 #include "HostBase.h"
 #include "IpcClientHost.h"
 #include "Settings.h"
@@ -154,8 +153,7 @@ void CardHostWindow::resizeWindowBufferEvent(int w, int h, QRect windowScreenBou
 			setMaximized(false); // disable direct rendering for the resize event
 		setBoundingRect(windowScreenBounds.width(), windowScreenBounds.height());
 
-		m_paintPath = QPainterPath();
-		m_paintPath.addRoundedRect(m_boundingRect, 25, 25);
+		setPaintPath(m_boundingRect, 25, 25);
 
 		// reconstruct shadow
 		CardDropShadowEffect* shadow = static_cast<CardDropShadowEffect*>(graphicsEffect());
@@ -435,7 +433,7 @@ void CardHostWindow::paintBase(QPainter* painter, bool maximized)
         const QPixmap* pix = acquireScreenPixmap();
         if (pix) {
             QRectF brect = boundingRect();
-            QPainterPath paintPath;
+            const CardRoundedCorners::Shape* shape;
 
                             initializeRoundedCornerStage();
 
@@ -443,9 +441,9 @@ void CardHostWindow::paintBase(QPainter* painter, bool maximized)
 
             if (m_adjustmentAngle == 90 || m_adjustmentAngle == -90) {
                 QRectF rotRect = QRectF(brect.y(), brect.x(), brect.height(), brect.width());
-                paintPath.addRoundedRect(rotRect, 25, 25);
+                shape = CardRoundedCorners::instance()->acquire(rotRect, 25, 25);
             } else {
-                paintPath.addRoundedRect(m_boundingRect, 25, 25);
+                shape = CardRoundedCorners::instance()->acquire(m_boundingRect, 25, 25);
             }
 
             int originX = brect.x();
@@ -476,9 +474,11 @@ void CardHostWindow::paintBase(QPainter* painter, bool maximized)
                             }
                             m_roundedCornerShaderStage->removeFromPainter(painter);
 #else
-                            painter->fillPath(paintPath, *pix);
+                            if (!shape->draw(painter, *pix, painter->brushOrigin()))
+                                painter->fillPath(shape->path(), *pix);
 #endif
                             painter->rotate(-m_adjustmentAngle);
+            CardRoundedCorners::instance()->release(shape);
             painter->setBrushOrigin(0, 0);
         }
     }
@@ -0,0 +1,193 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "CardRoundedCorners.h"
+
+#include <math.h>
+
+const int CardRoundedCorners::kMaxUnused;
+
+CardRoundedCorners* CardRoundedCorners::s_instance = 0;
+
+CardRoundedCorners::Shape::Shape(const QRectF& rect, qreal xRadius, qreal yRadius)
+	: m_rect(rect)
+	, m_xRadius(xRadius)
+	, m_yRadius(yRadius)
+	, m_numBody(0)
+	, m_refCount(0)
+{
+	m_path.addRoundedRect(rect, xRadius, yRadius);
+
+	// the corners are whole pixels, so that their masks line up with the pixmap. A
+	// radius of more than half the rect is clamped, as addRoundedRect does
+	qreal cw = ::ceil(qBound(qreal(0), xRadius, rect.width() / 2));
+	qreal ch = ::ceil(qBound(qreal(0), yRadius, rect.height() / 2));
+	if (cw == 0 || ch == 0) {
+		m_body[m_numBody++] = rect;
+		return;
+	}
+
+	QRectF body[3] = {
+		QRectF(rect.x() + cw, rect.y(), rect.width() - 2 * cw, ch),
+		QRectF(rect.x(), rect.y() + ch, rect.width(), rect.height() - 2 * ch),
+		QRectF(rect.x() + cw, rect.bottom() - ch, rect.width() - 2 * cw, ch)
+	};
+	for (int i = 0; i < 3; i++) {
+		if (body[i].width() > 0 && body[i].height() > 0)
+			m_body[m_numBody++] = body[i];
+	}
+
+	m_corners[0] = QRectF(rect.x(), rect.y(), cw, ch);
+	m_corners[1] = QRectF(rect.right() - cw, rect.y(), cw, ch);
+	m_corners[2] = QRectF(rect.x(), rect.bottom() - ch, cw, ch);
+	m_corners[3] = QRectF(rect.right() - cw, rect.bottom() - ch, cw, ch);
+
+	for (int i = 0; i < NumCorners; i++) {
+		m_masks[i] = QImage((int) cw, (int) ch, QImage::Format_ARGB32_Premultiplied);
+		m_masks[i].fill(0);
+
+		QPainter p(&m_masks[i]);
+		p.setRenderHint(QPainter::Antialiasing, true);
+		p.translate(-m_corners[i].topLeft());
+		p.fillPath(m_path, Qt::black);
+	}
+
+	m_scratch = QImage((int) cw, (int) ch, QImage::Format_ARGB32_Premultiplied);
+}
+
+bool CardRoundedCorners::Shape::draw(QPainter* painter, const QPixmap& pix, const QPointF& origin) const
+{
+	if (!QRectF(origin, QSizeF(pix.size())).contains(m_rect))
+		return false;
+
+	for (int i = 0; i < m_numBody; i++)
+		painter->drawPixmap(m_body[i], pix, m_body[i].translated(-origin));
+
+	if (m_scratch.isNull())
+		return true;
+
+	// the corners are blended in: under Source (the cards' mode at full opacity) the
+	// transparent pixels outside the curve would be written over what is behind the card,
+	// where a path fill leaves everything it doesn't cover alone
+	QPainter::CompositionMode mode = painter->compositionMode();
+	if (mode != QPainter::CompositionMode_SourceOver)
+		painter->setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+	for (int i = 0; i < NumCorners; i++) {
+		QPainter p(&m_scratch);
+		p.setCompositionMode(QPainter::CompositionMode_Source);
+		p.drawPixmap(m_scratch.rect(), pix, m_corners[i].translated(-origin));
+		p.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+		p.drawImage(0, 0, m_masks[i]);
+		p.end();
+
+		painter->drawImage(m_corners[i], m_scratch);
+	}
+
+	if (mode != QPainter::CompositionMode_SourceOver)
+		painter->setCompositionMode(mode);
+
+	return true;
+}
+
+CardRoundedCorners* CardRoundedCorners::instance()
+{
+	if (G_UNLIKELY(s_instance == 0))
+		s_instance = new CardRoundedCorners;
+
+	return s_instance;
+}
+
+CardRoundedCorners::~CardRoundedCorners()
+{
+	for (ShapeMap::iterator it = m_shapes.begin(); it != m_shapes.end(); ++it)
+		delete it->second;
+}
+
+bool CardRoundedCorners::Key::operator<(const Key& other) const
+{
+	if (x != other.x) return x < other.x;
+	if (y != other.y) return y < other.y;
+	if (w != other.w) return w < other.w;
+	if (h != other.h) return h < other.h;
+	if (xRadius != other.xRadius) return xRadius < other.xRadius;
+	return yRadius < other.yRadius;
+}
+
+CardRoundedCorners::Key CardRoundedCorners::keyFor(const QRectF& rect, qreal xRadius, qreal yRadius)
+{
+	Key key = { rect.x(), rect.y(), rect.width(), rect.height(), xRadius, yRadius };
+	return key;
+}
+
+const CardRoundedCorners::Shape* CardRoundedCorners::acquire(const QRectF& rect, qreal xRadius, qreal yRadius)
+{
+	Key key = keyFor(rect, xRadius, yRadius);
+
+	Shape* shape = 0;
+	ShapeMap::iterator it = m_shapes.find(key);
+	if (it != m_shapes.end()) {
+		shape = it->second;
+		if (shape->m_refCount == 0)
+			m_unused.erase(shape->m_unusedPos);
+	}
+	else {
+		shape = new Shape(rect, xRadius, yRadius);
+		m_shapes[key] = shape;
+	}
+
+	shape->m_refCount++;
+	return shape;
+}
+
+void CardRoundedCorners::release(const Shape* constShape)
+{
+	if (!constShape)
+		return;
+
+	Shape* shape = const_cast<Shape*>(constShape);
+	if (G_UNLIKELY(shape->m_refCount <= 0)) {
+		g_critical("%s: shape released more often than acquired", __PRETTY_FUNCTION__);
+		return;
+	}
+
+	if (--shape->m_refCount > 0)
+		return;
+
+	shape->m_unusedPos = m_unused.insert(m_unused.end(), shape);
+	while ((int) m_unused.size() > kMaxUnused)
+		evict(m_unused.front());
+}
+
+void CardRoundedCorners::trim()
+{
+	while (!m_unused.empty())
+		evict(m_unused.front());
+}
+
+void CardRoundedCorners::evict(Shape* shape)
+{
+	m_unused.erase(shape->m_unusedPos);
+	m_shapes.erase(keyFor(shape->m_rect, shape->m_xRadius, shape->m_yRadius));
+	delete shape;
+}
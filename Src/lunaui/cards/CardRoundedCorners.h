@@ -0,0 +1,131 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef CARDROUNDEDCORNERS_H
+#define CARDROUNDEDCORNERS_H
+
+#include "Common.h"
+
+#include <list>
+#include <map>
+
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmap>
+#include <QRectF>
+
+/**
+ * Rounded rect outlines shared by all the cards.
+ *
+ * Cards of the same size and orientation have the same outline, so it is built once
+ * per (rect, radii) and handed out by reference: the rect carries the orientation
+ * (rotated cards pass their rect with width and height swapped). Along with the
+ * path, each shape keeps an antialiased mask of its four corners, so that a card is
+ * drawn as a few rectangular blits of its pixmap plus four corner-sized masked
+ * blits, instead of a path fill with the pixmap as a brush, which has the raster
+ * engine tessellate and clip the whole outline on every paint.
+ *
+ * Shapes are reference counted. Unreferenced ones are kept around (a card flipping
+ * back and forth needs the same two again) up to kMaxUnused, oldest dropped first.
+ * GUI thread only.
+ */
+class CardRoundedCorners
+{
+public:
+
+	static const int kMaxUnused = 8;
+
+	class Shape
+	{
+	public:
+
+		const QRectF& rect() const { return m_rect; }
+		const QPainterPath& path() const { return m_path; }
+
+		// draws pix, with its top left corner at origin (as a brush origin would), clipped
+		// to the outline. Returns false, without drawing, if pix doesn't cover the
+		// outline: a texture brush would tile it
+		bool draw(QPainter* painter, const QPixmap& pix, const QPointF& origin) const;
+
+	private:
+
+		Shape(const QRectF& rect, qreal xRadius, qreal yRadius);
+
+		enum { NumCorners = 4 };
+
+		QRectF			m_rect;
+		qreal			m_xRadius;
+		qreal			m_yRadius;
+		QPainterPath	m_path;
+		QRectF			m_body[3];
+		int				m_numBody;
+		QRectF			m_corners[NumCorners];
+		QImage			m_masks[NumCorners];
+		mutable QImage	m_scratch;
+
+		int				m_refCount;
+		std::list<Shape*>::iterator m_unusedPos;
+
+		friend class CardRoundedCorners;
+	};
+
+	static CardRoundedCorners* instance();
+
+	// the returned shape stays valid until released
+	const Shape* acquire(const QRectF& rect, qreal xRadius, qreal yRadius);
+	void release(const Shape* shape);
+
+	int numShapes() const { return m_shapes.size(); }
+	int numUnused() const { return m_unused.size(); }
+
+	// drops the unreferenced shapes
+	void trim();
+
+private:
+
+	struct Key
+	{
+		qreal x, y, w, h, xRadius, yRadius;
+		bool operator<(const Key& other) const;
+	};
+
+	static Key keyFor(const QRectF& rect, qreal xRadius, qreal yRadius);
+
+	typedef std::map<Key, Shape*> ShapeMap;
+
+	CardRoundedCorners() {}
+	~CardRoundedCorners();
+
+	void evict(Shape* shape);
+
+	ShapeMap			m_shapes;
+	std::list<Shape*>	m_unused;		// most recently released last
+
+	static CardRoundedCorners* s_instance;
+
+private:
+
+	CardRoundedCorners(const CardRoundedCorners&);
+	CardRoundedCorners& operator=(const CardRoundedCorners&);
+};
+
+#endif /* CARDROUNDEDCORNERS_H */
@@ -107,6 +107,7 @@ CardWindow::CardWindow(WindowType::Type type, HostWindowData* data, IpcClientHos
 	, m_loadingAnim(0)
 	, m_loadingTimerId(0)
     , m_splashBackgroundName()
+	, m_paintShape(0)
 	, m_compMode(QPainter::CompositionMode_Source)
 	, m_group(0)
 	, m_attachedToGroup(true)
@@ -152,6 +153,7 @@ CardWindow::CardWindow(WindowType::Type type, const QPixmap& pixmap)
 	, m_loadingAnim(0)
 	, m_loadingTimerId(0)
 	, m_splashBackgroundName()
+	, m_paintShape(0)
 	, m_compMode(QPainter::CompositionMode_Source)
 	, m_group(0)
 	, m_attachedToGroup(true)
@@ -221,6 +223,8 @@ CardWindow::~CardWindow()
 
 	delete m_loadingAnim;
 
+	CardRoundedCorners::instance()->release(m_paintShape);
+
     if(m_maximized && WindowType::Type_ModalChildWindowCard != type()) {
 		// disable the direct rendering request for this window with SystemUiController
 		SystemUiController::instance()->setDirectRenderingForWindow(SystemUiController::CARD_WINDOW_MANAGER, this, false);
@@ -980,12 +984,10 @@ void CardWindow::queueUpWindowForFlip(QRect windowScreenBounds, bool sync)
 		trans.rotate( - SystemUiController::instance()->getRotationAngle());
 		m_tempRotatedBrush.setTransform(trans);
 
-		m_paintPath = QPainterPath();
-
 		if (m_adjustmentAngle != 90 && m_adjustmentAngle != -90){
-			m_paintPath.addRoundedRect(boundingRect(), 25, 25);
+			setPaintPath(boundingRect(), 25, 25);
 		} else {
-			m_paintPath.addRoundedRect(QRectF(m_boundingRect.y(), m_boundingRect.x(), m_boundingRect.height(), m_boundingRect.width()), 25, 25);
+			setPaintPath(QRectF(m_boundingRect.y(), m_boundingRect.x(), m_boundingRect.height(), m_boundingRect.width()), 25, 25);
 		}
 	}
 
@@ -1013,8 +1015,7 @@ void CardWindow::queuedFlipCanceled(QRect windowScreenBounds)
 	m_boundingRect = m_preFlipBoundingRect;
 
 	//restore the paint path to what it was, in case it got changed
-	m_paintPath = QPainterPath();
-	m_paintPath.addRoundedRect(boundingRect(), 25, 25);
+	setPaintPath(boundingRect(), 25, 25);
 
 	m_isResizing = false;
 	m_flipsQueuedUp--;
@@ -1551,12 +1552,10 @@ void CardWindow::setVisibleDimensions(int width, int height)
 	if (shadow)
 		shadow->cacheDrawingData();
 
-	m_paintPath = QPainterPath();
-
     if ((m_adjustmentAngle != 90 && m_adjustmentAngle != -90) || this->type() == WindowType::Type_ModalChildWindowCard) {
-                m_paintPath.addRoundedRect(boundingRect(), 8, 6); //where you alter the loading rect stuff
+                setPaintPath(boundingRect(), 8, 6); //where you alter the loading rect stuff
 	} else {
-		m_paintPath.addRoundedRect(QRectF(m_boundingRect.y(), m_boundingRect.x(), m_boundingRect.height(), m_boundingRect.width()), 25, 25);
+		setPaintPath(QRectF(m_boundingRect.y(), m_boundingRect.x(), m_boundingRect.height(), m_boundingRect.width()), 25, 25);
 	}
 
 	initializeRoundedCornerStage();
@@ -1688,7 +1687,9 @@ void CardWindow::paintBase(QPainter* painter, bool maximized)
                 }
 
                 if(!m_isResizing) {
-                    painter->fillPath(m_paintPath, *pix);
+                    // a blit plus the corners, unless the pixmap has to tile
+                    if (!m_paintShape || !m_paintShape->draw(painter, *pix, painter->brushOrigin()))
+                        painter->fillPath(m_paintPath, *pix);
                 } else {
                     painter->fillPath(m_paintPath, m_tempRotatedBrush);
                 }
@@ -2482,6 +2483,15 @@ GhostCard* CardWindow::createGhost()
     return ghost;
 }
 
+void CardWindow::setPaintPath(const QRectF& rect, qreal xRadius, qreal yRadius)
+{
+	const CardRoundedCorners::Shape* old = m_paintShape;
+	m_paintShape = CardRoundedCorners::instance()->acquire(rect, xRadius, yRadius);
+	CardRoundedCorners::instance()->release(old);
+
+	m_paintPath = m_paintShape->path();
+}
+
 void CardWindow::initializeRoundedCornerStage()
 {
 #if defined(USE_ROUNDEDCORNER_SHADER)
@@ -45,6 +45,7 @@
 #endif
 
 #include "CardRoundedCornerShaderStage.h"
+#include "CardRoundedCorners.h"
 
 class CardLoading;
 class PIpcMessage;
@@ -291,6 +292,9 @@ protected:
 
     virtual void initializeRoundedCornerStage();
 
+	// takes the outline from the shared cache, rather than building it again
+	void setPaintPath(const QRectF& rect, qreal xRadius, qreal yRadius);
+
 	bool isInValidOrientation();
 
 protected:
@@ -350,6 +354,7 @@ protected:
 	std::string m_splashBackgroundName;
 
 	QPainterPath m_paintPath;
+	const CardRoundedCorners::Shape* m_paintShape;
 	QPainter::CompositionMode m_compMode;
 
 	Position m_position;
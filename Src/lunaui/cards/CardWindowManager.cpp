@@ -76,6 +76,7 @@ static const qreal kReorderEndWindowOpacity = 1.0f;
 CardWindowManager::CardWindowManager(int maxWidth, int maxHeight)
 	: WindowManagerBase(maxWidth, maxHeight)
 	, m_activeGroup(0)
+	, m_activeGroupIndex(-1)
 	, m_draggedWin(0)
 	, m_penDown(false)
 	, m_cardToRestoreToMaximized(0)
@@ -164,6 +165,7 @@ CardWindowManager::~CardWindowManager()
 void CardWindowManager::init()
 {
 	kGapBetweenGroups = Settings::LunaSettings()->gapBetweenCardGroups;
+	m_groupLayout.setGap(kGapBetweenGroups);
 
     if (g_file_test(Settings::LunaSettings()->firstCardLaunch.c_str(), G_FILE_TEST_EXISTS)){
         m_dismissedFirstCard=true;
@@ -272,6 +274,7 @@ void CardWindowManager::resize(int width, int height)
 	// previous cancelation of Card Window flip operations.
 
 	WindowManagerBase::resize(width, height);
+	m_groupLayout.setViewportWidth(boundingRect().width());
 
 	m_normalScreenBounds = QRect(0, Settings::LunaSettings()->positiveSpaceTopPadding,
 						  	     SystemUiController::instance()->currentUiWidth(),
@@ -289,7 +292,7 @@ void CardWindowManager::resize(int width, int height)
     updateAngryCardThreshold();
 
 	if(m_groups.size() > 0) {
-		int index = m_groups.indexOf(m_activeGroup);
+		int index = activeGroupIndex();
 
 		// first resize the active group
 		m_groups[index]->resize(width, height, m_normalScreenBounds);
@@ -401,6 +404,10 @@ void CardWindowManager::startAnimations()
 
 void CardWindowManager::clearAnimations()
 {
+	// groups a drag left off screen have to be in place before anything
+	// animates them from there
+	m_groupLayout.flush();
+
 	m_anims.stop();
 	m_anims.clear();
 	m_cardAnimMap.clear();
@@ -571,7 +578,7 @@ void CardWindowManager::prepareAddWindowSibling(CardWindow* win)
 				CardGroup* newGroup = new CardGroup(kActiveScale, kNonActiveScale);
 				newGroup->setPos(QPointF(0, kWindowOrigin));
 				newGroup->addToGroup(win);
-				m_groups.insert(m_groups.indexOf(m_activeGroup)+1, newGroup);
+				m_groups.insert(activeGroupIndex()+1, newGroup);
 				setActiveGroup(newGroup);
 			}
 
@@ -1004,6 +1011,7 @@ void CardWindowManager::removeCardFromGroup(CardWindow* win, bool adjustLayout)
 		// clean up this group
 		m_groups.remove(m_groups.indexOf(group));
 		removeAnimationForGroup(group);
+		m_groupLayout.reset();
 		delete group;
 	}
 
@@ -1051,7 +1059,7 @@ void CardWindowManager::layoutGroups(qreal xDiff)
 	if (!m_activeGroup || m_groups.empty())
 		return;
 
-	int activeGroupPosition = m_groups.indexOf(m_activeGroup);
+	int activeGroupPosition = activeGroupIndex();
 	removeAnimationForGroup(m_activeGroup);
 	m_activeGroup->setX(m_activeGroup->x() + xDiff);
 	int centerX = -m_activeGroup->left() - kGapBetweenGroups + m_activeGroup->x();
@@ -1375,24 +1383,13 @@ void CardWindowManager::slideAllGroupsOnTouchUpdate(int xOffset)
         return;
     }
 
-    m_activeGroup->setCardPositions(xOffset);
-
-    int activeGrpIndex = m_groups.indexOf(m_activeGroup);
-    int centerX = -m_activeGroup->left() - kGapBetweenGroups + xOffset;
-
-    for (int i = activeGrpIndex - 1; i >= 0; --i) {
-        centerX += -m_groups[i]->right();
-        m_groups[i]->setCardPositions(centerX);
-        centerX += -kGapBetweenGroups - m_groups[i]->left();
+    int activeGrpIndex = activeGroupIndex();
+    if (activeGrpIndex < 0) {
+        return;
     }
 
-    centerX = m_activeGroup->right() + kGapBetweenGroups + xOffset;
-
-    for (int i = activeGrpIndex + 1; i < m_groups.size(); ++i) {
-        centerX += m_groups[i]->left();
-        m_groups[i]->setCardPositions(centerX);
-        centerX += kGapBetweenGroups + m_groups[i]->right();
-    }
+    // only the groups on screen, and those whose fan changes, are touched
+    m_groupLayout.slide(m_groups, activeGrpIndex, xOffset);
 }
 
 bool CardWindowManager::handleTouchBegin(QTouchEvent *e)
@@ -1469,6 +1466,7 @@ void CardWindowManager::handleTouchUpdateMinimized(QTouchEvent* e)
         if (abs(delta.x()) > 0.866 * abs(delta.y())) {
             m_movement = MovementHLocked;
             m_activeGroupPivot = m_activeGroup->x();
+            m_groupLayout.reset();
         } else {
 			m_movement = MovementVLocked;
         }
@@ -1489,6 +1487,7 @@ void CardWindowManager::handleTouchUpdateMinimized(QTouchEvent* e)
                 slideAllGroups();
             } else {
                 m_activeGroupPivot = m_activeGroup->x();
+                m_groupLayout.reset();
             }
         }
 
@@ -1949,13 +1948,14 @@ void CardWindowManager::moveReorderSlotRight()
 	else if (m_activeGroup != m_groups.last() || m_activeGroup->size() > 1) {
 
 		CardWindow* activeWin = activeWindow();
-		int activeIndex = m_groups.indexOf(m_activeGroup);
+		int activeIndex = activeGroupIndex();
 		// yes, remove from the active group
 		m_activeGroup->removeFromGroup(activeWin);
 		if (m_activeGroup->empty()) {
 			// this was a temporarily created group.
 			// delete the temp group.
 			m_groups.remove(activeIndex);
+			m_groupLayout.reset();
 			delete m_activeGroup;
 
             newActiveGroup = m_groups[activeIndex];
@@ -2003,13 +2003,14 @@ void CardWindowManager::moveReorderSlotLeft()
 	else if (m_activeGroup != m_groups.first() || m_activeGroup->size() > 1) {
 
 		CardWindow* activeWin = activeWindow();
-		int activeIndex = m_groups.indexOf(m_activeGroup);
+		int activeIndex = activeGroupIndex();
 		// yes, remove from the active group
 		m_activeGroup->removeFromGroup(activeWin);
 		if (m_activeGroup->empty()) {
 			// this was a temporarily created group.
 			// delete the temp group
 			m_groups.remove(activeIndex);
+			m_groupLayout.reset();
 			delete m_activeGroup;
 
 			// the previous group is the new active group
@@ -2043,7 +2044,7 @@ void CardWindowManager::arrangeWindowsAfterReorderChange(int duration, QEasingCu
 	if (m_groups.empty() || !m_activeGroup)
 		return;
 
-	int activeGrpIndex = m_groups.indexOf(m_activeGroup);
+	int activeGrpIndex = activeGroupIndex();
 
 	clearAnimations();
 
@@ -2213,6 +2214,17 @@ CardGroup* CardWindowManager::groupClosestToCenterHorizontally() const
 	return grp;
 }
 
+int CardWindowManager::activeGroupIndex()
+{
+	// groups rarely move, so the last index is usually still right
+	if (m_activeGroupIndex < 0 || m_activeGroupIndex >= m_groups.size() ||
+		m_groups[m_activeGroupIndex] != m_activeGroup) {
+		m_activeGroupIndex = m_groups.indexOf(m_activeGroup);
+	}
+
+	return m_activeGroupIndex;
+}
+
 void CardWindowManager::setActiveGroup(CardGroup* group)
 {
 	m_activeGroup = group;
@@ -2229,7 +2241,7 @@ void CardWindowManager::switchToNextApp()
 
 	if (!m_activeGroup->makeNextCardActive()) {
 		// couldn't move, switch to the next group
-		int index = m_groups.indexOf(m_activeGroup);
+		int index = activeGroupIndex();
 		if (index < m_groups.size() - 1) {
 
 			m_activeGroup = m_groups[index + 1];
@@ -2252,7 +2264,7 @@ void CardWindowManager::switchToPrevApp()
 	if (!m_activeGroup->makePreviousCardActive()) {
 
 		// couldn't move, switch to the previous group
-		int index = m_groups.indexOf(m_activeGroup);
+		int index = activeGroupIndex();
 		if (index > 0) {
 
 			m_activeGroup = m_groups[index - 1];
@@ -2277,11 +2289,11 @@ void CardWindowManager::switchToNextGroup()
 		return;
 	}
 
-	int activeGroupIndex = m_groups.indexOf(m_activeGroup);
-	activeGroupIndex++;
-	activeGroupIndex = qMin(activeGroupIndex, m_groups.size() - 1);
+	int index = activeGroupIndex();
+	index++;
+	index = qMin(index, m_groups.size() - 1);
 
-	setActiveGroup(m_groups[activeGroupIndex]);
+	setActiveGroup(m_groups[index]);
 
 	slideAllGroups();
 }
@@ -2298,11 +2310,11 @@ void CardWindowManager::switchToPrevGroup()
 		return;
 	}
 
-	int activeGroupIndex = m_groups.indexOf(m_activeGroup);
-	activeGroupIndex--;
-	activeGroupIndex = qMax(activeGroupIndex, 0);
+	int index = activeGroupIndex();
+	index--;
+	index = qMax(index, 0);
 
-	setActiveGroup(m_groups[activeGroupIndex]);
+	setActiveGroup(m_groups[index]);
 
 	slideAllGroups();
 }
@@ -2360,7 +2372,7 @@ void CardWindowManager::switchToNextAppMaximized()
 		else {
 
 			// switch to the bottom card of the next group
-			int index = m_groups.indexOf(m_activeGroup);
+			int index = activeGroupIndex();
 			setActiveGroup(m_groups[index+1]);
 			m_activeGroup->makeBackCardActive();
 		}
@@ -2444,7 +2456,7 @@ void CardWindowManager::switchToPrevAppMaximized()
 		else {
 
 			// shift to the bottom card in the next group 
-			int index = m_groups.indexOf(m_activeGroup);
+			int index = activeGroupIndex();
 			setActiveGroup(m_groups[index-1]);
 			m_activeGroup->makeFrontCardActive();
 		}
@@ -2483,7 +2495,7 @@ void CardWindowManager::slideAllGroups(bool includeActiveCard)
 	if (m_groups.empty() || !m_activeGroup)
 		return;
 
-	int activeGrpIndex = m_groups.indexOf(m_activeGroup);
+	int activeGrpIndex = activeGroupIndex();
 
 	clearAnimations();
 
@@ -2545,7 +2557,7 @@ void CardWindowManager::slideAllGroupsTo(int xOffset)
 	if (m_groups.empty() || !m_activeGroup)
 		return;
 
-	int activeGrpIndex = m_groups.indexOf(m_activeGroup);
+	int activeGrpIndex = activeGroupIndex();
 
 	clearAnimations();
 
@@ -2608,7 +2620,7 @@ void CardWindowManager::layoutAllGroups(bool includeActiveCard)
 	if (m_groups.empty() || !m_activeGroup)
 		return;
 
-	int activeGrpIndex = m_groups.indexOf(m_activeGroup);
+	int activeGrpIndex = activeGroupIndex();
 
 	clearAnimations();
 
@@ -2638,7 +2650,7 @@ void CardWindowManager::slideToActiveCard()
 	if (m_groups.empty() || !m_activeGroup)
 		return;
 
-	int activeGrpIndex = m_groups.indexOf(m_activeGroup);
+	int activeGrpIndex = activeGroupIndex();
 
 	clearAnimations();
 
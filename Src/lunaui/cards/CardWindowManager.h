@@ -25,6 +25,7 @@
 #include "Common.h"
 
 #include "WindowManagerBase.h"
+#include "CardGroupLayout.h"
 
 #include <QStateMachine>
 #include <QGraphicsSceneMouseEvent>
@@ -228,6 +229,8 @@ private:
 	void slideToActiveCard();
 
 	void setActiveGroup(CardGroup* group);
+	// index of m_activeGroup in m_groups, -1 if none
+	int activeGroupIndex();
 
 	void disableCardRestoreToMaximized();
 	void restoreCardToMaximized();
@@ -278,6 +281,8 @@ private:
 
 	QVector<CardGroup*> m_groups;
 	CardGroup* m_activeGroup;
+	int m_activeGroupIndex;
+	CardGroupLayout<CardGroup> m_groupLayout;
 
 	QRect m_normalScreenBounds;
 	QRect m_targetPositiveSpace;
@@ -28,6 +28,7 @@
 #include "Localization.h"
 #include "DisplayManager.h"
 #include "WindowServer.h"
+#include "QmlComponentCache.h"
 
 #include <QGesture>
 #include <QCoreApplication>
@@ -71,10 +72,10 @@ DockModeClockWindow::DockModeClockWindow(const QPixmap& pixmap, DockModeWindowMa
 		QDeclarativeContext* context =	qmlEngine->rootContext();
 		Settings* settings = Settings::LunaSettings();
 		std::string systemMenuQmlPath = settings->lunaQmlUiComponentsPath + "DockModeTime/Clocks.qml";
-		QUrl url = QUrl::fromLocalFile(systemMenuQmlPath.c_str());
-		m_qmlNotifMenu = new QDeclarativeComponent(qmlEngine, url, this);
+		QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+		m_qmlNotifMenu = qmlCache->component(systemMenuQmlPath.c_str());
 		if(m_qmlNotifMenu) {
-			m_clockObject = qobject_cast<QGraphicsObject *>(m_qmlNotifMenu->create());
+			m_clockObject = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlNotifMenu));
 			if(m_clockObject) {
 				m_clockObject->setPos (boundingRect().x(), boundingRect().y());
 				m_clockObject->setParentItem(this);
@@ -51,6 +51,7 @@
 #include "DockModeLaunchPoint.h"
 #include "StatusBar.h"
 #include "WebosTapAndHoldGesture.h"
+#include "QmlComponentCache.h"
 
 static const int kTopLeftWindowIndex     = 0;
 static const int kTopRightWindowIndex    = 1;
@@ -113,10 +114,10 @@ void DockModeMenuManager::init()
 
 		Settings* settings = Settings::LunaSettings();
 		std::string systemMenuQmlPath = settings->lunaQmlUiComponentsPath + "DockModeAppMenu/DockModeAppMenu.qml";
-		QUrl url = QUrl::fromLocalFile(systemMenuQmlPath.c_str());
-		m_qmlNotifMenu = new QDeclarativeComponent(qmlEngine, url, this);
+		QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+		m_qmlNotifMenu = qmlCache->component(systemMenuQmlPath.c_str());
 		if(m_qmlNotifMenu) {
-			m_menuObject = qobject_cast<QGraphicsObject *>(m_qmlNotifMenu->create());
+			m_menuObject = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlNotifMenu));
 			if(m_menuObject) {
 				int offset = m_menuObject->property("edgeOffset").toInt();
 				m_menuObject->setPos (boundingRect().x() - offset, boundingRect().y() + Settings::LunaSettings()->positiveSpaceTopPadding);
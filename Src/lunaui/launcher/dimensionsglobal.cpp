@@ -422,5 +422,12 @@ QState* createFSMState(const QString& stateName,QState * parent)
 
 int qHash(const QUuid& q)
 {
-	return qHash(q.toString());
+	//hashed straight from the uuid fields; the icon and page indexes hit this on every touch move, so
+	// going through toString() (and a heap allocation) per lookup is not acceptable
+	uint h = q.data1 ^ (((uint)q.data2 << 16) | (uint)q.data3);
+	for (int i=0;i<8;++i)
+	{
+		h = (h << 5) + h + q.data4[i];
+	}
+	return (int)h;
 }
@@ -78,6 +78,7 @@
 #include "Localization.h"
 #include "QtUtils.h"
 #include "WindowServer.h"
+#include "QmlComponentCache.h"
 
 #if defined(TARGET_DEVICE)
 #include <FlickGesture.h>
@@ -1343,10 +1344,10 @@ void LauncherObject::fullSizeInit(quint32 width,quint32 height)
 	if(qmlEngine) {
 		QDeclarativeContext* context =	qmlEngine->rootContext();
 		QString qmlPath = StringTranslator::inputString(Settings::LunaSettings()->lunaQmlUiComponentsPath + "AppInfoDialog/AppInfoDialog.qml");
-		QUrl url = QUrl::fromLocalFile(qmlPath);
-		m_qmlAppInfoDialog = new QDeclarativeComponent(qmlEngine, url, this);
+		QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+		m_qmlAppInfoDialog = qmlCache->component(qmlPath);
 		if(m_qmlAppInfoDialog) {
-			m_appInfoDialog = qobject_cast<QGraphicsObject *>(m_qmlAppInfoDialog->create());
+			m_appInfoDialog = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlAppInfoDialog));
 			if(m_appInfoDialog) {
 				m_appInfoDialog->setAcceptTouchEvents(true);
 				m_appInfoDialog->setPos (-m_appInfoDialog->boundingRect().width()/2, -m_appInfoDialog->boundingRect().height()/2);
@@ -1360,7 +1361,6 @@ void LauncherObject::fullSizeInit(quint32 width,quint32 height)
 		}
 		else
 		{
-			delete m_qmlAppInfoDialog;
 			m_qmlAppInfoDialog = 0;
 		}
 	}
@@ -3867,8 +3867,8 @@ bool LauncherObject::processNewWebOSApp(DimensionsSystemInterface::WebOSApp * p_
 
 void LauncherObject::saveCurrentLauncherLayouts()
 {
-	qDebug() << __FUNCTION__ << ": trying to save Launcher state";
-	DimensionsSystemInterface::PageSaver::saveLauncher(this);
+	qDebug() << __FUNCTION__ << ": scheduling a save of the Launcher state";
+	DimensionsSystemInterface::PageSaver::scheduleSaveLauncher(this);
 }
 
 void LauncherObject::sendIconToQuickLaunchBar(IconBase * p_icon)
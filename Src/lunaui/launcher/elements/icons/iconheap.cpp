@@ -152,20 +152,20 @@ IconBase * IconHeap::copyIcon(const QUuid& iconUid)
 		return 0;
 	}
 	m_copyMapByUid.insert(pClone->uid(),IconWrapper(pClone->uid(),iw.appId,iw.launchPtId,pClone,iw.uid));
+	m_copiesByMasterUid.insert(iw.uid,pClone->uid());
 	return pClone;
 }
 
 QList<IconBase *> IconHeap::findCopies(const QUuid& masterUid)
 {
-	//TODO: SLOW
-
 	QList<IconBase *> rlist;
-	for (CopyMapIter it = m_copyMapByUid.begin();
-			it != m_copyMapByUid.end();++it)
+	for (CopiesByMasterIter it = m_copiesByMasterUid.find(masterUid);
+			(it != m_copiesByMasterUid.end()) && (it.key() == masterUid);++it)
 	{
-		if (it->copyOf == masterUid)
+		CopyMapIter f = m_copyMapByUid.find(it.value());
+		if (f != m_copyMapByUid.end())
 		{
-			rlist << it->pIcon;
+			rlist << f->pIcon;
 		}
 	}
 	return rlist;
@@ -274,6 +274,7 @@ void IconHeap::deleteIconCopy(const QUuid& copiedIconUid)
 		return;
 	}
 	m_copyMapByUid.remove(copiedIconUid);
+	m_copiesByMasterUid.remove(iw.copyOf,copiedIconUid);
 	delete iw.pIcon;
 }
 
@@ -26,10 +26,14 @@
 #include <QUuid>
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QMultiHash>
 #include <QPointer>
 #include <QList>
 #include <QSize>
 
+#include "dimensionsglobal.h"
+
 class PixmapObject;
 class IconBase;
 
@@ -170,17 +174,22 @@ private:
 	typedef QMap<CommonlyUsedImages::Enum,QPointer<PixmapObject> >::const_iterator CommonIconImageNameMapConstIter;
 	QMap<CommonlyUsedImages::Enum,QPointer<PixmapObject> > m_commonIconImagesMapById;
 
-	typedef QMap<QUuid,IconWrapper>::iterator MainMapIter;
-	QMap<QUuid,IconWrapper> m_mainMapByUid;
-	typedef QMap<QString,IconWrapper>::iterator AliasMapIter;
-	QMap<QString,IconWrapper> m_aliasMapByAppLaunchPointCombinedId;
+	//these are hit on every app install/remove and launch point update, and from the page layouts during reorders;
+	// nothing depends on their ordering so they are hashes rather than maps
+	typedef QHash<QUuid,IconWrapper>::iterator MainMapIter;
+	QHash<QUuid,IconWrapper> m_mainMapByUid;
+	typedef QHash<QString,IconWrapper>::iterator AliasMapIter;
+	QHash<QString,IconWrapper> m_aliasMapByAppLaunchPointCombinedId;
 
-	typedef QMap<QUuid,IconWrapper>::iterator CopyMapIter;
-	QMap<QUuid,IconWrapper> m_copyMapByUid;		//copies of the icons of the main map go here.
+	typedef QHash<QUuid,IconWrapper>::iterator CopyMapIter;
+	QHash<QUuid,IconWrapper> m_copyMapByUid;		//copies of the icons of the main map go here.
 												// it is the responsibility of the thing that requested the copy to maintain
 												// the uid handle to it so it can request it to be cleaned out later when no
 												// longer needed
 
+	typedef QMultiHash<QUuid,QUuid>::iterator CopiesByMasterIter;
+	QMultiHash<QUuid,QUuid> m_copiesByMasterUid;	//master uid -> uids of its copies in m_copyMapByUid (see findCopies())
+
 };
 
 #endif /* ICONHEAP_H_ */
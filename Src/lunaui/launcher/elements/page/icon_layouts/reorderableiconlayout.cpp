@@ -58,6 +58,7 @@ ReorderableIconLayout::ReorderableIconLayout(ReorderablePage * p_owner)
 , m_p_fsmStateReorderPending(0)
 , m_p_fsmStateTrackedFloating(0)
 , m_p_fsmStateReorderPendingAndTrackedFloating(0)
+, m_iconIndexDirty(false)
 {
 	m_maxIconsPerRow = IconLayoutSettings::settings()->reorderablelayout_maxIconsPerRow;
 	m_horizIconSpacingAdjust = IconLayoutSettings::settings()->reorderablelayout_iconHorizSpaceAdjustInPixels;
@@ -372,7 +373,9 @@ void ReorderableIconLayout::iconCellReleaseIcon(const QPoint& cellCoordinate)
 		return;	//no icon
 	}
 	pCell->resetIconPosition();
+	unindexCellAt(cellCoordinate);
 	pCell->m_qp_icon = 0;		//There'd better be another reference to it somewhere....
+	indexCellAt(cellCoordinate);
 }
 
 //virtual
@@ -563,56 +566,151 @@ bool ReorderableIconLayout::layoutCoordinateForGridCoordinate(const QPoint& grid
 //virtual
 IconCell * ReorderableIconLayout::findIconByUid(const QUuid& iconUid,QPoint& r_gridCoordinate,bool includePendingIconsInCells)
 {
-	int x = 0;
+	if (m_iconIndexDirty)
+	{
+		rebuildIconIndex();
+	}
+
+	bool staleHint = false;
+	IconIndexConstIter f = m_iconIndex.constFind(iconUid);
+	if (f != m_iconIndex.constEnd())
+	{
+		IconCell * pCell = iconCellAtGridCoordinate(f.value());
+		if (pCell && pCell->m_qp_icon && (pCell->m_qp_icon->uid() == iconUid))
+		{
+			r_gridCoordinate = f.value();
+			return pCell;
+		}
+		staleHint = true;
+	}
+
+	//a reorder commit (IconCell::commitPendingIcon) moves the pending icon into the cell's main icon, so the
+	// pending index is also where a committed icon will be
+	f = m_pendingIconIndex.constFind(iconUid);
+	if (f != m_pendingIconIndex.constEnd())
+	{
+		IconCell * pCell = iconCellAtGridCoordinate(f.value());
+		if (pCell && pCell->m_qp_icon && (pCell->m_qp_icon->uid() == iconUid))
+		{
+			r_gridCoordinate = f.value();
+			m_iconIndex.insert(iconUid,r_gridCoordinate);
+			m_pendingIconIndex.remove(iconUid);
+			return pCell;
+		}
+		if (pCell && pCell->m_qp_pendingReorderIcon && (pCell->m_qp_pendingReorderIcon->uid() == iconUid))
+		{
+			if (includePendingIconsInCells && !staleHint)
+			{
+				r_gridCoordinate = f.value();
+				return pCell;
+			}
+		}
+		else
+		{
+			staleHint = true;
+		}
+	}
+
+	if (!staleHint)
+	{
+		return 0;
+	}
+
+	//the index pointed somewhere that no longer holds the icon. This shouldn't happen with the maintenance done
+	// in the add/remove/reorder paths, but it's cheap insurance: rebuild everything and answer from the fresh index
+	rebuildIconIndex();
+	f = m_iconIndex.constFind(iconUid);
+	if (f != m_iconIndex.constEnd())
+	{
+		r_gridCoordinate = f.value();
+		return iconCellAtGridCoordinate(r_gridCoordinate);
+	}
+	if (includePendingIconsInCells)
+	{
+		f = m_pendingIconIndex.constFind(iconUid);
+		if (f != m_pendingIconIndex.constEnd())
+		{
+			r_gridCoordinate = f.value();
+			return iconCellAtGridCoordinate(r_gridCoordinate);
+		}
+	}
+	return 0;
+}
+
+//virtual
+bool ReorderableIconLayout::dbg_verifyIconIndex()
+{
+	if (m_iconIndexDirty)
+	{
+		//nothing to check against; it'll be rebuilt on the next lookup
+		return true;
+	}
+	//findIconByUid() repairs the index as it goes, so it can't be used here: every cell is checked against
+	// the hashes directly, for whether a lookup would resolve it without falling back to a rebuild
+	bool consistent = true;
+	const QPoint nowhere(-1,-1);
 	int y = 0;
-	//TODO: SLOW
 	for (IconRowIter it = m_iconRows.begin();
-			it != m_iconRows.end();++it,++y,x=0)
+			it != m_iconRows.end();++it,++y)
 	{
+		int x = 0;
 		for (IconRow::IconCellListIter cit = (*it)->m_iconList.begin();
 				cit != (*it)->m_iconList.end();++cit,++x)
 		{
+			QPoint here(x,y);
 			if ((*cit)->m_qp_icon)
 			{
-				if ((*cit)->m_qp_icon->uid() == iconUid)
+				//a stale main entry is passed over for the pending one, which is where a committed reorder left the icon
+				QUuid uid = (*cit)->m_qp_icon->uid();
+				if ((m_iconIndex.value(uid,nowhere) != here) && (m_pendingIconIndex.value(uid,nowhere) != here))
 				{
-					r_gridCoordinate = QPoint(x,y);
-					//qDebug() << __FUNCTION__ << " found icon on " << r_gridCoordinate;
-					return *cit;
+					qDebug() << __FUNCTION__ << ": icon " << uid << " is @" << here
+							<< " but the index has it @" << m_iconIndex.value(uid,nowhere)
+							<< " (pending @" << m_pendingIconIndex.value(uid,nowhere) << ")";
+					consistent = false;
+				}
+			}
+			if ((*cit)->m_qp_pendingReorderIcon)
+			{
+				//a main entry is looked at first; if it's stale, the lookup gives up on the pending one and rebuilds
+				QUuid uid = (*cit)->m_qp_pendingReorderIcon->uid();
+				bool resolves;
+				IconIndexConstIter f = m_iconIndex.constFind(uid);
+				if (f != m_iconIndex.constEnd())
+				{
+					IconCell * pCell = iconCellAtGridCoordinate(f.value());
+					resolves = pCell && pCell->m_qp_icon && (pCell->m_qp_icon->uid() == uid);
 				}
 				else
 				{
-					//qDebug() << __FUNCTION__ << " miss on " << QPoint(x,y) << " , uid there is: " << (*cit)->m_qp_icon->uid();
+					resolves = (m_pendingIconIndex.value(uid,nowhere) == here);
+				}
+				if (!resolves)
+				{
+					qDebug() << __FUNCTION__ << ": pending icon " << uid << " @" << here
+							<< " is not in the index";
+					consistent = false;
 				}
-			}
-			else
-			{
-				//qDebug() << __FUNCTION__ << " miss on " << QPoint(x,y) << " no icon there";
 			}
 		}
 	}
-	if (includePendingIconsInCells)
+	for (IconIndexConstIter it = m_iconIndex.constBegin();it != m_iconIndex.constEnd();++it)
 	{
-		x=0;
-		y=0;
-		for (IconRowIter it = m_iconRows.begin();
-				it != m_iconRows.end();++it,++y,x=0)
+		if (!iconCellAtGridCoordinate(it.value()))
 		{
-			for (IconRow::IconCellListIter cit = (*it)->m_iconList.begin();
-					cit != (*it)->m_iconList.end();++cit,++x)
-			{
-				if ((*cit)->m_qp_pendingReorderIcon)
-				{
-					if ((*cit)->m_qp_pendingReorderIcon->uid() == iconUid)
-					{
-						r_gridCoordinate = QPoint(x,y);
-						return *cit;
-					}
-				}
-			}
+			qDebug() << __FUNCTION__ << ": index entry for " << it.key() << " points outside the layout @" << it.value();
+			consistent = false;
 		}
 	}
-	return 0;
+	for (IconIndexConstIter it = m_pendingIconIndex.constBegin();it != m_pendingIconIndex.constEnd();++it)
+	{
+		if (!iconCellAtGridCoordinate(it.value()))
+		{
+			qDebug() << __FUNCTION__ << ": pending index entry for " << it.key() << " points outside the layout @" << it.value();
+			consistent = false;
+		}
+	}
+	return consistent;
 }
 
 //virtual
@@ -691,6 +789,12 @@ IconBase * ReorderableIconLayout::startTrackingIcon(const QPoint& gridCoord,bool
 	pIcon->setZValue(pIcon->zValue()+1.0);
 	pCell->m_qp_icon = 0;		//this will prevent it from redrawing as a part of this layout
 	pCell->m_qp_pendingReorderIcon = pIcon;		//..but it's still part of this cell until moved
+	IconIndex::iterator fi = m_iconIndex.find(pIcon->uid());
+	if ((fi != m_iconIndex.end()) && (fi.value() == gridCoord))
+	{
+		m_iconIndex.erase(fi);
+	}
+	m_pendingIconIndex.insert(pIcon->uid(),gridCoord);
 	return pIcon;
 }
 
@@ -748,6 +852,7 @@ IconBase * ReorderableIconLayout::startTrackingIconFromTransfer(const QPoint& gr
 	iconTracked->setZValue(iconTracked->zValue()+1.0);
 	pCell->m_qp_icon = 0;		//this will prevent it from redrawing as a part of this layout
 	pCell->m_qp_pendingReorderIcon = iconTracked;		//..but it's still part of this cell until moved
+	m_pendingIconIndex.insert(iconTracked->uid(),gridCoord);
 	return iconTracked;
 }
 
@@ -793,6 +898,7 @@ bool ReorderableIconLayout::trackedIconMovedTo(IconBase * p_icon,const QPoint& g
 			return false;
 		}
 		pDestCell->m_qp_pendingReorderIcon = p_icon;
+		m_pendingIconIndex.insert(p_icon->uid(),gridCoord);
 		return true;
 	}
 
@@ -808,6 +914,7 @@ bool ReorderableIconLayout::trackedIconMovedTo(IconBase * p_icon,const QPoint& g
 			return false;
 		}
 		pDestCell->m_qp_pendingReorderIcon = p_icon;
+		m_pendingIconIndex.insert(p_icon->uid(),gridCoord);
 		return true;
 	}
 	return false;
@@ -1218,6 +1325,10 @@ bool ReorderableIconLayout::initializePendingCellListFromOpList(QList<IconOperat
 		}
 		destinationCells.insert(pCellDestination);
 		pCellDestination->m_qp_pendingReorderIcon = pCellSource->m_qp_icon;
+		if (pCellSource->m_qp_icon)
+		{
+			m_pendingIconIndex.insert(pCellSource->m_qp_icon->uid(),QPoint(it->m_destinationColumn,it->m_destinationRow));
+		}
 	}
 	for (QSet<IconCell *>::iterator it = destinationCells.begin();
 			it != destinationCells.end();++it)
@@ -1378,6 +1489,7 @@ quint32 ReorderableIconLayout::addIcon(IconBase * p_icon)
 		IconRow * pNewRow = new IconRow(this);
 		pNewRow->appendCell(new IconCell(pNewRow,p_icon,m_iconCellSize));
 		m_iconRows.append(pNewRow);
+		indexCellAt(QPoint(0,0));
 		return 1;	//remember, returns row index +1
 	}
 
@@ -1392,6 +1504,7 @@ quint32 ReorderableIconLayout::addIcon(IconBase * p_icon)
 
 	//now pRow is a good row to add the icon to...do it
 	pRow->appendCell(new IconCell(pRow,p_icon,m_iconCellSize));
+	indexCellAt(QPoint(pRow->m_iconList.size()-1,m_iconRows.size()-1));
 	return (m_iconRows.size());		//size() == index of last() + 1
 }
 
@@ -1421,6 +1534,7 @@ quint32 ReorderableIconLayout::addIcon(IconCell * p_cell)
 		p_cell->m_p_layoutRowObject = pNewRow;
 		pNewRow->appendCell(p_cell);
 		m_iconRows.append(pNewRow);
+		indexCellAt(QPoint(0,0));
 		return 1;	//remember, returns row index +1
 	}
 
@@ -1440,6 +1554,7 @@ quint32 ReorderableIconLayout::addIcon(IconCell * p_cell)
 	//now pRow is a good row to add the icon to...do it
 	p_cell->m_p_layoutRowObject = pRow;
 	pRow->appendCell(p_cell);
+	indexCellAt(QPoint(pRow->m_iconList.size()-1,m_iconRows.size()-1));
 	return (m_iconRows.size());		//size() == index of last() + 1
 }
 
@@ -1511,6 +1626,8 @@ quint32 ReorderableIconLayout::addIconAt(IconBase * p_icon,const QPoint& gridCoo
 	//add the icon at the right place
 	IconRow * pRow = m_iconRows[gridCoordinate.y()];
 	pRow->m_iconList.insert(gridCoordinate.x(),new IconCell(pRow,p_icon,m_iconCellSize));
+	//everything to the right shifted by one
+	indexRowFrom(gridCoordinate.y(),gridCoordinate.x());
 	return (quint32)(gridCoordinate.y()+1);
 }
 
@@ -1544,6 +1661,8 @@ quint32 ReorderableIconLayout::addIconAt(IconCell * p_cell,const QPoint& gridCoo
 	//add the icon at the right place
 	IconRow * pRow = m_iconRows[gridCoordinate.y()];
 	pRow->m_iconList.insert(gridCoordinate.x(),p_cell);
+	//everything to the right shifted by one
+	indexRowFrom(gridCoordinate.y(),gridCoordinate.x());
 	return (quint32)(gridCoordinate.y()+1);
 }
 
@@ -1599,12 +1718,19 @@ bool ReorderableIconLayout::removeIconCell(const QPoint& gridCoordinate)
 	}
 
 	//ok, remove the cell
+	unindexCellAt(gridCoordinate);
 	pRow->removeCell(gridCoordinate.x());
 
 	if (pRow->m_iconList.empty())
 	{
 		m_iconRows.removeAt(gridCoordinate.y());
 		delete pRow;
+		//every row below moved up
+		invalidateIconIndex();
+	}
+	else
+	{
+		indexRowFrom(gridCoordinate.y(),gridCoordinate.x());
 	}
 
 	//signify that the layout is dirty and must be recomputed
@@ -1664,6 +1790,7 @@ void ReorderableIconLayout::initLayoutFromSequentialIconList(ReorderableIconLayo
 
 	/// START THE LAYOUT
 	layout.m_iconRows.clear();
+	layout.invalidateIconIndex();
 
 	for (IconListConstIter it = iconList.constBegin();
 			it != iconList.constEnd();++it)
@@ -1772,6 +1899,7 @@ void ReorderableIconLayout::destroyAllRows()
 		delete *it;
 	}
 	m_iconRows.clear();
+	invalidateIconIndex();
 	m_anchorRow = 0;
 	m_relayoutCount = 0;		//this could theoretically be preserved along with the anchor row #,
 								// to make relayouts on subtle resizes less jarring. But since currently most
@@ -1872,6 +2000,89 @@ void ReorderableIconLayout::relayoutExisting()
 
 }
 
+//virtual
+void ReorderableIconLayout::invalidateIconIndex()
+{
+	m_iconIndex.clear();
+	m_pendingIconIndex.clear();
+	m_iconIndexDirty = true;
+}
+
+//virtual
+void ReorderableIconLayout::rebuildIconIndex()
+{
+	m_iconIndex.clear();
+	m_pendingIconIndex.clear();
+	m_iconIndexDirty = false;
+	for (quint32 y = 0;y < (quint32)m_iconRows.size();++y)
+	{
+		indexRowFrom(y,0);
+	}
+}
+
+//virtual
+void ReorderableIconLayout::indexCellAt(const QPoint& gridCoordinate)
+{
+	if (m_iconIndexDirty)
+	{
+		return;		//will get picked up by the rebuild
+	}
+	IconCell * pCell = iconCellAtGridCoordinate(gridCoordinate);
+	if (!pCell)
+	{
+		return;
+	}
+	if (pCell->m_qp_icon)
+	{
+		m_iconIndex.insert(pCell->m_qp_icon->uid(),gridCoordinate);
+	}
+	if (pCell->m_qp_pendingReorderIcon)
+	{
+		m_pendingIconIndex.insert(pCell->m_qp_pendingReorderIcon->uid(),gridCoordinate);
+	}
+}
+
+//virtual
+void ReorderableIconLayout::indexRowFrom(const quint32 rowIndex,const quint32 fromColumn)
+{
+	if (m_iconIndexDirty || (rowIndex >= (quint32)m_iconRows.size()))
+	{
+		return;
+	}
+	quint32 numCells = (quint32)(m_iconRows[rowIndex]->m_iconList.size());
+	for (quint32 x = fromColumn;x < numCells;++x)
+	{
+		indexCellAt(QPoint(x,rowIndex));
+	}
+}
+
+//virtual
+void ReorderableIconLayout::unindexCellAt(const QPoint& gridCoordinate)
+{
+	IconCell * pCell = iconCellAtGridCoordinate(gridCoordinate);
+	if (!pCell)
+	{
+		return;
+	}
+	//only drop entries that actually point here; the same icon may legitimately be indexed elsewhere
+	if (pCell->m_qp_icon)
+	{
+		IconIndex::iterator f = m_iconIndex.find(pCell->m_qp_icon->uid());
+		if ((f != m_iconIndex.end()) && (f.value() == gridCoordinate))
+		{
+			m_iconIndex.erase(f);
+		}
+	}
+	if (pCell->m_qp_pendingReorderIcon)
+	{
+		IconIndex::iterator f = m_pendingIconIndex.find(pCell->m_qp_pendingReorderIcon->uid());
+		if ((f != m_pendingIconIndex.end()) && (f.value() == gridCoordinate))
+		{
+			m_pendingIconIndex.erase(f);
+		}
+	}
+}
+
 //////////////////////////////////////// TRACKING / REORDER STATE MACHINE (FSM) ////////////////////////////////////////////////////
 
 //helper
@@ -26,6 +26,7 @@
 #include <QString>
 #include <QDebug>
 #include <QMap>
+#include <QHash>
 #include <QPointer>
 #include <QUuid>
 
@@ -98,8 +99,13 @@ public:
 	virtual IconCell * iconCellAtGridCoordinate(const QPoint& gridCoordinate);
 	virtual bool layoutCoordinateForGridCoordinate(const QPoint& gridCoordinate,QPointF& r_layoutCoordinate);
 
+	//uses the icon index (see m_iconIndex below); constant time unless the index was invalidated by a row add/remove
 	virtual IconCell * findIconByUid(const QUuid& iconUid,QPoint& r_gridCoordinate,bool includePendingIconsInCells = false);
 
+	//DEBUG: walks every cell and checks it against the icon index, without touching the index. Returns false (and dumps
+	// the mismatches to qDebug) if a lookup of a cell's icon or pending icon would miss it or need a rebuild to find it
+	virtual bool dbg_verifyIconIndex();
+
 	// all the icon cells, starting with the leftmost cell of the top row, and ending with the rightmost cell in the bottom row
 	//WARNING: DO NOT HOLD REF TO ANYTHING FROM THE RETURN OF THIS FN. It could be invalidated at any time (whenever an add/remove or relayout happens)
 	virtual QList<IconCell *> iconCellsInFlowOrder();
@@ -287,6 +293,14 @@ protected:
 	virtual void switchIconToReorderGraphics(IconBase * p_icon);
 	virtual void switchIconToNormalGraphics(IconBase * p_icon);
 
+	//icon index maintenance. Anything that shifts cells between grid coordinates wholesale (row adds/removes, relayouts)
+	// just invalidates; the index is rebuilt lazily on the next lookup
+	virtual void invalidateIconIndex();
+	virtual void rebuildIconIndex();
+	virtual void indexCellAt(const QPoint& gridCoordinate);
+	virtual void indexRowFrom(const quint32 rowIndex,const quint32 fromColumn);
+	virtual void unindexCellAt(const QPoint& gridCoordinate);
+
 protected:
 
 	typedef QList<IconRow *> IconRowList;
@@ -336,6 +350,15 @@ protected:
 	QMap<QUuid,QPointer<IconReorderAnimation> > m_trackedIconAnimations;
 	QMap<QUuid,QPoint> 	m_trackedIconLastPosition;
 
+	// icon uid -> grid coordinate of the cell holding it. These are hints: every hit is checked against the cell
+	// before it is returned, and a failed check falls back to a full rebuild. m_pendingIconIndex tracks
+	// IconCell::m_qp_pendingReorderIcon, which is also where a committed reorder will have moved an icon to
+	typedef QHash<QUuid,QPoint> IconIndex;
+	typedef IconIndex::const_iterator IconIndexConstIter;
+	IconIndex m_iconIndex;
+	IconIndex m_pendingIconIndex;
+	bool m_iconIndexDirty;
+
 	static const char * ReorderFSMPropertyName_isConsistent;
 
 	QStateMachine * m_p_reorderFSM;
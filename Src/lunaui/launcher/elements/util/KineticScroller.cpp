@@ -41,6 +41,7 @@ static const int kFlickFilterTimeout = 100; // ms
 static const qreal sFlickScalar = 2225;
 static const qreal kMaxSpeed = 100;
 static const qreal kDefaultFriction = 8e-4;
+static const qreal kOverscrollSpring = 0.015; // 1/ms, the softest spring pulling back from overscroll
 
 static inline const qreal qInf()
 {
@@ -75,6 +76,9 @@ KineticScroller::KineticScroller(qreal minValue, qreal maxValue)
 	, m_sReferenceTime(0)
 	, m_sReferenceTime1(0)
 	, m_overScrollCorrectionStart(0)
+	, m_flickState(FlickNormal)
+	, m_flickVelocity(0)
+	, m_motionTime(0)
 	, m_BypassOverScrollInfo(false)
 	, m_OverScrollCorrectionInterrupted(false)
 
@@ -127,36 +131,17 @@ static qreal now()
 
 void KineticScroller::flickAnimationTick()
 {
-	qreal timeToCompletion,easeResult,endDistance,diffDistance,tCurTime = 0.0, velocityAtCurTime;
-	static qreal velocityAtCurTimeOld, frictionOpposingMotion, referenceVelocity, timeToZeroVelocity;
+	qreal timeToCompletion,easeResult,endDistance,diffDistance,tCurTime = 0.0;
 
 	switch (m_flickState) {
 		case FlickNormal:
 			// get current time.
 			tCurTime = Time::curTimeMs();
 
-			// if we are in overscroll, set the flag to be overscrolling and continue for sometime, before the overscrollcorrection kicks in.
+			// if we are in overscroll, carry on with the flick's velocity and let the spring bring us back.
 			if(true == inOverscroll()) {
 				if(false == m_BypassOverScrollInfo) {
-
-					// Update m_sReferenceTime also, so that we stay as close as possible to the currentOffset
-					m_sReferenceTime = tCurTime;
-
-					// we have been travelling from refTime to tCurTime with a starting velocity v and accleration m_friction. Compute the final velocity at this point.
-					// This is the initial velocity when we go in overscroll.
-					velocityAtCurTimeOld = m_v0 + (kDefaultFriction * (tCurTime - m_sReferenceTime));
-
-					// Store this for future computations.
-					referenceVelocity = velocityAtCurTimeOld;
-
-					// Set the initial value of friction opposing motion.
-					frictionOpposingMotion = kDefaultFriction * -direction(m_v0);
-
-					// with initial velocity as velocityAtCurTimeOld and deceleration as frictionOpposingMotion, compute how long we'll need to get to zero final velocity.
-					timeToZeroVelocity = referenceVelocity/-frictionOpposingMotion;
-
-					// set the state that we are going into overscroll.
-					m_flickState = FlickOverScroll;
+					startMotion(flickVelocityAt(tCurTime), FlickOverScroll);
 					return;
 				}
 			}
@@ -177,51 +162,9 @@ void KineticScroller::flickAnimationTick()
 			break;
 
 		case FlickOverScroll:
-
-			// get current time.
-			tCurTime = Time::curTimeMs();
-
-			// get the current position for subsequent use.
-			m_s0 = scrollOffset();
-
-			// save sp
-			m_sp = m_s0;
-
-			// distance we have travelled since the last tick, slow down by applying additional friction.
-			m_s1 = (referenceVelocity * timeToZeroVelocity) + (0.5 * timeToZeroVelocity * timeToZeroVelocity * frictionOpposingMotion) + m_s0;
-
-			// get the end velocity after travelling timeToZeroVelocity time units.
-			velocityAtCurTime = referenceVelocity + ( frictionOpposingMotion * (tCurTime - m_sReferenceTime1));
-
-			// if velocityAtCurTime and velocityAtCurTimeOld are of different signs, we are done overscrolling.
-			if(((velocityAtCurTimeOld < 0 && velocityAtCurTime >= 0) || (velocityAtCurTimeOld > 0 && velocityAtCurTime <= 0))) {
-				m_flickState = FlickOverscrollCorrection;
-				flickAnimationTick();
-				return;
-			}
-
-			// increase the friction for the next iteration.
-			frictionOpposingMotion += (frictionOpposingMotion * amountInOverscroll()/m_maxOverscroll);
-
-			// save the reference velocity for the next iteration
-			referenceVelocity = velocityAtCurTime;
-
-			// compute the new time to based on the increased friction and current velocity
-			timeToZeroVelocity = referenceVelocity/-frictionOpposingMotion;
-			break;
-
 		case FlickOverscrollCorrection:
-			stopFlickAnimation();
-			velocityAtCurTime = 0;
-			velocityAtCurTimeOld = 0;
-			frictionOpposingMotion = 0;
-			m_overScrollCorrectionStart = Time::curTimeMs();
-			m_flickOverscrollAnimation = new QPropertyAnimation(this, "scrollOffset");
-			m_flickOverscrollAnimation->setEasingCurve(QEasingCurve::OutCubic);
-			m_flickOverscrollAnimation->setStartValue(m_scrollOffset);
-			m_flickOverscrollAnimation->setEndValue(m_scrollOffset < m_minScroll ? m_minScroll : m_maxScroll);
-			m_flickOverscrollAnimation->setDuration(kOverScrollCorrectionTimeOut);
-			m_flickOverscrollAnimation->start(QAbstractAnimation::DeleteWhenStopped);
+		case FlickSettle:
+			motionTick();
 			return;
 		}
 
@@ -270,6 +213,61 @@ qreal KineticScroller::easingCubicCoEfficient(qreal index) const
 	return (index * index * index) + 1;
 }
 
+qreal KineticScroller::flickVelocityAt(qreal time) const
+{
+	if (m_tRegularScrollingTime <= 0)
+		return 0;
+
+	// derivative of the eased curve flickAnimationTick() follows
+	qreal index = qBound((qreal) 0.0, (time - m_sReferenceTime) / m_tRegularScrollingTime, (qreal) 1.0);
+	return (m_s1 - m_s0) * 3 * (1 - index) * (1 - index) / m_tRegularScrollingTime;
+}
+
+void KineticScroller::startMotion(qreal velocity, FlickState state)
+{
+	m_motion.setFriction(kDefaultFriction);
+	m_motion.setBounds(m_minScroll, m_maxScroll);
+	qreal overshoot = qMax((qreal) 1.0, m_maxOverscroll - amountInOverscroll());
+	m_motion.setSpring(qMax(kOverscrollSpring, MotionIntegrator::springForOvershoot(velocity, overshoot)));
+	m_motion.start(scrollOffset(), velocity);
+
+	m_motionTime = Time::curTimeMs();
+	m_flickState = state;
+	m_flickVelocity = velocity;
+	if (state == FlickOverscrollCorrection)
+		m_overScrollCorrectionStart = m_motionTime;
+
+	m_flickAnimationTimerActive = true;
+	if (!m_flickAnimationTimer.isActive())
+		m_flickAnimationTimer.start(10);
+}
+
+void KineticScroller::motionTick()
+{
+	// however late this tick is, the motion covers exactly the time that went by
+	qreal tCurTime = Time::curTimeMs();
+	bool moving = m_motion.advance(tCurTime - m_motionTime);
+	m_motionTime = tCurTime;
+	m_flickVelocity = m_motion.velocity();
+
+	// turned around: on the way back now
+	if (m_flickState == FlickOverScroll && direction(m_v0) * m_flickVelocity < 0) {
+		m_flickState = FlickOverscrollCorrection;
+		m_overScrollCorrectionStart = tCurTime;
+	}
+
+	setScrollOffset(m_motion.position());
+
+	if (!moving)
+		stopFlickAnimation();
+}
+
+void KineticScroller::stopSettling()
+{
+	if (m_flickState == FlickSettle && m_flickAnimationTimerActive)
+		stopFlickAnimation();
+}
+
 void KineticScroller::setMaxOverscroll(qreal overscroll)
 {
 	Q_ASSERT(overscroll >= 0);
@@ -298,22 +296,8 @@ void KineticScroller::overscrollTrigger()
 	if (!inOverscroll())
 		return;
 
-	delete m_overscrollAnimation;
-
-	qreal target = scrollOffset() < m_minScroll ? m_minScroll : m_maxScroll;
-	m_overscrollAnimation = new QPropertyAnimation(this, "scrollOffset");
-	m_overscrollAnimation->setEasingCurve(QEasingCurve::OutCubic);
-	m_overscrollAnimation->setDuration(500);
-	m_overscrollAnimation->setEndValue(target);
-	m_overscrollAnimation->start(QAbstractAnimation::DeleteWhenStopped);
-}
-
-void KineticScroller::flickTransitionToOverscroll()
-{
-	if (!m_flickOverscrollAnimation.isNull()) {
-		//qDebug() << "starting overscroll animation @" << qAbs(m_flickOverscrollAnimation->endValue().toReal() - m_flickOverscrollAnimation->startValue().toReal()) / m_flickOverscrollAnimation->duration() << "px/ms";
-		m_flickOverscrollAnimation->start(QAbstractAnimation::DeleteWhenStopped);
-	}
+	stopSettling();
+	startMotion(0, FlickSettle);
 }
 
 qreal KineticScroller::scrollOffset() const
@@ -371,8 +355,7 @@ void KineticScroller::handleFlick(qreal velocity)
 	}*/
 
 	//	qDebug() << "flick of" << velocity << "(" << (-velocity / sFlickScalar) << "adjusted)";
-	if (!m_overscrollAnimation.isNull())
-		m_overscrollAnimation->stop();
+	stopSettling();
 	m_overscroll.stop();
 	m_flickFilter.stop();
 
@@ -419,7 +402,6 @@ void KineticScroller::handleMouseUp()
 		m_flickFilter.stop();
 		stopFlickAnimation();
 		m_flickAnimation = NULL;
-		m_flickOverscrollAnimation = NULL;
 	}
 	if (!animatingFlick()) {
 		// TODO: make this an animation
@@ -521,9 +503,9 @@ void KineticScroller::checkUserActionOnOverscroll()
 {
 	if (!m_flickAnimation.isNull()) {
 		m_overscroll.stop();
-		delete m_overscrollAnimation;
+		stopSettling();
 	} else if (inOverscroll()) {
-		delete m_overscrollAnimation;
+		stopSettling();
 		m_overscroll.start();
 	}
 }
@@ -541,10 +523,6 @@ qreal KineticScroller::instantaneousVelocity() const
 		old_s0 = m_flickAnimation->startValue().toReal();
 		old_s1 = m_flickAnimation->endValue().toReal();
 		duration = m_flickAnimation->duration();
-	} else if (!m_flickOverscrollAnimation.isNull()) {
-		old_s0 = m_flickOverscrollAnimation->startValue().toReal();
-		old_s1 = m_flickOverscrollAnimation->endValue().toReal();
-		duration = m_flickOverscrollAnimation->duration();
 	} else {
 		return 0;
 	}
@@ -568,20 +546,20 @@ void KineticScroller::stopFlickAnimation()
 	m_flickFilter.stop();
 	m_previousVelocity = 0;
 	m_flickAnimationTimerActive = false;
+	m_motion.stop();
 
 	if (!m_flickAnimation.isNull()) {
 		m_flickAnimation->disconnect();
 		m_flickAnimation->stop();
 	}
-	if (!m_flickOverscrollAnimation.isNull()) {
-		m_flickOverscrollAnimation->disconnect();
-		m_flickOverscrollAnimation->stop();
-	}
 }
 
 bool KineticScroller::animatingFlick() const
 {
-	return m_flickAnimationTimerActive || m_flickAnimationTimer.isActive() || !m_flickAnimation.isNull() || !m_flickOverscrollAnimation.isNull();
+	// settling back after a drag is not a flick
+	if (m_flickState == FlickSettle)
+		return !m_flickAnimation.isNull();
+	return m_flickAnimationTimerActive || m_flickAnimationTimer.isActive() || !m_flickAnimation.isNull();
 }
 
 qreal KineticScroller::amountInOverscroll() const
@@ -597,9 +575,6 @@ qreal KineticScroller::amountInOverscroll() const
 void KineticScroller::stopImmediately() {
 
 	stopFlickAnimation();
-
-	if (!m_overscrollAnimation.isNull())
-		m_overscrollAnimation->stop();
 	m_overscroll.stop();
 
 }
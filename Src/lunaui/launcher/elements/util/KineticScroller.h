@@ -32,6 +32,8 @@
 
 #include <limits>
 
+#include "motionintegrator.h"
+
 QT_BEGIN_NAMESPACE
 class QPropertyAnimation;
 QT_END_NAMESPACE
@@ -69,7 +71,6 @@ public:
 private Q_SLOTS:
 	void flickAnimationTick();
 	void overscrollTrigger();
-	void flickTransitionToOverscroll();
 	void stopFlickAnimation();
 
 private:
@@ -77,6 +78,7 @@ private:
 		FlickNormal,
 		FlickOverScroll,
 		FlickOverscrollCorrection,
+		FlickSettle,				// back into bounds after a drag, not a flick
 	};
 
 	enum FlickDirection {
@@ -93,9 +95,13 @@ private:
 	bool inOverscroll() const;
 	bool inOverscroll(qreal scrollOffset) const;
 	void checkUserActionOnOverscroll();
+	void startMotion(qreal velocity, FlickState state);
+	void motionTick();
+	void stopSettling();
 
 	qreal amountInOverscroll() const;
 	qreal instantaneousVelocity() const;
+	qreal flickVelocityAt(qreal time) const;
 	qreal easingCubicCoEfficient(qreal index) const;
 
 	QTimer m_flickAnimationTimer;
@@ -111,8 +117,8 @@ private:
 	qreal m_previousVelocity;
 	qreal m_accumulatedScroll;
 	QPointer<QPropertyAnimation> m_flickAnimation;
-	QPointer<QPropertyAnimation> m_flickOverscrollAnimation;
-	QPointer<QPropertyAnimation> m_overscrollAnimation;
+	MotionIntegrator m_motion;		// overscroll, and the way back from it
+	qreal m_motionTime;
 	FlickDirection m_flickEventDirection;
 	FlickState m_flickState;
 	qreal m_flickVelocity;
@@ -185,6 +185,9 @@ OperationalSettings::OperationalSettings()
 , forceSaveOnHide(false)
 , usePreciseTimeForMasterSaveFileName(false)
 , useSingleMasterSaveFileName(true)
+, launcherSaveQuietPeriodMs(750)
+, saveLauncherInBackground(true)
+, useBinaryLauncherSaveFormat(true)
 , useApplicationManagerHiddenFlag(true)
 , useStagedRendering(true)
 , appKeywordsToPageDesignatorMapFilepath("/etc/palm/launcher3/app-keywords-to-designator-map.txt")
@@ -237,6 +240,9 @@ void OperationalSettings::readSettings(const char* filePath)
 	KEY_BOOLEAN("Main","ForceSaveOnHide",forceSaveOnHide);
 	KEY_BOOLEAN("Main","UsePreciseTimeForMasterFilename",usePreciseTimeForMasterSaveFileName);
 	KEY_BOOLEAN("Main","UseSingleMasterFilename",useSingleMasterSaveFileName);
+	KEY_UINTEGER("Main","LauncherSaveQuietPeriodMs",launcherSaveQuietPeriodMs);
+	KEY_BOOLEAN("Main","SaveLauncherInBackground",saveLauncherInBackground);
+	KEY_BOOLEAN("Main","UseBinaryLauncherSaveFormat",useBinaryLauncherSaveFormat);
 	KEY_BOOLEAN("Main","UseApplicationManagerHiddenFlag",useApplicationManagerHiddenFlag);
 	KEY_BOOLEAN("Main","UseStagedRendering",useStagedRendering);
 	KEY_QSTRING("Main","AppKeywordsToPageDesignatorMapFilepath",appKeywordsToPageDesignatorMapFilepath);
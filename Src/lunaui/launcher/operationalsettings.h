@@ -80,6 +80,22 @@ public:
 	// (default = true)
 	bool useSingleMasterSaveFileName;
 
+	// launcher layout saves are deferred until there have been no further changes for this long, and are then written out
+	// on a background thread (only the pages that actually changed). A reorder drag or an app install that touches several
+	// pages results in a single save this way
+	// (default = 750)
+	quint32 launcherSaveQuietPeriodMs;
+
+	// if false, every launcher layout change is saved right away, on the gui thread (the old behavior)
+	// (default = true)
+	bool saveLauncherInBackground;
+
+	// in addition to the INI master and page files, write a single binary image of the launcher layout
+	// (launcher_<x>.lbin, see LauncherBinarySave) and restore from it when it is present and valid. The INI files are still
+	// written and are used whenever the binary image is missing, corrupt, or from a different format version
+	// (default = true)
+	bool useBinaryLauncherSaveFormat;
+
 	// this will control whether the AppMonitor recognizes and respects the ApplicationManager's "hidden" flag.
 	// if 'true', then an app descriptor with hidden set will have the same effect as the blacklisting of the app id
 	// if 'false', the flag will be ignored and the app will get added to the launcher just like any other app
@@ -20,6 +20,7 @@
 
 
 #include "frictiontransform.h"
+#include "motionintegrator.h"
 
 #define DEFAULT_COEF_FSTATIC	0.6
 #define DEFAULT_COEF_FKINETIC	0.5
@@ -177,26 +178,18 @@ void FrictionTransform::vec(const qreal time,qreal& d,qreal& v, qreal& a)
 		return;
 	}
 
-	if (t > m_computedGrindToHaltTime)
+	qreal dist;
+	MotionIntegrator::friction(m_computedInitialVelocity,m_computedAccelKineticFriction,t,dist,v);
+	if (v <= 0.0)
 	{
 		v = 0.0;
 		a = 0.0;
 		d = m_computedFinalDisplacement;
 	}
-	else {
-		qreal t2 = t*t;
-		v = m_computedInitialVelocity - t*m_computedAccelKineticFriction;
-		if (v <= 0.0)
-		{
-			v = 0.0;
-			a = 0.0;
-			d = m_computedFinalDisplacement;
-		}
-		else
-		{
-			a = m_computedAccelKineticFriction;
-			d = m_initialDisplacement + m_reverse*(m_computedInitialVelocity*t - t2*a/2);
-		}
+	else
+	{
+		a = m_computedAccelKineticFriction;
+		d = m_initialDisplacement + m_reverse*dist;
 	}
 	update(t,d,v,a);
 }
@@ -251,9 +244,9 @@ void FrictionTransform::parametersChanged()
 	m_computedAccelKineticFriction = m_coeffFrictionKinetic*m_gravityAccel;
 	m_computedInitialVelocity = qMax((qreal)0.0,m_initialVelocity + (m_initialAcceleration - m_computedAccelStaticFriction)*m_forceMomentTime);
 	//compute where the discontinuity occurs, when velocity drops to 0
-	m_computedGrindToHaltTime = m_computedInitialVelocity / m_computedAccelKineticFriction;
-	m_computedFinalDisplacement = m_initialDisplacement + m_reverse*(m_computedInitialVelocity*m_computedGrindToHaltTime
-			- m_computedGrindToHaltTime*m_computedGrindToHaltTime*m_computedAccelKineticFriction/2);
+	m_computedGrindToHaltTime = MotionIntegrator::frictionTime(m_computedInitialVelocity,m_computedAccelKineticFriction);
+	m_computedFinalDisplacement = m_initialDisplacement
+			+ m_reverse*MotionIntegrator::frictionDistance(m_computedInitialVelocity,m_computedAccelKineticFriction);
 
 	//qDebug() << __FUNCTION__ << ": halt @ " << m_computedGrindToHaltTime << "(abs: " << m_computedGrindToHaltTime+m_startTime
 //			<< " ), initialDisplacement: " << m_initialDisplacement
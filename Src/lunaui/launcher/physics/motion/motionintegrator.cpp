@@ -0,0 +1,228 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "motionintegrator.h"
+
+#include <cmath>
+#include <limits>
+
+#define DEFAULT_FRICTION		8e-4		// px/ms^2
+#define DEFAULT_OMEGA			0.015		// 1/ms: about 350ms to settle from rest
+#define REST_DISTANCE			0.25		// px
+#define REST_VELOCITY			0.005		// px/ms
+
+static inline qreal sign(qreal x)
+{
+	return x < 0.0 ? -1.0 : 1.0;
+}
+
+MotionIntegrator::MotionIntegrator()
+: m_friction(DEFAULT_FRICTION)
+, m_omega(DEFAULT_OMEGA)
+, m_min(-std::numeric_limits<qreal>::infinity())
+, m_max(std::numeric_limits<qreal>::infinity())
+, m_moving(false)
+, m_position(0.0)
+, m_velocity(0.0)
+, m_remainder(0.0)
+, m_steps(0)
+{
+}
+
+void MotionIntegrator::setFriction(qreal deceleration)
+{
+	m_friction = qAbs(deceleration);
+}
+
+void MotionIntegrator::setSpring(qreal omega)
+{
+	if (omega > 0.0 && omega < std::numeric_limits<qreal>::infinity())
+		m_omega = omega;
+}
+
+void MotionIntegrator::setBounds(qreal minPosition, qreal maxPosition)
+{
+	m_min = minPosition;
+	m_max = qMax(minPosition, maxPosition);
+}
+
+void MotionIntegrator::start(qreal position, qreal velocity)
+{
+	m_position = position;
+	m_velocity = velocity;
+	m_remainder = 0.0;
+	m_steps = 0;
+	m_moving = true;
+}
+
+void MotionIntegrator::stop()
+{
+	m_velocity = 0.0;
+	m_remainder = 0.0;
+	m_moving = false;
+}
+
+bool MotionIntegrator::advance(qreal elapsedMs)
+{
+	if (!m_moving)
+		return false;
+
+	m_remainder += qMax((qreal) 0.0, elapsedMs);
+	while (m_moving && m_remainder >= kStepMs) {
+		m_moving = integrate(kStepMs, m_position, m_velocity);
+		m_remainder -= kStepMs;
+		m_steps++;
+	}
+
+	if (!m_moving)
+		stop();
+	return m_moving;
+}
+
+qreal MotionIntegrator::position() const
+{
+	// the same closed form as the next step, for the time it has used up so far
+	qreal position = m_position;
+	qreal velocity = m_velocity;
+	if (m_moving && m_remainder > 0.0)
+		integrate(m_remainder, position, velocity);
+	return position;
+}
+
+qreal MotionIntegrator::velocity() const
+{
+	qreal position = m_position;
+	qreal velocity = m_velocity;
+	if (m_moving && m_remainder > 0.0)
+		integrate(m_remainder, position, velocity);
+	return velocity;
+}
+
+bool MotionIntegrator::inBounds() const
+{
+	return inBounds(m_position);
+}
+
+bool MotionIntegrator::inBounds(qreal position) const
+{
+	return m_min <= position && position <= m_max;
+}
+
+bool MotionIntegrator::integrate(qreal dt, qreal& position, qreal& velocity) const
+{
+	if (inBounds(position)) {
+		if (velocity == 0.0)
+			return false;
+
+		qreal d, v;
+		friction(velocity, m_friction, dt, d, v);
+		if (inBounds(position + d)) {
+			position += d;
+			velocity = v;
+			// stopped short of the bounds: done
+			return velocity != 0.0;
+		}
+
+		// past a bound within dt: the spring takes over from where it was crossed
+		qreal bound = velocity < 0.0 ? m_min : m_max;
+		qreal t = crossingTime(velocity, m_friction, bound - position);
+		friction(velocity, m_friction, t, d, v);
+		qreal y;
+		spring(0.0, v, m_omega, dt - t, y, v);
+		position = bound + y;
+		velocity = v;
+		return true;
+	}
+
+	qreal bound = position < m_min ? m_min : m_max;
+	qreal y, v;
+	spring(position - bound, velocity, m_omega, dt, y, v);
+
+	if (qAbs(y) < REST_DISTANCE && qAbs(v) < REST_VELOCITY) {
+		position = bound;
+		velocity = 0.0;
+		return false;
+	}
+
+	position = bound + y;
+	velocity = v;
+	return true;
+}
+
+//static
+qreal MotionIntegrator::frictionTime(qreal v0, qreal deceleration)
+{
+	if (deceleration <= 0.0)
+		return std::numeric_limits<qreal>::infinity();
+	return qAbs(v0) / deceleration;
+}
+
+//static
+qreal MotionIntegrator::frictionDistance(qreal v0, qreal deceleration)
+{
+	if (deceleration <= 0.0)
+		return v0 == 0.0 ? 0.0 : sign(v0) * std::numeric_limits<qreal>::infinity();
+	return sign(v0) * v0 * v0 / (2 * deceleration);
+}
+
+//static
+qreal MotionIntegrator::crossingTime(qreal v0, qreal deceleration, qreal distance)
+{
+	// the first root of v0 t - sign(v0) deceleration t^2 / 2 = distance
+	qreal speed = qAbs(v0);
+	if (deceleration <= 0.0)
+		return qAbs(distance) / speed;
+	qreal root = speed * speed - 2 * deceleration * qAbs(distance);
+	return (speed - std::sqrt(qMax((qreal) 0.0, root))) / deceleration;
+}
+
+//static
+void MotionIntegrator::friction(qreal v0, qreal deceleration, qreal t, qreal& d, qreal& v)
+{
+	if (t >= frictionTime(v0, deceleration)) {
+		d = frictionDistance(v0, deceleration);
+		v = 0.0;
+		return;
+	}
+
+	qreal a = -sign(v0) * deceleration;
+	d = v0 * t + a * t * t / 2;
+	v = v0 + a * t;
+}
+
+//static
+void MotionIntegrator::spring(qreal y0, qreal v0, qreal omega, qreal t, qreal& y, qreal& v)
+{
+	// critically damped: y(t) = (y0 + (v0 + omega y0) t) e^(-omega t)
+	qreal e = std::exp(-omega * t);
+	qreal b = v0 + omega * y0;
+	y = (y0 + b * t) * e;
+	v = (b - omega * (y0 + b * t)) * e;
+}
+
+//static
+qreal MotionIntegrator::springForOvershoot(qreal v0, qreal maxOvershoot)
+{
+	// hit at v0 from its rest, the spring goes out by v0 / (omega e) at most
+	if (maxOvershoot <= 0.0)
+		return std::numeric_limits<qreal>::infinity();
+	return qAbs(v0) / (M_E * maxOvershoot);
+}
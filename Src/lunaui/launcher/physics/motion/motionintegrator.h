@@ -0,0 +1,95 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef MOTIONINTEGRATOR_H_
+#define MOTIONINTEGRATOR_H_
+
+#include <QtGlobal>
+
+/**
+ * Fixed timestep motion along one axis: friction while within bounds, and a critically
+ * damped spring pulling back to the bound when past it.
+ *
+ * advance() takes the real time elapsed since the last call and runs as many kStepMs
+ * steps as it covers, carrying the remainder over. Each step uses the closed form
+ * solution for its kStepMs, so where the motion goes depends only on the total time,
+ * not on how it was sliced into frames. position() and velocity() apply the same
+ * closed form to the remainder.
+ *
+ * Plain value type, no allocation: meant to live inside whatever it moves.
+ */
+class MotionIntegrator
+{
+public:
+
+	static const int kStepMs = 4;
+
+	MotionIntegrator();
+
+	// px/ms^2
+	void setFriction(qreal deceleration);
+	// 1/ms: the higher, the stiffer. A spring from rest settles in about 7 / omega
+	void setSpring(qreal omega);
+	void setBounds(qreal minPosition, qreal maxPosition);
+
+	void start(qreal position, qreal velocity);
+	void stop();
+
+	// false once the motion has come to rest
+	bool advance(qreal elapsedMs);
+
+	bool moving() const { return m_moving; }
+	qreal position() const;
+	qreal velocity() const;
+	bool inBounds() const;
+	int numSteps() const { return m_steps; }
+
+	// where friction alone stops something starting at v0, and when
+	static qreal frictionDistance(qreal v0, qreal deceleration);
+	static qreal frictionTime(qreal v0, qreal deceleration);
+
+	// t ms into the motion: under friction from v0, or on the spring from y0 off its rest
+	static void friction(qreal v0, qreal deceleration, qreal t, qreal& d, qreal& v);
+	static void spring(qreal y0, qreal v0, qreal omega, qreal t, qreal& y, qreal& v);
+
+	// the stiffness that keeps a spring hit at v0 within maxOvershoot of its rest
+	static qreal springForOvershoot(qreal v0, qreal maxOvershoot);
+
+private:
+
+	// dt ms on from position and velocity. False if that comes to rest
+	bool integrate(qreal dt, qreal& position, qreal& velocity) const;
+	bool inBounds(qreal position) const;
+	static qreal crossingTime(qreal v0, qreal deceleration, qreal distance);
+
+	qreal	m_friction;
+	qreal	m_omega;
+	qreal	m_min;
+	qreal	m_max;
+
+	bool	m_moving;
+	qreal	m_position;
+	qreal	m_velocity;
+	qreal	m_remainder;
+	int		m_steps;
+};
+
+#endif /* MOTIONINTEGRATOR_H_ */
@@ -0,0 +1,370 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "launcherbinarysave.h"
+#include "pagesaver.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include <glib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace DimensionsSystemInterface
+{
+
+quint32 LauncherBinarySave::FormatVersion = 2;
+
+static const quint32 kMagic = 0x4E49424C;		// "LBIN" when read as bytes on a little endian machine
+static const quint32 kNoString = 0xFFFFFFFF;
+
+//all fields are naturally aligned, so there is no padding in any of these
+struct BinHeader
+{
+	quint32 magic;
+	quint32 formatVersion;
+	quint32 saveSystemVersion;
+	quint32 headerSize;
+	quint64 timeStamp;
+	quint32 numPages;
+	quint32 numIcons;
+	quint32 numStrings;
+	quint32 pageTableOffset;
+	quint32 iconTableOffset;
+	quint32 stringIndexOffset;
+	quint32 stringDataOffset;
+	quint32 stringDataSize;
+	quint32 checksum;			//qChecksum() of everything after the header
+	quint32 reserved;
+	quint64 iniStamp;			//iniStamp() of the INI files when this was written
+};
+
+struct BinPage
+{
+	quint32 type;
+	quint32 name;
+	quint32 designator;
+	quint32 uid;
+	quint32 filepath;
+	qint32	pageIndex;
+	quint32 firstIcon;
+	quint32 numIcons;
+};
+
+struct BinIcon
+{
+	quint32 type;
+	quint32 id;
+	quint32 launchId;			//kNoString if the icon didn't have a launch point
+	qint32	launchType;
+};
+
+struct BinString
+{
+	quint32 offset;
+	quint32 length;
+};
+
+class StringTableBuilder
+{
+public:
+	quint32 add(const QString& s)
+	{
+		QHash<QString,quint32>::const_iterator f = m_indexes.constFind(s);
+		if (f != m_indexes.constEnd())
+		{
+			return f.value();
+		}
+		QByteArray utf8 = s.toUtf8();
+		BinString entry;
+		entry.offset = (quint32)m_data.size();
+		entry.length = (quint32)utf8.size();
+		m_data.append(utf8);
+		quint32 idx = (quint32)m_entries.size();
+		m_entries.append(entry);
+		m_indexes.insert(s,idx);
+		return idx;
+	}
+
+	QHash<QString,quint32> m_indexes;
+	QVector<BinString> m_entries;
+	QByteArray m_data;
+};
+
+template <typename T>
+static void appendRaw(QByteArray& r_buffer,const T& v)
+{
+	r_buffer.append((const char *)&v,sizeof(T));
+}
+
+//static
+QString LauncherBinarySave::filepathForMaster(const QString& masterFilepath)
+{
+	QString path = masterFilepath;
+	if (path.endsWith(QString(".msave")))
+	{
+		path.chop(6);
+	}
+	return path + QString(".lbin");
+}
+
+//FNV-1a, 64 bit
+static void hashBytes(quint64& r_hash,const void * pData,size_t size)
+{
+	const uchar * p = (const uchar *)pData;
+	for (size_t i=0;i<size;++i)
+	{
+		r_hash ^= p[i];
+		r_hash *= Q_UINT64_C(0x100000001b3);
+	}
+}
+
+static void hashFile(quint64& r_hash,const QString& filepath)
+{
+	quint64 fields[5] = { 0, 0, 0, 0, 0 };
+	struct stat st;
+	if (stat(QFile::encodeName(filepath).constData(),&st) == 0)
+	{
+		fields[0] = (quint64)st.st_dev;
+		fields[1] = (quint64)st.st_ino;
+		fields[2] = (quint64)st.st_size;
+		fields[3] = (quint64)st.st_mtim.tv_sec;
+		fields[4] = (quint64)st.st_mtim.tv_nsec;
+	}
+	//a missing file hashes as all zeros, which is different from any file that is there
+	hashBytes(r_hash,fields,sizeof(fields));
+}
+
+//static
+quint64 LauncherBinarySave::iniStamp(const QString& masterFilepath,const QList<PageSaveSnapshot>& pages)
+{
+	quint64 hash = Q_UINT64_C(0xcbf29ce484222325);
+	hashFile(hash,masterFilepath);
+	for (QList<PageSaveSnapshot>::const_iterator it = pages.constBegin();
+			it != pages.constEnd();++it)
+	{
+		hashFile(hash,it->filepath);
+	}
+	return hash;
+}
+
+//static
+bool LauncherBinarySave::write(const LauncherSaveSnapshot& launcher,const QString& filepath)
+{
+	StringTableBuilder strings;
+	QByteArray pageTable;
+	QByteArray iconTable;
+	quint32 numIcons = 0;
+
+	for (QList<PageSaveSnapshot>::const_iterator it = launcher.pages.constBegin();
+			it != launcher.pages.constEnd();++it)
+	{
+		BinPage page;
+		page.type = strings.add(it->pageType);
+		page.name = strings.add(it->pageName);
+		page.designator = strings.add(it->pageDesignator);
+		page.uid = strings.add(it->pageUid);
+		page.filepath = strings.add(it->filepath);
+		page.pageIndex = it->pageIndex;
+		page.firstIcon = numIcons;
+		page.numIcons = (quint32)it->icons.size();
+		appendRaw(pageTable,page);
+
+		for (QVector<PageSaveIconRecord>::const_iterator iit = it->icons.constBegin();
+				iit != it->icons.constEnd();++iit)
+		{
+			BinIcon icon;
+			icon.type = strings.add(iit->type);
+			icon.id = strings.add(iit->id);
+			icon.launchId = (iit->hasLaunchPoint ? strings.add(iit->launchId) : kNoString);
+			icon.launchType = iit->launchType;
+			appendRaw(iconTable,icon);
+		}
+		numIcons += page.numIcons;
+	}
+
+	BinHeader header;
+	memset(&header,0,sizeof(header));
+	header.magic = kMagic;
+	header.formatVersion = FormatVersion;
+	header.saveSystemVersion = PageSaver::saveSystemVersion();
+	header.headerSize = sizeof(BinHeader);
+	header.timeStamp = launcher.timeStamp;
+	header.iniStamp = iniStamp(launcher.masterFilepath,launcher.pages);
+	header.numPages = (quint32)launcher.pages.size();
+	header.numIcons = numIcons;
+	header.numStrings = (quint32)strings.m_entries.size();
+	header.pageTableOffset = sizeof(BinHeader);
+	header.iconTableOffset = header.pageTableOffset + (quint32)pageTable.size();
+	header.stringIndexOffset = header.iconTableOffset + (quint32)iconTable.size();
+	header.stringDataOffset = header.stringIndexOffset + header.numStrings * sizeof(BinString);
+	header.stringDataSize = (quint32)strings.m_data.size();
+
+	QByteArray body;
+	body.reserve(header.stringDataOffset + header.stringDataSize - sizeof(BinHeader));
+	body.append(pageTable);
+	body.append(iconTable);
+	body.append((const char *)strings.m_entries.constData(),strings.m_entries.size() * sizeof(BinString));
+	body.append(strings.m_data);
+	header.checksum = qChecksum(body.constData(),body.size());
+
+	//same directory as the target, so the rename below is atomic
+	QString tempFilepath = filepath + QString(".tmp");
+	QFile file(tempFilepath);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		g_warning("%s: unable to open [%s] for writing",__FUNCTION__,qPrintable(tempFilepath));
+		return false;
+	}
+	bool ok = (file.write((const char *)&header,sizeof(header)) == (qint64)sizeof(header))
+				&& (file.write(body) == (qint64)body.size())
+				&& file.flush();
+	if (ok)
+	{
+		(void)fsync(file.handle());
+	}
+	file.close();
+
+	if ((!ok) || (rename(QFile::encodeName(tempFilepath).constData(),QFile::encodeName(filepath).constData()) != 0))
+	{
+		g_warning("%s: writing [%s] failed",__FUNCTION__,qPrintable(filepath));
+		QFile::remove(tempFilepath);
+		return false;
+	}
+	return true;
+}
+
+//static
+bool LauncherBinarySave::read(const QString& filepath,LauncherSaveSnapshot& r_launcher,quint64 * r_iniStamp)
+{
+	QFile file(filepath);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+	qint64 fileSize = file.size();
+	if ((fileSize < (qint64)sizeof(BinHeader)) || (fileSize > (qint64)0x7FFFFFFF))
+	{
+		return false;
+	}
+	const uchar * pBase = file.map(0,fileSize);
+	if (!pBase)
+	{
+		return false;
+	}
+
+	//the mapping goes away with 'file', on every return path
+	const BinHeader * pHeader = (const BinHeader *)pBase;
+	const quint64 size = (quint64)fileSize;
+	if ((pHeader->magic != kMagic)
+		|| (pHeader->formatVersion != FormatVersion)
+		|| (pHeader->saveSystemVersion != PageSaver::saveSystemVersion())
+		|| (pHeader->headerSize != sizeof(BinHeader))
+		|| (pHeader->pageTableOffset + (quint64)pHeader->numPages * sizeof(BinPage) > size)
+		|| (pHeader->iconTableOffset + (quint64)pHeader->numIcons * sizeof(BinIcon) > size)
+		|| (pHeader->stringIndexOffset + (quint64)pHeader->numStrings * sizeof(BinString) > size)
+		|| ((quint64)pHeader->stringDataOffset + pHeader->stringDataSize != size)
+		|| ((pHeader->pageTableOffset % 4) || (pHeader->iconTableOffset % 4) || (pHeader->stringIndexOffset % 4)))
+	{
+		g_warning("%s: [%s] is not a usable launcher save file",__FUNCTION__,qPrintable(filepath));
+		return false;
+	}
+	if (qChecksum((const char *)(pBase + sizeof(BinHeader)),(uint)(size - sizeof(BinHeader))) != pHeader->checksum)
+	{
+		g_warning("%s: [%s] is corrupt (checksum mismatch)",__FUNCTION__,qPrintable(filepath));
+		return false;
+	}
+
+	//decode every distinct string once; the records below only copy (share) them
+	const BinString * pStringIndex = (const BinString *)(pBase + pHeader->stringIndexOffset);
+	const char * pStringData = (const char *)(pBase + pHeader->stringDataOffset);
+	QVector<QString> strings(pHeader->numStrings);
+	for (quint32 i=0;i<pHeader->numStrings;++i)
+	{
+		if ((quint64)pStringIndex[i].offset + pStringIndex[i].length > pHeader->stringDataSize)
+		{
+			return false;
+		}
+		strings[i] = QString::fromUtf8(pStringData + pStringIndex[i].offset,pStringIndex[i].length);
+	}
+	const quint32 numStrings = pHeader->numStrings;
+
+	const BinPage * pPages = (const BinPage *)(pBase + pHeader->pageTableOffset);
+	const BinIcon * pIcons = (const BinIcon *)(pBase + pHeader->iconTableOffset);
+
+	r_launcher.masterFilepath = QString();
+	r_launcher.timeStamp = pHeader->timeStamp;
+	if (r_iniStamp)
+	{
+		*r_iniStamp = pHeader->iniStamp;
+	}
+	r_launcher.pages.clear();
+	r_launcher.pages.reserve(pHeader->numPages);
+	for (quint32 p=0;p<pHeader->numPages;++p)
+	{
+		const BinPage& binPage = pPages[p];
+		if ((binPage.type >= numStrings) || (binPage.name >= numStrings) || (binPage.designator >= numStrings)
+			|| (binPage.uid >= numStrings) || (binPage.filepath >= numStrings)
+			|| ((quint64)binPage.firstIcon + binPage.numIcons > pHeader->numIcons))
+		{
+			r_launcher.pages.clear();
+			return false;
+		}
+		r_launcher.pages << PageSaveSnapshot();
+		PageSaveSnapshot& page = r_launcher.pages.last();
+		page.pageType = strings[binPage.type];
+		page.pageName = strings[binPage.name];
+		page.pageDesignator = strings[binPage.designator];
+		page.pageUid = strings[binPage.uid];
+		page.filepath = strings[binPage.filepath];
+		page.pageIndex = binPage.pageIndex;
+		page.icons.resize(binPage.numIcons);
+
+		PageSaveIconRecord * pOut = page.icons.data();
+		for (quint32 i=0;i<binPage.numIcons;++i)
+		{
+			const BinIcon& binIcon = pIcons[binPage.firstIcon+i];
+			if ((binIcon.type >= numStrings) || (binIcon.id >= numStrings)
+				|| ((binIcon.launchId != kNoString) && (binIcon.launchId >= numStrings)))
+			{
+				r_launcher.pages.clear();
+				return false;
+			}
+			pOut[i].type = strings[binIcon.type];
+			pOut[i].id = strings[binIcon.id];
+			pOut[i].hasLaunchPoint = (binIcon.launchId != kNoString);
+			pOut[i].launchType = binIcon.launchType;
+			if (pOut[i].hasLaunchPoint)
+			{
+				pOut[i].launchId = strings[binIcon.launchId];
+			}
+		}
+	}
+	return true;
+}
+
+} //end namespace
@@ -0,0 +1,76 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef LAUNCHERBINARYSAVE_H_
+#define LAUNCHERBINARYSAVE_H_
+
+#include <QString>
+
+#include "pagesavequeue.h"
+
+namespace DimensionsSystemInterface
+{
+
+/*
+ * A single-file binary image of the whole launcher (master + all pages), kept next to the INI master file
+ * (launcher_<x>.msave -> launcher_<x>.lbin). It is written from the same snapshot as the INI files, and read
+ * in preference to them at restore time; the INI files stay the fallback (and the format for older builds).
+ *
+ * Layout (native byte order; a mismatch in the magic number makes the file be rejected):
+ *
+ *	header			fixed size, see launcherbinarysave.cpp
+ *	page table		numPages fixed-size page records; each refers to a [firstIcon,firstIcon+numIcons) range of the icon table
+ *	icon table		numIcons fixed-size icon records
+ *	string index	numStrings (offset,length) pairs into the string data
+ *	string data		UTF-8, each distinct string stored once
+ *
+ * All strings in the records are indexes into the string index. The reader maps the file, validates every offset
+ * and index against the file size, decodes each distinct string once, and then fills in the snapshot in a single
+ * pass over the records.
+ *
+ * The INI files stay the master copy: anything may (re)write them without knowing about the image (BackupManager's
+ * restore, an older build). So the header carries a stamp of the INI files as they were when the image was written,
+ * and the image only stands in for them while the stamp still matches.
+ *
+ */
+class LauncherBinarySave
+{
+public:
+
+	//bump when the layout changes. Files with a different format version, or with a different PageSaver::SaveSystemVersion,
+	// are ignored and the INI files are used instead
+	static quint32 FormatVersion;
+
+	static QString filepathForMaster(const QString& masterFilepath);
+
+	//writes to a temp file in the same directory and renames it over filepath. The INI files of the snapshot
+	// should be on disk already: they are what the image gets stamped with
+	static bool write(const LauncherSaveSnapshot& launcher,const QString& filepath);
+	static bool read(const QString& filepath,LauncherSaveSnapshot& r_launcher,quint64 * r_iniStamp = 0);
+
+	//device, inode, size and modification time of the master and page files. The safe file ops replace a file by
+	// renaming a new one over it, so any rewrite changes the stamp, even within the same second
+	static quint64 iniStamp(const QString& masterFilepath,const QList<PageSaveSnapshot>& pages);
+};
+
+} //end namespace
+
+#endif /* LAUNCHERBINARYSAVE_H_ */
@@ -27,6 +27,7 @@
 #include "webosapp.h"
 #include "reorderablepage.h"
 #include "operationalsettings.h"
+#include "launcherbinarysave.h"
 
 #include <QDir>
 #include <QFileInfoList>
@@ -37,6 +38,7 @@
 #include "ApplicationDescription.h"
 
 #include <cjson/json.h>
+#include <glib.h>
 
 ////public:
 namespace DimensionsSystemInterface
@@ -54,11 +56,102 @@ PageRestore::~PageRestore()
 
 //static
 QList<QVariantMap> PageRestore::restoreLauncher(const QString& masterSaveFilepath)
+{
+	LauncherSaveSnapshot launcher;
+	if (!readLauncherSave(masterSaveFilepath,launcher))
+	{
+		return QList<QVariantMap>();
+	}
+	return restoreLauncherFromSnapshot(launcher);
+}
+
+//static
+QVariantMap PageRestore::restoreQuickLaunch(const QString& quicklaunchSaveFilepath)
+{
+	return (processQuicklaunchFile(quicklaunchSaveFilepath));
+}
+
+//static
+QVariantMap PageRestore::restorePage(const QString& pageSaveFilepath)
+{
+	PageSaveSnapshot page;
+	if (!readPageIni(pageSaveFilepath,page))
+	{
+		return QVariantMap();
+	}
+
+	QVariantMap rmap;
+	rmap[PageSaver::SaveTagKey_PageType] = page.pageType;
+	if (!page.pageName.isEmpty())
+	{
+		rmap[PageSaver::SaveTagKey_PageName] = page.pageName;
+	}
+	if (!page.pageDesignator.isEmpty())
+	{
+		rmap[PageSaver::SaveTagKey_PageDesignator] = page.pageDesignator;
+	}
+	if (!page.pageUid.isEmpty())
+	{
+		rmap[PageSaver::SaveTagKey_PageUid] = page.pageUid;
+	}
+
+	QList<WebOSAppRestoreObject> restoreObjectList = restoreReorderablePage(page);
+	if (restoreObjectList.isEmpty())
+	{
+		return rmap;
+	}
+
+	QVariant appListV;
+	appListV.setValue(restoreObjectList);
+	rmap[PageSaver::SaveTagKey_PageRestoreObjectList] = appListV;
+
+	return rmap;
+}
+
+//static
+bool PageRestore::readLauncherSave(const QString& masterSaveFilepath,LauncherSaveSnapshot& r_launcher)
+{
+	if (masterSaveFilepath.isEmpty())
+	{
+		return false;
+	}
+	QString binaryFilepath = LauncherBinarySave::filepathForMaster(masterSaveFilepath);
+	if (OperationalSettings::settings()->useBinaryLauncherSaveFormat)
+	{
+		quint64 stamp = 0;
+		if (LauncherBinarySave::read(binaryFilepath,r_launcher,&stamp) && (!r_launcher.pages.isEmpty()))
+		{
+			//the INI files are the master copy; if anything rewrote them since (e.g. a backup restore), the image is stale
+			if (stamp == LauncherBinarySave::iniStamp(masterSaveFilepath,r_launcher.pages))
+			{
+				r_launcher.masterFilepath = masterSaveFilepath;
+				return true;
+			}
+			g_message("%s: the INI files changed since [%s] was written",__FUNCTION__,qPrintable(binaryFilepath));
+		}
+	}
+
+	if (!readLauncherIni(masterSaveFilepath,r_launcher))
+	{
+		return false;
+	}
+
+	if (OperationalSettings::settings()->useBinaryLauncherSaveFormat)
+	{
+		//first boot on this format, or the image was bad; either way, the INI files just read are the current state
+		g_message("%s: (re)creating the binary launcher save [%s] from the INI files",__FUNCTION__,qPrintable(binaryFilepath));
+		(void)LauncherBinarySave::write(r_launcher,binaryFilepath);
+	}
+	return true;
+}
+
+//static
+bool PageRestore::readLauncherIni(const QString& masterSaveFilepath,LauncherSaveSnapshot& r_launcher)
 {
 	QList<QVariantMap> pageInfoList = processMasterFile(masterSaveFilepath);
 	if (pageInfoList.isEmpty())
 	{
-		return QList<QVariantMap>();
+		return false;
 	}
 
 	/*
@@ -67,42 +160,31 @@ QList<QVariantMap> PageRestore::restoreLauncher(const QString& masterSaveFilepat
 	map[PageSaver::SaveTagKey_PageIndex] = pageIndex;
 	*/
 
-	for (QList<QVariantMap>::iterator it = pageInfoList.begin();
-			it != pageInfoList.end();++it)
+	r_launcher.masterFilepath = masterSaveFilepath;
+	r_launcher.pages.clear();
+	for (QList<QVariantMap>::const_iterator it = pageInfoList.constBegin();
+			it != pageInfoList.constEnd();++it)
 	{
-		QVariantMap pageMap = restorePage(it->value(PageSaver::SaveTagKey_PageFile,QString("")).toString());
-		if (pageMap.isEmpty())
+		PageSaveSnapshot page;
+		if (!readPageIni(it->value(PageSaver::SaveTagKey_PageFile,QString("")).toString(),page))
 		{
-			continue;
+			//keep the entry, as before, just without any content
+			page = PageSaveSnapshot();
 		}
-
-		/*
-		 * rmap[PageSaver::SaveTagKey_PageType]
-		 * rmap[PageSaver::SaveTagKey_PageName]
-		 * rmap[PageSaver::SaveTagKey_PageDesignator]
-		 * rmap[PageSaver::SaveTagKey_PageUuid]
-		 * rmap[PageSaver::SaveTagKey_PageAppUidList]
-		 */
-		it->insert(PageSaver::SaveTagKey_PageRestoreObjectList,pageMap.value(PageSaver::SaveTagKey_PageRestoreObjectList));
-		it->insert(PageSaver::SaveTagKey_PageName,pageMap.value(PageSaver::SaveTagKey_PageName));
-		it->insert(PageSaver::SaveTagKey_PageDesignator,pageMap.value(PageSaver::SaveTagKey_PageDesignator));
-		it->insert(PageSaver::SaveTagKey_PageUid,pageMap.value(PageSaver::SaveTagKey_PageUid));
+		page.pageType = it->value(PageSaver::SaveTagKey_PageType).toString();
+		page.filepath = it->value(PageSaver::SaveTagKey_PageFile).toString();
+		page.pageIndex = it->value(PageSaver::SaveTagKey_PageIndex).toInt();
+		r_launcher.pages << page;
 	}
-	return pageInfoList;
-}
-
-//static
-QVariantMap PageRestore::restoreQuickLaunch(const QString& quicklaunchSaveFilepath)
-{
-	return (processQuicklaunchFile(quicklaunchSaveFilepath));
+	return true;
 }
 
 //static
-QVariantMap PageRestore::restorePage(const QString& pageSaveFilepath)
+bool PageRestore::readPageIni(const QString& pageSaveFilepath,PageSaveSnapshot& r_page)
 {
 	if (pageSaveFilepath.isEmpty())
 	{
-		return QVariantMap();
+		return false;
 	}
 	SafeFileOperator safesave(SafeFileOperator::Read,pageSaveFilepath,QSettings::IniFormat);
 	QSettings& settings = safesave.safeSettings();
@@ -110,50 +192,69 @@ QVariantMap PageRestore::restorePage(const QString& pageSaveFilepath)
 	if (settings.status() != QSettings::NoError)
 	{
 		//problem with the file op
-		return QVariantMap();
+		return false;
 	}
 
 	//check the page type...
 
 	settings.beginGroup("header");
-	QString pageType = settings.value(PageSaver::SaveTagKey_PageType,QString("")).toString();
-	QString pageName = settings.value(PageSaver::SaveTagKey_PageName,QString("")).toString();
-	QString pageDesignator = settings.value(PageSaver::SaveTagKey_PageDesignator,QString("")).toString();
-	QString pageUid = settings.value(PageSaver::SaveTagKey_PageUid,QString("")).toString();
+	r_page.pageType = settings.value(PageSaver::SaveTagKey_PageType,QString("")).toString();
+	r_page.pageName = settings.value(PageSaver::SaveTagKey_PageName,QString("")).toString();
+	r_page.pageDesignator = settings.value(PageSaver::SaveTagKey_PageDesignator,QString("")).toString();
+	r_page.pageUid = settings.value(PageSaver::SaveTagKey_PageUid,QString("")).toString();
 	settings.endGroup();
 
-	if (pageType != QString(ReorderablePage::staticMetaObject.className()))
+	if (r_page.pageType != QString(ReorderablePage::staticMetaObject.className()))
 	{
 		//TODO: the ReorderablePage assumption...
-		return QVariantMap();
+		return false;
 	}
 
-	QVariantMap rmap;
-	rmap[PageSaver::SaveTagKey_PageType] = pageType;
-	if (!pageName.isEmpty())
-	{
-		rmap[PageSaver::SaveTagKey_PageName] = pageName;
-	}
-	if (!pageDesignator.isEmpty())
-	{
-		rmap[PageSaver::SaveTagKey_PageDesignator] = pageDesignator;
-	}
-	if (!pageUid.isEmpty())
-	{
-		rmap[PageSaver::SaveTagKey_PageUid] = pageUid;
-	}
+	r_page.filepath = pageSaveFilepath;
+	readReorderablePageIcons(settings,r_page.icons);
+	return true;
+}
 
-	QList<WebOSAppRestoreObject> restoreObjectList = restoreReorderablePage(settings,pageUid);
-	if (restoreObjectList.isEmpty())
+//static
+QList<QVariantMap> PageRestore::restoreLauncherFromSnapshot(const LauncherSaveSnapshot& launcher)
+{
+	QList<QVariantMap> rlist;
+	for (QList<PageSaveSnapshot>::const_iterator it = launcher.pages.constBegin();
+			it != launcher.pages.constEnd();++it)
 	{
-		return rmap;
-	}
+		if ((it->pageType != QString(ReorderablePage::staticMetaObject.className()))
+			|| (it->filepath.isEmpty()))
+		{
+			continue;
+		}
 
-	QVariant appListV;
-	appListV.setValue(restoreObjectList);
-	rmap[PageSaver::SaveTagKey_PageRestoreObjectList] = appListV;
+		/*
+		 * map[PageSaver::SaveTagKey_PageType]
+		 * map[PageSaver::SaveTagKey_PageFile]
+		 * map[PageSaver::SaveTagKey_PageIndex]
+		 * map[PageSaver::SaveTagKey_PageRestoreObjectList]
+		 * map[PageSaver::SaveTagKey_PageName]
+		 * map[PageSaver::SaveTagKey_PageDesignator]
+		 * map[PageSaver::SaveTagKey_PageUid]
+		 */
+		QVariantMap map;
+		map[PageSaver::SaveTagKey_PageType] = it->pageType;
+		map[PageSaver::SaveTagKey_PageFile] = it->filepath;
+		map[PageSaver::SaveTagKey_PageIndex] = it->pageIndex;
 
-	return rmap;
+		QList<WebOSAppRestoreObject> restoreObjectList = restoreReorderablePage(*it);
+		QVariant appListV;
+		if (!restoreObjectList.isEmpty())
+		{
+			appListV.setValue(restoreObjectList);
+		}
+		map[PageSaver::SaveTagKey_PageRestoreObjectList] = appListV;
+		map[PageSaver::SaveTagKey_PageName] = (it->pageName.isEmpty() ? QVariant() : QVariant(it->pageName));
+		map[PageSaver::SaveTagKey_PageDesignator] = (it->pageDesignator.isEmpty() ? QVariant() : QVariant(it->pageDesignator));
+		map[PageSaver::SaveTagKey_PageUid] = (it->pageUid.isEmpty() ? QVariant() : QVariant(it->pageUid));
+		rlist << map;
+	}
+	return rlist;
 }
 
 //static
@@ -893,28 +994,42 @@ QList<QPair<QString,QList<QString> > > PageRestore::loadStaticLegacyLauncherConf
 ////protected:
 
 //static
-QList<WebOSAppRestoreObject> PageRestore::restoreReorderablePage(QSettings& settings,const QString& pageUid)
+void PageRestore::readReorderablePageIcons(QSettings& settings,QVector<PageSaveIconRecord>& r_icons)
 {
 	//TODO: TEMP: improve this for features and completeness...for now, just skip to the icons array and read them
 	int numIcons = settings.beginReadArray("icons");
-	QList<WebOSAppRestoreObject> rlist;
-	if (numIcons == 0)
+	r_icons.resize(qMax(numIcons,0));
+	for (int i = 0;i < numIcons;++i)
 	{
-		return rlist;
+		settings.setArrayIndex(i);
+		PageSaveIconRecord& icon = r_icons[i];
+		icon.type = settings.value("type",QString("")).toString();
+		icon.id = settings.value("id",QString("")).toString();
+		QVariant launchTypeV = settings.value("launchtype");
+		icon.hasLaunchPoint = launchTypeV.isValid();
+		icon.launchType = launchTypeV.toInt();
+		icon.launchId = settings.value("launchid",QString("")).toString();
 	}
+	settings.endArray();
+}
 
-	for (int i = 0;i < numIcons;++i)
+//static
+QList<WebOSAppRestoreObject> PageRestore::restoreReorderablePage(const PageSaveSnapshot& page)
+{
+	QList<WebOSAppRestoreObject> rlist;
+	quint32 i = 0;
+	for (QVector<PageSaveIconRecord>::const_iterator it = page.icons.constBegin();
+			it != page.icons.constEnd();++it,++i)
 	{
 		//TODO: TEMP: see PageSaver for WebOSApp-only restriction
-		settings.setArrayIndex(i);
-		QString appId = settings.value("id",QString("")).toString();
+		const QString& appId = it->id;
 		if (appId.isEmpty())
 		{
 			continue;
 		}
 
 		//	//TODO: HF DFISH-14598
-		s_positionsAsStoredOnDiskMap[appId] = QPair<QString,quint32>(pageUid,i);
+		s_positionsAsStoredOnDiskMap[appId] = QPair<QString,quint32>(page.pageUid,i);
 		//
 
 		//look up the app uid in the AppMonitor
@@ -924,10 +1039,7 @@ QList<WebOSAppRestoreObject> PageRestore::restoreReorderablePage(QSettings& sett
 			continue;
 		}
 
-		WOAppIconType::Enum t = (WOAppIconType::Enum)(settings.value("launchtype",(int)(WOAppIconType::INVALID))).toInt();
-		QString launchpointId = settings.value("launchid",QString("")).toString();
-
-		rlist << WebOSAppRestoreObject(pWoApp->uid(),appId,launchpointId,i);
+		rlist << WebOSAppRestoreObject(pWoApp->uid(),appId,it->launchId,i);
 	}
 
 	return rlist;
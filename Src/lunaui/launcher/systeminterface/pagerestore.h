@@ -33,6 +33,7 @@
 #include <QPair>
 
 #include "safefileops.h"
+#include "pagesavequeue.h"
 
 class DimensionsUI;
 class Page;
@@ -93,6 +94,15 @@ public:
 	static QVariantMap restoreQuickLaunch(const QString& quicklaunchSaveFilepath);
 
 	static QVariantMap restorePage(const QString& pageSaveFilepath);
+
+	//reads the saved launcher layout without resolving anything against the AppMonitor. Uses the binary image
+	// (LauncherBinarySave) when it is enabled, present and valid, and the INI files otherwise; in that case, the binary image
+	// is (re)created from what was read, so the next restore can use it
+	static bool readLauncherSave(const QString& masterSaveFilepath,LauncherSaveSnapshot& r_launcher);
+	static bool readLauncherIni(const QString& masterSaveFilepath,LauncherSaveSnapshot& r_launcher);
+	static bool readPageIni(const QString& pageSaveFilepath,PageSaveSnapshot& r_page);
+	//...and this does the resolving; the output is what restoreLauncher() returns
+	static QList<QVariantMap> restoreLauncherFromSnapshot(const LauncherSaveSnapshot& launcher);
 	static QString pageSaveFilepathFromPageTag(const QVariantMap& pageTag);
 
 	//// ---- MASTER FILE HANDLING ------
@@ -130,7 +140,8 @@ public:
 	//
 protected:
 
-	static QList<WebOSAppRestoreObject> restoreReorderablePage(QSettings& savedSettingsObj,const QString& pageUid);
+	static void readReorderablePageIcons(QSettings& savedSettingsObj,QVector<PageSaveIconRecord>& r_icons);
+	static QList<WebOSAppRestoreObject> restoreReorderablePage(const PageSaveSnapshot& page);
 
 };
 
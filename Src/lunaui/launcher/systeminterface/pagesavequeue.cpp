@@ -0,0 +1,367 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "pagesavequeue.h"
+#include "pagesaver.h"
+#include "launcherbinarysave.h"
+#include "operationalsettings.h"
+#include "safefileops.h"
+
+#include <QMutexLocker>
+#include <QFile>
+#include <QSettings>
+
+#include <glib.h>
+
+namespace DimensionsSystemInterface
+{
+
+static QString masterEntryKey(const PageSaveSnapshot& page)
+{
+	return page.pageType + QString("|") + page.filepath + QString("|%1").arg(page.pageIndex);
+}
+
+void PageSaveWorker::slotRunJob()
+{
+	m_p_queue->runQueuedJob();
+	Q_EMIT signalJobDone();
+}
+
+PageSaveQueue::PageSaveQueue(QObject * p_parent)
+: QObject(p_parent)
+, m_p_worker(0)
+, m_latestDirty(false)
+, m_writeInFlight(false)
+, m_numPagesWritten(0)
+, m_numPagesSkipped(0)
+, m_numWritesCompleted(0)
+, m_jobState(NoJob)
+, m_jobSuccess(false)
+{
+	m_p_worker = new PageSaveWorker(this);
+	m_p_worker->moveToThread(&m_thread);
+	connect(m_p_worker,SIGNAL(signalJobDone()),
+			this,SLOT(slotJobDone()),
+			Qt::QueuedConnection);
+	m_thread.start(QThread::LowPriority);
+}
+
+//virtual
+PageSaveQueue::~PageSaveQueue()
+{
+	flush();
+	m_thread.quit();
+	m_thread.wait();
+	delete m_p_worker;
+}
+
+void PageSaveQueue::submit(const LauncherSaveSnapshot& snapshot)
+{
+	m_latest = snapshot;
+	m_latestDirty = true;
+	if (!m_writeInFlight)
+	{
+		dispatch();
+	}
+	//else, slotJobDone() will pick up the latest snapshot
+}
+
+bool PageSaveQueue::flush(const LauncherSaveSnapshot * p_snapshot,bool forceAll)
+{
+	bool collected = false;
+	bool collectedSuccess = false;
+	{
+		QMutexLocker locker(&m_jobMutex);
+		if (m_jobState == JobQueued)
+		{
+			//the worker hasn't started on it yet; take it back. Its pages are still dirty relative to m_lastWrittenPages
+			// so they get picked up below
+			m_jobState = NoJob;
+			m_job = Job();
+			m_latestDirty = true;
+		}
+		else
+		{
+			collected = collectFinishedJob(collectedSuccess);
+		}
+		m_writeInFlight = false;
+	}
+	if (collected)
+	{
+		Q_EMIT signalWriteCompleted(collectedSuccess);
+	}
+
+	if (p_snapshot)
+	{
+		m_latest = *p_snapshot;
+		m_latestDirty = true;
+	}
+	if ((!m_latestDirty) && (!forceAll))
+	{
+		return true;
+	}
+	m_latestDirty = false;
+
+	Job job = buildJob(m_latest,forceAll);
+	bool rc = runJob(job);
+	if (rc)
+	{
+		recordJob(job);
+	}
+	++m_numWritesCompleted;
+	return rc;
+}
+
+bool PageSaveQueue::isIdle() const
+{
+	return ((!m_writeInFlight) && (!m_latestDirty));
+}
+
+//static
+bool PageSaveQueue::writePageSnapshot(const PageSaveSnapshot& page)
+{
+	SafeFileOperator safesave(SafeFileOperator::Write,page.filepath,QSettings::IniFormat);
+	QSettings& settings = safesave.safeSettings();
+
+	if (settings.status() != QSettings::NoError)
+	{
+		//problem with the file op
+		return false;
+	}
+
+	//clear it out, and re-sync
+	settings.clear();
+	settings.sync();
+
+	settings.beginGroup("header");
+	settings.setValue(PageSaver::SaveTagKey_PageName,page.pageName);
+	settings.setValue(PageSaver::SaveTagKey_PageDesignator,page.pageDesignator);
+	settings.setValue(PageSaver::SaveTagKey_PageType,page.pageType);
+	settings.setValue(PageSaver::SaveTagKey_PageUid,page.pageUid);
+	settings.endGroup();
+
+	settings.beginWriteArray("icons");
+	int idx = 0;
+	for (QVector<PageSaveIconRecord>::const_iterator it = page.icons.constBegin();
+			it != page.icons.constEnd();++it,++idx)
+	{
+		settings.setArrayIndex(idx);
+		settings.setValue("type",it->type);
+		settings.setValue("id",it->id);
+		if (it->hasLaunchPoint)
+		{
+			settings.setValue("launchtype",it->launchType);
+			settings.setValue("launchid",it->launchId);
+		}
+	}
+	settings.endArray();
+	return true;
+}
+
+//static
+bool PageSaveQueue::writeMasterSnapshot(const LauncherSaveSnapshot& launcher)
+{
+	SafeFileOperator safesave(SafeFileOperator::Write,launcher.masterFilepath,QSettings::IniFormat);
+	QSettings& master = safesave.safeSettings();
+	if (master.status() != QSettings::NoError)
+	{
+		//problem with the file op
+		return false;
+	}
+
+	master.beginGroup("header");
+	master.setValue(PageSaver::MasterTagHeaderKey_TimeStamp,launcher.timeStamp);
+	master.setValue(PageSaver::MasterTagHeaderKey_SimpleName,QString("default"));
+	master.setValue(PageSaver::MasterTagHeaderKey_NumPages,launcher.pages.size());
+	master.setValue(PageSaver::MasterTagHeaderKey_SaveSystemVersion,PageSaver::saveSystemVersion());
+	master.endGroup();
+
+	master.beginWriteArray("pages");
+	int pageIdx=0;
+	for (QList<PageSaveSnapshot>::const_iterator it = launcher.pages.constBegin();
+			it != launcher.pages.constEnd();++it,++pageIdx)
+	{
+		master.setArrayIndex(pageIdx);
+		master.setValue(PageSaver::SaveTagKey_PageType,it->pageType);
+		master.setValue(PageSaver::SaveTagKey_PageFile,it->filepath);
+		master.setValue(PageSaver::SaveTagKey_PageIndex,it->pageIndex);
+	}
+	master.endArray();
+
+	return true;
+}
+
+///protected Q_SLOTS:
+
+void PageSaveQueue::slotJobDone()
+{
+	bool collected = false;
+	bool collectedSuccess = false;
+	{
+		QMutexLocker locker(&m_jobMutex);
+		collected = collectFinishedJob(collectedSuccess);
+	}
+	if (!collected)
+	{
+		//already collected (and the write followed up on) by a flush()
+		return;
+	}
+	m_writeInFlight = false;
+	if (m_latestDirty)
+	{
+		//more changes came in while that was being written
+		dispatch();
+	}
+	Q_EMIT signalWriteCompleted(collectedSuccess);
+}
+
+///protected:
+
+PageSaveQueue::Job PageSaveQueue::buildJob(const LauncherSaveSnapshot& snapshot,bool forceAll)
+{
+	Job job;
+	job.snapshot = snapshot;
+
+	QList<QString> masterPages;
+	for (QList<PageSaveSnapshot>::const_iterator it = snapshot.pages.constBegin();
+			it != snapshot.pages.constEnd();++it)
+	{
+		masterPages << masterEntryKey(*it);
+		QHash<QString,PageSaveSnapshot>::const_iterator f = m_lastWrittenPages.constFind(it->filepath);
+		if ((!forceAll) && (f != m_lastWrittenPages.constEnd()) && (f.value() == *it))
+		{
+			++m_numPagesSkipped;
+			continue;
+		}
+		job.pagesToWrite << *it;
+	}
+	job.writeMaster = forceAll
+			|| (snapshot.masterFilepath != m_lastWrittenMasterFilepath)
+			|| (masterPages != m_lastWrittenMasterPages);
+	job.writeBinary = OperationalSettings::settings()->useBinaryLauncherSaveFormat;
+	return job;
+}
+
+void PageSaveQueue::dispatch()
+{
+	m_latestDirty = false;
+	Job job = buildJob(m_latest,false);
+	if (job.pagesToWrite.isEmpty() && (!job.writeMaster))
+	{
+		//nothing actually changed on disk
+		return;
+	}
+
+	{
+		QMutexLocker locker(&m_jobMutex);
+		m_job = job;
+		m_jobState = JobQueued;
+	}
+	m_writeInFlight = true;
+	QMetaObject::invokeMethod(m_p_worker,"slotRunJob",Qt::QueuedConnection);
+}
+
+//static
+bool PageSaveQueue::runJob(const Job& job)
+{
+	bool rc = true;
+	for (QList<PageSaveSnapshot>::const_iterator it = job.pagesToWrite.constBegin();
+			it != job.pagesToWrite.constEnd();++it)
+	{
+		if (!writePageSnapshot(*it))
+		{
+			g_warning("%s: failed to write page file [%s]",__FUNCTION__,qPrintable(it->filepath));
+			rc = false;
+		}
+	}
+	if (rc && job.writeMaster)
+	{
+		rc = writeMasterSnapshot(job.snapshot);
+	}
+	if (job.writeBinary && (!job.pagesToWrite.isEmpty() || job.writeMaster))
+	{
+		//written after the INI files, and stamped with what they look like on disk now (see LauncherBinarySave::iniStamp).
+		// If the INI files didn't all make it, or the image can't be written, it has to go, so that restore uses the
+		// INI files instead of picking up a stale image
+		QString binaryFilepath = LauncherBinarySave::filepathForMaster(job.snapshot.masterFilepath);
+		if ((!rc) || (!LauncherBinarySave::write(job.snapshot,binaryFilepath)))
+		{
+			QFile::remove(binaryFilepath);
+		}
+	}
+	return rc;
+}
+
+void PageSaveQueue::recordJob(const Job& job)
+{
+	for (QList<PageSaveSnapshot>::const_iterator it = job.pagesToWrite.constBegin();
+			it != job.pagesToWrite.constEnd();++it)
+	{
+		m_lastWrittenPages.insert(it->filepath,*it);
+	}
+	m_numPagesWritten += job.pagesToWrite.size();
+	if (job.writeMaster)
+	{
+		m_lastWrittenMasterFilepath = job.snapshot.masterFilepath;
+		m_lastWrittenMasterPages.clear();
+		for (QList<PageSaveSnapshot>::const_iterator it = job.snapshot.pages.constBegin();
+				it != job.snapshot.pages.constEnd();++it)
+		{
+			m_lastWrittenMasterPages << masterEntryKey(*it);
+		}
+	}
+}
+
+void PageSaveQueue::runQueuedJob()
+{
+	QMutexLocker locker(&m_jobMutex);
+	if (m_jobState != JobQueued)
+	{
+		//taken back by a flush()
+		return;
+	}
+	m_jobSuccess = runJob(m_job);
+	m_jobState = JobFinished;
+}
+
+bool PageSaveQueue::collectFinishedJob(bool& r_success)
+{
+	if (m_jobState != JobFinished)
+	{
+		return false;
+	}
+	m_jobState = NoJob;
+	r_success = m_jobSuccess;
+	if (m_jobSuccess)
+	{
+		recordJob(m_job);
+	}
+	else
+	{
+		//try again with the next snapshot; nothing from this job is recorded as written, so all of it stays dirty
+		g_warning("%s: background launcher save failed",__FUNCTION__);
+	}
+	++m_numWritesCompleted;
+	m_job = Job();
+	return true;
+}
+
+} //end namespace
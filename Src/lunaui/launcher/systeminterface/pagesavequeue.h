@@ -0,0 +1,208 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2011-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef PAGESAVEQUEUE_H_
+#define PAGESAVEQUEUE_H_
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+
+namespace DimensionsSystemInterface
+{
+
+//one icon entry of a page save file ("icons" array); plain data, so it can be handed to the save thread
+class PageSaveIconRecord
+{
+public:
+	PageSaveIconRecord() : hasLaunchPoint(false) , launchType(0) {}
+
+	bool operator==(const PageSaveIconRecord& o) const
+	{
+		return ((type == o.type) && (id == o.id) && (hasLaunchPoint == o.hasLaunchPoint)
+				&& (launchType == o.launchType) && (launchId == o.launchId));
+	}
+	bool operator!=(const PageSaveIconRecord& o) const { return !(*this == o); }
+
+	QString type;
+	QString id;
+	bool	hasLaunchPoint;
+	int		launchType;
+	QString launchId;
+};
+
+//everything that goes into one page save file, captured on the gui thread
+class PageSaveSnapshot
+{
+public:
+	PageSaveSnapshot() : pageIndex(0) {}
+
+	bool operator==(const PageSaveSnapshot& o) const
+	{
+		return ((filepath == o.filepath) && (pageName == o.pageName) && (pageDesignator == o.pageDesignator)
+				&& (pageType == o.pageType) && (pageUid == o.pageUid) && (pageIndex == o.pageIndex)
+				&& (icons == o.icons));
+	}
+	bool operator!=(const PageSaveSnapshot& o) const { return !(*this == o); }
+
+	QString filepath;
+	QString pageName;
+	QString pageDesignator;
+	QString pageType;
+	QString pageUid;
+	int		pageIndex;
+	QVector<PageSaveIconRecord> icons;
+};
+
+//the whole launcher: the master (.msave) file and all of its pages
+class LauncherSaveSnapshot
+{
+public:
+	LauncherSaveSnapshot() : timeStamp(0) {}
+
+	QString masterFilepath;
+	quint64 timeStamp;
+	QList<PageSaveSnapshot> pages;
+};
+
+class PageSaveQueue;
+class PageSaveWorker : public QObject
+{
+	Q_OBJECT
+public:
+	PageSaveWorker(PageSaveQueue * p_queue) : m_p_queue(p_queue) {}
+
+Q_SIGNALS:
+	void signalJobDone();
+
+public Q_SLOTS:
+	void slotRunJob();
+
+protected:
+	PageSaveQueue * m_p_queue;
+};
+
+/*
+ * Writes LauncherSaveSnapshot-s out on a background thread.
+ *
+ * Only the pages whose content differs from what this queue last wrote successfully are written; the master file
+ * is only re-written if the page list changed. Snapshots submitted while a write is in progress are coalesced - only
+ * the newest one is written once the current write finishes.
+ * The files are written through SafeFileOperator exactly as in the synchronous path, so each file is still replaced
+ * atomically (temp file + rename).
+ * If enabled, the binary image of the launcher (LauncherBinarySave) is written last, every time anything is written
+ *
+ */
+class PageSaveQueue : public QObject
+{
+	Q_OBJECT
+public:
+
+	PageSaveQueue(QObject * p_parent = 0);
+	virtual ~PageSaveQueue();
+
+	//non-blocking; the snapshot is copied
+	void submit(const LauncherSaveSnapshot& snapshot);
+
+	//blocking; cancels or waits out the in-progress write and then writes the latest submitted snapshot on the calling thread
+	// (if p_snapshot is given, it becomes the latest snapshot first). If forceAll is true, every page file is written regardless
+	// of whether it changed
+	bool flush(const LauncherSaveSnapshot * p_snapshot = 0,bool forceAll = false);
+
+	bool isIdle() const;
+
+	//counters, for diagnostics and the benchmarks
+	quint32 numPagesWritten() const { return m_numPagesWritten; }
+	quint32 numPagesSkipped() const { return m_numPagesSkipped; }
+	quint32 numWritesCompleted() const { return m_numWritesCompleted; }
+
+	//the actual file writers. These only touch the snapshot and the filesystem, so they are safe to call from any thread
+	static bool writePageSnapshot(const PageSaveSnapshot& page);
+	static bool writeMasterSnapshot(const LauncherSaveSnapshot& launcher);
+
+Q_SIGNALS:
+
+	void signalWriteCompleted(bool success);
+
+protected Q_SLOTS:
+
+	void slotJobDone();
+
+protected:
+
+	friend class PageSaveWorker;
+
+	class Job
+	{
+	public:
+		Job() : writeMaster(false) , writeBinary(false) {}
+		LauncherSaveSnapshot snapshot;
+		QList<PageSaveSnapshot> pagesToWrite;
+		bool writeMaster;
+		bool writeBinary;		//the LauncherBinarySave image of the whole snapshot
+	};
+
+	enum JobState
+	{
+		NoJob,
+		JobQueued,
+		JobFinished
+	};
+
+	Job buildJob(const LauncherSaveSnapshot& snapshot,bool forceAll);
+	void dispatch();
+	static bool runJob(const Job& job);
+	void recordJob(const Job& job);
+
+	//called on the worker thread
+	void runQueuedJob();
+	//must hold m_jobMutex; returns false if there was no finished job to collect
+	bool collectFinishedJob(bool& r_success);
+
+	QThread m_thread;
+	PageSaveWorker * m_p_worker;
+
+	//gui thread only
+	LauncherSaveSnapshot m_latest;
+	bool m_latestDirty;
+	bool m_writeInFlight;
+	QHash<QString,PageSaveSnapshot> m_lastWrittenPages;		//keyed by filepath
+	QString m_lastWrittenMasterFilepath;
+	QList<QString> m_lastWrittenMasterPages;
+
+	quint32 m_numPagesWritten;
+	quint32 m_numPagesSkipped;
+	quint32 m_numWritesCompleted;
+
+	//shared with the worker thread; the worker holds the mutex for the duration of the write
+	QMutex m_jobMutex;
+	JobState m_jobState;
+	Job m_job;
+	bool m_jobSuccess;
+};
+
+} //end namespace
+
+#endif /* PAGESAVEQUEUE_H_ */
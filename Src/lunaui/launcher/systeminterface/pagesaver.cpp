@@ -99,6 +99,9 @@ void PageSaver::filesForBackup(QList<QString> * pFileList)
 
 	//TODO: be more selective about saving only the valid files. For now, just save it all
 
+	//make sure whatever the launcher has scheduled is actually on disk before it gets picked up
+	flushScheduledSaves();
+
 	g_message("%s: about to scan: %s",__FUNCTION__,qPrintable(OperationalSettings::settings()->savedPagesDirectory));
 	QList<QString> rlist;
 	QDir dir = QDir(OperationalSettings::settings()->savedPagesDirectory);
@@ -119,13 +122,15 @@ void PageSaver::filesForBackup(QList<QString> * pFileList)
 
 PageSaver::PageSaver()
 {
-
+	m_quietTimer.setSingleShot(true);
+	connect(&m_quietTimer,SIGNAL(timeout()),
+			this,SLOT(slotQuietPeriodElapsed()));
 }
 
 //virtual
 PageSaver::~PageSaver()
 {
-
+	flushScheduledSaves();
 }
 
 //static
@@ -150,6 +155,81 @@ QVariantMap PageSaver::savePage(Page * p_page,LauncherObject * p_uiContext)
 
 //static
 bool PageSaver::saveLauncher(LauncherObject * p_uiContext)
+{
+	LauncherSaveSnapshot snapshot;
+	if (!snapshotLauncher(p_uiContext,snapshot))
+	{
+		return false;
+	}
+
+	//going through the queue keeps its record of what is on disk accurate, and cancels anything it had pending
+	PageSaver * pSaver = instance();
+	pSaver->m_quietTimer.stop();
+	pSaver->m_qp_scheduledContext = 0;
+	return pSaver->m_saveQueue.flush(&snapshot,true);
+}
+
+//static
+void PageSaver::scheduleSaveLauncher(LauncherObject * p_uiContext)
+{
+	if (!p_uiContext)
+	{
+		return;
+	}
+	if (!OperationalSettings::settings()->saveLauncherInBackground)
+	{
+		(void)saveLauncher(p_uiContext);
+		return;
+	}
+	PageSaver * pSaver = instance();
+	pSaver->m_qp_scheduledContext = p_uiContext;
+	//(re)start; a burst of changes (e.g. a reorder drag, or an app install touching several pages) results in one save
+	pSaver->m_quietTimer.start(OperationalSettings::settings()->launcherSaveQuietPeriodMs);
+}
+
+//static
+void PageSaver::flushScheduledSaves()
+{
+	if (!s_qp_instance)
+	{
+		return;
+	}
+	PageSaver * pSaver = s_qp_instance;
+	LauncherSaveSnapshot snapshot;
+	if (pSaver->m_quietTimer.isActive())
+	{
+		pSaver->m_quietTimer.stop();
+		if (snapshotLauncher(pSaver->m_qp_scheduledContext,snapshot))
+		{
+			pSaver->m_qp_scheduledContext = 0;
+			(void)pSaver->m_saveQueue.flush(&snapshot);
+			return;
+		}
+	}
+	(void)pSaver->m_saveQueue.flush();
+}
+
+//static
+bool PageSaver::snapshotPage(Page * p_page,LauncherObject * p_uiContext,PageSaveSnapshot& r_snapshot)
+{
+	if ((!p_page)
+		|| (!p_uiContext))
+	{
+		return false;
+	}
+
+	//TODO: add new page types here....
+	ReorderablePage * pReorderPage = qobject_cast<ReorderablePage *>(p_page);
+	if (!pReorderPage)
+	{
+		//don't support any other page types at the moment
+		return false;
+	}
+	return snapshotReorderablePage(pReorderPage,p_uiContext,r_snapshot);
+}
+
+//static
+bool PageSaver::snapshotLauncher(LauncherObject * p_uiContext,LauncherSaveSnapshot& r_snapshot)
 {
 	if (!p_uiContext)
 	{
@@ -158,22 +238,21 @@ bool PageSaver::saveLauncher(LauncherObject * p_uiContext)
 	//grab the pages from the ui context
 	QList<QPointer<Page> > pages = p_uiContext->pages();
 
-	quint64 timeStamp = (quint64)QDateTime::currentMSecsSinceEpoch();
-	QList<QVariantMap> pagesSaved;
+	r_snapshot.timeStamp = (quint64)QDateTime::currentMSecsSinceEpoch();
+	r_snapshot.pages.clear();
 	for (QList<QPointer<Page> >::const_iterator it = pages.constBegin();
 			it != pages.constEnd();++it)
 	{
-		QVariantMap pageInfoMap = savePage(*it,p_uiContext);
-		if (pageInfoMap.isEmpty())
+		PageSaveSnapshot page;
+		if (!snapshotPage(*it,p_uiContext,page))
 		{
 			//didn't save the page for whatever reason. Skip
 			continue;
 		}
-		pagesSaved << pageInfoMap;
+		r_snapshot.pages << page;
 	}
 
-	int numPagesSaved = pagesSaved.size();
-	if (numPagesSaved == 0)
+	if (r_snapshot.pages.isEmpty())
 	{
 		//no pages could be saved
 		return false;
@@ -183,7 +262,7 @@ bool PageSaver::saveLauncher(LauncherObject * p_uiContext)
 								? QString("fixed")
 								: (
 									OperationalSettings::settings()->usePreciseTimeForMasterSaveFileName
-											? QString("%1").arg(timeStamp)
+											? QString("%1").arg(r_snapshot.timeStamp)
 											: QDate::currentDate().toString("dd-MM-yyyy")
 									)
 								);
@@ -192,36 +271,9 @@ bool PageSaver::saveLauncher(LauncherObject * p_uiContext)
 		nameTimeFragment = QString("null");
 	}
 
-	//create the masterfile
-	QString masterFilepath = OperationalSettings::settings()->savedPagesDirectory + QString("/") +
+	//the masterfile
+	r_snapshot.masterFilepath = OperationalSettings::settings()->savedPagesDirectory + QString("/") +
 							QString("launcher_")+nameTimeFragment+QString(".msave");
-	SafeFileOperator safesave(SafeFileOperator::Write,masterFilepath,QSettings::IniFormat);
-	QSettings& master = safesave.safeSettings();
-	if (master.status() != QSettings::NoError)
-	{
-		//problem with the file op
-		return false;
-	}
-
-	master.beginGroup("header");
-	master.setValue(PageSaver::MasterTagHeaderKey_TimeStamp,timeStamp);
-	master.setValue(PageSaver::MasterTagHeaderKey_SimpleName,QString("default"));
-	master.setValue(PageSaver::MasterTagHeaderKey_NumPages,numPagesSaved);
-	master.setValue(PageSaver::MasterTagHeaderKey_SaveSystemVersion,SaveSystemVersion);
-	master.endGroup();
-
-	master.beginWriteArray("pages");
-	int pageIdx=0;
-	for (QList<QVariantMap>::iterator it = pagesSaved.begin();
-			it != pagesSaved.end();++it,++pageIdx)
-	{
-		master.setArrayIndex(pageIdx);
-		master.setValue(PageSaver::SaveTagKey_PageType,it->value(PageSaver::SaveTagKey_PageType));
-		master.setValue(PageSaver::SaveTagKey_PageFile,it->value(PageSaver::SaveTagKey_PageFile));
-		master.setValue(PageSaver::SaveTagKey_PageIndex,it->value(PageSaver::PageSaver::SaveTagKey_PageIndex));
-	}
-	master.endArray();
-
 	return true;
 }
 
@@ -320,8 +372,29 @@ bool PageSaver::saveQuickLaunch(LauncherObject * p_uiContext,QuickLaunchBar * p_
 
 ///protected:
 
-//virtual
+//static
 QVariantMap PageSaver::saveReorderablePage(ReorderablePage * p_reorderPage,LauncherObject * p_uiContext)
+{
+	PageSaveSnapshot snapshot;
+	if ((!snapshotReorderablePage(p_reorderPage,p_uiContext,snapshot))
+		|| (!PageSaveQueue::writePageSnapshot(snapshot)))
+	{
+		return QVariantMap();
+	}
+
+	QVariantMap rmap;
+	rmap[PageSaver::SaveTagKey_PageName] = snapshot.pageName;
+	rmap[PageSaver::SaveTagKey_PageDesignator] = snapshot.pageDesignator;
+	rmap[PageSaver::SaveTagKey_PageType] = snapshot.pageType;
+	rmap[PageSaver::SaveTagKey_PageUid] = snapshot.pageUid;
+	rmap[PageSaver::SaveTagKey_PageFile] = snapshot.filepath;
+	rmap[PageSaver::SaveTagKey_PageIndex] = snapshot.pageIndex;
+	rmap[PageSaver::SaveTagKey_PageNumIcons] = snapshot.icons.size();
+	return rmap;
+}
+
+//static
+bool PageSaver::snapshotReorderablePage(ReorderablePage * p_reorderPage,LauncherObject * p_uiContext,PageSaveSnapshot& r_snapshot)
 {
 	/*
 	 *
@@ -335,50 +408,24 @@ QVariantMap PageSaver::saveReorderablePage(ReorderablePage * p_reorderPage,Launc
 	IconLayout * pLayout = p_reorderPage->currentIconLayout();
 	if (!pLayout)
 	{
-		return QVariantMap();
+		return false;
 	}
 
-
 	//create a filename to use
-	QString filepath = OperationalSettings::settings()->savedPagesDirectory + QString("/")
+	r_snapshot.filepath = OperationalSettings::settings()->savedPagesDirectory + QString("/")
 			+ QString("page_")
 			+ QString(p_reorderPage->metaObject()->className())
 			+ QString("_")+p_reorderPage->property(Page::PageNamePropertyName).toString()
 			+ QString("_")+p_reorderPage->uid().toString();
 
-	SafeFileOperator safesave(SafeFileOperator::Write,filepath,QSettings::IniFormat);
-	QSettings& settings = safesave.safeSettings();
-
-	if (settings.status() != QSettings::NoError)
-	{
-		//problem with the file op
-		return QVariantMap();
-	}
-
-	//clear it out, and re-sync
-	settings.clear();
-	settings.sync();
+	r_snapshot.pageName = p_reorderPage->property(Page::PageNamePropertyName).toString();
+	r_snapshot.pageDesignator = p_reorderPage->property(Page::PageDesignatorPropertyName).toString();
+	r_snapshot.pageType = QString(p_reorderPage->metaObject()->className());
+	r_snapshot.pageUid = p_reorderPage->uid().toString();
+	r_snapshot.pageIndex = p_reorderPage->property(Page::PageIndexPropertyName).toInt();
+	r_snapshot.icons.clear();
 
-	//write out the page info first
-
-	settings.beginGroup("header");
-	settings.setValue(PageSaver::SaveTagKey_PageName,p_reorderPage->property(Page::PageNamePropertyName).toString());
-	settings.setValue(PageSaver::SaveTagKey_PageDesignator,p_reorderPage->property(Page::PageDesignatorPropertyName).toString());
-	settings.setValue(PageSaver::SaveTagKey_PageType,QString(p_reorderPage->metaObject()->className()));
-	settings.setValue(PageSaver::SaveTagKey_PageUid,p_reorderPage->uid().toString());
-	settings.endGroup();
-
-	QVariantMap rmap;
-	rmap[PageSaver::SaveTagKey_PageName] = p_reorderPage->property(Page::PageNamePropertyName).toString();
-	rmap[PageSaver::SaveTagKey_PageDesignator] = p_reorderPage->property(Page::PageDesignatorPropertyName).toString();
-	rmap[PageSaver::SaveTagKey_PageType] = QString(p_reorderPage->metaObject()->className());
-	rmap[PageSaver::SaveTagKey_PageUid] = p_reorderPage->uid().toString();
-	rmap[PageSaver::SaveTagKey_PageFile] = filepath;
-	rmap[PageSaver::SaveTagKey_PageIndex] = p_reorderPage->property(Page::PageIndexPropertyName).toInt();
-
-	settings.beginWriteArray("icons");
 	QList<IconCell *> iconFlowList = pLayout->iconCellsInFlowOrder();
-	int idx = 0;
 	int iti = 0;
 	for (QList<IconCell *>::iterator it = iconFlowList.begin();
 			it != iconFlowList.end();++it,++iti)
@@ -416,23 +463,21 @@ QVariantMap PageSaver::saveReorderablePage(ReorderablePage * p_reorderPage,Launc
 			qDebug() << __FUNCTION__ << ": error (iti = " << iti << "): app uid = " << appUid << " isn't a WebOS app";
 			continue;
 		}
-		settings.setArrayIndex(idx++);
-		settings.setValue("type",QString(pApp->metaObject()->className()));
-		settings.setValue("id",pApp->appId());
+		PageSaveIconRecord record;
+		record.type = QString(pApp->metaObject()->className());
+		record.id = pApp->appId();
 		//check and see what kind of icon this is...i.e. what launchpoint it represents
 		WOAppIconType::Enum t;
 		QString launchptId = pApp->launchpointIdOfIcon(pMasterIcon->uid(),&t);
 		if (t != WOAppIconType::INVALID)
 		{
-			settings.setValue("launchtype",(int)t);
-			settings.setValue("launchid",launchptId);
+			record.hasLaunchPoint = true;
+			record.launchType = (int)t;
+			record.launchId = launchptId;
 		}
-
-		//qDebug() << __FUNCTION__ << ": saved appid = " << pApp->appId() << " at index " << idx-1;
+		r_snapshot.icons << record;
 	}
-	settings.endArray();
-	rmap[PageSaver::SaveTagKey_PageNumIcons] = idx;
-	return rmap;
+	return true;
 }
 
 //static
@@ -494,5 +539,20 @@ void PageSaver::dbgPackUpAndSaveCurrentLauncher3Dir(const QString& extraFilename
 	myProcess->start(program, arguments);
 }
 
+///protected Q_SLOTS:
+
+void PageSaver::slotQuietPeriodElapsed()
+{
+	//the snapshot has to be taken here, on the gui thread, since it walks the live pages and icons. Everything after
+	// that - comparing against what's on disk, and the file i/o - happens on the save thread
+	LauncherSaveSnapshot snapshot;
+	if (!snapshotLauncher(m_qp_scheduledContext,snapshot))
+	{
+		return;
+	}
+	m_qp_scheduledContext = 0;
+	m_saveQueue.submit(snapshot);
+}
+
 
 } //end namespace
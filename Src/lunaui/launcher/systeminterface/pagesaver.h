@@ -27,6 +27,9 @@
 #include <QVariant>
 #include <QString>
 #include <QList>
+#include <QTimer>
+
+#include "pagesavequeue.h"
 
 class LauncherObject;
 class QuickLaunchBar;
@@ -71,7 +74,16 @@ public:
 	virtual ~PageSaver();
 
 	static QVariantMap savePage(Page * p_page,LauncherObject * p_uiContext);
+	//synchronous; writes everything right away on the calling thread (any pending background save is folded into it)
 	static bool	saveLauncher(LauncherObject * p_uiContext);
+	//asynchronous; the save is deferred until the launcher has been quiet for launcherSaveQuietPeriodMs (see OperationalSettings),
+	// and then only the pages that changed are written, on the save thread
+	static void scheduleSaveLauncher(LauncherObject * p_uiContext);
+	//writes out anything scheduled but not yet on disk; blocks
+	static void flushScheduledSaves();
+
+	static bool snapshotPage(Page * p_page,LauncherObject * p_uiContext,PageSaveSnapshot& r_snapshot);
+	static bool snapshotLauncher(LauncherObject * p_uiContext,LauncherSaveSnapshot& r_snapshot);
 	static bool saveQuickLaunch(LauncherObject * p_uiContext,QuickLaunchBar * p_quickLauncher);
 
 	static quint32 saveSystemVersion() { return SaveSystemVersion; }
@@ -82,10 +94,19 @@ public:
 
 	static void dbgPackUpAndSaveCurrentLauncher3Dir(const QString& extraFilenameTag,QList<QVariantMap> * p_dbgLauncherConf = 0);
 
+protected Q_SLOTS:
+
+	void slotQuietPeriodElapsed();
+
 protected:
 
 	static QPointer<PageSaver> s_qp_instance;
 	static QVariantMap saveReorderablePage(ReorderablePage * p_reorderPage,LauncherObject * p_uiContext);
+	static bool snapshotReorderablePage(ReorderablePage * p_reorderPage,LauncherObject * p_uiContext,PageSaveSnapshot& r_snapshot);
+
+	PageSaveQueue m_saveQueue;
+	QTimer m_quietTimer;
+	QPointer<LauncherObject> m_qp_scheduledContext;
 
 };
 
@@ -0,0 +1,170 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include <string.h>
+
+#include "ClockFace.h"
+
+static const qint64 kMinuteMs = 60 * 1000;
+
+ClockFace::ClockFace()
+	: m_height(0)
+	, m_numCells(0)
+	, m_numWakeups(0)
+	, m_lastPaintedPixels(0)
+	, m_totalPaintedPixels(0)
+{
+}
+
+void ClockFace::clearGlyphs()
+{
+	m_glyphs.clear();
+	m_height = 0;
+	invalidate();
+}
+
+void ClockFace::setGlyph(char ch, const QRect& atlasRect)
+{
+	m_glyphs[ch] = atlasRect;
+	m_height = MAX(m_height, atlasRect.height());
+	invalidate();
+}
+
+QRect ClockFace::glyph(char ch) const
+{
+	return m_glyphs.value(ch);
+}
+
+void ClockFace::invalidate()
+{
+	m_numCells = 0;
+}
+
+int ClockFace::width() const
+{
+	int width = 0;
+	for (int i = 0; i < m_numCells; i++)
+		width += m_cells[i].rect.width();
+	return width;
+}
+
+static void addDirty(QVector<QRect>& dirty, const QRect& r)
+{
+	if (r.isEmpty())
+		return;
+
+	// all the cells are on one row: merging intervals is enough
+	for (int i = 0; i < dirty.size(); i++) {
+		QRect& d = dirty[i];
+		if (r.left() <= d.right() + 1 && d.left() <= r.right() + 1) {
+			d = d.united(r);
+			// the grown rect may now reach the ones after it
+			while (i + 1 < dirty.size() && dirty[i + 1].left() <= d.right() + 1) {
+				d = d.united(dirty[i + 1]);
+				dirty.remove(i + 1);
+			}
+			return;
+		}
+		if (r.right() < d.left()) {
+			dirty.insert(i, r);
+			return;
+		}
+	}
+	dirty.append(r);
+}
+
+QVector<QRect> ClockFace::setText(const char* text, int y)
+{
+	Cell cells[kMaxChars];
+	int numCells = 0;
+	int width = 0;
+
+	// characters without a glyph take no space, as before
+	for (const char* c = text; *c && numCells < kMaxChars; c++) {
+		QRect src = m_glyphs.value(*c);
+		if (src.isEmpty())
+			continue;
+		cells[numCells].ch = *c;
+		cells[numCells].rect = QRect(width, y, src.width(), m_height);
+		width += src.width();
+		numCells++;
+	}
+
+	int xOff = (-width) / 2;
+	for (int i = 0; i < numCells; i++)
+		cells[i].rect.translate(xOff, 0);
+
+	QVector<QRect> dirty;
+	for (int i = 0; i < MAX(numCells, m_numCells); i++) {
+		bool hasOld = i < m_numCells;
+		bool hasNew = i < numCells;
+		if (hasOld && hasNew && cells[i].ch == m_cells[i].ch && cells[i].rect == m_cells[i].rect)
+			continue;
+		if (hasOld)
+			addDirty(dirty, m_cells[i].rect);
+		if (hasNew)
+			addDirty(dirty, cells[i].rect);
+	}
+
+	memcpy(m_cells, cells, sizeof(cells));
+	m_numCells = numCells;
+
+	m_lastPaintedPixels = 0;
+	for (int i = 0; i < dirty.size(); i++)
+		m_lastPaintedPixels += dirty[i].width() * dirty[i].height();
+	m_totalPaintedPixels += m_lastPaintedPixels;
+
+	return dirty;
+}
+
+int ClockFace::msToNextBoundary(qint64 wallMs, int periodMs)
+{
+	if (periodMs <= 0)
+		return 0;
+
+	qint64 rem = wallMs % periodMs;
+	if (rem < 0)
+		rem += periodMs;
+	return (int) (periodMs - rem);
+}
+
+void ClockFace::noteWakeup(qint64 nowMs)
+{
+	if (m_numWakeups == kWakeupHistory) {
+		memmove(m_wakeups, m_wakeups + 1, (kWakeupHistory - 1) * sizeof(qint64));
+		m_numWakeups--;
+	}
+	m_wakeups[m_numWakeups++] = nowMs;
+}
+
+int ClockFace::wakeupsPerMinute(qint64 nowMs) const
+{
+	// saturates at kWakeupHistory, which is already far over budget
+	int count = 0;
+	for (int i = m_numWakeups - 1; i >= 0; i--) {
+		if (nowMs - m_wakeups[i] >= kMinuteMs)
+			break;
+		count++;
+	}
+	return count;
+}
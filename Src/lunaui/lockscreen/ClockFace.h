@@ -0,0 +1,97 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef CLOCKFACE_H
+#define CLOCKFACE_H
+
+#include "Common.h"
+
+#include <QHash>
+#include <QRect>
+#include <QVector>
+
+/**
+ * Layout of the lock screen clock: one cell per character, laid out side by side and
+ * centred on x = 0, with each glyph's source rect in a single pre-composited atlas.
+ *
+ * setText() compares the new cells with the old ones and returns only the rects that
+ * need repainting: a minute tick usually touches one digit. When the width of the
+ * text changes, the cells move and everything they covered before or after is dirty.
+ *
+ * The face also keeps the numbers the power budget is checked against: how often the
+ * clock woke up over the last minute, and how many pixels the last tick invalidated.
+ */
+class ClockFace
+{
+public:
+
+	static const int kMaxChars = 8;
+
+	struct Cell
+	{
+		char	ch;
+		QRect	rect;	// where it's drawn, in item coordinates
+	};
+
+	ClockFace();
+
+	void			clearGlyphs();
+	void			setGlyph(char ch, const QRect& atlasRect);
+	QRect			glyph(char ch) const;
+
+	int				height() const { return m_height; }
+
+	// lays the text out with its top at y; returns the dirty rects, left to right,
+	// with touching ones merged
+	QVector<QRect>	setText(const char* text, int y);
+	// forgets the current cells: the next setText() dirties all of them
+	void			invalidate();
+
+	int				numCells() const { return m_numCells; }
+	const Cell&		cell(int index) const { return m_cells[index]; }
+	int				width() const;
+
+	// ms from wallMs (ms since the epoch) to the next multiple of periodMs
+	static int		msToNextBoundary(qint64 wallMs, int periodMs);
+
+	// setText() counts the pixels, the owner notes its own wakeups
+	void			noteWakeup(qint64 nowMs);
+	int				wakeupsPerMinute(qint64 nowMs) const;
+	int				lastPaintedPixels() const { return m_lastPaintedPixels; }
+	qint64			totalPaintedPixels() const { return m_totalPaintedPixels; }
+
+private:
+
+	static const int kWakeupHistory = 64;
+
+	QHash<char, QRect>	m_glyphs;
+	int				m_height;
+
+	Cell			m_cells[kMaxChars];
+	int				m_numCells;
+
+	qint64			m_wakeups[kWakeupHistory];
+	int				m_numWakeups;
+	int				m_lastPaintedPixels;
+	qint64			m_totalPaintedPixels;
+};
+
+#endif /* CLOCKFACE_H */
@@ -22,6 +22,7 @@
 #include <string>
 #include <cmath>
 #include <map>
+#include <sys/time.h>
 
 #include "HostBase.h"
 #include "Settings.h"
@@ -36,27 +37,20 @@
 #include <QHash>
 #include <QGraphicsPixmapItem>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 
 
 ClockWindow::ClockWindow()
-	: m_width(0)
 {
 	memset(m_time, 0, MaxTimeChars);
 
 	loadDigits();
-
-	const HostInfo& info = HostBase::instance()->getInfo();
-
-	if (!m_digits.empty()) {
-		int height = m_digits.constBegin().value().height();
-		m_bounds = QRect(-info.displayWidth/2, -height/2, info.displayWidth, height);
-	}
-	else {
-		m_bounds = QRect(0, 0, 0, 0);
-	}
+	layoutBounds();
 
 	updateTimeFormat();
 
+	// paint() only draws the cells that were invalidated
+	setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 	setVisible(true);
 }
 
@@ -64,13 +58,12 @@ ClockWindow::~ClockWindow()
 {
 }
 
-void ClockWindow::resize(int width, int height)
+void ClockWindow::layoutBounds()
 {
 	const HostInfo& info = HostBase::instance()->getInfo();
 
-	prepareGeometryChange();
-	if (!m_digits.empty()) {
-		int height = m_digits.constBegin().value().height();
+	if (m_face.height() > 0) {
+		int height = m_face.height();
 		m_bounds = QRect(-info.displayWidth/2, -height/2, info.displayWidth, height);
 	}
 	else {
@@ -78,6 +71,15 @@ void ClockWindow::resize(int width, int height)
 	}
 }
 
+void ClockWindow::resize(int width, int height)
+{
+	prepareGeometryChange();
+	layoutBounds();
+
+	// the cells are laid out against the bounds: the next tick repaints them all
+	m_face.invalidate();
+}
+
 void ClockWindow::loadDigits()
 {
 	QString digitPath = qFromUtf8Stl(Settings::LunaSettings()->lunaSystemResourcesPath) + "/";
@@ -91,11 +93,42 @@ void ClockWindow::loadDigits()
 		{0, 0}
 	};
 
+	QList<QPixmap> digits;
+	int width = 0;
+	int height = 0;
+
 	const ImagePath* cur = imagePaths;
 	while (cur->path != 0) {
-		m_digits[cur->key] = QPixmap(digitPath + cur->path);
+		QPixmap digit(digitPath + cur->path);
+		digits.append(digit);
+		width += digit.width();
+		height = MAX(height, digit.height());
 		cur++;
 	}
+
+	m_face.clearGlyphs();
+	if (width == 0 || height == 0) {
+		m_atlas = QPixmap();
+		return;
+	}
+
+	// composite them once, so that a tick is a few blits out of one pixmap
+	m_atlas = QPixmap(width, height);
+	m_atlas.fill(Qt::transparent);
+
+	QPainter painter(&m_atlas);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+
+	int xOff = 0;
+	for (int i = 0; i < digits.size(); i++) {
+		const QPixmap& digit = digits[i];
+		if (digit.isNull())
+			continue;
+		painter.drawPixmap(xOff, 0, digit);
+		m_face.setGlyph(imagePaths[i].key, QRect(xOff, 0, digit.width(), height));
+		xOff += digit.width();
+	}
+	painter.end();
 }
 
 // QGraphicsItem::boundingRect
@@ -107,15 +140,12 @@ QRectF ClockWindow::boundingRect() const
 // QGraphicsItem::paint
 void ClockWindow::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+	QRect exposed = option->exposedRect.toAlignedRect();
 
-	int len = strlen(m_time);
-	int xOff = (-m_width) / 2;
-	for (int i=0; i<len; i++) {
-		QPixmap surf = m_digits[m_time[i]];
-		if (!surf.isNull()) {
-			painter->drawPixmap(xOff, m_bounds.y(), surf.width(), m_bounds.height(), surf);
-			xOff += surf.width();
-		}
+	for (int i = 0; i < m_face.numCells(); i++) {
+		const ClockFace::Cell& cell = m_face.cell(i);
+		if (cell.rect.intersects(exposed))
+			painter->drawPixmap(cell.rect, m_atlas, m_face.glyph(cell.ch));
 	}
 }
 
@@ -124,6 +154,13 @@ void ClockWindow::updateTimeFormat()
     m_twelveHour = LocalePreferences::instance()->timeFormat() == "HH12";
 }
 
+static qint64 wallClockMs()
+{
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (qint64) tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
 void ClockWindow::tick()
 {
 	time_t rawTime;
@@ -144,15 +181,24 @@ void ClockWindow::tick()
 		strftime(m_time, MaxTimeChars, LOCALIZED("%H:%M").c_str(), timeinfo);
 	}
 
-	// recalculate the width of the new time
-	m_width = 0;
-	int len = strlen(m_time);
-	for (int i=0; i<len; i++) {
-		QPixmap surf = m_digits[m_time[i]];
-		if (!surf.isNull())
-			m_width += surf.width();
-	}
+	QVector<QRect> dirty = m_face.setText(m_time, m_bounds.y());
+	for (int i = 0; i < dirty.size(); i++)
+		update(dirty[i]);
+
+	qint64 now = wallClockMs();
+	m_face.noteWakeup(now);
 
-	update();
+#if defined(FB1_POWER_OPTIMIZATION)
+	g_message("%s: %d wakeups in the last minute, %d pixels painted (%lld in total)",
+			  __PRETTY_FUNCTION__, m_face.wakeupsPerMinute(now),
+			  m_face.lastPaintedPixels(), m_face.totalPaintedPixels());
+#endif
 }
 
+int ClockWindow::msToNextTick() const
+{
+	// land a little after the boundary, so that the new minute is the one read back
+	static const int kSlackMs = 20;
+
+	return ClockFace::msToNextBoundary(wallClockMs(), 60 * 1000) + kSlackMs;
+}
@@ -26,9 +26,11 @@
 #include "Timer.h"
 #include "sptr.h"
 #include "Event.h"
+#include "ClockFace.h"
 
 #include <QObject>
 #include <QGraphicsObject>
+#include <QPixmap>
 
 class ClockWindow : public QGraphicsObject
 {
@@ -46,20 +48,27 @@ public:
 	void updateTimeFormat();
 	void resize(int width, int height);
 
+	// repaints the digits that changed, if any
 	void tick();
 
+	// the display only shows minutes: the next tick is due on the next minute boundary
+	int msToNextTick() const;
+
+	const ClockFace& face() const { return m_face; }
+
 private:
 
 	void loadDigits();
+	void layoutBounds();
 
 	static const unsigned int MaxTimeChars = 6;
 
 	char m_time[MaxTimeChars];
-	int m_width;
 	bool m_twelveHour;
 
-	typedef QHash<char, QPixmap> ImageMap;
-	ImageMap m_digits;
+	// all the digits side by side in one pixmap, drawn from with the face's source rects
+	QPixmap m_atlas;
+	ClockFace m_face;
 
 	typedef struct {
 		char key;
@@ -54,8 +54,10 @@
 #include "Utils.h"
 #include "QtUtils.h"
 #include "ClockWindow.h"
+#include "StatusBarServicesConnector.h"
 #include "IMEController.h"
 #include "QmlInputItem.h"
+#include "QmlComponentCache.h"
 
 #include <QPropertyAnimation>
 #include <QTextLayout>
@@ -89,7 +91,6 @@ static unsigned int kBannerWidgetHeight = 0;
 static const int kSaucerRadiusSquared = 146 * 146;
 
 static const unsigned int kHideHelpTimeoutInMS = 1000;
-static const unsigned int kPaintTick = 1000;
 
 // strings used as keys to lookup locale versions
 static const char* kUnlockLabel = "Drag up to unlock";
@@ -358,6 +359,7 @@ LockWindow::LockWindow(uint32_t maxWidth, uint32_t maxHeight)
 
 	connect(SystemUiController::instance(), SIGNAL(signalBannerAboutToUpdate(QRect&)), this, SLOT(slotBannerAboutToUpdate(QRect&)));
 	connect(SystemUiController::instance(), SIGNAL(signalBootFinished()), this, SLOT(slotBootFinished()));
+	connect(StatusBarServicesConnector::instance(), SIGNAL(signalSystemTimeChanged()), this, SLOT(slotSystemTimeChanged()));
 
 //	connect(SystemService::instance(), SIGNAL(signalDeviceUnlocked()), this, SLOT(slotDeviceUnlocked()));
 //	connect(SystemService::instance(), SIGNAL(signalCancelPinEntry()), this, SLOT(slotCancelPasswordEntry()));
@@ -468,12 +470,13 @@ void LockWindow::init()
     if(qmlEngine) {
         QDeclarativeContext* context =	qmlEngine->rootContext();
 
+		QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+
 		std::string qmlPath = settings->lunaQmlUiComponentsPath + "UnlockPanel/UnlockPanel.qml";
-		QUrl url = QUrl::fromLocalFile(qmlPath.c_str());
         qmlRegisterType<InputItem>("CustomComponents", 1, 0, "InputItem");
-		m_qmlUnlockPanel = new QDeclarativeComponent(qmlEngine, url, this);
+		m_qmlUnlockPanel = qmlCache->component(qmlPath.c_str());
         if(m_qmlUnlockPanel) {
-			m_unlockPanel = qobject_cast<InputItem *>(m_qmlUnlockPanel->create());
+			m_unlockPanel = qobject_cast<InputItem *>(qmlCache->create(m_qmlUnlockPanel));
 			if(m_unlockPanel) {
 
                 m_unlockPanel->setPos (-m_unlockPanel->boundingRect().width()/2, -m_unlockPanel->boundingRect().height()/2);
@@ -489,10 +492,9 @@ void LockWindow::init()
 		}
 
 		qmlPath = settings->lunaQmlUiComponentsPath + "MessageDialog/MessageDialog.qml";
-		url = QUrl::fromLocalFile(qmlPath.c_str());
-		m_qmlUnlockDialog = new QDeclarativeComponent(qmlEngine, url, this);
+		m_qmlUnlockDialog = qmlCache->component(qmlPath.c_str());
 		if(m_qmlUnlockDialog) {
-			m_unlockDialog = qobject_cast<QGraphicsObject *>(m_qmlUnlockDialog->create());
+			m_unlockDialog = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlUnlockDialog));
 			if(m_unlockPanel) {
 				m_unlockDialog->setPos (-m_unlockDialog->boundingRect().width()/2, -m_unlockDialog->boundingRect().height()/2);
 				m_unlockDialog->setParentItem(this);
@@ -780,7 +782,7 @@ void LockWindow::handlePowerOn()
 	// start up the paint timer
 	m_clockWin->tick();
 	if (!m_paintTimer.running())
-		m_paintTimer.start(kPaintTick);
+		m_paintTimer.start(m_clockWin->msToNextTick(), true);
 }
 
 void LockWindow::handlePowerOff()
@@ -970,8 +972,8 @@ void LockWindow::changeState(State newState)
 		// put the unlock button at its resting spot
 		m_lockButton->reset();
 
-		// kick off our timer
-		m_paintTimer.start(kPaintTick);
+		// kick off our timer, on the next minute boundary
+		m_paintTimer.start(m_clockWin->msToNextTick(), true);
 
 		// time stamp when the screen was locked
 		m_lastLocked = Time::curSysTimeMs();
@@ -1586,10 +1588,19 @@ void LockWindow::slotDialogButton3Pressed()
 
 bool LockWindow::paint()
 {
+	// one wakeup per minute: realign on the wall clock every time instead of drifting
 	if (m_clockWin) {
 		m_clockWin->tick();
+		m_paintTimer.start(m_clockWin->msToNextTick(), true);
 	}
-	return true;
+	return false;
+}
+
+void LockWindow::slotSystemTimeChanged()
+{
+	// the pending tick was aligned on the old time
+	if (m_paintTimer.running())
+		paint();
 }
 
 QRectF LockWindow::boundingRect() const
@@ -123,6 +123,7 @@ private Q_SLOTS:
 	void slotPositiveSpaceChangeFinished(const QRect& r);
 
 	void slotUiRotationCompleted();
+	void slotSystemTimeChanged();
 
 private:
 
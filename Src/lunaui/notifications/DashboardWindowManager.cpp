@@ -57,6 +57,7 @@
 #include "DockModeWindowManager.h"
 #include "WebosTapAndHoldGesture.h"
 #include "SingleClickGesture.h"
+#include "QmlComponentCache.h"
 #include <QGraphicsPixmapItem>
 
 static const int kTabletAlertWindowPadding       = 5;
@@ -156,10 +157,10 @@ void DashboardWindowManager::init()
 
 			 Settings* settings = Settings::LunaSettings();
 			 std::string systemMenuQmlPath = settings->lunaQmlUiComponentsPath + "DashboardMenu/DashboardMenu.qml";
-			 QUrl url = QUrl::fromLocalFile(systemMenuQmlPath.c_str());
-			 m_qmlNotifMenu = new QDeclarativeComponent(qmlEngine, url, this);
+			 QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+			 m_qmlNotifMenu = qmlCache->component(systemMenuQmlPath.c_str());
              if(m_qmlNotifMenu) {
-				 m_menuObject = qobject_cast<QGraphicsObject *>(m_qmlNotifMenu->create());
+				 m_menuObject = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlNotifMenu));
 				 if(m_menuObject) {
 					 m_menuObject->setParentItem(this);
 					 m_notifMenuRightEdgeOffset = m_menuObject->property("edgeOffset").toInt();
@@ -31,6 +31,7 @@
 #include "QmlAlertWindow.h"
 #include "Settings.h"
 #include "WindowServerLuna.h"
+#include "QmlComponentCache.h"
 
 QmlAlertWindow::QmlAlertWindow(const QString& path, int width, int height)
 	: AlertWindow(WindowType::Type_PopupAlert, width, height, true)
@@ -39,10 +40,10 @@ QmlAlertWindow::QmlAlertWindow(const QString& path, int width, int height)
 	if (qmlEngine) {
 		QDeclarativeContext* context =	qmlEngine->rootContext();
 		Settings* settings = Settings::LunaSettings();
-		QUrl url = QUrl::fromLocalFile(path);
-		m_qmlComp = new QDeclarativeComponent(qmlEngine, url, this);
+		QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+		m_qmlComp = qmlCache->component(path);
         if (m_qmlComp) {
-			m_gfxObj = qobject_cast<QGraphicsObject*>(m_qmlComp->create());
+			m_gfxObj = qobject_cast<QGraphicsObject*>(qmlCache->create(m_qmlComp));
 			if (m_gfxObj) {
 				m_gfxObj->setPos(-width/2, -height/2);
 				m_gfxObj->setParentItem(this);
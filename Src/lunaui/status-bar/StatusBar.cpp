@@ -31,6 +31,7 @@
 #include "StatusBarNotificationArea.h"
 #include "StatusBarItemGroup.h"
 #include "StatusBarServicesConnector.h"
+#include "StatusBarRenderCache.h"
 #include "AnimationSettings.h"
 #include "WindowServerLuna.h"
 #include "DashboardWindowManager.h"
@@ -74,6 +75,10 @@ StatusBar::StatusBar(StatusBarType type, int width, int height)
 
 	m_bounds = QRect(-width/2, -height/2, width, height);
 
+	// the clock and battery glyphs depend on the locale's digits and date format
+	connect(LocalePreferences::instance(), SIGNAL(prefsLocaleChanged()),
+			StatusBarRenderCache::instance(), SLOT(clearGlyphs()), Qt::UniqueConnection);
+
     // Charging icon
     m_battery = new StatusBarBattery();
 
@@ -25,6 +25,7 @@
 #include "StatusBarServicesConnector.h"
 #include "SystemUiController.h"
 #include "SoundPlayerPool.h"
+#include "StatusBarRenderCache.h"
 
 #include <QPainter>
 
@@ -54,9 +55,7 @@ StatusBarBattery::StatusBarBattery(bool showText)
 
 	// Load a single image to get the size -- defer all others until init
 	std::string errorPath = statusBarImagesPath + "battery-error.png";
-	m_errorPixmap = QPixmap(errorPath.c_str());
-
-	if (!m_errorPixmap.isNull()) {
+	if (StatusBarRenderCache::instance()->addIcon(errorPath, m_errorPixmap)) {
 		m_imgWidth = m_errorPixmap.width() + BATTERY_IMAGE_WIDTH_PADDING;
 		m_imgHeight = m_errorPixmap.height();
 	}
@@ -103,45 +102,31 @@ QRectF StatusBarBattery::boundingRect() const
 
 void StatusBarBattery::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+	const QPixmap* atlas = StatusBarRenderCache::instance()->iconAtlas();
+	QRect source;
+
 	if (!m_powerdConnected) {
-		if (!m_errorPixmap.isNull()) {
-			painter->drawPixmap(m_bounds.x() + (m_bounds.width() - m_pixmap[m_chargeState].width())/2.0,
-					            m_bounds.y() + (m_bounds.height() - m_chargingPixmap[m_chargeState].height())/2.0,
-					            m_errorPixmap);
-		}
+		source = m_errorPixmap;
+	} else if (m_charging) {
+		source = m_chargingPixmap[m_chargeState];
 	} else {
-		if (m_charging) {
-			if (!m_chargingPixmap[m_chargeState].isNull()) {
-				painter->drawPixmap(m_bounds.x() + (m_bounds.width() - m_pixmap[m_chargeState].width())/2.0,
-						            m_bounds.y() + (m_bounds.height() - m_chargingPixmap[m_chargeState].height())/2.0,
-						            m_chargingPixmap[m_chargeState]);
-			}
-		} else {
-			if (!m_pixmap[m_chargeState].isNull()) {
-				painter->drawPixmap(m_bounds.x() + (m_bounds.width() - m_pixmap[m_chargeState].width())/2.0,
-						            m_bounds.y() + (m_bounds.height() - m_chargingPixmap[m_chargeState].height())/2.0,
-						            m_pixmap[m_chargeState]);
-			}
-		}
+		source = m_pixmap[m_chargeState];
 	}
 
-	if(Settings::LunaSettings()->tabletUi && m_showBatteryText) {
-		QPen oldPen = painter->pen();
-		QFont origFont = painter->font();
-		painter->setFont(*m_font);
+	if (!source.isNull()) {
+		painter->drawPixmap(QPointF(m_bounds.x() + (m_bounds.width() - m_pixmap[m_chargeState].width())/2.0,
+									m_bounds.y() + (m_bounds.height() - m_chargingPixmap[m_chargeState].height())/2.0),
+							*atlas, source);
+	}
 
+	if(Settings::LunaSettings()->tabletUi && m_showBatteryText) {
 		QFontMetrics fontMetrics(*m_font);
 
 		int baseLine = m_textHeight/2 - fontMetrics.descent() + TEXT_BASELINE_OFFSET;
 
-		// paint the text
-		painter->setPen(QColor(0xFF, 0xFF, 0xFF, 0xFF));
-
-		painter->drawText(QPointF(m_bounds.width()/2 - m_imgWidth - m_textWidth, baseLine), m_batteryText);
-
-		painter->setPen(oldPen);
-		painter->setFont(origFont);
-
+		// paint the text, from the pre-rendered glyphs
+		StatusBarRenderCache::instance()->drawText(painter, *m_font, QColor(0xFF, 0xFF, 0xFF, 0xFF),
+												   QPointF(m_bounds.width()/2 - m_imgWidth - m_textWidth, baseLine), m_batteryText);
 	}
 }
 
@@ -154,6 +139,7 @@ void StatusBarBattery::init()
 
 	Settings* settings = Settings::LunaSettings();
 	std::string statusBarImagesPath = settings->lunaSystemResourcesPath + "/statusBar/";
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
 
 	for (i = 0; i < kNumBatteryStates; i++) {
 		::snprintf(intBuf, sizeof(intBuf), "%d", i);
@@ -169,15 +155,12 @@ void StatusBarBattery::init()
 		if (i == (kNumBatteryStates - 1)) {
 			m_pixmap[i] = m_pixmap[i-1];
 		} else {
-			m_pixmap[i] = QPixmap(batteryPath.c_str());
+			cache->addIcon(batteryPath, m_pixmap[i]);
 		}
 
-		m_chargingPixmap[i] = QPixmap(chargingPath.c_str());
+		cache->addIcon(chargingPath, m_chargingPixmap[i]);
 	}
 
-	std::string errorPath = statusBarImagesPath + "battery-error.png";
-	m_errorPixmap = QPixmap(errorPath.c_str());
-
 	// Instantiates and initialized the services connector
 	StatusBarServicesConnector* svcConnector = StatusBarServicesConnector::instance();
 
@@ -222,6 +205,9 @@ void StatusBarBattery::slotBatteryLevelUpdated(int percentage)
 
 void StatusBarBattery::slotChargingStateUpdated(bool charging)
 {
+	if(charging == m_charging)
+		return;
+
 	m_charging = charging;
 
 	update();
@@ -250,6 +236,10 @@ void StatusBarBattery::setBatteryLevelText(int percent)
 		sprintf(text, " ? ");
 	}
 
+	// the level is reported far more often than it changes
+	if(m_batteryText == QLatin1String(text))
+		return;
+
 	QFontMetrics fontMetrics(*m_font);
 
 	m_batteryText = QString(text);
@@ -62,9 +62,10 @@ private:
 
 	static const int kNumBatteryStates = 13;
 	static const int m_chargeLevels[kNumBatteryStates];
-	QPixmap m_pixmap[kNumBatteryStates];
-	QPixmap m_chargingPixmap[kNumBatteryStates];
-	QPixmap m_errorPixmap;
+	// in the status bar icon atlas
+	QRect   m_pixmap[kNumBatteryStates];
+	QRect   m_chargingPixmap[kNumBatteryStates];
+	QRect   m_errorPixmap;
 	int     m_textWidth;
 	int     m_textHeight;
 	int     m_imgWidth;
@@ -25,6 +25,7 @@
 #include "Preferences.h"
 #include "Localization.h"
 #include "StatusBarServicesConnector.h"
+#include "StatusBarRenderCache.h"
 
 #include <QPainter>
 #include <QTimer>
@@ -114,26 +115,13 @@ void StatusBarClock::setDisplayDate(bool date)
 
 void StatusBarClock::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-#if defined TARGET_DESKTOP && (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    painter->drawPixmap(-boundingRect().width() / 2, -boundingRect().height() / 2, m_textPixmap);
-#else
-	QPen oldPen = painter->pen();
-
-	QFont origFont = painter->font();
-	painter->setFont(*m_font);
-
 	QFontMetrics fontMetrics(*m_font);
 
 	int baseLine = m_textRect.height()/2 - fontMetrics.descent() + TEXT_BASELINE_OFFSET;
 
-	// paint the text
-	painter->setPen(QColor(0xFF, 0xFF, 0xFF, 0xFF));
-
-	painter->drawText(QPointF(-m_textRect.width()/2, baseLine), m_timeText);
-
-	painter->setPen(oldPen);
-	painter->setFont(origFont);
-#endif
+	// paint the text (from the pre-rendered glyphs, unless it has letters in it)
+	StatusBarRenderCache::instance()->drawText(painter, *m_font, QColor(0xFF, 0xFF, 0xFF, 0xFF),
+											   QPointF(-m_textRect.width()/2, baseLine), m_timeText);
 }
 
 void StatusBarClock::setTimeText(const char *time, bool doUpdate)
@@ -152,18 +140,6 @@ void StatusBarClock::setTimeText(const QString& time, bool doUpdate)
 
 	m_textRect = fontMetrics.boundingRect(m_timeText);
 
-#if defined TARGET_DESKTOP && (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    m_textPixmap = QPixmap(boundingRect().width(), boundingRect().height());
-    m_textPixmap.fill(Qt::transparent);
-
-    QPainter p;
-    p.begin(&m_textPixmap);
-    p.setFont(*m_font);
-    p.setPen(QColor(0xFF, 0xFF, 0xFF, 0xFF));
-    p.drawText(m_textPixmap.rect(), Qt::AlignCenter, m_timeText);
-    p.end();
-#endif
-
 	if (doUpdate) {
 		update();
 	}
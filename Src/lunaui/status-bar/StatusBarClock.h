@@ -60,9 +60,6 @@ private:
 	QString m_timeText;
 	QRectF m_textRect;
 	QFont* m_font;
-#if defined TARGET_DESKTOP && (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    QPixmap m_textPixmap;
-#endif
 
 	bool m_twelveHour;
 	bool m_displayDate;
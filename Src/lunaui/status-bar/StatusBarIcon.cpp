@@ -43,6 +43,13 @@ StatusBarIcon::~StatusBarIcon()
 void StatusBarIcon::setImage(QPixmap* img)
 {
 	m_imgPtr = img;
+	m_imgSource = QRect();
+}
+
+void StatusBarIcon::setImage(const QPixmap* atlas, const QRect& source)
+{
+	m_imgPtr = atlas;
+	m_imgSource = source;
 }
 
 QRect StatusBarIcon::boundingRect() const
@@ -53,9 +60,10 @@ QRect StatusBarIcon::boundingRect() const
 void StatusBarIcon::updateBoundingRect(bool forceRepaint)
 {
 	if(m_imgPtr && !m_imgPtr->isNull() && m_visible) {
+		QRect source = imageSource();
 		int imgWidth, imgHeight, maxHeight;
-		imgWidth = m_imgPtr->width();
-		imgHeight = m_imgPtr->height();
+		imgWidth = source.width();
+		imgHeight = source.height();
 		maxHeight = Settings::LunaSettings()->positiveSpaceTopPadding - 2;
 
 		if(imgHeight > maxHeight) {
@@ -152,8 +160,9 @@ void StatusBarIcon::paint(QPainter* painter, QPoint centerRight, int fraction)
 		int imgWidth, imgHeight, maxHeight;
 		qreal ratio = 1.0;
 		bool scaled = false;
-		imgWidth = m_imgPtr->width();
-		imgHeight = m_imgPtr->height();
+		QRect source = imageSource();
+		imgWidth = source.width();
+		imgHeight = source.height();
 		maxHeight = Settings::LunaSettings()->positiveSpaceTopPadding - 2;
 
 		if(imgHeight > maxHeight) {
@@ -169,13 +178,13 @@ void StatusBarIcon::paint(QPainter* painter, QPoint centerRight, int fraction)
 				painter->drawPixmap(centerRight.x() - imgWidth, centerRight.y() - imgHeight/2,
 									imgWidth, imgHeight,
 									*m_imgPtr,
-									0, 0, m_imgPtr->width(), m_imgPtr->height());
+									source.x(), source.y(), source.width(), source.height());
 			} else {
 				painter->setOpacity(0.5 * opacity);
 				painter->drawPixmap(centerRight.x() - imgWidth, centerRight.y() - imgHeight/2,
 									fraction/ratio, imgHeight,
 									*m_imgPtr,
-									0, 0, fraction, m_imgPtr->height());
+									source.x(), source.y(), fraction, source.height());
 				painter->setOpacity(opacity);
 			}
 		} else if(m_animState == SLIDE_ANIMATION) {
@@ -185,13 +194,13 @@ void StatusBarIcon::paint(QPainter* painter, QPoint centerRight, int fraction)
 				painter->drawPixmap(centerRight.x() - width, centerRight.y() - imgHeight/2,
 									width, imgHeight,
 									*m_imgPtr,
-									0, 0, m_imgPtr->width() * m_animWidth, m_imgPtr->height());
+									source.x(), source.y(), source.width() * m_animWidth, source.height());
 			} else {
 				painter->setOpacity(m_animOpacity * opacity * 0.5);
 				painter->drawPixmap(centerRight.x() - width, centerRight.y() - imgHeight/2,
 									(fraction/ratio) * m_animWidth, imgHeight,
 									*m_imgPtr,
-									0, 0, fraction * m_animWidth, m_imgPtr->height());
+									source.x(), source.y(), fraction * m_animWidth, source.height());
 			}
 			painter->setOpacity(opacity);
 		}
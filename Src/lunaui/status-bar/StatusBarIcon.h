@@ -61,6 +61,7 @@ public:
 	void paint(QPainter* painter, QPoint centerRight, int width=-1);
 
 	void setImage(QPixmap* img);
+	void setImage(const QPixmap* atlas, const QRect& source); // part of an atlas
 
 protected Q_SLOTS:
 	void slotAnimFinished();
@@ -77,7 +78,10 @@ protected:
 		SLIDE_ANIMATION
 	};
 
-	QPixmap* m_imgPtr;
+	QRect imageSource() const { return m_imgSource.isNull() ? m_imgPtr->rect() : m_imgSource; }
+
+	const QPixmap* m_imgPtr;
+	QRect m_imgSource; // null for the whole pixmap
 
 	QRect m_bounds;
 	bool  m_visible;
@@ -23,6 +23,7 @@
 #include "Settings.h"
 #include "Preferences.h"
 #include "StatusBarServicesConnector.h"
+#include "StatusBarRenderCache.h"
 
 #include <QPainter>
 
@@ -40,13 +41,13 @@ StatusBarInfoItem::~StatusBarInfoItem()
 
 void StatusBarInfoItem::loadImage(int index, std::string imgPath)
 {
-	QPixmap img;
+	QRect source;
 
 	if(!imgPath.empty()) {
-		img.load(imgPath.c_str());
+		StatusBarRenderCache::instance()->addIcon(imgPath, source);
 	}
 
-	m_images.insert(index, img);
+	m_images.insert(index, source);
 }
 
 void StatusBarInfoItem::selectImage(unsigned int index)
@@ -55,7 +56,7 @@ void StatusBarInfoItem::selectImage(unsigned int index)
 		m_imgIndex = index;
 
 		if(!m_images[index].isNull()) {
-			setImage(&m_images[index]);
+			setImage(StatusBarRenderCache::instance()->iconAtlas(), m_images[index]);
 		} else {
 			setImage(NULL);
 		}
@@ -84,7 +85,9 @@ StatusBarInfo::StatusBarInfo(StatusBar::StatusBarType type)
 	, m_mute(0)
 	, m_airplaneMode(0)
 {
-
+	m_commitTimer.setSingleShot(true);
+	m_commitTimer.setInterval(kCommitIntervalMs);
+	connect(&m_commitTimer, SIGNAL(timeout()), SLOT(slotCommit()));
 }
 
 StatusBarInfo::~StatusBarInfo()
@@ -328,88 +331,171 @@ void StatusBarInfo::slotDualRssiEnabled()
 
 }
 
-void StatusBarInfo::updateItem(StatusBarInfoItem * item, bool shown, int index)
+// returns true if the item starts showing or hiding
+bool StatusBarInfo::updateItem(StatusBarInfoItem * item, bool shown, int index)
 {
 	if(!item)
-		return;
+		return false;
+
+	bool wasVisible = item->isVisible();
 
 	if(shown) {
 		item->selectImage(index);
-		if(!item->isVisible()) {
+		if(!wasVisible) {
 			item->show();
 		}
 	} else {
-		if(item->isVisible()) {
+		if(wasVisible) {
 			item->hide();
 		}
 	}
 
-	update();
+	return shown != wasVisible;
+}
+
+StatusBarInfoItem* StatusBarInfo::itemFor(StatusBarModel::Icon icon) const
+{
+	switch(icon) {
+	case StatusBarModel::IconRSSI:			return m_rssi;
+	case StatusBarModel::IconRSSI1x:		return m_rssi1x;
+	case StatusBarModel::IconWAN:			return m_wan;
+	case StatusBarModel::IconBluetooth:		return m_bluetooth;
+	case StatusBarModel::IconWifi:			return m_wifi;
+	case StatusBarModel::IconTTY:			return m_tty;
+	case StatusBarModel::IconHAC:			return m_hac;
+	case StatusBarModel::IconCallForward:	return m_callForward;
+	case StatusBarModel::IconRoaming:		return m_roaming;
+	case StatusBarModel::IconVpn:			return m_vpn;
+	case StatusBarModel::IconRotationLock:	return m_rotationLock;
+	case StatusBarModel::IconMute:			return m_mute;
+	case StatusBarModel::IconAirplaneMode:	return m_airplaneMode;
+	default:								return 0;
+	}
+}
+
+// where paint() puts the item, in item coordinates
+QRectF StatusBarInfo::itemRect(StatusBarInfoItem* item) const
+{
+	qreal right = 0;
+
+	for(int x = 0; x < m_icons.size(); x++) {
+		StatusBarInfoItem* icon = m_icons.at(x);
+		if(!icon->isVisible())
+			continue;
+
+		QRect iconBounds = icon->boundingRect();
+		if(icon == item)
+			return QRectF(right - iconBounds.width(), -iconBounds.height()/2, iconBounds.width(), iconBounds.height());
+
+		right -= iconBounds.width() + (ICON_SPACING * icon->visiblePortion());
+	}
+
+	return QRectF();
+}
+
+void StatusBarInfo::queueItem(StatusBarModel::Icon icon, bool shown, int index)
+{
+	if(m_model.set(icon, shown, index)) {
+		if(!m_commitTimer.isActive())
+			m_commitTimer.start();
+	} else if(m_commitTimer.isActive()) {
+		// everything went back to what is on screen
+		m_commitTimer.stop();
+	}
+}
+
+void StatusBarInfo::slotCommit()
+{
+	QRectF oldBounds = m_bounds;
+	bool relayout = false;
+	QRectF dirtyRect;
+
+	unsigned int changed = m_model.commit();
+	for(int i = 0; i < StatusBarModel::NumIcons; i++) {
+		if(!(changed & (1U << i)))
+			continue;
+
+		StatusBarModel::Icon icon = (StatusBarModel::Icon) i;
+		StatusBarInfoItem* item = itemFor(icon);
+		const StatusBarModel::State& state = m_model.rendered(icon);
+
+		if(updateItem(item, state.shown, state.index))
+			relayout = true;
+		else if(item && item->isVisible())
+			dirtyRect |= itemRect(item);
+	}
+
+	// showing or hiding an icon, or a new image of another size, moves the icons on
+	// its left: only a new image in the same place can be repainted on its own
+	if(relayout || m_bounds != oldBounds)
+		update();
+	else if(!dirtyRect.isEmpty())
+		update(dirtyRect);
 }
 
 void StatusBarInfo::setRSSI(bool shown, StatusBar::IndexRSSI index)
 {
-	updateItem(m_rssi, shown, (int) index);
+	queueItem(StatusBarModel::IconRSSI, shown, (int) index);
 }
 
 void StatusBarInfo::setRSSI1x(bool shown, StatusBar::IndexRSSI1x index)
 {
-	updateItem(m_rssi1x, shown, (int) index);
+	queueItem(StatusBarModel::IconRSSI1x, shown, (int) index);
 }
 
 void StatusBarInfo::setTTY(bool enabled)
 {
-	updateItem(m_tty, enabled, 0);
+	queueItem(StatusBarModel::IconTTY, enabled, 0);
 }
 
 void StatusBarInfo::setHAC(bool enabled)
 {
-	updateItem(m_hac, enabled, 0);
+	queueItem(StatusBarModel::IconHAC, enabled, 0);
 }
 
 void StatusBarInfo::setCallForward(bool enabled)
 {
-	updateItem(m_callForward, enabled, 0);
+	queueItem(StatusBarModel::IconCallForward, enabled, 0);
 }
 
 void StatusBarInfo::setRoaming(bool enabled)
 {
-	updateItem(m_roaming, enabled, 0);
+	queueItem(StatusBarModel::IconRoaming, enabled, 0);
 }
 
 void StatusBarInfo::setVpn(bool enabled)
 {
-	updateItem(m_vpn, enabled, 0);
+	queueItem(StatusBarModel::IconVpn, enabled, 0);
 }
 
 void StatusBarInfo::setWAN(bool shown, StatusBar::IndexWAN index)
 {
-	updateItem(m_wan, shown, (int) index);
+	queueItem(StatusBarModel::IconWAN, shown, (int) index);
 }
 
 void StatusBarInfo::setBluetooth(bool shown, StatusBar::IndexBluetooth index)
 {
-	updateItem(m_bluetooth, shown, (int) index);
+	queueItem(StatusBarModel::IconBluetooth, shown, (int) index);
 }
 
 void StatusBarInfo::setWifi(bool shown, StatusBar::IndexWiFi index)
 {
-	updateItem(m_wifi, shown, (int) index);
+	queueItem(StatusBarModel::IconWifi, shown, (int) index);
 }
 
 void StatusBarInfo::setRotationLock(bool locked)
 {
-	updateItem(m_rotationLock, locked, 0);
+	queueItem(StatusBarModel::IconRotationLock, locked, 0);
 }
 
 void StatusBarInfo::setMute(bool muteOn)
 {
-	updateItem(m_mute, muteOn, 0);
+	queueItem(StatusBarModel::IconMute, muteOn, 0);
 }
 
 void StatusBarInfo::setAirplaneMode(bool airplaneModeOn)
 {
-	updateItem(m_airplaneMode, airplaneModeOn, 0);
+	queueItem(StatusBarModel::IconAirplaneMode, airplaneModeOn, 0);
 }
 
 void StatusBarInfo::slotAirplaneModeState(t_airplaneModeState state) {
@@ -26,9 +26,11 @@
 #include "StatusBarItem.h"
 #include "StatusBarIcon.h"
 #include "StatusBarServicesConnector.h"
+#include "StatusBarModel.h"
 
 #include <QGraphicsObject>
 #include <QPixmap>
+#include <QTimer>
 
 
 class StatusBarInfoItem : public StatusBarIcon
@@ -45,7 +47,7 @@ public:
 
 private:
 
-	QVector<QPixmap> m_images;
+	QVector<QRect> m_images; // in the icon atlas
 	int m_imgIndex;
 
 };
@@ -91,8 +93,14 @@ private Q_SLOTS:
 	void slotRoamingIndicatorChanged();
 	void slotDualRssiEnabled();
 	void slotAirplaneModeState(t_airplaneModeState state);
+	void slotCommit();
 private:
-	void updateItem(StatusBarInfoItem * item, bool shown, int index);
+	static const int kCommitIntervalMs = 16; // one frame
+
+	void queueItem(StatusBarModel::Icon icon, bool shown, int index);
+	StatusBarInfoItem* itemFor(StatusBarModel::Icon icon) const;
+	QRectF itemRect(StatusBarInfoItem* item) const;
+	bool updateItem(StatusBarInfoItem * item, bool shown, int index);
 	std::string getRoamingImageName(std::string roamingIndicatorName);
 
 	StatusBar::StatusBarType m_type;
@@ -113,6 +121,9 @@ private:
 	StatusBarInfoItem *m_mute;
 	StatusBarInfoItem *m_airplaneMode;
 
+	// what the icons should show; committed to them at most once per frame
+	StatusBarModel m_model;
+	QTimer m_commitTimer;
 };
 
 
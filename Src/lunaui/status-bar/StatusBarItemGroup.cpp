@@ -390,14 +390,22 @@ void StatusBarItemGroup::paint(QPainter* painter, const QStyleOptionGraphicsItem
 	}
 
 	if(m_activeBkgPix && (m_overlayOpacity > 0.0)) {
-		painter->setOpacity(opacity * m_overlayOpacity);
+		QSize tabSize = tabRect.size().toSize();
+		if(m_activeTabPix.size() != tabSize && !tabSize.isEmpty()) {
+			m_activeTabPix = QPixmap(tabSize);
+			m_activeTabPix.fill(Qt::transparent);
+
+			QPainter p(&m_activeTabPix);
+			p.drawPixmap(0, 0, margin, tabSize.height(),
+						 *m_activeBkgPix, 0, 0, margin, m_activeBkgPix->height());
+			p.drawPixmap(margin, 0, tabSize.width() - 2*margin, tabSize.height(),
+						 *m_activeBkgPix, margin, 0, m_activeBkgPix->width() - 2*margin, m_activeBkgPix->height());
+			p.drawPixmap(tabSize.width() - margin, 0, margin, tabSize.height(),
+						 *m_activeBkgPix, m_activeBkgPix->width() - margin, 0, margin, m_activeBkgPix->height());
+		}
 
-		painter->drawPixmap(tabRect.x(), tabRect.y(), margin, tabRect.height(),
-							*m_activeBkgPix, 0, 0, margin, m_activeBkgPix->height());
-		painter->drawPixmap(tabRect.x() + margin, tabRect.y(), tabRect.width() - 2*margin, tabRect.height(),
-							*m_activeBkgPix, margin, 0, m_activeBkgPix->width() - 2*margin, m_activeBkgPix->height());
-		painter->drawPixmap(tabRect.x() + tabRect.width() - margin, tabRect.y(), margin, tabRect.height(),
-							*m_activeBkgPix, m_activeBkgPix->width() - margin, 0, margin, m_activeBkgPix->height());
+		painter->setOpacity(opacity * m_overlayOpacity);
+		painter->drawPixmap(tabRect.topLeft(), m_activeTabPix);
 	}
 
 //	if(m_mouseDown && m_pressedBkgPix) {
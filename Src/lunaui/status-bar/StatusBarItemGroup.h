@@ -102,6 +102,7 @@ private:
 	bool     m_actionable;
 	bool     m_mouseDown;
 	QPixmap* m_activeBkgPix;
+	QPixmap  m_activeTabPix; // m_activeBkgPix stretched to the tab, rebuilt when its size changes
 //	QPixmap* m_pressedBkgPix;
 	QPixmap* m_arrowPix;
 	QPixmap* m_separatorPix;
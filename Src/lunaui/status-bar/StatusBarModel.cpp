@@ -0,0 +1,88 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "StatusBarModel.h"
+
+StatusBarModel::StatusBarModel()
+	: m_dirty(0)
+	, m_forced(0)
+	, m_numEvents(0)
+	, m_numCommits(0)
+	, m_numChanges(0)
+{
+	// every icon starts out hidden
+	for (int i = 0; i < NumIcons; i++) {
+		m_pending[i].shown = false;
+		m_pending[i].index = 0;
+		m_rendered[i] = m_pending[i];
+	}
+}
+
+bool StatusBarModel::same(const State& a, const State& b)
+{
+	if (a.shown != b.shown)
+		return false;
+
+	return !a.shown || a.index == b.index;
+}
+
+bool StatusBarModel::set(Icon icon, bool shown, int index)
+{
+	m_numEvents++;
+
+	m_pending[icon].shown = shown;
+	m_pending[icon].index = index;
+
+	// an icon that went back to what is on screen within the frame is clean again
+	unsigned int bit = 1U << icon;
+	if (same(m_pending[icon], m_rendered[icon]) && !(m_forced & bit))
+		m_dirty &= ~bit;
+	else
+		m_dirty |= bit;
+
+	return m_dirty != 0;
+}
+
+void StatusBarModel::invalidate(Icon icon)
+{
+	m_forced |= 1U << icon;
+	m_dirty |= 1U << icon;
+}
+
+unsigned int StatusBarModel::commit()
+{
+	unsigned int changed = m_dirty;
+	if (!changed)
+		return 0;
+
+	for (int i = 0; i < NumIcons; i++) {
+		if (changed & (1U << i)) {
+			m_rendered[i] = m_pending[i];
+			m_numChanges++;
+		}
+	}
+
+	m_dirty = 0;
+	m_forced = 0;
+	m_numCommits++;
+
+	return changed;
+}
@@ -0,0 +1,95 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef STATUSBARMODEL_H
+#define STATUSBARMODEL_H
+
+/**
+ * What the status bar info icons should show, as opposed to what they show.
+ *
+ * Service events only record the new state of an icon here. Once per frame, commit()
+ * hands back the icons whose state differs from the last one rendered, so that an
+ * icon flapping within a frame, or a service repeating itself, costs no repaint.
+ * An icon that is hidden has no image: its index does not count as a change.
+ */
+class StatusBarModel
+{
+public:
+
+	enum Icon {
+		IconRSSI = 0,
+		IconRSSI1x,
+		IconWAN,
+		IconBluetooth,
+		IconWifi,
+		IconTTY,
+		IconHAC,
+		IconCallForward,
+		IconRoaming,
+		IconVpn,
+		IconRotationLock,
+		IconMute,
+		IconAirplaneMode,
+		NumIcons
+	};
+
+	struct State
+	{
+		bool	shown;
+		int		index;
+	};
+
+	StatusBarModel();
+
+	// returns true when a commit is needed
+	bool			set(Icon icon, bool shown, int index);
+	bool			dirty() const { return m_dirty != 0; }
+
+	// forces the icon out on the next commit, whatever its state
+	void			invalidate(Icon icon);
+
+	// marks the pending state as rendered, and returns the icons that changed, as a
+	// mask of (1 << Icon)
+	unsigned int	commit();
+
+	const State&	pending(Icon icon) const { return m_pending[icon]; }
+	const State&	rendered(Icon icon) const { return m_rendered[icon]; }
+
+	// since construction
+	unsigned int	numEvents() const { return m_numEvents; }
+	unsigned int	numCommits() const { return m_numCommits; }
+	unsigned int	numChanges() const { return m_numChanges; }
+
+private:
+
+	static bool		same(const State& a, const State& b);
+
+	State			m_pending[NumIcons];
+	State			m_rendered[NumIcons];
+	unsigned int	m_dirty;
+	unsigned int	m_forced;
+
+	unsigned int	m_numEvents;
+	unsigned int	m_numCommits;
+	unsigned int	m_numChanges;
+};
+
+#endif /* STATUSBARMODEL_H */
@@ -0,0 +1,252 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "StatusBarRenderCache.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QFontMetrics>
+#include <glib.h>
+
+static const int kStripWidth = 512;
+static const int kStripMinHeight = 64;
+
+// between packed images, so that smooth scaling doesn't pick up the neighbours
+static const int kStripPadding = 1;
+
+// room around each glyph for what overhangs its advance (italics, bold)
+static const int kGlyphPadding = 2;
+
+static StatusBarRenderCache* s_instance = 0;
+
+StatusBarRenderCache* StatusBarRenderCache::instance()
+{
+	if (G_UNLIKELY(s_instance == 0))
+		s_instance = new StatusBarRenderCache;
+
+	return s_instance;
+}
+
+StatusBarRenderCache::StatusBarRenderCache()
+	: m_lastGlyphSet(0)
+	, m_numGlyphs(0)
+{
+}
+
+StatusBarRenderCache::~StatusBarRenderCache()
+{
+	clearGlyphs();
+}
+
+QRect StatusBarRenderCache::Strip::add(const QImage& image)
+{
+	int w = image.width();
+	int h = image.height();
+
+	if (x > 0 && x + w > kStripWidth) {
+		x = 0;
+		y += rowHeight + kStripPadding;
+		rowHeight = 0;
+	}
+
+	int neededWidth = qMax(kStripWidth, x + w);
+	int neededHeight = y + h;
+
+	if (pixmap.isNull() || neededWidth > pixmap.width() || neededHeight > pixmap.height()) {
+		int newHeight = pixmap.isNull() ? kStripMinHeight : pixmap.height();
+		while (newHeight < neededHeight)
+			newHeight *= 2;
+
+		QPixmap grown(qMax(neededWidth, pixmap.width()), newHeight);
+		grown.fill(Qt::transparent);
+		if (!pixmap.isNull()) {
+			QPainter p(&grown);
+			p.setCompositionMode(QPainter::CompositionMode_Source);
+			p.drawPixmap(0, 0, pixmap);
+		}
+		pixmap = grown;
+	}
+
+	QPainter p(&pixmap);
+	p.setCompositionMode(QPainter::CompositionMode_Source);
+	p.drawImage(x, y, image);
+	p.end();
+
+	QRect rect(x, y, w, h);
+
+	x += w + kStripPadding;
+	rowHeight = qMax(rowHeight, h);
+
+	return rect;
+}
+
+void StatusBarRenderCache::Strip::clear()
+{
+	pixmap = QPixmap();
+	x = 0;
+	y = 0;
+	rowHeight = 0;
+}
+
+bool StatusBarRenderCache::addIcon(const std::string& filePath, QRect& source)
+{
+	QString path = QString::fromStdString(filePath);
+
+	QHash<QString, QRect>::const_iterator it = m_iconRects.constFind(path);
+	if (it != m_iconRects.constEnd()) {
+		source = it.value();
+		return !source.isNull();
+	}
+
+	QImage image(path);
+	if (image.isNull()) {
+		// don't try to load it again
+		m_iconRects.insert(path, QRect());
+		source = QRect();
+		return false;
+	}
+
+	if (!addIcon(image, source))
+		return false;
+
+	m_iconRects.insert(path, source);
+	return true;
+}
+
+bool StatusBarRenderCache::addIcon(const QImage& image, QRect& source)
+{
+	if (image.isNull()) {
+		source = QRect();
+		return false;
+	}
+
+	source = m_icons.add(image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+	return true;
+}
+
+bool StatusBarRenderCache::isGlyphText(const QString& text)
+{
+	// digits and separators look the same drawn one at a time; letters may not (ligatures,
+	// joining scripts, kerning), and would fill the strip with a glyph per character
+	for (int i = 0; i < text.size(); i++) {
+		ushort c = text.at(i).unicode();
+		if ((c < '0' || c > '9') && c != ':' && c != '.' && c != ',' && c != '/' &&
+			c != '-' && c != '%' && c != ' ')
+			return false;
+	}
+
+	return true;
+}
+
+StatusBarRenderCache::GlyphSet* StatusBarRenderCache::glyphSet(const QFont& font, const QColor& color)
+{
+	// the same text is usually drawn over and over
+	if (m_lastGlyphSet && m_lastGlyphSet->color == color && m_lastGlyphSet->font == font)
+		return m_lastGlyphSet;
+
+	QString key = font.key() + QLatin1Char('/') + QString::number(color.rgba(), 16);
+
+	GlyphSet* set = m_glyphSets.value(key, 0);
+	if (!set) {
+		set = new GlyphSet;
+		set->font = font;
+		set->color = color;
+		set->ascent = QFontMetrics(font).ascent();
+		m_glyphSets.insert(key, set);
+	}
+
+	m_lastGlyphSet = set;
+	return set;
+}
+
+const StatusBarRenderCache::Glyph& StatusBarRenderCache::glyph(GlyphSet* set, QChar c)
+{
+	QHash<ushort, Glyph>::iterator it = set->glyphs.find(c.unicode());
+	if (it != set->glyphs.end())
+		return it.value();
+
+	QFontMetrics fontMetrics(set->font);
+
+	Glyph glyph;
+	glyph.advance = fontMetrics.width(c);
+
+	QImage image(glyph.advance + 2 * kGlyphPadding, fontMetrics.height(), QImage::Format_ARGB32_Premultiplied);
+	image.fill(0);
+
+	QPainter p(&image);
+	p.setFont(set->font);
+	p.setPen(set->color);
+	p.drawText(QPointF(kGlyphPadding, set->ascent), QString(c));
+	p.end();
+
+	glyph.source = m_glyphStrip.add(image);
+	m_numGlyphs++;
+
+	return set->glyphs.insert(c.unicode(), glyph).value();
+}
+
+int StatusBarRenderCache::textWidth(const QFont& font, const QString& text)
+{
+	if (!isGlyphText(text))
+		return QFontMetrics(font).width(text);
+
+	GlyphSet* set = glyphSet(font, Qt::white);
+
+	int width = 0;
+	for (int i = 0; i < text.size(); i++)
+		width += glyph(set, text.at(i)).advance;
+
+	return width;
+}
+
+void StatusBarRenderCache::drawText(QPainter* painter, const QFont& font, const QColor& color,
+									const QPointF& baseline, const QString& text)
+{
+	if (!isGlyphText(text)) {
+		painter->save();
+		painter->setFont(font);
+		painter->setPen(color);
+		painter->drawText(baseline, text);
+		painter->restore();
+		return;
+	}
+
+	GlyphSet* set = glyphSet(font, color);
+
+	qreal x = baseline.x();
+	qreal y = baseline.y() - set->ascent;
+
+	for (int i = 0; i < text.size(); i++) {
+		const Glyph& g = glyph(set, text.at(i));
+		painter->drawPixmap(QPointF(x - kGlyphPadding, y), m_glyphStrip.pixmap, g.source);
+		x += g.advance;
+	}
+}
+
+void StatusBarRenderCache::clearGlyphs()
+{
+	qDeleteAll(m_glyphSets);
+	m_glyphSets.clear();
+	m_lastGlyphSet = 0;
+
+	m_glyphStrip.clear();
+	m_numGlyphs = 0;
+}
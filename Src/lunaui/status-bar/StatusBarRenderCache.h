@@ -0,0 +1,126 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef STATUSBARRENDERCACHE_H
+#define STATUSBARRENDERCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QPixmap>
+#include <QColor>
+#include <QFont>
+#include <string>
+
+class QPainter;
+
+/**
+ * Pre-rasterized status bar artwork.
+ *
+ * Every status bar icon state is packed once into a single atlas pixmap, so that the
+ * icons are drawn as sub-rectangles of one pixmap. Text made only of digits and
+ * separators (the clock, the battery level) is composited from glyphs rendered once
+ * per font and color, instead of being laid out and rasterized on every paint.
+ * Anything else (AM/PM, localized text) needs shaping, and goes through QPainter.
+ *
+ * Icons live as long as the process. Glyphs are dropped when the locale changes
+ * (clearGlyphs()); a new font or color simply renders a new set.
+ */
+class StatusBarRenderCache : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	static StatusBarRenderCache* instance();
+
+	// loads the image into the icon atlas, and returns where it is; the same file
+	// is only packed once
+	bool addIcon(const std::string& filePath, QRect& source);
+	bool addIcon(const QImage& image, QRect& source);
+
+	// the address stays the same when the atlas grows
+	const QPixmap* iconAtlas() const { return &m_icons.pixmap; }
+
+	// the text is drawn left to right from the start of its baseline; glyph text without kerning
+	int  textWidth(const QFont& font, const QString& text);
+	void drawText(QPainter* painter, const QFont& font, const QColor& color,
+				  const QPointF& baseline, const QString& text);
+
+	int  numIcons() const { return m_iconRects.size(); }
+	int  numGlyphs() const { return m_numGlyphs; }
+
+public Q_SLOTS:
+
+	void clearGlyphs();
+
+private:
+
+	struct Glyph
+	{
+		QRect	source;
+		int		advance;
+	};
+
+	struct GlyphSet
+	{
+		QFont				font;
+		QColor				color;
+		int					ascent;
+		QHash<ushort, Glyph> glyphs;
+	};
+
+	// images packed in rows, left to right; the pixmap doubles in height as needed
+	struct Strip
+	{
+		Strip() : x(0), y(0), rowHeight(0) {}
+
+		QPixmap	pixmap;
+		int		x;
+		int		y;
+		int		rowHeight;
+
+		QRect	add(const QImage& image);
+		void	clear();
+	};
+
+	StatusBarRenderCache();
+	~StatusBarRenderCache();
+
+	static bool		isGlyphText(const QString& text);
+
+	GlyphSet*		glyphSet(const QFont& font, const QColor& color);
+	const Glyph&	glyph(GlyphSet* set, QChar c);
+
+	Strip						m_icons;
+	QHash<QString, QRect>		m_iconRects;
+
+	Strip						m_glyphStrip;
+	QHash<QString, GlyphSet*>	m_glyphSets;
+	GlyphSet*					m_lastGlyphSet;
+	int							m_numGlyphs;
+
+private:
+
+	StatusBarRenderCache(const StatusBarRenderCache&);
+	StatusBarRenderCache& operator=(const StatusBarRenderCache&);
+};
+
+#endif /* STATUSBARRENDERCACHE_H */
@@ -28,6 +28,7 @@
 #include "DeviceInfo.h"
 #include "BtDeviceClass.h"
 #include "SystemService.h"
+#include "JsonScanner.h"
 #include <string.h>
 #include <map>
 
@@ -579,25 +580,23 @@ bool StatusBarServicesConnector::statusBarPowerdBatteryEventsCallback(LSHandle*
 
 bool StatusBarServicesConnector::powerdBatteryEventsCallback(LSHandle* handle, LSMessage* message, void* ctxt)
 {
-	g_message("StatusBar - powerdBatteryEventsCallback %s", LSMessageGetPayload(message));
+	const char* payload = LSMessageGetPayload(message);
+	g_debug("StatusBar - powerdBatteryEventsCallback %s", payload);
 
 	// Look for percent_ui
-	struct json_object* json = json_tokener_parse(LSMessageGetPayload(message));
-	struct json_object* percentObj = NULL;
+	JsonField percent("percent_ui");
+	if (!JsonScanner::scan(payload, &percent, 1))
+		return true;
 
-	if (json && !is_error(json)) {
-		if (!json_object_object_get_ex(json, "percent_ui", &percentObj)) {
-			g_critical("Unable to get percent_ui for battery state");
-			goto exit;
-		}
+	if (percent.type != JsonField::Integer) {
+		g_critical("Unable to get percent_ui for battery state");
+		return true;
+	}
 
-		m_batteryLevel = json_object_get_int(percentObj);
+	m_batteryLevel = percent.integer;
 
-		Q_EMIT signalBatteryLevelUpdated(m_batteryLevel);
-	}
+	Q_EMIT signalBatteryLevelUpdated(m_batteryLevel);
 
-exit:
-	if (json && !is_error(json)) json_object_put(json);
 	return true;
 }
 
@@ -610,39 +609,27 @@ bool StatusBarServicesConnector::statusBarPowerdChargerEventsCallback(LSHandle*
 
 bool StatusBarServicesConnector::powerdChargerEventsCallback(LSHandle* handle, LSMessage* message, void* ctxt)
 {
-	g_message("StatusBar - powerdChargerEventsCallback %s", LSMessageGetPayload(message));
+	const char* payload = LSMessageGetPayload(message);
+	g_debug("StatusBar - powerdChargerEventsCallback %s", payload);
 
-	struct json_object* chargingObj = NULL;
 	bool origState = m_charging;
 
-	struct json_object* json = json_tokener_parse(LSMessageGetPayload(message));
-	if (json && !is_error(json)) {
-		if (!json_object_object_get_ex(json, "Charging", &chargingObj)) {
-			g_critical("Charging field is missing!");
-			goto exit;
-		}
+	JsonField charging("Charging");
+	if (!JsonScanner::scan(payload, &charging, 1))
+		return true;
 
-		// Default to not charging unless we find out otherwise
-		m_charging = json_object_get_boolean(chargingObj);
+	if (charging.type != JsonField::Boolean) {
+		g_critical("Charging field is missing or not a boolean!");
+		return true;
+	}
 
-		// Check if we're charging -- usb or inductive
-		/*for (int j = 0; j < kNumChargeSources; j++) {
-			if (strcmp(json_object_get_string(typeObj), m_chargeSource[j]) == 0) {
-				if (json_object_object_get_ex(json, "connected", &connectedObj)) {
-					if (json_object_get_boolean(connectedObj)) {
-						m_charging = true;
-					}
-				}
-			}
-		}*/
+	// Default to not charging unless we find out otherwise
+	m_charging = charging.boolean;
 
-		if (m_charging != origState) {
-			Q_EMIT signalChargingStateUpdated(m_charging);
-		}
+	if (m_charging != origState) {
+		Q_EMIT signalChargingStateUpdated(m_charging);
 	}
 
-exit:
-	if (json && !is_error(json)) json_object_put(json);
 	return true;
 }
 
@@ -1178,30 +1165,36 @@ bool StatusBarServicesConnector::statusBarTelephonySignalEventsCallback(LSHandle
 
 bool StatusBarServicesConnector::telephonySignalEventsCallback(LSHandle* handle, const char* messagePayload, void* ctxt)
 {
-	struct json_object* root = json_tokener_parse(messagePayload);
-	struct json_object* label = 0;
-	struct json_object* signalValues = 0;
+	// this one comes several times a second with a changing signal: no DOM
+	enum { EventSignal = 0, EventBars, EventValue, EventValue1x, EventValueEvdo,
+		   ReturnValue, QueryBars, QueryExtended, QueryValue, QueryValue1x, QueryValueEvdo, NumFields };
+	JsonField fields[NumFields] = {
+		JsonField("eventSignal"), JsonField("eventSignal.bars"), JsonField("eventSignal.value"),
+		JsonField("eventSignal.value1x"), JsonField("eventSignal.valueEvdo"),
+		JsonField("returnValue"), JsonField("bars"), JsonField("extended"), JsonField("extended.value"),
+		JsonField("extended.value1x"), JsonField("extended.valueEvdo")
+	};
 
-	g_message("StatusBar - telephonySignalEventsCallback %s", messagePayload);
+	g_debug("StatusBar - telephonySignalEventsCallback %s", messagePayload);
 
-	label = json_object_object_get(root, "eventSignal");
-	if (label && !is_error(label) && json_object_is_type(label, json_type_object)) {
+	JsonScanner::scan(messagePayload, fields, NumFields);
+
+	bool result = false;
+	int value = 0;
+
+	if (fields[EventSignal].type == JsonField::Object) {
 		// Event
 		if(m_phoneRadioState) {
-			const char* string = 0;
-			//struct json_object* event = label;
-
 			if(m_phoneType == PHONE_TYPE_UNKNOWN) {
 				updateRSSIIcon(true, StatusBar::RSSI_0);
 				if(handle != NULL || ctxt != NULL) // to avoid re-buffering the same data
 					m_signalMsgPayloadBuffer = messagePayload;
 				// Request the phone type
-				bool result;
 				LSError lsError;
 				LSErrorInit(&lsError);
 
-				result = LSCall(handle, "palm://com.palm.telephony/platformQuery", "{ }",
-						statusBarPlatformQueryCallback, NULL, NULL, &lsError);
+				LSCall(handle, "palm://com.palm.telephony/platformQuery", "{ }",
+					   statusBarPlatformQueryCallback, NULL, NULL, &lsError);
 
 				if (LSErrorIsSet(&lsError)) {
 					LSErrorPrint(&lsError, stderr);
@@ -1213,126 +1206,70 @@ bool StatusBarServicesConnector::telephonySignalEventsCallback(LSHandle* handle,
 				m_rssi = 5;
 				updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
 			} else if(m_phoneType == PHONE_TYPE_GSM) {
-				label = json_object_object_get(label, "bars");
-				if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-				{
-					m_rssi = json_object_get_int(label);
-					if(m_rssi < 0)
-						m_rssi = 0;
-					updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
-				}
-			} else if(m_phoneType == PHONE_TYPE_CDMA){
-				signalValues = label;
-				label = json_object_object_get(signalValues, "value");
-				if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-				{
-					m_rssi = json_object_get_int(label);
-					if(!Preferences::instance()->useDualRSSI()) {
-						if (m_rssi >= 0) {
-							if(m_rssi > 5)
-								m_rssi = 5; // display at most 5 bars
-							updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
-						} else {
-							updateRSSIIcon(true, StatusBar::RSSI_ERROR);
-						}
-					} else {
-						int rssiev = 0;
-						int rssi1x = 0;
-
-						label = json_object_object_get(signalValues, "value1x");
-						if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-						{
-							rssi1x = json_object_get_int(label);
-							if(rssi1x < 0) rssi1x = 0;
-							if(rssi1x > 5) rssi1x = 5;
-						}
-
-						label = json_object_object_get(signalValues, "valueEvdo");
-						if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-						{
-							rssiev = json_object_get_int(label);
-							if(rssiev < 0) rssiev = 0;
-							if(rssiev > 5) rssiev = 5;
-						}
-						updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_EV_0 + rssiev));
-						updateRSSI1xIcon(true, (StatusBar::IndexRSSI1x)(StatusBar::RSSI_1X_0 + rssiev));
-					}
-				}
+				if (fields[EventBars].getInt(value))
+					updateSignalBars(value);
+			} else if(m_phoneType == PHONE_TYPE_CDMA) {
+				if (fields[EventValue].getInt(value))
+					updateSignalValues(value, fields[EventValue1x], fields[EventValueEvdo]);
 			}
 		}
-	} else {
+	} else if (fields[ReturnValue].getBool(result)) {
 		// response to Query
-		label = json_object_object_get(root, "returnValue");
-		if (label && !is_error(label) && json_object_is_type(label, json_type_boolean)) {
-			bool result = json_object_get_boolean(label);
-
-			if(result) {
-
-				if(m_phoneInLimitedService) {
-					updateRSSIIcon(true, StatusBar::RSSI_0);
-				} else if(m_demoBuild) {
-					m_rssi = 5;
-					updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
-				} else if(m_phoneType == PHONE_TYPE_GSM) {
-					label = json_object_object_get(root, "bars");
-					if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-					{
-						m_rssi = json_object_get_int(label);
-						if(m_rssi < 0)
-							m_rssi = 0;
-						updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
-					}
-				} else if(m_phoneType == PHONE_TYPE_CDMA){
-					label = json_object_object_get(root, "extended");
-					if (label && !is_error(label) && json_object_is_type(label, json_type_object)) {
-						signalValues = label;
-						label = json_object_object_get(signalValues, "value");
-						if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-						{
-							m_rssi = json_object_get_int(label);
-							if(!Preferences::instance()->useDualRSSI()) {
-								if (m_rssi >= 0) {
-									if(m_rssi > 5)
-										m_rssi = 5; // display at most 5 bars
-									updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
-								} else {
-									updateRSSIIcon(true, StatusBar::RSSI_ERROR);
-								}
-							} else {
-								int rssiev = 0;
-								int rssi1x = 0;
-
-								label = json_object_object_get(signalValues, "value1x");
-								if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-								{
-									rssi1x = json_object_get_int(label);
-									if(rssi1x < 0) rssi1x = 0;
-									if(rssi1x > 5) rssi1x = 5;
-								}
-
-								label = json_object_object_get(signalValues, "valueEvdo");
-								if (label && !is_error(label) && json_object_is_type(label, json_type_int))
-								{
-									rssiev = json_object_get_int(label);
-									if(rssiev < 0) rssiev = 0;
-									if(rssiev > 5) rssiev = 5;
-								}
-								updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_EV_0 + rssiev));
-								updateRSSI1xIcon(true, (StatusBar::IndexRSSI1x)(StatusBar::RSSI_1X_0 + rssiev));
-							}
-						}
-					}
-				}
+		if(result) {
+			if(m_phoneInLimitedService) {
+				updateRSSIIcon(true, StatusBar::RSSI_0);
+			} else if(m_demoBuild) {
+				m_rssi = 5;
+				updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
+			} else if(m_phoneType == PHONE_TYPE_GSM) {
+				if (fields[QueryBars].getInt(value))
+					updateSignalBars(value);
+			} else if(m_phoneType == PHONE_TYPE_CDMA) {
+				if (fields[QueryExtended].type == JsonField::Object && fields[QueryValue].getInt(value))
+					updateSignalValues(value, fields[QueryValue1x], fields[QueryValueEvdo]);
 			}
 		}
 	}
 
-	if (root && !is_error(root))
-		json_object_put(root);
-
 	return true;
 }
 
+void StatusBarServicesConnector::updateSignalBars(int bars)
+{
+	m_rssi = bars;
+	if(m_rssi < 0)
+		m_rssi = 0;
+	updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
+}
+
+void StatusBarServicesConnector::updateSignalValues(int value, const JsonField& value1x, const JsonField& valueEvdo)
+{
+	m_rssi = value;
+	if(!Preferences::instance()->useDualRSSI()) {
+		if (m_rssi >= 0) {
+			if(m_rssi > 5)
+				m_rssi = 5; // display at most 5 bars
+			updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_0 + m_rssi));
+		} else {
+			updateRSSIIcon(true, StatusBar::RSSI_ERROR);
+		}
+	} else {
+		int rssiev = 0;
+		int rssi1x = 0;
+
+		if (value1x.getInt(rssi1x)) {
+			if(rssi1x < 0) rssi1x = 0;
+			if(rssi1x > 5) rssi1x = 5;
+		}
+
+		if (valueEvdo.getInt(rssiev)) {
+			if(rssiev < 0) rssiev = 0;
+			if(rssiev > 5) rssiev = 5;
+		}
+		updateRSSIIcon(true, (StatusBar::IndexRSSI)(StatusBar::RSSI_EV_0 + rssiev));
+		updateRSSI1xIcon(true, (StatusBar::IndexRSSI1x)(StatusBar::RSSI_1X_0 + rssiev));
+	}
+}
 
 bool StatusBarServicesConnector::statusBarTelephonySIMEventsCallback(LSHandle* handle, LSMessage* message, void* ctxt)
 {
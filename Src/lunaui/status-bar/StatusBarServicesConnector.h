@@ -30,6 +30,7 @@
 #include "StatusBar.h"
 
 struct json_object;
+struct JsonField;
 
 
 typedef struct WifiAccessPoint {
@@ -330,6 +331,8 @@ private:
 
 	bool validSIMRejectCode(unsigned int code);
 	void updateRSSIIcon(bool show, StatusBar::IndexRSSI index);
+	void updateSignalBars(int bars);
+	void updateSignalValues(int value, const JsonField& value1x, const JsonField& valueEvdo);
 	void updateRSSI1xIcon(bool show, StatusBar::IndexRSSI1x index);
 	StatusBar::IndexWAN getWanIndex(bool connected, const char* type);
 
@@ -51,6 +51,7 @@
 #include "BtDeviceClass.h"
 #include "DisplayManager.h"
 #include "WindowServer.h"
+#include "QmlComponentCache.h"
 #include "SystemUiController.h"
 
 #define SYS_UI_APP_ID      "com.palm.systemui"
@@ -164,10 +165,10 @@ void SystemMenu::init()
 
 		 Settings* settings = Settings::LunaSettings();
 		 std::string systemMenuQmlPath = settings->lunaQmlUiComponentsPath + "SystemMenu/SystemMenu.qml";
-		 QUrl url = QUrl::fromLocalFile(systemMenuQmlPath.c_str());
-		 m_qmlMenu = new QDeclarativeComponent(qmlEngine, url, this);
+		 QmlComponentCache* qmlCache = WindowServer::instance()->qmlComponentCache();
+		 m_qmlMenu = qmlCache->component(systemMenuQmlPath.c_str());
 		 if(m_qmlMenu) {
-			 m_menuObject = qobject_cast<QGraphicsObject *>(m_qmlMenu->create());
+			 m_menuObject = qobject_cast<QGraphicsObject *>(qmlCache->create(m_qmlMenu));
 			 if(m_menuObject) {
 				 m_menuObject->setParentItem(this);
 				 m_rightEdgeOffset = m_menuObject->property("edgeOffset").toInt();
@@ -34,6 +34,7 @@
 #include <PIpcMessageMacros.h>
 
 #include "CardHostWindow.h"
+#include "CpuPolicy.h"
 #include "QtHostWindow.h"
 #include "HostWindow.h"
 #include "IpcServer.h"
@@ -41,12 +42,8 @@
 #include "WindowServer.h"
 #include "WebAppMgrProxy.h"
 
-static const int kPriorityActive = -1;
-static const int kPriorityInactive = 1;
-
 IpcClientHost::IpcClientHost()
 	: m_pid(-1)
-	, m_processPriority(0)
 	, m_clearing(false)
 	, m_idleDestroySrc(0)
 {
@@ -54,7 +51,6 @@ IpcClientHost::IpcClientHost()
 
 IpcClientHost::IpcClientHost(int pid, const std::string& name, PIpcChannel* channel)
 	: m_pid(pid)
-	, m_processPriority(0)
 	, m_name(name)
 	, m_clearing(false)
 	, m_idleDestroySrc(0)
@@ -125,15 +121,19 @@ void IpcClientHost::onDisconnected()
 
 	m_clearing = true;
 
-	for (WindowMap::const_iterator it = m_winMap.begin(); it != m_winMap.end(); ++it) {
-		static_cast<HostWindow*>(it->second)->channelRemoved();
-		static_cast<HostWindow*>(it->second)->setClientHost(0);
-		WindowServer::instance()->removeWindow(it->second);
+	for (int i = 0; i < m_windows.capacity(); i++) {
+		Window* w = m_windows.at(i);
+		if (!w)
+			continue;
+
+		static_cast<HostWindow*>(w)->channelRemoved();
+		static_cast<HostWindow*>(w)->setClientHost(0);
+		WindowServer::instance()->removeWindow(w);
 	}
 
-	m_winMap.clear();
-	m_winSet.clear();
-	m_closedWinSet.clear();
+	m_windows.clear();
+	m_keys.clear();
+	m_closedWindows.clear();
 
 	// http://bugreports.qt.nokia.com/browse/QTBUG-18434: deleteLater does
 	// not work when used in a g_idle_dispatch
@@ -181,8 +181,7 @@ void IpcClientHost::onPrepareAddWindow(int key, int type, int width, int height)
 		win->setAppId(m_name);
 	}
 
-	m_winMap[key] = win;
-	m_winSet.insert(win);
+	addWindow(key, win);
 
 	g_message("%s (%d): Attached to key: %d, width: %d, height: %d, Window: %p",
 	          __PRETTY_FUNCTION__, __LINE__, key, width, height, win);
@@ -208,9 +207,10 @@ void IpcClientHost::onRemoveWindow(int key)
 	g_message("%s (%d): Remove Window with key:%d, window: %p",
 	          __PRETTY_FUNCTION__, __LINE__, key, win);
 	
-	m_winMap.erase(key);
-	m_winSet.erase(win);
-	m_closedWinSet.erase(win);
+	SlotHandle handle = m_keys[key];
+	m_keys.erase(key);
+	m_windows.remove(handle);
+	m_closedWindows.erase(handle);
 	WindowServer::instance()->removeWindow(win);
 }
 
@@ -343,54 +343,92 @@ void IpcClientHost::onUnfocusWindow(int key)
 
 Window* IpcClientHost::findWindow(int key) const
 {
-	WindowMap::const_iterator it = m_winMap.find(key);
-	if (it == m_winMap.end()) {
+	KeyMap::const_iterator it = m_keys.find(key);
+	Window* win = (it != m_keys.end()) ? m_windows.get(it->second) : 0;
+	if (!win) {
         g_warning("%s (%d): Failed to find window with key: %d",
 				   __PRETTY_FUNCTION__, __LINE__, key);
 		return 0;
 	}
 
+	return win;
+}
+
+void IpcClientHost::addWindow(int key, Window* win)
+{
+	SlotHandle handle = m_windows.insert(win);
+	if (handle != SlotTable<Window>::kInvalidHandle)
+		m_keys[key] = handle;
+}
+
+SlotHandle IpcClientHost::findHandle(HostWindow* w, int* key) const
+{
+	// a window is normally found by its own key, but it goes out of step with ours
+	// while the window gets a new buffer
+	KeyMap::const_iterator it = m_keys.find(w->routingId());
+	if (it == m_keys.end() || m_windows.get(it->second) != w) {
+		for (it = m_keys.begin(); it != m_keys.end(); ++it) {
+			if (m_windows.get(it->second) == w)
+				break;
+		}
+
+		if (it == m_keys.end())
+			return SlotTable<Window>::kInvalidHandle;
+	}
+
+	if (key)
+		*key = it->first;
+
 	return it->second;
 }
 
+void IpcClientHost::windowClosed(SlotHandle handle)
+{
+	if (m_windows.contains(handle))
+		m_closedWindows.insert(handle);
+}
+
+bool IpcClientHost::allWindowsClosed()
+{
+	// windows that were deleted in the meantime no longer count
+	for (HandleSet::iterator it = m_closedWindows.begin(); it != m_closedWindows.end();) {
+		if (m_windows.contains(*it))
+			++it;
+		else
+			m_closedWindows.erase(it++);
+	}
+
+	return (int) m_closedWindows.size() == m_windows.size();
+}
+
 void IpcClientHost::slotMaximizedCardWindowChanged(Window* w)
 {
 	bool thisIsMyWindow = false;
 
-	if (w) {
-		if (m_winSet.find(w) != m_winSet.end())
+	if (w && w->isIpcWindow()) {
+		if (findHandle(static_cast<HostWindow*>(w)) != SlotTable<Window>::kInvalidHandle)
 			thisIsMyWindow = true;
 	}
 
-	if (thisIsMyWindow) {
-		if (m_processPriority != kPriorityActive) {
-			m_processPriority = kPriorityActive;
-			::setpriority(PRIO_PROCESS, m_pid,  m_processPriority);
-			g_debug("%s: setting priority of %d to %d", __PRETTY_FUNCTION__, m_pid, m_processPriority);
-		}
-	}
-    else {
-		if (m_processPriority != kPriorityInactive) {
-			m_processPriority = kPriorityInactive;
-			::setpriority(PRIO_PROCESS, m_pid, m_processPriority);
-			g_debug("%s: setting priority of %d to %d", __PRETTY_FUNCTION__, m_pid, m_processPriority);
-		}
-	}
+	// the policy moves whoever was in the foreground before to the background
+	CpuPolicy* policy = CpuPolicy::instance();
+	if (thisIsMyWindow)
+		policy->setForeground(m_pid);
+	else if (policy->foreground() == m_pid)
+		policy->setForeground(-1);
 }
 
 void IpcClientHost::closeWindow(Window* w)
 {
-	for (WindowMap::const_iterator it = m_winMap.begin();
-		 it != m_winMap.end(); ++it) {
-		if (it->second == w) {
-			m_channel->sendAsyncMessage(new View_Close(it->first, w->disableKeepAlive()));
-			m_closedWinSet.insert(w);
-			break;
-		}
-    }
+	int key = 0;
+	SlotHandle handle = findHandle(static_cast<HostWindow*>(w), &key);
+	if (handle != SlotTable<Window>::kInvalidHandle) {
+		m_channel->sendAsyncMessage(new View_Close(key, w->disableKeepAlive()));
+		windowClosed(handle);
+	}
 
 	// FIXME: the nuking decision should not be inferred based on window type
-	if ((w->type() != WindowType::Type_Emergency) && (m_closedWinSet == m_winSet)) {
+	if ((w->type() != WindowType::Type_Emergency) && allWindowsClosed()) {
 		// All windows closed. Its ok to ask this process to be nuked
 		IpcServer::instance()->addProcessToNukeList(m_pid);
 	}
@@ -398,7 +436,7 @@ void IpcClientHost::closeWindow(Window* w)
 
 bool IpcClientHost::hasWindows() const
 {
-    return !m_winMap.empty();
+    return !m_windows.empty();
 }
 
 void IpcClientHost::relaunch(char * const argv[])
@@ -406,11 +444,10 @@ void IpcClientHost::relaunch(char * const argv[])
         // For applications with "handlesRelaunch" attribute, it sends the IPC
         // relaunch message. Otherwise, find the first window and maximize it
 
-	WindowMap::const_iterator it = m_winMap.begin();
-	if (it == m_winMap.end())
-		return;
+	Window* w = 0;
+	for (int i = 0; i < m_windows.capacity() && !w; i++)
+		w = m_windows.at(i);
 
-	Window* w = it->second;
 	if (!w)
 		return;
 
@@ -427,8 +464,15 @@ void IpcClientHost::replaceWindowKey(Window* win, int oldKey, int newKey)
 {
 	g_message("%s:%d window: %p, old: %d, new: %d", __PRETTY_FUNCTION__, __LINE__,
 			  win, oldKey, newKey);
-	m_winMap.erase(oldKey);
-	m_winMap[newKey] = win;
+	KeyMap::iterator it = m_keys.find(oldKey);
+	if (it == m_keys.end() || m_windows.get(it->second) != win) {
+		g_warning("%s: window %p is not ours", __PRETTY_FUNCTION__, win);
+		return;
+	}
+
+	SlotHandle handle = it->second;
+	m_keys.erase(it);
+	m_keys[newKey] = handle;
 }
 
 void IpcClientHost::windowDeleted(Window* w)
@@ -436,20 +480,30 @@ void IpcClientHost::windowDeleted(Window* w)
 	if (m_clearing)
 		return;
 
-	if (m_winSet.find(w) == m_winSet.end())
-		return;
+	int key = 0;
+	SlotHandle handle = findHandle(static_cast<HostWindow*>(w), &key);
+	if (handle != SlotTable<Window>::kInvalidHandle) {
+		m_keys.erase(key);
+	}
+	else {
+		// no key maps to it anymore (its key was reused), but it is still in the table
+		for (int i = 0; i < m_windows.capacity(); i++) {
+			if (m_windows.at(i) == w) {
+				handle = m_windows.handleAt(i);
+				break;
+			}
+		}
+
+		if (handle == SlotTable<Window>::kInvalidHandle)
+			return;
+	}
 
 	g_message("%s (%d): window: %p",
 	          __PRETTY_FUNCTION__, __LINE__, w);
-	
-	m_winSet.erase(w);
 
-	for (WindowMap::iterator it = m_winMap.begin(); it != m_winMap.end(); ++it) {
-		if (it->second == w) {
-			m_winMap.erase(it);
-			break;
-		}
-	}
+	// any closed handle to it goes stale with it
+	m_windows.remove(handle);
+	m_closedWindows.erase(handle);
 }
 
 gboolean IpcClientHost::idleDestroyCallback(gpointer arg)
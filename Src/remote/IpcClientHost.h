@@ -25,18 +25,20 @@
 #include "Common.h"
 
 #include <string>
-#include <map>
-#include <set>
+#include <tr1/unordered_map>
+#include <tr1/unordered_set>
 #include <glib.h>
 
 #include <PIpcChannelListener.h>
 #include "Window.h"
+#include "SlotTable.h"
 
 #include <QObject>
 
 class PIpcChannel;
 class PIpcBuffer;
 class SysMgrKeyEvent;
+class HostWindow;
 
 class IpcClientHost : public QObject, public PIpcChannelListener
 {
@@ -75,6 +77,12 @@ protected:
 
 	virtual Window* findWindow(int key) const;
 
+	void addWindow(int key, Window* win);
+	// kInvalidHandle if w is not one of ours. Sets key when given
+	SlotHandle findHandle(HostWindow* w, int* key = 0) const;
+	void windowClosed(SlotHandle handle);
+	bool allWindowsClosed();
+
 protected Q_SLOTS:
 
 	void slotMaximizedCardWindowChanged(Window* w);
@@ -83,14 +91,15 @@ protected Q_SLOTS:
 protected:
 
 	int m_pid;
-	int m_processPriority;
 	std::string m_name;
 
-	typedef std::map<int, Window*> WindowMap;
-	typedef std::set<Window*> WindowSet;
-	WindowMap m_winMap;
-	WindowSet m_winSet;
-	WindowSet m_closedWinSet;
+	// every message names its window by key: the keys map to handles into the table,
+	// so that nothing here is left pointing to a window that went away
+	typedef std::tr1::unordered_map<int, SlotHandle> KeyMap;
+	typedef std::tr1::unordered_set<SlotHandle> HandleSet;
+	SlotTable<Window> m_windows;
+	KeyMap m_keys;
+	HandleSet m_closedWindows;
 
 	bool m_clearing;
 	GSource* m_idleDestroySrc;
@@ -43,6 +43,7 @@
 #include "SystemService.h"
 #include "MemoryMonitor.h"
 #include "CpuAffinity.h"
+#include "CpuPolicy.h"
 
 #ifndef TARGET_DESKTOP	
 	#include "rolegen.h"
@@ -161,8 +162,8 @@ IpcServer::~IpcServer()
 
 void IpcServer::clientConnected(int pid, const std::string& name, PIpcChannel* channel)
 {
-	// Find the appid from the path of the file
-	std::string appId = appIdFromPid(pid);
+	// Find the appid from the path of the file, unless we launched it
+	std::string appId = appIdForPid(pid);
 	if (appId.empty())
 		appId = name;
 	
@@ -177,19 +178,25 @@ void IpcServer::clientConnected(int pid, const std::string& name, PIpcChannel* c
 			// update the memory watcher for this process, in case there is one
 			MemoryMonitor::instance()->monitorNativeProcessMemory(pid, 0, it->second);
 		}
+		m_appIds.erase(it->second);
 		m_nativeProcessMap.erase(it);
 	}
 
-	m_nativeProcessMap[appId] = pid;
+	addNativeProcess(appId, pid);
 	
 	if (0 != strcmp(name.c_str(), "WebAppManager"/*FIXME:qtwebkit WEB_APP_MGR_IPC_NAME*/))
 	{ // regular (native) app connecting
 		IpcClientHost* c = new IpcClientHost(pid, appId, channel);
-		m_clientHostSet.insert(c);
+		addClientHost(c);
+
+		// in the background until one of its cards gets maximized
+		CpuPolicy::instance()->setProcessClass(pid, CpuPolicy::Background);
 	} else {
 		// WebKit WebApp Manager connecting
 		WebAppMgrProxy* c = WebAppMgrProxy::connectWebAppMgr(pid, channel);
-		m_clientHostSet.insert(c);
+		addClientHost(c);
+
+		CpuPolicy::instance()->setProcessClass(pid, CpuPolicy::Service);
 	}
 	
 }
@@ -316,7 +323,7 @@ int IpcServer::launchNativeProcess(const std::string& appId, const char* path, c
 		MemoryMonitor::instance()->monitorNativeProcessMemory(pid, requiredMemory);
 	}
 
-	m_nativeProcessMap[appId] = pid;
+	addNativeProcess(appId, pid);
 	g_message("%s: Process %s (%s) launched with pid: %d", __PRETTY_FUNCTION__,
 			  appId.c_str(), path, pid);
 
@@ -348,7 +355,7 @@ void IpcServer::killProcess(int pid, bool notifyUser)
 	
 	if(notifyUser) {
 		std::string nullString;
-		std::string appId = appIdFromPid(pid);
+		std::string appId = appIdForPid(pid);
 		std::string appName("Application");
 		std::string appTitle;
 		
@@ -374,27 +381,33 @@ void IpcServer::processRemoved(int pid, bool doCleanup)
 	if (doCleanup)
 		::waitid(P_PID, pid, NULL, WEXITED | WNOHANG);	
 
-	for (ProcessMap::iterator it = m_nativeProcessMap.begin();
-		 it != m_nativeProcessMap.end(); ++it) {
+	CpuPolicy::instance()->removeProcess(pid);
 
-		if (it->second == pid) {
-			g_message("%s: pid: %d, appId: %s:", __PRETTY_FUNCTION__,
-					  pid, it->first.c_str());
-			m_nativeProcessMap.erase(it);
-			return;
-		}
-	}
+	AppIdMap::iterator appIt = m_appIds.find(pid);
+	if (appIt == m_appIds.end())
+		return;
 
-	for (ProcessMap::iterator it = m_webAppProcessMap.begin();
-		 it != m_webAppProcessMap.end(); ++it) {
+	const std::string& appId = appIt->second;
+	g_message("%s: pid: %d, appId: %s:", __PRETTY_FUNCTION__,
+			  pid, appId.c_str());
 
-		if (it->second == pid) {
-			g_message("%s: pid: %d, appId: %s:", __PRETTY_FUNCTION__,
-					  pid, it->first.c_str());
+	ProcessMap::iterator it = m_nativeProcessMap.find(appId);
+	if (it != m_nativeProcessMap.end() && it->second == pid) {
+		m_nativeProcessMap.erase(it);
+	}
+	else {
+		it = m_webAppProcessMap.find(appId);
+		if (it != m_webAppProcessMap.end() && it->second == pid)
 			m_webAppProcessMap.erase(it);
-			return;
-		}
 	}
+
+	m_appIds.erase(appIt);
+}
+
+void IpcServer::addNativeProcess(const std::string& appId, int pid)
+{
+	m_nativeProcessMap[appId] = pid;
+	m_appIds[pid] = appId;
 }
 
 void IpcServer::addProcessToNukeList(int pid)
@@ -485,9 +498,51 @@ std::string IpcServer::appIdFromPid(int pid)
 	return std::string(appIdStart, appIdEnd - appIdStart);
 }
 
+std::string IpcServer::appIdForPid(int pid)
+{
+	AppIdMap::const_iterator it = m_appIds.find(pid);
+	if (it != m_appIds.end())
+		return it->second;
+
+	return appIdFromPid(pid);
+}
+
+void IpcServer::addClientHost(IpcClientHost* client)
+{
+	SlotHandle handle = m_clientHosts.insert(client);
+	if (handle == SlotTable<IpcClientHost>::kInvalidHandle)
+		return;
+
+	m_clientHostsByPid[client->pid()] = handle;
+	m_clientHostsByAppId[client->name()] = handle;
+}
+
 void IpcServer::ipcClientHostQuit(IpcClientHost* client)
 {
-	m_clientHostSet.erase(client);
+	SlotHandle handle = SlotTable<IpcClientHost>::kInvalidHandle;
+
+	ClientPidMap::iterator it = m_clientHostsByPid.find(client->pid());
+	if (it != m_clientHostsByPid.end() && m_clientHosts.get(it->second) == client) {
+		handle = it->second;
+		m_clientHostsByPid.erase(it);
+	}
+	else {
+		// another host took over its pid
+		for (int i = 0; i < m_clientHosts.capacity(); i++) {
+			if (m_clientHosts.at(i) == client) {
+				handle = m_clientHosts.handleAt(i);
+				break;
+			}
+		}
+	}
+
+	ClientAppIdMap::iterator appIt = m_clientHostsByAppId.find(client->name());
+	if (appIt != m_clientHostsByAppId.end() && appIt->second == handle)
+		m_clientHostsByAppId.erase(appIt);
+
+	// quits twice for WebAppMgrProxy: the second time, the handle is stale already
+	m_clientHosts.remove(handle);
+
 	// FIXME: this prevents having multiple client hosts per process
 	m_nukeSet.erase(client->pid());
 	processRemoved(client->pid(), false);
@@ -496,14 +551,13 @@ void IpcServer::ipcClientHostQuit(IpcClientHost* client)
 
 IpcClientHost* IpcServer::clientHostForAppId(const std::string& appId) const
 {
-	for (ClientSet::const_iterator it = m_clientHostSet.begin();
-		 it != m_clientHostSet.end(); ++it) {
+	ClientAppIdMap::const_iterator it = m_clientHostsByAppId.find(appId);
+	if (it == m_clientHostsByAppId.end())
+		return 0;
 
-		g_debug("Checking clientHost: '%s' against '%s'", (*it)->name().c_str(),
-				appId.c_str());
-        if ((*it)->name() == appId && (*it)->hasWindows())
-			return *it;
-	}
+	IpcClientHost* host = m_clientHosts.get(it->second);
+	if (host && host->hasWindows())
+		return host;
 
 	return 0;
 }
@@ -24,14 +24,15 @@
 
 #include "Common.h"
 
-#include <map>
 #include <set>
 #include <string>
+#include <tr1/unordered_map>
 
 #include <PIpcServer.h>
 
 #include "Timer.h"
 #include "ApplicationDescription.h"
+#include "SlotTable.h"
 
 class IpcClientHost;
 
@@ -59,6 +60,9 @@ private:
 
 	bool nukeProcessTimer();
 	std::string appIdFromPid(int pid);
+	std::string appIdForPid(int pid);
+	void addNativeProcess(const std::string& appId, int pid);
+	void addClientHost(IpcClientHost* client);
 	IpcClientHost* clientHostForAppId(const std::string& appId) const;
 
 	static void childProcessDiedCallback(GPid pid, gint status, gpointer data);
@@ -66,14 +70,21 @@ private:
 	
 private:
 
-	typedef std::map<std::string, int> ProcessMap;
+	typedef std::tr1::unordered_map<std::string, int> ProcessMap;
+	typedef std::tr1::unordered_map<int, std::string> AppIdMap;
 	typedef std::set<int> ProcessSet;
-	typedef std::set<IpcClientHost*> ClientSet;
+	typedef std::tr1::unordered_map<int, SlotHandle> ClientPidMap;
+	typedef std::tr1::unordered_map<std::string, SlotHandle> ClientAppIdMap;
 
 	ProcessMap m_nativeProcessMap;
 	ProcessMap m_webAppProcessMap;
+	AppIdMap m_appIds;				// pid to appId, for both maps above
 	ProcessSet m_nukeSet;
-	ClientSet m_clientHostSet;
+
+	// client hosts by pid and by appId: handles, as the hosts delete themselves
+	SlotTable<IpcClientHost> m_clientHosts;
+	ClientPidMap m_clientHostsByPid;
+	ClientAppIdMap m_clientHostsByAppId;
 
 	Timer<IpcServer> m_nukeProcessTimer;
 };
@@ -0,0 +1,188 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef MESSAGEREPLAYQUEUE_H
+#define MESSAGEREPLAYQUEUE_H
+
+#include "Common.h"
+
+#include <list>
+
+/**
+ * What a queued message is, as far as replaying it later is concerned
+ */
+struct QueuedMessage
+{
+	enum Kind {
+		Ordered = 0,		// replayed in order, never dropped (launches, closes, clipboard, ...)
+		BestEffort,			// replayed in order; dropped (oldest first) if the queue overflows (cache, memory hints)
+		Input,				// stale by the time it could be replayed: never queued
+		Resize,				// only the last one per key (routing id) is kept
+		Focus,				// same
+		Property,			// only the last one per key (property) is kept
+		Orientation,		// only the last one is kept, replayed ahead of the ordered messages
+		UiDimensions		// same
+	};
+};
+
+/**
+ * Holds the messages for a peer that isn't there (yet), and gives them back in the
+ * order they should be replayed once it is.
+ *
+ * Messages that are superseded by a later one of the same kind (and key) are deleted
+ * as soon as the later one arrives, input is deleted right away, and global state
+ * (orientation, ui dimensions) goes out before everything else, so that the peer
+ * starts with the current values instead of working through every change. The rest
+ * keeps its order. Past capacity, the oldest best effort messages are dropped to
+ * make room. Nothing else ever is: commands like launches and closes are not
+ * idempotent and the peer would get out of sync, so without best effort messages
+ * left the queue goes over capacity instead (see numOverCapacity()).
+ *
+ * Takes ownership of the messages it accepts.
+ */
+template <class Message>
+class MessageReplayQueue
+{
+public:
+
+	MessageReplayQueue(int capacity)
+		: m_capacity(capacity)
+		, m_maxDepth(0)
+		, m_numCollapsed(0)
+		, m_numInputDropped(0)
+		, m_numOverflowed(0)
+		, m_numOverCapacity(0)
+	{
+	}
+
+	~MessageReplayQueue() { clear(); }
+
+	// false if msg was not queued (it has been deleted)
+	bool push(Message* msg, QueuedMessage::Kind kind, int key = 0) {
+		if (kind == QueuedMessage::Input) {
+			delete msg;
+			m_numInputDropped++;
+			return false;
+		}
+
+		if (kind == QueuedMessage::Orientation || kind == QueuedMessage::UiDimensions) {
+			for (typename EntryList::iterator it = m_state.begin(); it != m_state.end(); ++it) {
+				if (it->kind == kind) {
+					delete it->msg;
+					it->msg = msg;
+					m_numCollapsed++;
+					return true;
+				}
+			}
+			m_state.push_back(Entry(msg, kind, key));
+		}
+		else {
+			if (kind == QueuedMessage::Resize || kind == QueuedMessage::Focus ||
+				kind == QueuedMessage::Property) {
+				for (typename EntryList::iterator it = m_ordered.begin(); it != m_ordered.end(); ++it) {
+					if (it->kind == kind && it->key == key) {
+						delete it->msg;
+						m_ordered.erase(it);
+						m_numCollapsed++;
+						break;
+					}
+				}
+			}
+			m_ordered.push_back(Entry(msg, kind, key));
+		}
+
+		if (size() > m_capacity && !dropOldest())
+			m_numOverCapacity++;
+
+		if (size() > m_maxDepth)
+			m_maxDepth = size();
+
+		return true;
+	}
+
+	// the next message to replay, which the caller now owns. 0 when empty
+	Message* pop() {
+		EntryList& list = m_state.empty() ? m_ordered : m_state;
+		if (list.empty())
+			return 0;
+
+		Message* msg = list.front().msg;
+		list.pop_front();
+		return msg;
+	}
+
+	void clear() {
+		for (typename EntryList::iterator it = m_state.begin(); it != m_state.end(); ++it)
+			delete it->msg;
+		for (typename EntryList::iterator it = m_ordered.begin(); it != m_ordered.end(); ++it)
+			delete it->msg;
+		m_state.clear();
+		m_ordered.clear();
+	}
+
+	bool empty() const { return m_state.empty() && m_ordered.empty(); }
+	int size() const { return m_state.size() + m_ordered.size(); }
+	int capacity() const { return m_capacity; }
+
+	int maxDepth() const { return m_maxDepth; }
+	int numCollapsed() const { return m_numCollapsed; }
+	int numInputDropped() const { return m_numInputDropped; }
+	int numOverflowed() const { return m_numOverflowed; }
+	// pushes that left the queue over capacity, for lack of anything droppable
+	int numOverCapacity() const { return m_numOverCapacity; }
+
+private:
+
+	struct Entry
+	{
+		Entry(Message* m, QueuedMessage::Kind k, int kk) : msg(m), kind(k), key(kk) {}
+
+		Message*			msg;
+		QueuedMessage::Kind	kind;
+		int					key;
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	bool dropOldest() {
+		for (typename EntryList::iterator it = m_ordered.begin(); it != m_ordered.end(); ++it) {
+			if (it->kind == QueuedMessage::BestEffort) {
+				delete it->msg;
+				m_ordered.erase(it);
+				m_numOverflowed++;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	EntryList	m_state;		// replayed first
+	EntryList	m_ordered;
+	int			m_capacity;
+
+	int			m_maxDepth;
+	int			m_numCollapsed;
+	int			m_numInputDropped;
+	int			m_numOverflowed;
+	int			m_numOverCapacity;
+};
+
+#endif /* MESSAGEREPLAYQUEUE_H */
@@ -55,11 +55,17 @@
 #include "MemoryMonitor.h"
 #include "CustomEvents.h"
 #include "HostWindowData.h"
+#include "HostBase.h"
 #include "Time.h"
 
 static WebAppMgrProxy* s_instance = NULL;
 static gchar* s_appToLaunchWhenConnectedStr = NULL;
 
+// messages kept while WebAppMgr isn't connected (launches are kept regardless)
+static const int kMaxQueuedMessages = 256;
+// queued messages replayed per main loop iteration
+static const int kReplayBatchSize = 16;
+
 
 void WebAppMgrProxy::setAppToLaunchUponConnection(char* app)
 {
@@ -136,8 +142,9 @@ WebAppMgrProxy* WebAppMgrProxy::connectWebAppMgr(int pid, PIpcChannel* channel)
 
 
 WebAppMgrProxy::WebAppMgrProxy()
+	: m_discMsgQueue(kMaxQueuedMessages)
+	, m_replayTimer(HostBase::instance()->masterTimer(), this, &WebAppMgrProxy::replayTimerFired)
 {
-	m_processPriority = 0;
     m_orientation = OrientationEvent::Orientation_Up;
 	m_channel = 0;
 	m_ipcImgDragBuffer = 0;
@@ -155,10 +162,28 @@ void WebAppMgrProxy::clientConnected(int pid, PIpcChannel* channel)
 void WebAppMgrProxy::sendQueuedMessages()
 {
 	// if we have any outgoing messages queued up, send them out
-	while (!m_discMsgQueue.empty()) {
-		sendAsyncMessage(m_discMsgQueue.front());
-		m_discMsgQueue.pop();
-	}
+	if (m_discMsgQueue.empty() || m_replayTimer.running())
+		return;
+
+	g_message("%s: replaying %d queued messages (max depth %d, %d superseded, %d input dropped, %d overflowed)",
+			  __PRETTY_FUNCTION__, m_discMsgQueue.size(), m_discMsgQueue.maxDepth(),
+			  m_discMsgQueue.numCollapsed(), m_discMsgQueue.numInputDropped(),
+			  m_discMsgQueue.numOverflowed());
+
+	if (replayTimerFired())
+		m_replayTimer.start(0);
+}
+
+bool WebAppMgrProxy::replayTimerFired()
+{
+	if (!connected())
+		return false;
+
+	// a batch at a time, so that the main loop gets to run in between
+	for (int i = 0; i < kReplayBatchSize && !m_discMsgQueue.empty(); i++)
+		m_channel->sendAsyncMessage(m_discMsgQueue.pop());
+
+	return !m_discMsgQueue.empty();
 }
 
 bool WebAppMgrProxy::connected()
@@ -243,11 +268,25 @@ void WebAppMgrProxy::resumeWebKitProcess()
 
 void WebAppMgrProxy::sendAsyncMessage(PIpcMessage* msg)
 {
-	if(connected())	{
+	sendAsyncMessage(msg, QueuedMessage::Ordered);
+}
+
+void WebAppMgrProxy::sendAsyncMessage(PIpcMessage* msg, QueuedMessage::Kind kind, int key)
+{
+	// while the queue is being replayed, new messages line up behind it. Input doesn't need to
+	if (connected() && (m_discMsgQueue.empty() || kind == QueuedMessage::Input)) {
 		m_channel->sendAsyncMessage(msg);
 	} else {
 		// queue up the messages while not connected
-		m_discMsgQueue.push(msg);
+		int overflowed = m_discMsgQueue.numOverflowed();
+		int overCapacity = m_discMsgQueue.numOverCapacity();
+		m_discMsgQueue.push(msg, kind, key);
+		if (m_discMsgQueue.numOverflowed() != overflowed && (overflowed % 64) == 0)
+			g_warning("%s: queue full (%d messages), dropping the oldest best effort ones",
+					  __PRETTY_FUNCTION__, m_discMsgQueue.size());
+		if (m_discMsgQueue.numOverCapacity() != overCapacity && (overCapacity % 64) == 0)
+			g_warning("%s: %d messages queued, over capacity: keeping them all",
+					  __PRETTY_FUNCTION__, m_discMsgQueue.size());
 	}
 }
 
@@ -322,8 +361,7 @@ void WebAppMgrProxy::onPrepareAddWindow(int key, int type, int width, int height
 
     Window* win = createWindowForWebApp(static_cast<WindowType::Type>(type), data);
 
-	m_winMap[key] = win;
-	m_winSet.insert(win);
+	addWindow(key, win);
 
 	g_message("%s (%d): Attached to key: %d, width: %d, height: %d, window: %p",
 	          __PRETTY_FUNCTION__, __LINE__, key, width, height, win);
@@ -355,8 +393,7 @@ void WebAppMgrProxy::onPrepareAddWindowWithMetaData(int key, int metaDataKey, in
 
     Window* win = createWindowForWebApp(static_cast<WindowType::Type>(type), data);
 
-	m_winMap[key] = win;
-	m_winSet.insert(win);
+	addWindow(key, win);
 
 	g_message("%s (%d): Attached to key: %d, width: %d, height: %d, window: %p",
 	          __PRETTY_FUNCTION__, __LINE__, key, width, height, win);
@@ -490,12 +527,11 @@ Window* WebAppMgrProxy::createWindowForWebApp(WindowType::Type winType, HostWind
 
 void WebAppMgrProxy::closeWindow(Window* w)
 {
-	for (WindowMap::const_iterator it = m_winMap.begin(); it != m_winMap.end(); ++it) {
-		if (it->second == w) {
-			sendAsyncMessage(new View_Close(it->first, w->disableKeepAlive()));
-			m_closedWinSet.insert(w);
-			break;
-		}
+	int key = 0;
+	SlotHandle handle = findHandle(static_cast<HostWindow*>(w), &key);
+	if (handle != SlotTable<Window>::kInvalidHandle) {
+		sendAsyncMessage(new View_Close(key, w->disableKeepAlive()));
+		windowClosed(handle);
 	}
 }
 
@@ -750,8 +786,12 @@ void WebAppMgrProxy::inputEvent(Window* win, Event* e)
     if (EventThrottler::instance()->shouldDropEvent(e))
 	    return;
 
+	// a move shows where the pen will be when the app renders it
+	if (!EventThrottler::instance()->resampleMove(e))
+		return;
+
 	sendAsyncMessage(new View_InputEvent(static_cast<HostWindow*>(win)->routingId(),
-										 SysMgrEventWrapper(e)));
+										 SysMgrEventWrapper(e)), QueuedMessage::Input);
 }
 
 void WebAppMgrProxy::inputQKeyEvent(Window* win, QKeyEvent* event)
@@ -766,7 +806,7 @@ void WebAppMgrProxy::inputQKeyEvent(Window* win, QKeyEvent* event)
 		if (event->modifiers() & Qt::MetaModifier) {
 			g_message("%s: MetaModifier is set", __PRETTY_FUNCTION__);
 		}	
-		sendAsyncMessage(new View_KeyEvent(static_cast<HostWindow*>(win)->routingId(), event));
+		sendAsyncMessage(new View_KeyEvent(static_cast<HostWindow*>(win)->routingId(), event), QueuedMessage::Input);
 	}
 }
 
@@ -777,12 +817,13 @@ void WebAppMgrProxy::focusEvent(Window* win, bool focused)
 		           __PRETTY_FUNCTION__, __LINE__);
 		return;
 	}
-	sendAsyncMessage(new View_Focus(static_cast<HostWindow*>(win)->routingId(), focused));
+	int routingId = static_cast<HostWindow*>(win)->routingId();
+	sendAsyncMessage(new View_Focus(routingId, focused), QueuedMessage::Focus, routingId);
 }
 
 void WebAppMgrProxy::uiDimensionsChanged(int width, int height)
 {
-	sendAsyncMessage(new View_Mgr_UiDimensionsChanged(width, height));
+	sendAsyncMessage(new View_Mgr_UiDimensionsChanged(width, height), QueuedMessage::UiDimensions);
 }
 
 void WebAppMgrProxy::resizeEvent(Window* win, int newWidth, int newHeight, bool resizeBufer)
@@ -792,18 +833,19 @@ void WebAppMgrProxy::resizeEvent(Window* win, int newWidth, int newHeight, bool
 		           __PRETTY_FUNCTION__, __LINE__);
 		return;
 	}
-	sendAsyncMessage(new View_Resize(static_cast<HostWindow*>(win)->routingId(), newWidth, newHeight, resizeBufer));
+	int routingId = static_cast<HostWindow*>(win)->routingId();
+	sendAsyncMessage(new View_Resize(routingId, newWidth, newHeight, resizeBufer), QueuedMessage::Resize, routingId);
 }
 
 void WebAppMgrProxy::setOrientation(OrientationEvent::Orientation orient)
 {
 	m_orientation = orient;
-	sendAsyncMessage(new View_Mgr_SetOrientation(static_cast<int>(orient)));
+	sendAsyncMessage(new View_Mgr_SetOrientation(static_cast<int>(orient)), QueuedMessage::Orientation);
 }
 
 void WebAppMgrProxy::setGlobalProperties(int key)
 {
-    sendAsyncMessage(new View_Mgr_GlobalProperties(key));
+    sendAsyncMessage(new View_Mgr_GlobalProperties(key), QueuedMessage::Property, key);
 }
 
 void WebAppMgrProxy::inspect( const char* procId )
@@ -813,7 +855,7 @@ void WebAppMgrProxy::inspect( const char* procId )
 
 void WebAppMgrProxy::clearWebkitCache()
 {
-	sendAsyncMessage(new View_Mgr_ClearWebkitCache());
+	sendAsyncMessage(new View_Mgr_ClearWebkitCache(), QueuedMessage::BestEffort);
 }
 
 void WebAppMgrProxy::setJavascriptFlags( const char* flags )
@@ -828,7 +870,7 @@ void WebAppMgrProxy::enableDebugger( bool enable )
 
 void WebAppMgrProxy::performLowMemoryActions( const bool allowExpensive )
 {
-	sendAsyncMessage(new View_Mgr_PerformLowMemoryActions(allowExpensive));
+	sendAsyncMessage(new View_Mgr_PerformLowMemoryActions(allowExpensive), QueuedMessage::BestEffort);
 }
 
 void WebAppMgrProxy::postShutdownEvent()
@@ -25,13 +25,14 @@
 #include "Common.h"
 
 #include <PIpcChannelListener.h>
-#include <queue>
 #include "IpcClientHost.h"
 #include "Event.h"
 #include "CustomEvents.h"
 #include <NewContentIndicatorEvent.h>
 #include <BannerMessageEvent.h>
 #include "ActiveCallBannerEvent.h"
+#include "MessageReplayQueue.h"
+#include "Timer.h"
 
 class PIpcChannel;
 class PIpcBuffer;
@@ -55,8 +56,11 @@ public:
 	virtual ~WebAppMgrProxy();
 	
 	void sendAsyncMessage(PIpcMessage* msg);
+	// kind (and key) tell how the message is treated if it has to wait for the connection
+	void sendAsyncMessage(PIpcMessage* msg, QueuedMessage::Kind kind, int key=0);
 	PIpcChannel* getIpcChannel() const;
 	void sendQueuedMessages();
+	int queuedMessageCount() const { return m_discMsgQueue.size(); }
 	
 	void closeWindow(Window* w);
     void launchUrl(const char* url, WindowType::Type winType=WindowType::Type_Card,
@@ -152,8 +156,10 @@ private:
 	static void webKitDiedCallback(GPid pid, gint status, gpointer data);
 	void webKitDied(GPid pid, gint status);
 
+	bool replayTimerFired();
+
 private:
-	
+
 	WebAppMgrProxy();
 	void clientConnected(int pid, PIpcChannel* channel);
 
@@ -161,7 +167,8 @@ private:
 	WebAppMgrProxy& operator=(const WebAppMgrProxy&);
 	
 private:
-	std::queue<PIpcMessage*> m_discMsgQueue; // for queueing outgoing messages while not connected
+	MessageReplayQueue<PIpcMessage> m_discMsgQueue; // for queueing outgoing messages while not connected
+	Timer<WebAppMgrProxy> m_replayTimer;
 	OrientationEvent::Orientation m_orientation;
 	
 	PIpcBuffer* m_ipcImgDragBuffer;
@@ -0,0 +1,81 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "SoundFeedbackChannel.h"
+
+#include <cjson/json.h>
+
+SoundFeedbackChannel::SoundFeedbackChannel(SoundFeedbackSink* sink, guint32 coalesceWindowMs)
+	: m_sink(sink)
+	, m_coalesceWindowMs(coalesceWindowMs)
+	, m_numPosted(0)
+	, m_numSent(0)
+	, m_numCoalesced(0)
+{
+}
+
+SoundFeedbackChannel::~SoundFeedbackChannel()
+{
+	// the sink is not owned
+}
+
+bool SoundFeedbackChannel::post(const std::string& name, const std::string& sinkName, guint64 nowMs)
+{
+	m_numPosted++;
+
+	RequestMap::iterator it = m_requests.find(std::make_pair(name, sinkName));
+	if (it == m_requests.end()) {
+		it = m_requests.insert(std::make_pair(std::make_pair(name, sinkName), Request())).first;
+		it->second.payload = buildPayload(name, sinkName);
+	}
+
+	Request& request = it->second;
+	if (request.sent && nowMs >= request.lastSentMs &&
+		nowMs - request.lastSentMs < m_coalesceWindowMs) {
+		m_numCoalesced++;
+		return false;
+	}
+
+	if (!m_sink)
+		return false;
+
+	request.sent = true;
+	request.lastSentMs = nowMs;
+	m_numSent++;
+
+	return m_sink->sendFeedback(request.payload);
+}
+
+std::string SoundFeedbackChannel::buildPayload(const std::string& name, const std::string& sinkName)
+{
+	json_object* json = json_object_new_object();
+	json_object_object_add(json, "name", json_object_new_string(name.c_str()));
+
+	if (!sinkName.empty())
+		json_object_object_add(json, "sink", json_object_new_string(sinkName.c_str()));
+
+	std::string payload = json_object_to_json_string(json);
+	json_object_put(json);
+
+	return payload;
+}
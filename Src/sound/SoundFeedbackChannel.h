@@ -0,0 +1,98 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef SOUNDFEEDBACKCHANNEL_H
+#define SOUNDFEEDBACKCHANNEL_H
+
+#include "Common.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <glib.h>
+
+/**
+ * Where feedback requests end up. The real one (in SoundPlayerPool) calls
+ * com.palm.audio/systemsounds/playFeedback; tests plug in their own.
+ */
+class SoundFeedbackSink
+{
+public:
+	virtual ~SoundFeedbackSink() {}
+
+	// payload is the complete, already serialized, json request
+	virtual bool sendFeedback(const std::string& payload) = 0;
+};
+
+/**
+ * Keeps one pre-serialized request per (feedback name, sink name) pair, so that a
+ * feedback sound costs a map lookup and one call into the sink.
+ *
+ * Requests for the same feedback that arrive within the coalesce window of the one
+ * that was last sent are folded into it: a burst of identical clicks a few ms apart
+ * results in a single call (and sounds the same). The first request of a burst is
+ * always sent right away, so nothing is delayed.
+ */
+class SoundFeedbackChannel
+{
+public:
+
+	SoundFeedbackChannel(SoundFeedbackSink* sink, guint32 coalesceWindowMs);
+	~SoundFeedbackChannel();
+
+	void		setSink(SoundFeedbackSink* sink) { m_sink = sink; }
+	SoundFeedbackSink* sink() const { return m_sink; }
+
+	void		setCoalesceWindow(guint32 ms) { m_coalesceWindowMs = ms; }
+
+	// returns true if a call was made, false if the request was coalesced (or failed)
+	bool		post(const std::string& name, const std::string& sinkName, guint64 nowMs);
+
+	static std::string buildPayload(const std::string& name, const std::string& sinkName);
+
+	guint32		numPosted() const { return m_numPosted; }
+	guint32		numSent() const { return m_numSent; }
+	guint32		numCoalesced() const { return m_numCoalesced; }
+	guint32		numPayloads() const { return m_requests.size(); }
+
+private:
+
+	struct Request
+	{
+		Request() : lastSentMs(0), sent(false) {}
+
+		std::string	payload;
+		guint64		lastSentMs;
+		bool		sent;
+	};
+
+	typedef std::map<std::pair<std::string, std::string>, Request> RequestMap;
+
+	SoundFeedbackSink*	m_sink;
+	guint32				m_coalesceWindowMs;
+	RequestMap			m_requests;
+
+	guint32				m_numPosted;
+	guint32				m_numSent;
+	guint32				m_numCoalesced;
+};
+
+#endif /* SOUNDFEEDBACKCHANNEL_H */
@@ -123,6 +123,9 @@ SoundPlayer::SoundPlayer()
 	, m_retries(0)
 	, m_state(eState_Init)
 	, m_fakeBackupRingtoneCount(0)
+	, m_warm(false)
+	, m_playedWarm(false)
+	, m_playRequestTime(0)
 	, m_timer(HostBase::instance()->masterTimer(), this, &SoundPlayer::healthCheck)
 	, m_activityID(0)
 {
@@ -174,7 +177,13 @@ void SoundPlayer::play(const std::string& filePath, const std::string& streamCla
 		return;
 	}
 
-	if (m_state != eState_Init)
+	// a warm player is connected (or still connecting) and idle: there is nothing to stop
+	bool idleWarm = m_warm && (m_state == eState_Connecting || m_state == eState_Connected);
+	m_warm = false;
+	m_playedWarm = idleWarm;
+	m_playRequestTime = currentTime();
+
+	if (m_state != eState_Init && !idleWarm)
 		stop();
 
 	// recycling? move state machine back
@@ -182,6 +191,48 @@ void SoundPlayer::play(const std::string& filePath, const std::string& streamCla
 		setState(eState_Connected);
 
 	m_filePath = filePath;
+	setStreamClass(streamClass);
+
+	m_repeat = repeat;
+	m_duration = float(duration) / 1000.f;	// integer ms to float seconds
+
+	if (idleWarm && m_state == eState_Connecting)
+	{	// connected() takes it from here. Until now the timer only watched the connection: book the activity too
+		m_timer.stop();
+		startTimer();
+	}
+	checkForNextStep();
+}
+
+/**
+ * Warm pool entry point: get connected (and loaded), but don't play
+ */
+void SoundPlayer::warmUp(const std::string& streamClass, const std::string& preloadPath)
+{
+	PRINTF_BLUE("SoundPlayer::warmUp(%s): %p: streamClass: %s, preload: %s",
+			  getStateName(), this, streamClass.c_str(), preloadPath.c_str());
+
+	if (m_state != eState_Init || !VERIFY(m_player == 0))
+		return;
+
+	m_warm = true;
+	m_warmStreamClass = streamClass;
+	m_preloadPath = preloadPath;
+	setStreamClass(streamClass);
+
+	setState(eState_Connecting);
+	// an idle connection doesn't need to keep the device awake, but a stuck one needs to be noticed
+	m_timer.start(1000, false);
+	m_lastPlayingTime = currentTime();
+	m_player = media::MediaClient::createLunaMediaPlayer(*this);
+	m_player->addMediaPlayerChangeListener(m_mediaPlayerChangeListener);
+}
+
+/**
+ * Map the stream class name to the media API's
+ */
+void SoundPlayer::setStreamClass(const std::string& streamClass)
+{
 	m_streamClass = streamClass;
 	m_audioStreamClass = kAudioStreamMedia;
 
@@ -222,14 +273,10 @@ void SoundPlayer::play(const std::string& filePath, const std::string& streamCla
 
 		else
 		{
-			WARNING("SoundPlayer::play: unrecognized media class '%s' for '%s'. Will use media class.", streamClass.c_str(), filePath.c_str());
+			WARNING("SoundPlayer::setStreamClass: unrecognized media class '%s' for '%s'. Will use media class.", streamClass.c_str(), m_filePath.c_str());
 			m_audioStreamClass = kAudioStreamMedia;
 		}
 	}
-
-	m_repeat = repeat;
-	m_duration = float(duration) / 1000.f;	// integer ms to float seconds
-	checkForNextStep();
 }
 
 /**
@@ -337,6 +384,11 @@ void SoundPlayer::currentTimeChanged()
 		PRINTF_BOLD("SoundPlayer::currentTimeChanged(%s): %f sec", getStateName(), m_player->getCurrentTime());
 		if (m_state == eState_PlayPending || m_state == eState_Playing)
 		{
+			if (m_playRequestTime)
+			{	// first sign of playback since play(): that's the latency the user hears
+				SoundPlayerPool::instance()->playStarted(m_streamClass, m_playedWarm, currentTime() - m_playRequestTime);
+				m_playRequestTime = 0;
+			}
 			setState(eState_Playing);
 			m_lastPlayingTime = currentTime();
 			if (!m_repeat && m_duration > 0 && m_player->getCurrentTime() >= m_duration)
@@ -413,6 +465,12 @@ void SoundPlayer::extendedErrorChanged()
  */
 void SoundPlayer::onError()
 {
+	if (m_warm)
+	{	// couldn't even preload: let the pool replace us
+		WARNING("SoundPlayer::onError(%s): warm player failed to load '%s'. Declaring SoundPlayer object dead.", getStateName(), m_preloadPath.c_str());
+		setState(eState_Dead);
+		return;
+	}
 	if (VERIFY(m_player) && eState_PlayPending && m_retries++ < 3)
 	{
 		m_player->unload();
@@ -460,8 +518,17 @@ void SoundPlayer::checkForNextStep()
 	else if (m_state == eState_Connected)
 	{
 		if (m_filePath.empty())
-		{	// if we had any problem, don't recycle this player...
-			if (m_retries == 0)
+		{
+			if (m_warm)
+			{	// idle in the warm pool: get the sound ready and wait for play()
+				m_timer.stop();
+				if (!m_preloadPath.empty() && VERIFY(m_player)) {
+					m_preloadedPath = m_preloadPath;
+					m_player->load(uriForPath(m_preloadedPath), m_audioStreamClass);
+				}
+			}
+			// if we had any problem, don't recycle this player...
+			else if (m_retries == 0)
 				setState(eState_Finished);
 			else
 				setState(eState_Dead);
@@ -470,7 +537,11 @@ void SoundPlayer::checkForNextStep()
 		{
 			setState(eState_PlayPending);
 			startTimer();
-			m_player->load(getURI(), m_audioStreamClass);
+			// a warm player may have this very sound loaded already (not if play() came while connecting)
+			if (m_preloadedPath != m_filePath)
+				m_player->load(getURI(), m_audioStreamClass);
+			m_preloadedPath.clear();
+			m_preloadPath.clear();
 			m_player->play();
 		}
 	}
@@ -555,6 +626,11 @@ bool SoundPlayer::healthCheck()
 			SoundPlayerPool::instance()->playFeedback("sysmgr_alert", "palerts");	// let's hope audiod & pulse are ok!
 		}
 	}
+	else if (m_warm && m_state == eState_Connecting && m_lastPlayingTime + cConnectDelay < currentTime())
+	{
+		WARNING("SoundPlayer::healthCheck(%s): warm player can't connect for %llu ms. Declaring SoundPlayer object dead.", getStateName(), currentTime() - m_lastPlayingTime);
+		setState(eState_Dead);
+	}
 	else if (m_state == eState_Closing && m_lastPlayingTime + cCloseDelay < currentTime())
 	{
 		WARNING("SoundPlayer::healthCheck(%s): can't close for %llu ms. Declaring SoundPlayer object dead.", getStateName(), currentTime() - m_lastPlayingTime);
@@ -572,12 +648,17 @@ bool SoundPlayer::healthCheck()
  * Return URI based on file name or URI
  */
 string SoundPlayer::getURI()
+{
+	return uriForPath(m_filePath);
+}
+
+string SoundPlayer::uriForPath(const string& filePath)
 {
 	string	uri;
-	if (m_filePath.size() > 0 && m_filePath[0] == '/')
-		uri = "file://" + m_filePath;
+	if (filePath.size() > 0 && filePath[0] == '/')
+		uri = "file://" + filePath;
 	else
-		uri = m_filePath;
+		uri = filePath;
 	return uri;
 }
 
@@ -114,6 +114,19 @@ public:
 
 	bool 		dead() const { return m_state == eState_Dead; }
 
+	/**
+	 * Warm pool support: connect to the media server for streamClass (and load preloadPath,
+	 * if not empty) without playing anything, so that a later play() starts right away.
+	 * Only valid on a new player.
+	 */
+	void		warmUp(const std::string& streamClass, const std::string& preloadPath);
+
+	// connected, idle and ready to play
+	bool		warm() const { return m_warm && m_state == eState_Connected; }
+	const std::string&	warmStreamClass() const { return m_warmStreamClass; }
+	// empty until the preload went out, which is once connected
+	const std::string&	preloadedPath() const { return m_preloadedPath; }
+
 	static int m_numInstances; // to keep count of number of instantiations
 
 protected:
@@ -145,7 +158,9 @@ private:
 	const char *	getStateName();
 	guint64			currentTime();
 	void			startTimer();
+	void			setStreamClass(const std::string& streamClass);
 	string			getURI();
+	static string	uriForPath(const string& filePath);
 	void			onError();
 
 	LSHandle *		getServiceHandle();
@@ -162,6 +177,12 @@ private:
 	EState					m_state;
 	guint64					m_lastPlayingTime;
 	int						m_fakeBackupRingtoneCount;
+	bool					m_warm;				// in the warm pool, not asked to play yet
+	string					m_warmStreamClass;
+	string					m_preloadPath;		// what to load ahead of time, once connected
+	string					m_preloadedPath;	// what the media player has loaded, if we loaded it ahead of time
+	bool					m_playedWarm;		// play() was called on a warm player
+	guint64					m_playRequestTime;	// 0 once the first playback progress was reported
 	boost::shared_ptr<MediaPlayerChangeListener>	m_mediaPlayerChangeListener;
 
 	Timer<SoundPlayer>		m_timer;
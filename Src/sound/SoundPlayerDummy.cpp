@@ -44,3 +44,9 @@ void SoundPlayer::stop()
 {
     
 }
+
+void SoundPlayer::warmUp(const std::string& streamClass, const std::string& preloadPath)
+{
+	m_warmStreamClass = streamClass;
+	m_preloadedPath = preloadPath;
+}
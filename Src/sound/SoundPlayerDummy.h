@@ -47,7 +47,17 @@ public:
 
 	bool 		dead() const { return true; }
 
+	void		warmUp(const std::string& streamClass, const std::string& preloadPath);
+	bool		warm() const { return false; }
+	const std::string&	warmStreamClass() const { return m_warmStreamClass; }
+	const std::string&	preloadedPath() const { return m_preloadedPath; }
+
 	static int m_numInstances; // to keep count of number of instantiations
+
+private:
+
+	std::string	m_warmStreamClass;
+	std::string	m_preloadedPath;
 };	
 
 
@@ -23,7 +23,6 @@
 
 #include "SoundPlayerPool.h"
 #include <algorithm>
-#include <cjson/json.h>
 
 #include "HostBase.h"
 #include "Preferences.h"
@@ -31,6 +30,16 @@
 static SoundPlayerPool* s_instance = 0;
 static const int kMaxPooledPlayers = 0;
 static const int kMaxPlayers = 5;
+// identical feedback requests closer together than this are played once
+static const int kFeedbackCoalesceMs = 15;
+// connected players kept ready for notification and alert sounds
+static const int kWarmPlayersPerClass = 1;
+// player slots the warm pool leaves free, for sounds of other classes
+static const int kColdPlayersReserved = 2;
+// let the boot sequence settle before connecting the first warm players
+static const int kInitialWarmUpDelayMs = 10000;
+// after a warm player is used, replace it once its sound had time to play
+static const int kReplenishDelayMs = 2000;
 
 SoundPlayerPool* SoundPlayerPool::instance()
 {
@@ -41,7 +50,11 @@ SoundPlayerPool* SoundPlayerPool::instance()
 }
 
 SoundPlayerPool::SoundPlayerPool()
-	: m_purgeTimer(HostBase::instance()->masterTimer(), this, &SoundPlayerPool::purgeTimerFired)
+	: m_lsHandle(0)
+	, m_purgeTimer(HostBase::instance()->masterTimer(), this, &SoundPlayerPool::purgeTimerFired)
+	, m_feedbackChannel(&m_busFeedbackSink, kFeedbackCoalesceMs)
+	, m_warmPool(&m_warmPlayerFactory)
+	, m_warmTimer(HostBase::instance()->masterTimer(), this, &SoundPlayerPool::warmTimerFired)
 {
     s_instance = this;
 
@@ -62,6 +75,15 @@ SoundPlayerPool::SoundPlayerPool()
 		LSErrorFree(&error);
 		return;
 	}
+
+	m_busFeedbackSink.m_lsHandle = m_lsHandle;
+
+#if defined(HAS_MEDIA_API)
+	// the sounds that go through SoundPlayer most often: custom notification & alert tones
+	m_warmPool.setTarget("notifications", kWarmPlayersPerClass);
+	m_warmPool.setTarget("alerts", kWarmPlayersPerClass);
+	scheduleWarmUp(kInitialWarmUpDelayMs);
+#endif
 }
 
 SoundPlayerPool::~SoundPlayerPool()
@@ -75,9 +97,17 @@ sptr<SoundPlayer> SoundPlayerPool::play(const std::string& filePath,
 										const std::string& streamClass,
 										bool repeat, int duration)
 {
-	sptr<SoundPlayer> player = getPooledPlayer();
+	sptr<SoundPlayer> player = m_warmPool.take(streamClass, filePath);
+	if (player.get())
+		scheduleWarmUp(kReplenishDelayMs);
+	else
+		player = getPooledPlayer();
+
 	if (!player.get()) {
-		if (SoundPlayer::m_numInstances >= kMaxPlayers) {
+		// idle warm players give way to an actual request
+		while (numPlayers() >= kMaxPlayers && m_warmPool.evictOne()) {}
+
+		if (numPlayers() >= kMaxPlayers) {
 			g_warning ("Exceeded maximum instances of sound players %d, ignoring request", kMaxPlayers);
 			return 0;
             }
@@ -107,27 +137,77 @@ void SoundPlayerPool::playFeedback(const std::string& name,
 {
 	if (sinkName.empty() && !Preferences::instance()->playFeedbackSounds())
 		return;
-	
-	bool ret;
-	LSError error;
-	LSErrorInit(&error);
 
-	if (!m_lsHandle)
-		return;
+	m_feedbackChannel.post(name, sinkName, SingletonTimer::currentTime());
+}
 
-	json_object* json = json_object_new_object();
-	json_object_object_add(json, "name", json_object_new_string(name.c_str()));
+void SoundPlayerPool::setFeedbackSink(SoundFeedbackSink* sink)
+{
+	m_feedbackChannel.setSink(sink ? sink : &m_busFeedbackSink);
+}
 
-	if (!sinkName.empty())
-		json_object_object_add(json, "sink", json_object_new_string(sinkName.c_str()));
+bool SoundPlayerPool::LunaBusFeedbackSink::sendFeedback(const std::string& payload)
+{
+	if (!m_lsHandle)
+		return false;
 
-	ret = LSCall(m_lsHandle, "palm://com.palm.audio/systemsounds/playFeedback",
-				 json_object_to_json_string(json), NULL, NULL, NULL, &error);
+	LSError error;
+	LSErrorInit(&error);
+
+	bool ret = LSCall(m_lsHandle, "palm://com.palm.audio/systemsounds/playFeedback",
+					  payload.c_str(), NULL, NULL, NULL, &error);
 	if (!ret) {
 		g_warning("Failed in playFeedback call: %s", error.message);
 		LSErrorFree(&error);
 	}
-	json_object_put(json);
+	return ret;
+}
+
+void SoundPlayerPool::setWarmPlayers(const std::string& streamClass, int count)
+{
+	m_warmPool.setTarget(streamClass, count);
+	if (m_warmPool.needsPlayers())
+		scheduleWarmUp(0);
+}
+
+sptr<SoundPlayer> SoundPlayerPool::WarmPlayerFactory::createWarmPlayer(const std::string& streamClass,
+																	   const std::string& preloadPath)
+{
+	sptr<SoundPlayer> player(new SoundPlayer);
+	player->warmUp(streamClass, preloadPath);
+	return player;
+}
+
+void SoundPlayerPool::scheduleWarmUp(int delayMs)
+{
+	if (!m_warmTimer.running())
+		m_warmTimer.start(delayMs, true);
+}
+
+bool SoundPlayerPool::warmTimerFired()
+{
+	// don't set up media sessions while something is playing: we'll be back when it finishes
+	if (!m_activePlayers.empty())
+		return false;
+
+	// the tones can be changed at any time: players with an old one loaded get replaced
+	m_warmPool.setPreload("notifications", Preferences::instance()->getCurrentNotificationtone());
+	m_warmPool.setPreload("alerts", Preferences::instance()->getCurrentAlerttone());
+
+	int budget = kMaxPlayers - kColdPlayersReserved - numPlayers();
+	if (budget > 0)
+		m_warmPool.replenish(budget);
+
+	return false;
+}
+
+void SoundPlayerPool::playStarted(const std::string& streamClass, bool warm, guint64 latencyMs)
+{
+	m_latencyStats.record(streamClass, warm, (guint32) latencyMs);
+
+	SoundPlayLatencyStats::Entry entry = m_latencyStats.entry(streamClass, warm);
+	g_debug("Sound playback started: %s, %s player, %llu ms after play (avg %u ms over %u plays)",
+			streamClass.c_str(), warm ? "warm" : "cold", latencyMs, entry.averageMs(), entry.count);
 }
 
 void SoundPlayerPool::queueFinishedPlayer(sptr<SoundPlayer> player)
@@ -155,6 +235,10 @@ void SoundPlayerPool::queueFinishedPlayer(sptr<SoundPlayer> player)
 		
 	if (!m_purgeTimer.running())
 		m_purgeTimer.start(0);
+
+	// includes warm players that gave up
+	if (m_warmPool.needsPlayers())
+		scheduleWarmUp(kReplenishDelayMs);
 }
 
 bool SoundPlayerPool::purgeTimerFired()
@@ -184,6 +268,19 @@ bool SoundPlayerPool::purgeTimerFired()
     return false;
 }
 
+int SoundPlayerPool::numPlayers() const
+{
+	// SoundPlayer only counts its instances in the dummy build: count what we hold instead.
+	// Finished players keep their media connection until they are dead
+	int count = m_activePlayers.size() + m_warmPool.size();
+	for (PlayerList::const_iterator it = m_finishedPlayers.begin(); it != m_finishedPlayers.end(); ++it) {
+		if (!(*it)->dead())
+			count++;
+	}
+
+	return count;
+}
+
 sptr<SoundPlayer> SoundPlayerPool::getPooledPlayer()
 {
 /*	
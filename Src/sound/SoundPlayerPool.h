@@ -30,6 +30,8 @@
 
 #include "sptr.h"
 #include "Timer.h"
+#include "SoundFeedbackChannel.h"
+#include "SoundWarmPool.h"
 
 #if !defined(HAS_MEDIA_API)
 #include "SoundPlayerDummy.h"
@@ -50,14 +52,44 @@ public:
 
 	void playFeedback(const std::string& name, const std::string& sinkName=std::string());
 
+	// replaces the luna bus as the destination of playFeedback() (e.g. for a local stand-in
+	// audio service). Pass 0 to go back to the bus. The sink is not owned
+	void setFeedbackSink(SoundFeedbackSink* sink);
+	SoundFeedbackChannel& feedbackChannel() { return m_feedbackChannel; }
+
+	// number of connected, idle players to keep ready for a stream class (0 turns warming off)
+	void setWarmPlayers(const std::string& streamClass, int count);
+	const SoundPlayLatencyStats& latencyStats() const { return m_latencyStats; }
+
 private:
 
+	class LunaBusFeedbackSink : public SoundFeedbackSink
+	{
+	public:
+		LunaBusFeedbackSink() : m_lsHandle(0) {}
+		virtual bool sendFeedback(const std::string& payload);
+
+		LSHandle* m_lsHandle;
+	};
+
+	class WarmPlayerFactory : public SoundWarmPool<SoundPlayer>::Factory
+	{
+	public:
+		virtual sptr<SoundPlayer> createWarmPlayer(const std::string& streamClass,
+												   const std::string& preloadPath);
+	};
+
 	SoundPlayerPool();
 	~SoundPlayerPool();
 
 	void queueFinishedPlayer(sptr<SoundPlayer> player);
 	bool purgeTimerFired();
 	sptr<SoundPlayer> getPooledPlayer();
+	int numPlayers() const;
+
+	void scheduleWarmUp(int delayMs);
+	bool warmTimerFired();
+	void playStarted(const std::string& streamClass, bool warm, guint64 latencyMs);
 
 private:
 
@@ -68,6 +100,14 @@ private:
 	LSHandle* m_lsHandle;
 	Timer<SoundPlayerPool> m_purgeTimer;
 
+	LunaBusFeedbackSink m_busFeedbackSink;
+	SoundFeedbackChannel m_feedbackChannel;
+
+	WarmPlayerFactory m_warmPlayerFactory;
+	SoundWarmPool<SoundPlayer> m_warmPool;
+	Timer<SoundPlayerPool> m_warmTimer;
+	SoundPlayLatencyStats m_latencyStats;
+
 	friend class SoundPlayer;
 };
 
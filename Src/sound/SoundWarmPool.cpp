@@ -0,0 +1,61 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "Common.h"
+
+#include "SoundWarmPool.h"
+
+#include <stdio.h>
+
+void SoundPlayLatencyStats::record(const std::string& streamClass, bool warm, guint32 latencyMs)
+{
+	Entry& entry = m_entries[std::make_pair(streamClass, warm)];
+	entry.count++;
+	entry.totalMs += latencyMs;
+	entry.lastMs = latencyMs;
+	if (latencyMs > entry.maxMs)
+		entry.maxMs = latencyMs;
+}
+
+SoundPlayLatencyStats::Entry SoundPlayLatencyStats::entry(const std::string& streamClass, bool warm) const
+{
+	EntryMap::const_iterator it = m_entries.find(std::make_pair(streamClass, warm));
+	if (it == m_entries.end())
+		return Entry();
+
+	return it->second;
+}
+
+std::string SoundPlayLatencyStats::report() const
+{
+	std::string out;
+	char line[256];
+
+	for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+		const Entry& entry = it->second;
+		snprintf(line, sizeof(line), "%s (%s): %u plays, avg %u ms, max %u ms, last %u ms\n",
+				 it->first.first.c_str(), it->first.second ? "warm" : "cold",
+				 entry.count, entry.averageMs(), entry.maxMs, entry.lastMs);
+		out += line;
+	}
+
+	return out;
+}
@@ -0,0 +1,285 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2008-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef SOUNDWARMPOOL_H
+#define SOUNDWARMPOOL_H
+
+#include "Common.h"
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <glib.h>
+
+#include "sptr.h"
+
+/**
+ * Time from a play request to the first sign of playback (the first position update
+ * from the media service), per stream class, kept apart for players that came out of
+ * the warm pool and players that had to connect first.
+ */
+class SoundPlayLatencyStats
+{
+public:
+
+	struct Entry
+	{
+		Entry() : count(0), totalMs(0), maxMs(0), lastMs(0) {}
+
+		guint32		count;
+		guint64		totalMs;
+		guint32		maxMs;
+		guint32		lastMs;
+
+		guint32		averageMs() const { return count ? guint32(totalMs / count) : 0; }
+	};
+
+	void		record(const std::string& streamClass, bool warm, guint32 latencyMs);
+	void		reset() { m_entries.clear(); }
+
+	// an empty entry if nothing was recorded for that class yet
+	Entry		entry(const std::string& streamClass, bool warm) const;
+
+	// one line per stream class, for logging
+	std::string	report() const;
+
+private:
+
+	typedef std::map<std::pair<std::string, bool>, Entry> EntryMap;
+
+	EntryMap	m_entries;
+};
+
+/**
+ * Keeps a configurable number of players per stream class connected to the media
+ * service (and optionally with a sound already loaded), so that a play request doesn't
+ * have to wait for the bus registration and the media session setup.
+ *
+ * A warm player is handed out once and is not returned to the pool: the media server
+ * doesn't handle back to back playbacks on the same client well, so the pool is topped
+ * up with fresh players instead (see replenish()).
+ *
+ * Player needs:
+ *	bool				dead() const;			// gave up, don't use
+ *	bool				warm() const;			// connected, idle and ready to play
+ *	const std::string&	warmStreamClass() const;
+ *	const std::string&	preloadedPath() const;	// empty if nothing was loaded
+ */
+template <class Player>
+class SoundWarmPool
+{
+public:
+
+	class Factory
+	{
+	public:
+		virtual ~Factory() {}
+
+		// a new player that connects for streamClass (and loads preloadPath, if not
+		// empty) without playing anything
+		virtual sptr<Player> createWarmPlayer(const std::string& streamClass,
+											  const std::string& preloadPath) = 0;
+	};
+
+	SoundWarmPool(Factory* factory)
+		: m_factory(factory)
+		, m_numHits(0)
+		, m_numMisses(0)
+		, m_numCreated(0)
+	{
+	}
+
+	// number of warm players to keep for a stream class (0 to stop warming it)
+	void setTarget(const std::string& streamClass, int count) {
+		m_config[streamClass].target = count;
+		trim(streamClass);
+	}
+
+	int target(const std::string& streamClass) const {
+		typename ConfigMap::const_iterator it = m_config.find(streamClass);
+		return it != m_config.end() ? it->second.target : 0;
+	}
+
+	// sound the warm players of a stream class load ahead of time. Idle players that
+	// have something else loaded are dropped, and replaced on the next replenish()
+	void setPreload(const std::string& streamClass, const std::string& filePath) {
+		ClassConfig& config = m_config[streamClass];
+		if (config.preloadPath == filePath)
+			return;
+
+		config.preloadPath = filePath;
+		typename PlayerList::iterator it = m_players.begin();
+		while (it != m_players.end()) {
+			if ((*it)->warmStreamClass() == streamClass && (*it)->preloadedPath() != filePath)
+				it = m_players.erase(it);
+			else
+				++it;
+		}
+	}
+
+	const std::string& preload(const std::string& streamClass) const {
+		static const std::string s_none;
+		typename ConfigMap::const_iterator it = m_config.find(streamClass);
+		return it != m_config.end() ? it->second.preloadPath : s_none;
+	}
+
+	// hands out (and forgets) a warm player for streamClass: one that already has filePath
+	// loaded if possible, then any connected one, then one that is still connecting.
+	// 0 if the pool has nothing for that class
+	sptr<Player> take(const std::string& streamClass, const std::string& filePath) {
+		typename PlayerList::iterator best = m_players.end();
+		int bestScore = 0;
+		for (typename PlayerList::iterator it = m_players.begin(); it != m_players.end(); ++it) {
+			const sptr<Player>& player = *it;
+			if (player->dead() || player->warmStreamClass() != streamClass)
+				continue;
+
+			int score = 1;
+			if (player->warm())
+				score = (player->preloadedPath() == filePath) ? 3 : 2;
+
+			if (score > bestScore) {
+				best = it;
+				bestScore = score;
+			}
+		}
+
+		if (best == m_players.end()) {
+			m_numMisses++;
+			return 0;
+		}
+
+		sptr<Player> player = *best;
+		m_players.erase(best);
+		m_numHits++;
+		return player;
+	}
+
+	// drops dead players, then creates new ones until every stream class has its target
+	// count, creating no more than budget players. Returns the number of players created
+	int replenish(int budget) {
+		typename PlayerList::iterator it = m_players.begin();
+		while (it != m_players.end()) {
+			if ((*it)->dead())
+				it = m_players.erase(it);
+			else
+				++it;
+		}
+
+		int created = 0;
+		for (typename ConfigMap::const_iterator cit = m_config.begin(); cit != m_config.end(); ++cit) {
+			int missing = cit->second.target - size(cit->first);
+			while (missing-- > 0 && created < budget) {
+				sptr<Player> player = m_factory->createWarmPlayer(cit->first, cit->second.preloadPath);
+				if (!player.get())
+					break;
+
+				m_players.push_back(player);
+				m_numCreated++;
+				created++;
+			}
+		}
+
+		return created;
+	}
+
+	// gives up one warm player (dead or still connecting ones first) to make room for
+	// another player. false if the pool is empty
+	bool evictOne() {
+		if (m_players.empty())
+			return false;
+
+		typename PlayerList::iterator victim = m_players.begin();
+		for (typename PlayerList::iterator it = m_players.begin(); it != m_players.end(); ++it) {
+			if ((*it)->dead() || !(*it)->warm()) {
+				victim = it;
+				break;
+			}
+		}
+
+		m_players.erase(victim);
+		return true;
+	}
+
+	void clear() { m_players.clear(); }
+
+	int size() const { return m_players.size(); }
+
+	// live players only
+	int size(const std::string& streamClass) const {
+		int count = 0;
+		for (typename PlayerList::const_iterator it = m_players.begin(); it != m_players.end(); ++it) {
+			if (!(*it)->dead() && (*it)->warmStreamClass() == streamClass)
+				count++;
+		}
+		return count;
+	}
+
+	// any stream class below its target?
+	bool needsPlayers() const {
+		for (typename ConfigMap::const_iterator it = m_config.begin(); it != m_config.end(); ++it) {
+			if (size(it->first) < it->second.target)
+				return true;
+		}
+		return false;
+	}
+
+	guint32 numHits() const { return m_numHits; }
+	guint32 numMisses() const { return m_numMisses; }
+	guint32 numCreated() const { return m_numCreated; }
+
+private:
+
+	struct ClassConfig
+	{
+		ClassConfig() : target(0) {}
+
+		int			target;
+		std::string	preloadPath;
+	};
+
+	typedef std::map<std::string, ClassConfig> ConfigMap;
+	typedef std::list<sptr<Player> > PlayerList;
+
+	// drops the extra players of a class, newest first
+	void trim(const std::string& streamClass) {
+		int extra = size(streamClass) - target(streamClass);
+		typename PlayerList::iterator it = m_players.end();
+		while (extra > 0 && it != m_players.begin()) {
+			--it;
+			if ((*it)->warmStreamClass() == streamClass) {
+				it = m_players.erase(it);
+				extra--;
+			}
+		}
+	}
+
+	Factory*	m_factory;
+	ConfigMap	m_config;
+	PlayerList	m_players;
+
+	guint32		m_numHits;
+	guint32		m_numMisses;
+	guint32		m_numCreated;
+};
+
+#endif /* SOUNDWARMPOOL_H */
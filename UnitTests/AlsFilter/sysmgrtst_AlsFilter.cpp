@@ -0,0 +1,332 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "AlsFilter.h"
+
+// A light trace, as recorded from the sensor: one sample per line, "time lux", with the
+// time in ms. Set SYSMGR_ALS_TRACE to a file of those to replay it as well as the
+// synthetic traces below. The traces give the light level over time: the replay
+// samples them at whichever rate the filter asks for.
+
+enum { RegionUndefined, RegionDark, RegionDim, RegionIndoor, RegionOutdoor, NumRegions };
+
+static const uint32_t kFastMs = 100;
+static const uint32_t kSlowMs = 1000;
+
+struct TraceSample
+{
+	uint32_t	time;
+	int32_t		lux;
+};
+
+typedef std::vector<TraceSample> Trace;
+
+static void setRegions(AlsFilter& filter)
+{
+	filter.setRegionBorder(RegionUndefined, -1, 0);
+	filter.setRegionBorder(RegionDark, 6, 4);
+	filter.setRegionBorder(RegionDim, 100, 10);
+	filter.setRegionBorder(RegionIndoor, 1000, 100);
+	filter.setRegionBorder(RegionOutdoor, INT_MAX, 0);
+	filter.reset(RegionIndoor);
+}
+
+// deterministic noise, +-amount
+static int32_t noise(uint32_t* seed, int32_t amount)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return (int32_t) ((*seed >> 16) % (2 * amount + 1)) - amount;
+}
+
+static Trace steadyTrace(int32_t lux, int32_t noiseLux, uint32_t durationMs)
+{
+	Trace trace;
+	uint32_t seed = 1;
+	for (uint32_t t = 0; t <= durationMs; t += 50) {
+		TraceSample s = { t, lux + noise(&seed, noiseLux) };
+		trace.push_back(s);
+	}
+	return trace;
+}
+
+static bool readTrace(const char* path, Trace& trace)
+{
+	FILE* f = fopen(path, "r");
+	if (!f)
+		return false;
+
+	unsigned int time;
+	int lux;
+	while (fscanf(f, "%u %d", &time, &lux) == 2) {
+		TraceSample s = { time, lux };
+		trace.push_back(s);
+	}
+	fclose(f);
+	return trace.size() > 1;
+}
+
+static int32_t luxAt(const Trace& trace, uint32_t time)
+{
+	size_t i = 0;
+	while (i + 1 < trace.size() && trace[i + 1].time <= time)
+		i++;
+	return trace[i].lux;
+}
+
+struct ReplayResult
+{
+	ReplayResult() : samples(0), regionChanges(0), slowSamples(0), rejected(0), finalRegion(0) {}
+
+	int		samples;
+	int		regionChanges;		// what subscribers and the display hear about
+	int		slowSamples;
+	int		rejected;
+	int		finalRegion;
+};
+
+// the sampling the sensor does, at the rate the filter asks for
+static ReplayResult replay(const Trace& trace)
+{
+	AlsFilter filter;
+	setRegions(filter);
+
+	ReplayResult result;
+	uint32_t end = trace.back().time;
+	for (uint32_t t = trace.front().time; t <= end; t += filter.stable() ? kSlowMs : kFastMs) {
+		if (filter.stable())
+			result.slowSamples++;
+		if (filter.addSample(luxAt(trace, t), t))
+			result.regionChanges++;
+		result.samples++;
+	}
+	result.rejected = filter.numRejected();
+	result.finalRegion = filter.region();
+	return result;
+}
+
+// what AmbientLightSensor did before: the average of the last 10 samples, re-estimated
+// for every sample, at the fast rate
+static ReplayResult replayLegacy(const Trace& trace)
+{
+	static const int32_t border[NumRegions] = { -1, 6, 100, 1000, INT_MAX };
+	static const int32_t margin[NumRegions] = { 0, 4, 10, 100, 0 };
+
+	ReplayResult result;
+	std::vector<int32_t> window;
+	int32_t sum = 0;
+	int region = RegionIndoor;
+
+	uint32_t end = trace.back().time;
+	for (uint32_t t = trace.front().time; t <= end; t += kFastMs) {
+		int32_t lux = luxAt(trace, t);
+		window.push_back(lux);
+		sum += lux;
+		if (window.size() > 10) {
+			sum -= window.front();
+			window.erase(window.begin());
+		}
+		result.samples++;
+		if (window.size() < 10)
+			continue;
+
+		int old = region;
+		while (region > RegionDark && sum / 10 < border[region - 1] - margin[region - 1])
+			--region;
+		while (region < RegionOutdoor && sum / 10 > border[region] + margin[region])
+			++region;
+		if (region != old)
+			result.regionChanges++;
+	}
+	result.finalRegion = region;
+	return result;
+}
+
+static void report(const char* name, const Trace& trace, ReplayResult* legacy, ReplayResult* filtered)
+{
+	*legacy = replayLegacy(trace);
+	*filtered = replay(trace);
+
+	qDebug("%s: legacy %d samples, %d region changes; filtered %d samples (%d slow), %d region changes, %d rejected",
+		   name, legacy->samples, legacy->regionChanges,
+		   filtered->samples, filtered->slowSamples, filtered->regionChanges, filtered->rejected);
+}
+
+// -------------------------------------------------------------------------
+
+class TestAlsFilter : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void smoothing();
+	void outlierRejection();
+	void stepChange();
+	void hysteresis();
+	void slowRateWhenStable();
+	void replayRecorded();
+};
+
+void TestAlsFilter::smoothing()
+{
+	AlsFilter filter;
+	setRegions(filter);
+	filter.setTimeConstants(1000, 3000);
+
+	filter.addSample(200, 0);
+	filter.addSample(300, 1000);
+
+	// one time constant in: 63% of the way there, whatever the sample rate
+	QCOMPARE(filter.value(), 263);
+
+	AlsFilter fast;
+	setRegions(fast);
+	fast.setTimeConstants(1000, 3000);
+	fast.addSample(200, 0);
+	for (uint32_t t = 100; t <= 1000; t += 100)
+		fast.addSample(300, t);
+	QCOMPARE(fast.value(), 263);
+
+	// darker is slower
+	filter.addSample(100, 2000);
+	QVERIFY(filter.value() > 200);
+	QCOMPARE(filter.lastSample(), 100);
+}
+
+// a camera flash, or a hand passing over the sensor
+void TestAlsFilter::outlierRejection()
+{
+	AlsFilter filter;
+	setRegions(filter);
+
+	uint32_t t = 0;
+	for (; t < 1000; t += kFastMs)
+		filter.addSample(300, t);
+
+	QVERIFY(!filter.addSample(20000, t += kFastMs));
+	QVERIFY(!filter.addSample(310, t += kFastMs));
+	QVERIFY(!filter.addSample(0, t += kFastMs));
+	QVERIFY(!filter.addSample(290, t += kFastMs));
+
+	QCOMPARE(filter.region(), (int) RegionIndoor);
+	QCOMPARE(filter.numRejected(), 2);
+	QVERIFY(filter.value() > 280 && filter.value() < 320);
+
+	// the averaging alone went outdoor and back for a flash
+	Trace trace = steadyTrace(300, 20, 5000);
+	for (int i = 0; i < 4; i++)
+		trace[40 + i].lux = 20000;
+
+	ReplayResult legacy = replayLegacy(trace);
+	QCOMPARE(legacy.regionChanges, 2);
+}
+
+// walking outside: the region follows within a couple of samples
+void TestAlsFilter::stepChange()
+{
+	AlsFilter filter;
+	setRegions(filter);
+
+	uint32_t t = 0;
+	for (; t < 1000; t += kFastMs)
+		filter.addSample(300, t);
+	QCOMPARE(filter.region(), (int) RegionIndoor);
+
+	QVERIFY(!filter.addSample(8000, t));
+	t += kFastMs;
+	QVERIFY(filter.addSample(8000, t));
+	QCOMPARE(filter.region(), (int) RegionOutdoor);
+	QCOMPARE(filter.value(), 8000);
+
+	// and back in
+	for (int i = 0; i < 2; i++) {
+		t += kFastMs;
+		filter.addSample(40, t);
+	}
+	QCOMPARE(filter.region(), (int) RegionDim);
+}
+
+// a light level right on the dim/indoor border, flickering
+void TestAlsFilter::hysteresis()
+{
+	Trace trace = steadyTrace(100, 15, 20000);
+
+	ReplayResult legacy, filtered;
+	report("border flicker", trace, &legacy, &filtered);
+	QVERIFY(filtered.regionChanges <= 1);
+
+	// a slow dusk goes through each region once
+	Trace dusk;
+	uint32_t seed = 7;
+	for (uint32_t t = 0; t <= 120000; t += 50) {
+		int32_t lux = MAX(900 - (int32_t) (t / 120), 0);
+		TraceSample s = { t, MAX(lux + noise(&seed, lux / 10 + 2), 0) };
+		dusk.push_back(s);
+	}
+	report("dusk", dusk, &legacy, &filtered);
+	QCOMPARE(filtered.finalRegion, (int) RegionDark);
+	QCOMPARE(filtered.regionChanges, 2);
+}
+
+void TestAlsFilter::slowRateWhenStable()
+{
+	Trace trace = steadyTrace(300, 20, 60000);
+
+	ReplayResult legacy, filtered;
+	report("steady indoor", trace, &legacy, &filtered);
+
+	QCOMPARE(filtered.regionChanges, 0);
+	QVERIFY(filtered.samples * 5 < legacy.samples);
+
+	// a change brings the fast rate back
+	AlsFilter filter;
+	setRegions(filter);
+	uint32_t t = 0;
+	for (; !filter.stable(); t += kFastMs)
+		filter.addSample(300, t);
+	QCOMPARE(filter.numSamples(), (int) AlsFilter::kStableSamples);
+
+	filter.addSample(700, t);
+	QVERIFY(!filter.stable());
+}
+
+void TestAlsFilter::replayRecorded()
+{
+	const char* path = getenv("SYSMGR_ALS_TRACE");
+	if (!path)
+		QSKIP("SYSMGR_ALS_TRACE not set", SkipSingle);
+
+	Trace trace;
+	QVERIFY2(readTrace(path, trace), path);
+
+	ReplayResult legacy, filtered;
+	report(path, trace, &legacy, &filtered);
+}
+
+QTEST_MAIN(TestAlsFilter)
+#include "sysmgrtst_AlsFilter.moc"
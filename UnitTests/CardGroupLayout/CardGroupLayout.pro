@@ -0,0 +1,69 @@
+# @@@LICENSE
+#
+#      Copyright (c) 2010-2013 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# LICENSE@@@
+CONFIG += qt no_keywords
+QT += testlib
+CONFIG += link_pkgconfig
+PKGCONFIG = glib-2.0 gthread-2.0
+
+VPATH = ../../Src \
+		../../Src/base \
+		../../Src/core \
+		../../Src/lunaui/cards
+
+INCLUDEPATH = $$VPATH
+
+DEFINES += QT_WEBOS
+
+QMAKE_CXXFLAGS += -fno-rtti -fno-exceptions -Wall -Werror
+QMAKE_CXXFLAGS += -DFIX_FOR_QT
+# Override the default (-Wall -W) from g++.conf mkspec (see linux-g++.conf)
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter -Wno-unused-variable -Wno-reorder -Wno-missing-field-initializers -Wno-extra
+
+
+linux-g++ {
+	include(../../desktop.pri)
+}
+
+linux-qemux86-g++ {
+	include(../../device.pri)
+	QMAKE_CXXFLAGS += -fno-strict-aliasing
+}
+
+linux-qemuarm-g++ {
+    include(../../device.pri)
+    QMAKE_CXXFLAGS += -fno-strict-aliasing
+}
+
+linux-armv7-g++ {
+	include(../../device.pri)
+}
+
+linux-armv6-g++ {
+	include(../../device.pri)
+}
+
+DESTDIR = ./$${BUILD_TYPE}-$${MACHINE_NAME}
+OBJECTS_DIR = $$DESTDIR/.obj
+MOC_DIR = $$DESTDIR/.moc
+TARGET = sysmgrtst_CardGroupLayout
+
+HEADERS += \
+	CardGroupLayout.h
+
+SOURCES += \
+	sysmgrtst_CardGroupLayout.cpp
@@ -0,0 +1,258 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <QVector>
+
+#include "CardGroupLayout.h"
+
+// 50 cards in groups of one to four, on a 1024 pixel wide screen
+static const int kNumCards = 50;
+static const int kScreenWidth = 1024;
+static const int kCardWidth = 192;
+static const int kGap = 40;
+
+// what CardGroup does, with the cards reduced to their x
+class FakeGroup
+{
+public:
+
+	FakeGroup(int cards) : m_x(0), m_left(0), m_right(0), m_cardX(cards), m_cardSceneX(cards) {}
+
+	int left() const { return m_left; }
+	int right() const { return m_right; }
+	qreal x() const { return m_x; }
+	int size() const { return m_cardX.size(); }
+
+	bool collapsedAt(int x) const { return x != 0 && kCardWidth - qAbs(x) <= 1; }
+
+	void setCardPositions(int x) {
+
+		qreal amtToCollapse = qMax((qreal) 1, (qreal) (kCardWidth - qAbs(x))) / kCardWidth;
+		for (int i = 0; i < m_cardX.size(); i++)
+			m_cardX[i] = (i - (m_cardX.size() - 1) / 2.0) * 60 * amtToCollapse + (1 - amtToCollapse) * 10 * i;
+
+		m_left = kCardWidth / 2 - (int) m_cardX.first();
+		m_right = kCardWidth / 2 + (int) m_cardX.last();
+
+		setX(x);
+	}
+
+	void setX(qreal x) {
+
+		m_x = x;
+		for (int i = 0; i < m_cardX.size(); i++)
+			m_cardSceneX[i] = m_x + m_cardX[i];
+	}
+
+	void addCard() {
+		m_cardX.append(0);
+		m_cardSceneX.append(0);
+	}
+
+	const QVector<qreal>& cardSceneX() const { return m_cardSceneX; }
+
+private:
+
+	qreal m_x;
+	int m_left;
+	int m_right;
+	QVector<qreal> m_cardX;
+	QVector<qreal> m_cardSceneX;
+};
+
+static QVector<FakeGroup*> makeGroups()
+{
+	QVector<FakeGroup*> groups;
+	for (int cards = 0, i = 0; cards < kNumCards; i++) {
+		int size = qMin(1 + i % 4, kNumCards - cards);
+		groups.append(new FakeGroup(size));
+		cards += size;
+	}
+	return groups;
+}
+
+// what CardWindowManager::slideAllGroupsOnTouchUpdate used to do on every move
+static void slideAll(const QVector<FakeGroup*>& groups, int activeIndex, int xOffset)
+{
+	FakeGroup* active = groups[activeIndex];
+	active->setCardPositions(xOffset);
+
+	int centerX = -active->left() - kGap + xOffset;
+	for (int i = activeIndex - 1; i >= 0; --i) {
+		centerX += -groups[i]->right();
+		groups[i]->setCardPositions(centerX);
+		centerX += -kGap - groups[i]->left();
+	}
+
+	centerX = active->right() + kGap + xOffset;
+	for (int i = activeIndex + 1; i < groups.size(); ++i) {
+		centerX += groups[i]->left();
+		groups[i]->setCardPositions(centerX);
+		centerX += kGap + groups[i]->right();
+	}
+}
+
+// -------------------------------------------------------------------------
+
+class TestCardGroupLayout : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void init();
+	void cleanup();
+
+	void matchesFullLayout();
+	void skipsOffscreenGroups();
+	void groupsChange();
+	void benchmarkFullLayout();
+	void benchmarkIncremental();
+
+private:
+
+	QVector<FakeGroup*> m_groups;
+	int m_activeIndex;
+	CardGroupLayout<FakeGroup> m_layout;
+};
+
+void TestCardGroupLayout::init()
+{
+	m_groups = makeGroups();
+	m_activeIndex = m_groups.size() / 2;
+	slideAll(m_groups, m_activeIndex, 0);
+
+	m_layout = CardGroupLayout<FakeGroup>();
+	m_layout.setGap(kGap);
+	m_layout.setViewportWidth(kScreenWidth);
+}
+
+void TestCardGroupLayout::cleanup()
+{
+	qDeleteAll(m_groups);
+	m_groups.clear();
+}
+
+void TestCardGroupLayout::matchesFullLayout()
+{
+	QVector<FakeGroup*> reference = makeGroups();
+	slideAll(reference, m_activeIndex, 0);
+
+	// out to the left, and back past the start
+	int xOffset = 0;
+	for (; xOffset > -3000; xOffset -= 37) {
+		m_layout.slide(m_groups, m_activeIndex, xOffset);
+		slideAll(reference, m_activeIndex, xOffset);
+	}
+	for (; xOffset < 1500; xOffset += 53) {
+		m_layout.slide(m_groups, m_activeIndex, xOffset);
+		slideAll(reference, m_activeIndex, xOffset);
+	}
+
+	QVERIFY(m_layout.numDeferred() > 0);
+	m_layout.flush();
+	QCOMPARE(m_layout.numDeferred(), 0);
+
+	// both lag one move behind on the extents, give them one more to settle
+	m_layout.slide(m_groups, m_activeIndex, xOffset);
+	m_layout.flush();
+	slideAll(reference, m_activeIndex, xOffset);
+
+	for (int i = 0; i < m_groups.size(); i++) {
+		QCOMPARE(m_groups[i]->x(), reference[i]->x());
+		QCOMPARE(m_groups[i]->cardSceneX(), reference[i]->cardSceneX());
+	}
+
+	qDeleteAll(reference);
+}
+
+void TestCardGroupLayout::skipsOffscreenGroups()
+{
+	for (int xOffset = 0; xOffset > -400; xOffset -= 20)
+		m_layout.slide(m_groups, m_activeIndex, xOffset);
+
+	int placed = m_layout.numPlaced();
+	int moved = m_layout.numMoved();
+	m_layout.slide(m_groups, m_activeIndex, -420);
+
+	// a screen holds a handful of groups, and the rest wait
+	int touched = (m_layout.numPlaced() - placed) + (m_layout.numMoved() - moved);
+	qDebug("%d of %d groups touched", touched, m_groups.size());
+	QVERIFY(touched <= 8);
+	QVERIFY(m_layout.numDeferred() >= m_groups.size() - 8);
+
+	// only the groups near the center fan, the others just move
+	QVERIFY(m_layout.numPlaced() - placed <= 2);
+}
+
+void TestCardGroupLayout::groupsChange()
+{
+	m_layout.slide(m_groups, m_activeIndex, -100);
+
+	// a group went away mid drag: the layout must not touch it again
+	delete m_groups.takeFirst();
+	m_activeIndex--;
+	m_layout.slide(m_groups, m_activeIndex, -120);
+	m_layout.flush();
+
+	// a card joined the group next to the active one: it gets laid out again
+	FakeGroup* grown = m_groups[m_activeIndex + 1];
+	grown->addCard();
+
+	int placed = m_layout.numPlaced();
+	m_layout.slide(m_groups, m_activeIndex, -120);
+	QVERIFY(m_layout.numPlaced() > placed);
+
+	FakeGroup expected(grown->size());
+	expected.setCardPositions((int) grown->x());
+	QCOMPARE(grown->cardSceneX(), expected.cardSceneX());
+}
+
+void TestCardGroupLayout::benchmarkFullLayout()
+{
+	int xOffset = 0;
+	int step = -17;
+
+	QBENCHMARK {
+		xOffset += step;
+		if (qAbs(xOffset) > 2000)
+			step = -step;
+		slideAll(m_groups, m_activeIndex, xOffset);
+	}
+}
+
+void TestCardGroupLayout::benchmarkIncremental()
+{
+	int xOffset = 0;
+	int step = -17;
+
+	QBENCHMARK {
+		xOffset += step;
+		if (qAbs(xOffset) > 2000)
+			step = -step;
+		m_layout.slide(m_groups, m_activeIndex, xOffset);
+	}
+	m_layout.flush();
+}
+
+QTEST_MAIN(TestCardGroupLayout)
+#include "sysmgrtst_CardGroupLayout.moc"
@@ -0,0 +1,249 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+
+#include "CardRoundedCorners.h"
+
+static const int kScreenWidth = 1024;
+static const int kScreenHeight = 768;
+static const int kCardWidth = 640;
+static const int kCardHeight = 480;
+static const qreal kRadius = 25;
+
+static QRectF cardRect()
+{
+	return QRectF(-kCardWidth / 2, -kCardHeight / 2, kCardWidth, kCardHeight);
+}
+
+static QPixmap makeCard(int width, int height)
+{
+	QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+	QLinearGradient gradient(0, 0, width, height);
+	gradient.setColorAt(0, Qt::red);
+	gradient.setColorAt(1, Qt::blue);
+	painter.fillRect(image.rect(), gradient);
+	painter.end();
+
+	return QPixmap::fromImage(image);
+}
+
+// a card in the middle of the screen, scaled down as in the card view
+static void beginFrame(QImage& screen, QPainter& painter)
+{
+	screen.fill(0xff808080);
+	painter.begin(&screen);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+	painter.translate(kScreenWidth / 2, kScreenHeight / 2);
+	painter.scale(0.75, 0.75);
+}
+
+// -------------------------------------------------------------------------
+
+class TestCardRoundedCorners : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void initTestCase();
+	void cleanup();
+
+	void sharedAndCounted();
+	void evictsUnused();
+	void matchesPathFill();
+	void matchesPathFillInSourceMode();
+	void fallsBackWhenTiling();
+	void benchmarkPathFill();
+	void benchmarkCornerBlit();
+
+private:
+
+	void compareWithPathFill(QPainter::CompositionMode mode);
+
+	QPixmap m_card;
+};
+
+void TestCardRoundedCorners::initTestCase()
+{
+	m_card = makeCard(kCardWidth, kCardHeight);
+}
+
+void TestCardRoundedCorners::cleanup()
+{
+	CardRoundedCorners::instance()->trim();
+	QCOMPARE(CardRoundedCorners::instance()->numShapes(), 0);
+}
+
+void TestCardRoundedCorners::sharedAndCounted()
+{
+	CardRoundedCorners* corners = CardRoundedCorners::instance();
+
+	const CardRoundedCorners::Shape* a = corners->acquire(cardRect(), kRadius, kRadius);
+	const CardRoundedCorners::Shape* b = corners->acquire(cardRect(), kRadius, kRadius);
+	QCOMPARE(a, b);
+	QCOMPARE(corners->numShapes(), 1);
+
+	// rotated is another shape
+	QRectF rotated(cardRect().y(), cardRect().x(), kCardHeight, kCardWidth);
+	const CardRoundedCorners::Shape* c = corners->acquire(rotated, kRadius, kRadius);
+	QVERIFY(c != a);
+	QCOMPARE(c->rect(), rotated);
+
+	QPainterPath path;
+	path.addRoundedRect(cardRect(), kRadius, kRadius);
+	QVERIFY(a->path() == path);
+
+	corners->release(a);
+	QCOMPARE(corners->numUnused(), 0);
+	corners->release(b);
+	corners->release(c);
+	QCOMPARE(corners->numUnused(), 2);
+
+	// taken out of the unused ones again
+	QCOMPARE(corners->acquire(cardRect(), kRadius, kRadius), a);
+	QCOMPARE(corners->numUnused(), 1);
+	corners->release(a);
+}
+
+void TestCardRoundedCorners::evictsUnused()
+{
+	CardRoundedCorners* corners = CardRoundedCorners::instance();
+
+	const CardRoundedCorners::Shape* kept = corners->acquire(cardRect(), kRadius, kRadius);
+	for (int i = 0; i < CardRoundedCorners::kMaxUnused + 4; i++)
+		corners->release(corners->acquire(cardRect().adjusted(0, 0, -i, -i), 8, 6));
+
+	// the oldest unused are gone, the one in use is not
+	QCOMPARE(corners->numUnused(), (int) CardRoundedCorners::kMaxUnused);
+	QCOMPARE(corners->numShapes(), CardRoundedCorners::kMaxUnused + 1);
+	QCOMPARE(corners->acquire(cardRect(), kRadius, kRadius), kept);
+
+	corners->release(kept);
+	corners->release(kept);
+}
+
+void TestCardRoundedCorners::matchesPathFill()
+{
+	compareWithPathFill(QPainter::CompositionMode_SourceOver);
+}
+
+// what CardWindow::paint() draws with at full opacity
+void TestCardRoundedCorners::matchesPathFillInSourceMode()
+{
+	compareWithPathFill(QPainter::CompositionMode_Source);
+}
+
+void TestCardRoundedCorners::compareWithPathFill(QPainter::CompositionMode mode)
+{
+	const CardRoundedCorners::Shape* shape = CardRoundedCorners::instance()->acquire(cardRect(), kRadius, kRadius);
+	QPointF origin = cardRect().topLeft();
+
+	QImage before(kScreenWidth, kScreenHeight, QImage::Format_ARGB32_Premultiplied);
+	QImage after(kScreenWidth, kScreenHeight, QImage::Format_ARGB32_Premultiplied);
+
+	QPainter painter;
+	beginFrame(before, painter);
+	painter.setCompositionMode(mode);
+	painter.setBrushOrigin(origin);
+	painter.fillPath(shape->path(), m_card);
+	painter.end();
+
+	beginFrame(after, painter);
+	painter.setCompositionMode(mode);
+	QVERIFY(shape->draw(&painter, m_card, origin));
+	QCOMPARE(painter.compositionMode(), mode);
+	painter.end();
+
+	// give or take rounding and the antialiased edges
+	int differing = 0;
+	for (int y = 0; y < kScreenHeight; y++) {
+		for (int x = 0; x < kScreenWidth; x++) {
+			QRgb a = before.pixel(x, y);
+			QRgb b = after.pixel(x, y);
+			int diff = qMax(qAbs(qRed(a) - qRed(b)), qAbs(qBlue(a) - qBlue(b)));
+			if (diff > 8)
+				differing++;
+		}
+	}
+	qDebug("%d pixels differ", differing);
+	QVERIFY(differing < 4 * kCardWidth);
+
+	// the corners are cut off
+	QCOMPARE(after.pixel(kScreenWidth / 2 - kCardWidth * 3 / 8, kScreenHeight / 2 - kCardHeight * 3 / 8),
+			 (QRgb) 0xff808080);
+
+	CardRoundedCorners::instance()->release(shape);
+}
+
+void TestCardRoundedCorners::fallsBackWhenTiling()
+{
+	const CardRoundedCorners::Shape* shape = CardRoundedCorners::instance()->acquire(cardRect(), kRadius, kRadius);
+	QPixmap small = makeCard(kCardWidth / 2, kCardHeight);
+
+	QImage screen(kScreenWidth, kScreenHeight, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter;
+	beginFrame(screen, painter);
+	QVERIFY(!shape->draw(&painter, small, cardRect().topLeft()));
+	QVERIFY(!shape->draw(&painter, m_card, cardRect().topLeft() + QPointF(1, 0)));
+	painter.end();
+
+	CardRoundedCorners::instance()->release(shape);
+}
+
+void TestCardRoundedCorners::benchmarkPathFill()
+{
+	QPainterPath path;
+	path.addRoundedRect(cardRect(), kRadius, kRadius);
+
+	QImage screen(kScreenWidth, kScreenHeight, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter;
+	beginFrame(screen, painter);
+	painter.setBrushOrigin(cardRect().topLeft().toPoint());
+
+	QBENCHMARK {
+		painter.fillPath(path, m_card);
+	}
+	painter.end();
+}
+
+void TestCardRoundedCorners::benchmarkCornerBlit()
+{
+	const CardRoundedCorners::Shape* shape = CardRoundedCorners::instance()->acquire(cardRect(), kRadius, kRadius);
+
+	QImage screen(kScreenWidth, kScreenHeight, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter;
+	beginFrame(screen, painter);
+
+	QBENCHMARK {
+		shape->draw(&painter, m_card, cardRect().topLeft());
+	}
+	painter.end();
+
+	CardRoundedCorners::instance()->release(shape);
+}
+
+QTEST_MAIN(TestCardRoundedCorners)
+#include "sysmgrtst_CardRoundedCorners.moc"
@@ -0,0 +1,169 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include "ClockFace.h"
+
+// glyphs as wide as the lock screen's: the colon is narrower than the digits
+static void loadGlyphs(ClockFace& face)
+{
+	int x = 0;
+	for (char c = '0'; c <= '9'; c++) {
+		face.setGlyph(c, QRect(x, 0, 60, 100));
+		x += 60;
+	}
+	face.setGlyph(':', QRect(x, 0, 20, 100));
+}
+
+static int area(const QVector<QRect>& rects)
+{
+	int pixels = 0;
+	for (int i = 0; i < rects.size(); i++)
+		pixels += rects[i].width() * rects[i].height();
+	return pixels;
+}
+
+// -------------------------------------------------------------------------
+
+class TestClockFace : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void layout();
+	void oneDigit();
+	void widthChange();
+	void minuteOfTicks();
+	void boundaries();
+	void wakeups();
+};
+
+void TestClockFace::layout()
+{
+	ClockFace face;
+	loadGlyphs(face);
+
+	// the first text is all new
+	QVector<QRect> dirty = face.setText("12:34", -50);
+	QCOMPARE(face.numCells(), 5);
+	QCOMPARE(face.width(), 260);
+	QCOMPARE(dirty.size(), 1);
+	QCOMPARE(dirty[0], QRect(-130, -50, 260, 100));
+	QCOMPARE(face.cell(2).ch, ':');
+	QCOMPARE(face.cell(2).rect, QRect(-10, -50, 20, 100));
+
+	// the same text again: nothing to paint
+	QVERIFY(face.setText("12:34", -50).isEmpty());
+	QCOMPARE(face.lastPaintedPixels(), 0);
+
+	// unknown characters take no space
+	face.setText("1x2", 0);
+	QCOMPARE(face.numCells(), 2);
+}
+
+void TestClockFace::oneDigit()
+{
+	ClockFace face;
+	loadGlyphs(face);
+	face.setText("12:34", 0);
+
+	QVector<QRect> dirty = face.setText("12:35", 0);
+	QCOMPARE(dirty.size(), 1);
+	QCOMPARE(dirty[0], face.cell(4).rect);
+	QCOMPARE(face.lastPaintedPixels(), 60 * 100);
+
+	// both sides of the colon, which stays
+	dirty = face.setText("13:00", 0);
+	QCOMPARE(dirty.size(), 2);
+	QCOMPARE(dirty[0], face.cell(1).rect);
+	QCOMPARE(dirty[1], face.cell(3).rect.united(face.cell(4).rect));
+}
+
+void TestClockFace::widthChange()
+{
+	ClockFace face;
+	loadGlyphs(face);
+	face.setText("9:59", 0);
+	QCOMPARE(face.width(), 200);
+
+	// the text is centred: a new digit moves everything
+	QVector<QRect> dirty = face.setText("10:00", 0);
+	QCOMPARE(dirty.size(), 1);
+	QCOMPARE(dirty[0], QRect(-130, 0, 260, 100));
+
+	// and going back clears what is no longer covered
+	dirty = face.setText("9:59", 0);
+	QCOMPARE(dirty.size(), 1);
+	QCOMPARE(dirty[0], QRect(-130, 0, 260, 100));
+
+	// a resize repaints it all, even if the text is the same
+	face.invalidate();
+	QCOMPARE(area(face.setText("9:59", 0)), 200 * 100);
+}
+
+void TestClockFace::minuteOfTicks()
+{
+	ClockFace face;
+	loadGlyphs(face);
+
+	// a day of minute ticks paints a fraction of what full repaints would
+	qint64 full = 0;
+	char text[ClockFace::kMaxChars];
+	for (int m = 0; m < 24 * 60; m++) {
+		qsnprintf(text, sizeof(text), "%02d:%02d", m / 60, m % 60);
+		face.setText(text, 0);
+		full += face.width() * face.height();
+	}
+	qDebug("painted %lld of %lld pixels", face.totalPaintedPixels(), full);
+	QVERIFY(face.totalPaintedPixels() * 3 < full);
+}
+
+void TestClockFace::boundaries()
+{
+	QCOMPARE(ClockFace::msToNextBoundary(0, 60000), 60000);
+	QCOMPARE(ClockFace::msToNextBoundary(59999, 60000), 1);
+	QCOMPARE(ClockFace::msToNextBoundary(Q_INT64_C(1349000012345), 60000), 27655);
+	QCOMPARE(ClockFace::msToNextBoundary(Q_INT64_C(1349000012345), 1000), 655);
+	QCOMPARE(ClockFace::msToNextBoundary(-1, 1000), 1);
+}
+
+void TestClockFace::wakeups()
+{
+	ClockFace face;
+	qint64 t = Q_INT64_C(1349000000000);
+
+	// a second timer, for two minutes
+	for (int i = 0; i < 120; i++)
+		face.noteWakeup(t + i * 1000);
+	QCOMPARE(face.wakeupsPerMinute(t + 119 * 1000), 60);
+
+	// then aligned on the minute
+	t += 120 * 1000;
+	for (int i = 0; i < 5; i++)
+		face.noteWakeup(t + i * 60000);
+	QCOMPARE(face.wakeupsPerMinute(t + 4 * 60000), 1);
+	QCOMPARE(face.wakeupsPerMinute(t + 4 * 60000 + 30000), 1);
+	QCOMPARE(face.wakeupsPerMinute(t + 6 * 60000), 0);
+}
+
+QTEST_MAIN(TestClockFace)
+#include "sysmgrtst_ClockFace.moc"
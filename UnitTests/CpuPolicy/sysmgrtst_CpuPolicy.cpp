@@ -0,0 +1,319 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <map>
+#include <string>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "CpuPolicy.h"
+
+// a system with 4 cores (unless told otherwise), where every process starts at nice 0
+// on all of them
+class FakeBackend : public CpuPolicy::Backend
+{
+public:
+	struct State
+	{
+		State() : nice(0), affinity(0xf), cgroup("/user.slice") {}
+		int				nice;
+		unsigned long	affinity;
+		std::string		cgroup;
+	};
+
+	FakeBackend(std::map<int, State>& procs, std::map<std::string, int>& weights, int numCpus = 4)
+		: m_procs(procs), m_weights(weights), m_numCpus(numCpus) {}
+
+	virtual int numCpus() { return m_numCpus; }
+
+	virtual bool getNice(int pid, int& nice) { nice = m_procs[pid].nice; return true; }
+	virtual bool setNice(int pid, int nice) { m_procs[pid].nice = nice; return true; }
+	virtual bool getAffinity(int pid, unsigned long& mask) { mask = m_procs[pid].affinity; return true; }
+	virtual bool setAffinity(int pid, unsigned long mask) { m_procs[pid].affinity = mask; return true; }
+	virtual bool getCgroup(int pid, std::string& path) { path = m_procs[pid].cgroup; return true; }
+
+	virtual bool setCgroup(int pid, const std::string& dir)
+	{
+		m_procs[pid].cgroup = dir.substr(std::string("/cg").size());
+		return true;
+	}
+
+	virtual bool prepareCgroup(const std::string& dir, int cpuWeight)
+	{
+		m_weights[dir] = cpuWeight;
+		return true;
+	}
+
+	std::map<int, State>&		m_procs;
+	std::map<std::string, int>&	m_weights;
+	int							m_numCpus;
+};
+
+// -------------------------------------------------------------------------
+
+class TestCpuPolicy : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void init();
+
+	void foregroundFollowsFocus();
+	void demotesToOwnClass();
+	void foregroundOffCompositorCore();
+	void tableDriven();
+	void restoresOriginal();
+	void disableAndEnable();
+	void cgroups();
+	void dummyProcess();
+
+private:
+
+	std::map<int, FakeBackend::State>	m_procs;
+	std::map<std::string, int>			m_weights;
+};
+
+void TestCpuPolicy::init()
+{
+	m_procs.clear();
+	m_weights.clear();
+}
+
+void TestCpuPolicy::foregroundFollowsFocus()
+{
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setProcessClass(100, CpuPolicy::Background);
+	policy.setProcessClass(200, CpuPolicy::Background);
+	QCOMPARE(m_procs[100].nice, 1);
+	QCOMPARE(m_procs[100].affinity, 0x8UL);
+
+	policy.setForeground(100);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Foreground);
+	QCOMPARE(m_procs[100].nice, -1);
+	QCOMPARE(m_procs[100].affinity, 0x7UL);
+
+	policy.setForeground(200);
+	QCOMPARE(policy.foreground(), 200);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Background);
+	QCOMPARE(m_procs[100].nice, 1);
+	QCOMPARE(m_procs[200].nice, -1);
+
+	// the card went away: nobody in the foreground
+	policy.setForeground(-1);
+	QCOMPARE(policy.foreground(), -1);
+	QCOMPARE(policy.processClass(200), CpuPolicy::Background);
+
+	// dead processes are forgotten
+	policy.removeProcess(100);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Untracked);
+	QCOMPARE(policy.numTracked(), 1);
+}
+
+void TestCpuPolicy::demotesToOwnClass()
+{
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setProcessClass(100, CpuPolicy::Service);	// WebAppMgr
+	policy.setProcessClass(200, CpuPolicy::Background);
+
+	// a web card gets maximized, then a native one
+	policy.setForeground(100);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Foreground);
+	policy.setForeground(200);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Service);
+	QCOMPARE(m_procs[100].nice, 0);
+	QCOMPARE(m_procs[100].affinity, 0xfUL);
+
+	// back to card view
+	policy.setForeground(100);
+	policy.setForeground(-1);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Service);
+
+	// never tracked before: the background
+	policy.setForeground(300);
+	policy.setForeground(-1);
+	QCOMPARE(policy.processClass(300), CpuPolicy::Background);
+
+	// and the class survives disabling
+	policy.setForeground(100);
+	policy.setEnabled(false);
+	policy.setEnabled(true);
+	policy.setForeground(-1);
+	QCOMPARE(policy.processClass(100), CpuPolicy::Service);
+}
+
+void TestCpuPolicy::foregroundOffCompositorCore()
+{
+	// 2 cores, main() pinned sysmgr to the first one
+	m_procs[1].affinity = 0x1;
+	m_procs[100].affinity = 0x3;
+	m_procs[200].affinity = 0x3;
+	{
+		CpuPolicy policy(new FakeBackend(m_procs, m_weights, 2));
+		policy.setForeground(100);
+		QCOMPARE(m_procs[100].affinity, 0x1UL);
+
+		// the foreground moves off the compositor's core once that is known
+		policy.setProcessClass(1, CpuPolicy::Compositor);
+		QCOMPARE(m_procs[1].affinity, 0x1UL);
+		QCOMPARE(m_procs[100].affinity, 0x2UL);
+
+		policy.setProcessClass(200, CpuPolicy::Background);
+		policy.setForeground(200);
+		QCOMPARE(m_procs[200].affinity, 0x2UL);
+		QCOMPARE(m_procs[100].affinity, 0x2UL);
+	}
+
+	// 4 cores: neither the compositor's core nor the spare one
+	init();
+	m_procs[1].affinity = 0x1;
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setProcessClass(1, CpuPolicy::Compositor);
+	policy.setForeground(100);
+	QCOMPARE(m_procs[100].affinity, 0x6UL);
+}
+
+void TestCpuPolicy::tableDriven()
+{
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setProcessClass(1, CpuPolicy::Compositor);
+	policy.setProcessClass(300, CpuPolicy::Service);
+
+	// KeepCpus leaves affinity alone
+	QCOMPARE(m_procs[1].affinity, 0xfUL);
+	QCOMPARE(m_procs[1].nice, -1);
+	QCOMPARE(m_procs[300].nice, 0);
+
+	CpuPolicy::Rule rule = { 5, CpuPolicy::SpareCpus, 0 };
+	policy.setRule(CpuPolicy::Service, rule);
+	QCOMPARE(m_procs[300].nice, 5);
+	QCOMPARE(m_procs[300].affinity, 0x8UL);
+
+	// back to a class that keeps cpus: the original affinity comes back
+	policy.setProcessClass(300, CpuPolicy::Compositor);
+	QCOMPARE(m_procs[300].affinity, 0xfUL);
+}
+
+void TestCpuPolicy::restoresOriginal()
+{
+	m_procs[100].nice = 3;
+	m_procs[100].affinity = 0x3;
+
+	CpuPolicy* policy = new CpuPolicy(new FakeBackend(m_procs, m_weights));
+	policy->setForeground(100);
+	policy->setProcessClass(100, CpuPolicy::Background);
+	policy->setProcessClass(200, CpuPolicy::Background);
+
+	policy->restore(100);
+	QCOMPARE(m_procs[100].nice, 3);
+	QCOMPARE(m_procs[100].affinity, 0x3UL);
+	QCOMPARE(policy->processClass(100), CpuPolicy::Untracked);
+
+	// everything else goes back when the policy goes away
+	delete policy;
+	QCOMPARE(m_procs[200].nice, 0);
+	QCOMPARE(m_procs[200].affinity, 0xfUL);
+}
+
+void TestCpuPolicy::disableAndEnable()
+{
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setProcessClass(100, CpuPolicy::Background);
+	policy.setForeground(200);
+
+	policy.setEnabled(false);
+	QCOMPARE(m_procs[100].nice, 0);
+	QCOMPARE(m_procs[200].nice, 0);
+	QCOMPARE(m_procs[200].affinity, 0xfUL);
+
+	// still tracked, and updated, just not applied
+	policy.setForeground(100);
+	QCOMPARE(m_procs[100].nice, 0);
+
+	policy.setEnabled(true);
+	QCOMPARE(m_procs[100].nice, -1);
+	QCOMPARE(m_procs[200].nice, 1);
+}
+
+void TestCpuPolicy::cgroups()
+{
+	CpuPolicy policy(new FakeBackend(m_procs, m_weights));
+	policy.setCgroupRoot("/cg", "luna");
+	QCOMPARE(m_weights["/cg/luna/foreground"], 400);
+	QCOMPARE(m_weights["/cg/luna/background"], 25);
+
+	policy.setForeground(100);
+	QCOMPARE(m_procs[100].cgroup, std::string("/luna/foreground"));
+
+	policy.setForeground(200);
+	QCOMPARE(m_procs[100].cgroup, std::string("/luna/background"));
+
+	policy.restoreAll();
+	QCOMPARE(m_procs[100].cgroup, std::string("/user.slice"));
+	QCOMPARE(m_procs[200].cgroup, std::string("/user.slice"));
+}
+
+// the real backend, on a child process that just sleeps
+void TestCpuPolicy::dummyProcess()
+{
+	pid_t pid = fork();
+	if (pid == 0) {
+		pause();
+		_exit(0);
+	}
+	QVERIFY(pid > 0);
+
+	CpuPolicy* policy = CpuPolicy::instance();
+	int originalNice = getpriority(PRIO_PROCESS, pid);
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	QCOMPARE(sched_getaffinity(pid, sizeof(set), &set), 0);
+	int originalCpus = CPU_COUNT(&set);
+
+	// making it nicer is always allowed
+	policy->setProcessClass(pid, CpuPolicy::Background);
+	QCOMPARE(getpriority(PRIO_PROCESS, pid), 1);
+
+	CPU_ZERO(&set);
+	QCOMPARE(sched_getaffinity(pid, sizeof(set), &set), 0);
+	if (sysconf(_SC_NPROCESSORS_ONLN) > 1)
+		QCOMPARE(CPU_COUNT(&set), 1);
+
+	policy->restore(pid);
+	CPU_ZERO(&set);
+	QCOMPARE(sched_getaffinity(pid, sizeof(set), &set), 0);
+	QCOMPARE(CPU_COUNT(&set), originalCpus);
+
+	// only root can make it less nice again
+	if (geteuid() == 0)
+		QCOMPARE(getpriority(PRIO_PROCESS, pid), originalNice);
+
+	kill(pid, SIGKILL);
+	waitpid(pid, 0, 0);
+}
+
+QTEST_MAIN(TestCpuPolicy)
+#include "sysmgrtst_CpuPolicy.moc"
@@ -0,0 +1,172 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <stdint.h>
+#include <string>
+
+#include "HeapProfiler.h"
+
+// The allocations are reported by hand, with made up pointers, so that the counts
+// are exact: the malloc hooks (when this glibc has them) are taken out again.
+
+static void* fakePtr(int i)
+{
+	return (void*) (uintptr_t) (0x10000 + i * 16);
+}
+
+static void __attribute__((noinline)) allocateFromIcons(int i, size_t size)
+{
+	HeapProfiler::allocated(fakePtr(i), size);
+}
+
+static void __attribute__((noinline)) allocateFromCards(int i, size_t size)
+{
+	HeapProfiler::allocated(fakePtr(i), size);
+}
+
+static void startUnhooked(size_t sampleBytes)
+{
+	QVERIFY(HeapProfiler::start(sampleBytes));
+	if (HeapProfiler::hooked())
+		installHeapProfilerHooks(false);
+}
+
+// -------------------------------------------------------------------------
+
+class TestHeapProfiler : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void cleanup();
+
+	void perCallSite();
+	void samplingRate();
+	void manyLiveBlocks();
+	void stopped();
+	void pprofFormat();
+};
+
+void TestHeapProfiler::cleanup()
+{
+	HeapProfiler::stop();
+}
+
+void TestHeapProfiler::perCallSite()
+{
+	startUnhooked(1);
+
+	// the call site is the whole stack: the loop makes these two the same
+	allocateFromIcons(1, 100);
+	for (int i = 2; i <= 3; i++)
+		allocateFromCards(i, 50);
+
+	QCOMPARE(HeapProfiler::numSites(), 2);
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) 3);
+	QCOMPARE(HeapProfiler::inUseBytes(), (size_t) 200);
+
+	HeapProfiler::freed(fakePtr(1));
+	HeapProfiler::freed(fakePtr(99));	// never sampled
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) 2);
+	QCOMPARE(HeapProfiler::inUseBytes(), (size_t) 100);
+
+	// what was freed still counts as allocated
+	std::string profile = HeapProfiler::profile();
+	QVERIFY(profile.find("heap profile: 2: 100 [3: 200] @ heap_v2/1\n") == 0);
+	QVERIFY(profile.find("\n0: 0 [1: 100] @ 0x") != std::string::npos);
+	QVERIFY(profile.find("\n2: 100 [2: 100] @ 0x") != std::string::npos);
+}
+
+void TestHeapProfiler::samplingRate()
+{
+	startUnhooked(1000);
+
+	for (int i = 0; i < 10000; i++)
+		allocateFromIcons(i, 100);
+
+	// one sample per 1000 bytes, on average
+	size_t samples = HeapProfiler::inUseSamples();
+	qDebug("%lu samples for 1000000 bytes", (unsigned long) samples);
+	QVERIFY(samples > 800 && samples < 1250);
+	QCOMPARE(HeapProfiler::numSites(), 1);
+}
+
+void TestHeapProfiler::manyLiveBlocks()
+{
+	startUnhooked(1);
+
+	const int count = 20000;
+	for (int i = 0; i < count; i++)
+		allocateFromCards(i, 8);
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) count);
+
+	// free in an order unrelated to the hash table's
+	for (int i = 0; i < count; i += 2)
+		HeapProfiler::freed(fakePtr(i));
+	for (int i = count - 1; i > 0; i -= 2)
+		HeapProfiler::freed(fakePtr(i));
+
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) 0);
+	QCOMPARE(HeapProfiler::inUseBytes(), (size_t) 0);
+	QCOMPARE(HeapProfiler::numDropped(), (size_t) 0);
+}
+
+void TestHeapProfiler::stopped()
+{
+	startUnhooked(1);
+	allocateFromIcons(1, 10);
+	HeapProfiler::stop();
+
+	QVERIFY(!HeapProfiler::running());
+	allocateFromIcons(2, 10);
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) 1);
+
+	// restarting drops the old samples
+	startUnhooked(1);
+	QCOMPARE(HeapProfiler::inUseSamples(), (size_t) 0);
+	QCOMPARE(HeapProfiler::numSites(), 0);
+}
+
+void TestHeapProfiler::pprofFormat()
+{
+	startUnhooked(1);
+	allocateFromIcons(1, 64);
+
+	QString path = QDir::temp().filePath("sysmgrtst_heap.prof");
+	QVERIFY(HeapProfiler::dump(path.toUtf8().constData()));
+
+	QFile file(path);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QList<QByteArray> lines = file.readAll().split('\n');
+	file.close();
+	file.remove();
+
+	QVERIFY(lines.size() > 4);
+	QCOMPARE(lines[0], QByteArray("heap profile: 1: 64 [1: 64] @ heap_v2/1"));
+	QVERIFY(lines[1].startsWith("1: 64 [1: 64] @ 0x"));
+	QCOMPARE(lines[2], QByteArray());
+	QCOMPARE(lines[3], QByteArray("MAPPED_LIBRARIES:"));
+}
+
+QTEST_MAIN(TestHeapProfiler)
+#include "sysmgrtst_HeapProfiler.moc"
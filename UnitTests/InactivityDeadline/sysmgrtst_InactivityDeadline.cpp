@@ -0,0 +1,213 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <stdint.h>
+
+#include "InactivityDeadline.h"
+
+enum { TimeoutUser = 1, TimeoutInternal, TimeoutDim };
+
+// the display manager's timeout timer on a simulated clock: one timer, counted starts and stops
+class FakeDisplay : public InactivityTimer
+{
+public:
+	FakeDisplay(uint32_t start)
+		: InactivityTimer(lastEvent)
+		, clock(start), lastEvent(start), fireTime(0), running(false)
+		, starts(0), stops(0), expiredKind(0) {}
+
+	void activity(int kind, uint32_t timeoutMs)
+	{
+		lastEvent = clock;
+		arm(kind, timeoutMs);
+	}
+
+	// moves the clock on, firing the timer on the way
+	void advance(uint32_t ms)
+	{
+		uint32_t end = clock + ms;
+		while (running && (int32_t) (end - fireTime) >= 0) {
+			clock = fireTime;
+			running = false;
+			fire();
+		}
+		clock = end;
+	}
+
+	uint32_t	clock;
+	uint32_t	lastEvent;
+	uint32_t	fireTime;
+	bool		running;
+	int			starts;
+	int			stops;
+	int			expiredKind;
+
+protected:
+
+	uint32_t now() const { return clock; }
+	void startTimer(uint32_t delayMs) { fireTime = clock + delayMs; running = true; starts++; }
+	void stopTimer() { running = false; stops++; }
+	void timeoutExpired(int kind) { expiredKind = kind; }
+};
+
+// -------------------------------------------------------------------------
+
+class TestInactivityDeadline : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void activityBurst();
+	void onDimOffCycle();
+	void shorterDeadline();
+	void disarm();
+	void clockWrap();
+};
+
+// a finger dragging around for ten minutes, 60 events a second: the old timers were
+// stopped and started again for every one of them
+void TestInactivityDeadline::activityBurst()
+{
+	const uint32_t dimTimeout = 30000;
+	const int events = 36000;
+	FakeDisplay display(1000);
+
+	for (int i = 0; i < events; i++) {
+		display.activity(TimeoutUser, dimTimeout);
+		display.advance(1000 / 60);
+	}
+
+	qDebug("%d events: %d timer starts, %d stops (%d before)", events, display.starts, display.stops, events);
+	QCOMPARE(display.expiredKind, 0);
+	QVERIFY(display.starts <= 1 + (int) (events * (1000 / 60) / dimTimeout) + 1);
+	QCOMPARE(display.stops, 0);
+
+	// it still dims dimTimeout after the last event, to the millisecond
+	uint32_t lastEvent = display.lastEvent;
+	display.advance(dimTimeout - 1 - (display.clock - lastEvent));
+	QCOMPARE(display.expiredKind, 0);
+	display.advance(1);
+	QCOMPARE(display.expiredKind, (int) TimeoutUser);
+	QCOMPARE(display.clock - lastEvent, dimTimeout);
+	QVERIFY(!display.timerRunning());
+}
+
+// on, dimmed after the user timeout, woken up, dimmed again and switched off
+void TestInactivityDeadline::onDimOffCycle()
+{
+	const uint32_t dimTimeout = 30000;
+	const uint32_t offTimeout = 15000;
+	FakeDisplay display(5000);
+
+	display.activity(TimeoutUser, dimTimeout);
+	display.advance(dimTimeout);
+	QCOMPARE(display.expiredKind, (int) TimeoutUser);
+
+	// dim: the off timeout counts from when it dimmed
+	display.lastEvent = display.clock;
+	display.arm(TimeoutDim, offTimeout);
+	display.advance(offTimeout / 2);
+
+	// a touch brings it back on
+	display.expiredKind = 0;
+	display.activity(TimeoutUser, dimTimeout);
+	QCOMPARE(display.armed(), (int) TimeoutUser);
+	display.advance(offTimeout);
+	QCOMPARE(display.expiredKind, 0);
+	display.advance(dimTimeout - offTimeout);
+	QCOMPARE(display.expiredKind, (int) TimeoutUser);
+
+	display.lastEvent = display.clock;
+	display.arm(TimeoutDim, offTimeout);
+	display.advance(offTimeout);
+	QCOMPARE(display.expiredKind, (int) TimeoutDim);
+	QCOMPARE(display.armed(), 0);
+	QCOMPARE(display.starts, 4);
+}
+
+// a running timer that would fire too late is restarted, one firing early isn't
+void TestInactivityDeadline::shorterDeadline()
+{
+	FakeDisplay display(0);
+	display.activity(TimeoutUser, 30000);
+	QCOMPARE(display.starts, 1);
+
+	display.advance(1000);
+	display.arm(TimeoutInternal, 60000);
+	QCOMPARE(display.starts, 1);
+	QCOMPARE(display.armed(), (int) TimeoutInternal);
+
+	display.arm(TimeoutUser, 5000);
+	QCOMPARE(display.starts, 2);
+	QCOMPARE(display.stops, 1);
+	QCOMPARE(display.fireTime, (uint32_t) 5000);
+
+	// and an already passed deadline fires right away
+	display.advance(10000);
+	display.expiredKind = 0;
+	display.arm(TimeoutInternal, 2000);
+	QCOMPARE(display.fireTime, display.clock);
+	display.advance(0);
+	QCOMPARE(display.expiredKind, (int) TimeoutInternal);
+}
+
+void TestInactivityDeadline::disarm()
+{
+	FakeDisplay display(0);
+	display.disarm();
+	QCOMPARE(display.stops, 0);
+
+	display.activity(TimeoutUser, 30000);
+	display.disarm();
+	QCOMPARE(display.stops, 1);
+	QCOMPARE(display.armed(), 0);
+
+	display.advance(60000);
+	QCOMPARE(display.expiredKind, 0);
+
+	// a stale firing after disarming does nothing
+	display.fire();
+	QCOMPARE(display.expiredKind, 0);
+	QCOMPARE(display.starts, 1);
+	QVERIFY(!display.timerRunning());
+}
+
+void TestInactivityDeadline::clockWrap()
+{
+	FakeDisplay display(0xffffffff - 10000);
+	for (int i = 0; i < 100; i++) {
+		display.activity(TimeoutUser, 30000);
+		display.advance(500);
+	}
+	QCOMPARE(display.expiredKind, 0);
+	QCOMPARE(display.starts, 2);
+
+	// the events went past the wrap
+	QVERIFY(display.lastEvent < 0xffffffff - 10000);
+	display.advance(30000 - 500);
+	QCOMPARE(display.expiredKind, (int) TimeoutUser);
+	QCOMPARE(display.clock - display.lastEvent, (uint32_t) 30000);
+}
+
+QTEST_MAIN(TestInactivityDeadline)
+#include "sysmgrtst_InactivityDeadline.moc"
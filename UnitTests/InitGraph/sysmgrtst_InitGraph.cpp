@@ -0,0 +1,125 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <string>
+
+#include "InitGraph.h"
+#include "StartupTracer.h"
+
+// order in which the steps ran
+static std::string s_order;
+
+static void stepA() { s_order += 'a'; }
+static void stepB() { s_order += 'b'; }
+static void stepC() { s_order += 'c'; }
+static void stepD() { s_order += 'd'; }
+
+// -------------------------------------------------------------------------
+
+class TestInitGraph : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void init();
+
+	void dependencyOrder();
+	void readyInOrderAdded();
+	void cycle();
+	void traceJson();
+};
+
+void TestInitGraph::init()
+{
+	s_order.clear();
+}
+
+void TestInitGraph::dependencyOrder()
+{
+	InitGraph graph;
+	int c = graph.add("c", stepC);
+	int b = graph.add("b", stepB);
+	int a = graph.add("a", stepA);
+	graph.dependsOn(c, b);
+	graph.dependsOn(b, a);
+
+	QVERIFY(graph.run());
+	QCOMPARE(s_order, std::string("abc"));
+	QCOMPARE((int) graph.startOrder().size(), 3);
+	QCOMPARE(graph.name(graph.startOrder()[0]), "a");
+}
+
+void TestInitGraph::readyInOrderAdded()
+{
+	InitGraph graph;
+	int d = graph.add("d", stepD);
+	int b = graph.add("b", stepB);
+	int a = graph.add("a", stepA);
+	int c = graph.add("c", stepC);
+	graph.dependsOn(d, a);
+	Q_UNUSED(b);
+	Q_UNUSED(c);
+
+	// d waits for a, which comes after b; c is ready from the start but was added after a
+	QVERIFY(graph.run());
+	QCOMPARE(s_order, std::string("badc"));
+}
+
+void TestInitGraph::cycle()
+{
+	InitGraph graph;
+	int a = graph.add("a", stepA);
+	int b = graph.add("b", stepB);
+	int c = graph.add("c", stepC);
+	graph.dependsOn(a, b);
+	graph.dependsOn(b, a);
+	Q_UNUSED(c);
+
+	QVERIFY(!graph.run());
+	QCOMPARE(s_order, std::string("c"));
+}
+
+void TestInitGraph::traceJson()
+{
+	StartupTracer* tracer = StartupTracer::instance();
+	QCOMPARE(tracer->begin("disabled"), -1);
+
+	tracer->setEnabled(true);
+	InitGraph graph;
+	graph.add("a", stepA);
+	graph.add("b", stepB);
+	QVERIFY(graph.run());
+	tracer->mark("done");
+	tracer->setEnabled(false);
+
+	QCOMPARE(tracer->numPhases(), 3);
+
+	std::string json = tracer->toJson();
+	QVERIFY(json.find("{\"traceEvents\":[") == 0);
+	QVERIFY(json.find("\"name\":\"a\",\"cat\":\"startup\",\"ph\":\"X\"") != std::string::npos);
+	QVERIFY(json.find("\"name\":\"b\",\"cat\":\"startup\",\"ph\":\"X\"") != std::string::npos);
+	QVERIFY(json.find("\"name\":\"done\",\"cat\":\"startup\",\"ph\":\"i\"") != std::string::npos);
+}
+
+QTEST_MAIN(TestInitGraph)
+#include "sysmgrtst_InitGraph.moc"
@@ -23,6 +23,7 @@ PKGCONFIG = glib-2.0 gthread-2.0
 VPATH = ../../Src \
 		../../Src \
 		../../Src/base \
+		../../Src/base/gesture \
 		../../Src/core \
 		../../Src/js \
 		../../Src/sound \
@@ -33,6 +34,7 @@ VPATH = ../../Src \
 		../../Src/widgets \
 		../../Src/lunaui/virtual-keyboard \
 		../../Src/lunaui/launcher \
+		../../Src/lunaui/launcher/physics/motion \
 		../../Src/input
 
 INCLUDEPATH = $$VPATH
@@ -76,6 +78,7 @@ MOC_DIR = $$DESTDIR/.moc
 TARGET = sysmgrtst_InputTouch
 
 SOURCES += \
+	HeapProfiler.cpp \
 	MallocHooks.cpp \
 	Mutex.cpp \
 	Thread.cpp \
@@ -120,8 +123,11 @@ SOURCES += \
 	Settings.cpp \
 	DisplayManager.cpp \
 	DisplayStates.cpp \
+	InactivityDeadline.cpp \
 	AmbientLightSensor.cpp \
+	AlsFilter.cpp \
 	InputManager.cpp \
+	JsonScanner.cpp \
 	EventReporter.cpp \
 	ProcessManager.cpp \
 	SystemUiController.cpp \
@@ -137,7 +143,10 @@ SOURCES += \
 	SystemService.cpp \
 	EventThrottler.cpp \
 	EventThrottlerIme.cpp \
+	PenMoveResampler.cpp \
 	HapticsController.cpp \
+	InitGraph.cpp \
+	StartupTracer.cpp \
 	Preferences.cpp \
 	NotificationPolicy.cpp \
 	PersistentWindowCache.cpp \
@@ -155,12 +164,15 @@ SOURCES += \
 	MimeSystem.cpp \
 	IpcServer.cpp \
 	IpcClientHost.cpp \
+	CpuPolicy.cpp \
 	WebAppMgrProxy.cpp\
 	SuspendBlocker.cpp \
 	ApplicationStatus.cpp \
 	FullEraseConfirmationWindow.cpp \
 	Variant.cpp \
 	SoundPlayerPool.cpp \
+	SoundFeedbackChannel.cpp \
+	SoundWarmPool.cpp \
 	AsyncCaller.cpp \
 	HostWindow.cpp \
 	HostWindowData.cpp \
@@ -168,10 +180,10 @@ SOURCES += \
 	RemoteWindowData.cpp \
 	AlertWindow.cpp \
 	CardWindow.cpp \
+	CardRoundedCorners.cpp \
 	DashboardWindow.cpp \
 	MenuWindow.cpp \
 	CardLoading.cpp \
-	CardTransition.cpp \
 	NativeAlertManager.cpp \
 	EmergencyWindowManager.cpp \
 	VolumeControlAlertWindow.cpp \
@@ -181,6 +193,7 @@ SOURCES += \
 	DockWindow.cpp \
 	QuicklaunchLayout.cpp \
 	MemoryMonitor.cpp \
+	QmlComponentCache.cpp \
 	MenuWindowManager.cpp \
 	DashboardWindowManager.cpp \
 	GraphicsItemContainer.cpp \
@@ -190,6 +203,7 @@ SOURCES += \
 	BannerWindow.cpp \
 	TopLevelWindowManager.cpp \
 	ClockWindow.cpp \
+	ClockFace.cpp \
 	LockWindow.cpp \
 	DockModeWindowManager.cpp \
 	DockModeWindow.cpp \
@@ -212,6 +226,7 @@ SOURCES += \
 	CardHostWindow.cpp \
 	VirtualKeyboard.cpp \
 	KineticScroller.cpp \
+	motionintegrator.cpp \
 	VirtualKeyboardManager.cpp \
 	KeyboardFeedbackItem.cpp \
 	OverlayNotificationWindowManager.cpp \
@@ -221,6 +236,7 @@ SOURCES += \
 
 HEADERS += \
 	AmbientLightSensor.h \
+	AlsFilter.h \
 	AnimationSettings.h \
 	ApplicationDescription.h \
 	ApplicationInstallerErrors.h \
@@ -235,17 +251,24 @@ HEADERS += \
 	DeviceInfo.h \
 	DisplayManager.h \
 	DisplayStates.h \
+	InactivityDeadline.h \
 	EASPolicyManager.h \
 	EventReporter.h \
 	EventThrottler.h \
 	EventThrottlerIme.h \
+	PenMoveResampler.h \
 	HapticsController.h \
+	CpuPolicy.h \
+	HeapProfiler.h \
+	InitGraph.h \
+	StartupTracer.h \
 	HostBase.h \
 	HostWindow.h \
 	HostWindowData.h \
 	HostWindowDataSoftware.h \
 	RemoteWindowData.h \
 	InputManager.h \
+	JsonScanner.h \
 	LaunchPoint.h \
 	Localization.h \
 	Logging.h \
@@ -275,6 +298,7 @@ HEADERS += \
 	MutexLocker.h \
 	PGSharedWrapper.h \
 	PtrArray.h \
+	SlotTable.h \
 	Rectangle.h \
 	ScaleImageBresenham.h \
 	SingletonTimer.h \
@@ -314,8 +338,11 @@ HEADERS += \
 	IpcClientHost.h \
 	IpcServer.h \
 	WebAppMgrProxy.h \
+	MessageReplayQueue.h \
 	SoundPlayer.h \
 	SoundPlayerPool.h \
+	SoundFeedbackChannel.h \
+	SoundWarmPool.h \
 	MemoryWatcher.h \
 	ProcessBase.h \
 	WebAppBase.h \
@@ -327,10 +354,10 @@ HEADERS += \
 	WindowedWebApp.h \
 	AlertWindow.h \
 	CardWindow.h \
+	CardRoundedCorners.h \
 	DashboardWindow.h \
 	MenuWindow.h \
 	CardLoading.h \
-	CardTransition.h \
 	NativeAlertManager.h \
 	EmergencyWindowManager.h \
 	VolumeControlAlertWindow.h \
@@ -341,6 +368,7 @@ HEADERS += \
 	DockWindow.h \
 	QuicklaunchLayout.h \
 	MemoryMonitor.h \
+	QmlComponentCache.h \
 	MenuWindowManager.h \
 	DashboardWindowManager.h \
 	GraphicsItemContainer.h \
@@ -350,6 +378,7 @@ HEADERS += \
 	BannerWindow.h \
 	TopLevelWindowManager.h \
 	ClockWindow.h \
+	ClockFace.h \
 	LockWindow.h \
 	DockModeWindowManager.h \
 	DockModeWindow.h \
@@ -364,6 +393,7 @@ HEADERS += \
 	WebKitKeyMap.h \
 	PixmapButton.h \
 	CardGroup.h \
+	CardGroupLayout.h \
 	KeyboardMapping.h \
    	GestureEventTransition.h \
 	SingleClickGestureRecognizer.h \
@@ -373,6 +403,7 @@ HEADERS += \
 	CardHostWindow.h \
 	VirtualInputMethod.h \
 	KineticScroller.h \
+	motionintegrator.h \
 	VirtualKeyboard.h \
 	VirtualKeyboardManager.h \
 	KeyboardFeedbackItem.h \
@@ -412,7 +443,23 @@ HEADERS += launchercard.h \
 	QHelper.h \
 	DeleteCardGraphicsItem.h
 
-SOURCES += sysmgrtst_InputTouch.cpp
+SOURCES += \
+	FlickGestureRecognizer.cpp \
+	ScreenEdgeFlickGestureRecognizer.cpp \
+	WebosTapAndHoldGestureRecognizer.cpp
+
+HEADERS += \
+	FlickGestureRecognizer.h \
+	FlickGesture.h \
+	ScreenEdgeFlickGesture.h \
+	ScreenEdgeFlickGestureRecognizer.h \
+	WebosTapAndHoldGesture.h \
+	WebosTapAndHoldGestureRecognizer.h
+
+# touch trace replay benchmark
+SOURCES += sysmgrtst_InputTouch.cpp \
+	TouchTrace.cpp
+HEADERS += TouchTrace.h
 
 contains(CONFIG_BUILD, opengl) {
 	QT += opengl
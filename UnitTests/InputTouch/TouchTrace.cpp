@@ -0,0 +1,198 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#include "TouchTrace.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+static TouchFrame frame(uint32_t time, int count, int x1 = 0, int y1 = 0, int x2 = 0, int y2 = 0)
+{
+	TouchFrame f;
+	f.time = time;
+	f.count = count;
+	f.x[0] = x1;
+	f.y[0] = y1;
+	f.x[1] = x2;
+	f.y[1] = y2;
+	return f;
+}
+
+// one finger from (x1, y1) to (x2, y2) in durationMs, then lifted
+static TouchTrace stroke(const char* name, int x1, int y1, int x2, int y2, int durationMs, int sampleMs)
+{
+	TouchTrace trace;
+	trace.name = name;
+
+	int t = 0;
+	for (; t < durationMs; t += sampleMs) {
+		trace.frames.push_back(frame(t, 1, x1 + (x2 - x1) * t / durationMs,
+									 y1 + (y2 - y1) * t / durationMs));
+	}
+	trace.frames.push_back(frame(t, 1, x2, y2));
+	trace.frames.push_back(frame(t + sampleMs, 0));
+	return trace;
+}
+
+bool TouchTrace::read(const char* path, TouchTrace& trace)
+{
+	FILE* f = fopen(path, "r");
+	if (!f)
+		return false;
+
+	trace.name = path;
+	trace.frames.clear();
+
+	char line[256];
+	while (fgets(line, sizeof(line), f)) {
+		unsigned int time;
+		TouchFrame fr = frame(0, 0);
+		int n = sscanf(line, "%u %d %d %d %d %d", &time, &fr.count,
+					   &fr.x[0], &fr.y[0], &fr.x[1], &fr.y[1]);
+		if (n < 2 || fr.count < 0 || fr.count > TouchFrame::kMaxFingers || n < 2 + 2 * fr.count)
+			continue;
+		fr.time = time;
+		trace.frames.push_back(fr);
+	}
+	fclose(f);
+
+	// always end with the fingers up
+	if (!trace.frames.empty() && trace.frames.back().count)
+		trace.frames.push_back(frame(trace.frames.back().time + 10, 0));
+
+	return trace.frames.size() > 1;
+}
+
+// half the width at 5 px/ms, well within what FlickGestureRecognizer takes for a flick
+TouchTrace TouchTrace::flick(int width, int height, int sampleMs)
+{
+	return stroke("flick", width * 3 / 4, height / 2, width / 4, height / 2, width / 2 / 5, sampleMs);
+}
+
+// a card dragged around slowly, then let go without flicking it
+TouchTrace TouchTrace::drag(int width, int height, int sampleMs)
+{
+	TouchTrace trace = stroke("drag", width / 2, height / 2, width / 2, height / 4, 800, sampleMs);
+	TouchFrame last = trace.frames[trace.frames.size() - 2];
+	trace.frames.pop_back();
+	for (int i = 1; i <= 10; i++)
+		trace.frames.push_back(frame(last.time + i * sampleMs, 1, last.x[0], last.y[0]));
+	trace.frames.push_back(frame(last.time + 11 * sampleMs, 0));
+	return trace;
+}
+
+// two fingers moving apart, around the middle of the screen
+TouchTrace TouchTrace::pinch(int width, int height, int sampleMs)
+{
+	TouchTrace trace;
+	trace.name = "pinch";
+
+	const int durationMs = 400;
+	int cx = width / 2;
+	int cy = height / 2;
+	int from = width / 10;
+	int to = width * 2 / 5;
+
+	int t = 0;
+	for (; t <= durationMs; t += sampleMs) {
+		int d = from + (to - from) * t / durationMs;
+		trace.frames.push_back(frame(t, 2, cx - d, cy - d, cx + d, cy + d));
+	}
+	trace.frames.push_back(frame(t, 0));
+	return trace;
+}
+
+// from the bottom edge, up a third of the screen
+TouchTrace TouchTrace::edgeSwipe(int width, int height, int sampleMs)
+{
+	return stroke("edgeswipe", width / 2, height - 1, width / 2, height * 2 / 3, 120, sampleMs);
+}
+
+// a finger held still, with the panel's jitter, for a second
+TouchTrace TouchTrace::tapAndHold(int width, int height, int sampleMs)
+{
+	TouchTrace trace;
+	trace.name = "tapandhold";
+
+	int t = 0;
+	for (; t <= 1000; t += sampleMs)
+		trace.frames.push_back(frame(t, 1, width / 2 + (t / sampleMs) % 2, height / 2));
+	trace.frames.push_back(frame(t, 0));
+	return trace;
+}
+
+// -------------------------------------------------------------------------
+
+TouchBenchResult::TouchBenchResult()
+	: frames(0)
+	, events(0)
+	, dropped(0)
+	, gestureStartedMs(-1)
+	, gestureFinishedMs(-1)
+{
+}
+
+int percentile(std::vector<int> values, int percent)
+{
+	if (values.empty())
+		return 0;
+
+	size_t i = (values.size() - 1) * percent / 100;
+	std::nth_element(values.begin(), values.begin() + i, values.end());
+	return values[i];
+}
+
+static std::string stats(const std::vector<int>& values)
+{
+	long long sum = 0;
+	for (size_t i = 0; i < values.size(); i++)
+		sum += values[i];
+
+	char buf[128];
+	snprintf(buf, sizeof(buf), "{\"count\":%d,\"avg\":%d,\"p50\":%d,\"p95\":%d,\"max\":%d}",
+			 (int) values.size(), values.empty() ? 0 : (int) (sum / (long long) values.size()),
+			 percentile(values, 50), percentile(values, 95), percentile(values, 100));
+	return buf;
+}
+
+// the trace name is a file path at worst: no escaping needed beyond quotes
+static std::string quoted(const std::string& s)
+{
+	std::string out = "\"";
+	for (size_t i = 0; i < s.size(); i++) {
+		if (s[i] == '"' || s[i] == '\\')
+			out += '\\';
+		out += s[i];
+	}
+	return out + "\"";
+}
+
+std::string TouchBenchResult::json() const
+{
+	char buf[256];
+	snprintf(buf, sizeof(buf), ",\"frames\":%d,\"events\":%d,\"dropped\":%d,\"gesture_started_ms\":%d,\"gesture_finished_ms\":%d",
+			 frames, events, dropped, gestureStartedMs, gestureFinishedMs);
+
+	return "{\"trace\":" + quoted(trace) + buf
+		+ ",\"gesture\":" + quoted(gesture)
+		+ ",\"handle_us\":" + stats(handleUs)
+		+ ",\"paint_us\":" + stats(paintUs) + "}";
+}
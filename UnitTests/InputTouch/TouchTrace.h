@@ -0,0 +1,88 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+
+#ifndef TOUCHTRACE_H
+#define TOUCHTRACE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * A touch trace for replaying: the fingers on the panel, one frame per touch panel
+ * report. Fingers that were in the previous frame and aren't in this one were lifted.
+ *
+ * As a file, a frame per line: "time count x1 y1 [x2 y2]", with the time in ms and
+ * count the number of fingers down (0, 1 or 2).
+ */
+struct TouchFrame
+{
+	static const int kMaxFingers = 2;
+
+	uint32_t	time;
+	int			count;
+	int			x[kMaxFingers];
+	int			y[kMaxFingers];
+};
+
+struct TouchTrace
+{
+	std::string				name;
+	std::vector<TouchFrame>	frames;
+
+	uint32_t duration() const { return frames.empty() ? 0 : frames.back().time - frames.front().time; }
+
+	static bool read(const char* path, TouchTrace& trace);
+
+	// synthetic traces for a width x height panel, reporting every sampleMs
+	static TouchTrace flick(int width, int height, int sampleMs);
+	static TouchTrace drag(int width, int height, int sampleMs);
+	static TouchTrace pinch(int width, int height, int sampleMs);
+	static TouchTrace edgeSwipe(int width, int height, int sampleMs);
+	static TouchTrace tapAndHold(int width, int height, int sampleMs);
+};
+
+/**
+ * Per-trace numbers, written out as one JSON object per line so that CI can keep
+ * track of them.
+ */
+struct TouchBenchResult
+{
+	TouchBenchResult();
+
+	std::string	trace;
+	int			frames;
+	int			events;				// touch events delivered to the WindowServer
+	int			dropped;			// of those, the ones the throttler would drop
+
+	std::vector<int> handleUs;		// per event, from the panel report to handled
+	std::vector<int> paintUs;		// per paint of the scene
+
+	int			gestureStartedMs;	// from the first frame, -1 if never
+	int			gestureFinishedMs;
+	std::string	gesture;
+
+	std::string json() const;
+};
+
+int percentile(std::vector<int> values, int percent);
+
+#endif /* TOUCHTRACE_H */
@@ -23,14 +23,31 @@
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QGesture>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QImage>
+#include <QPainter>
 #include <QWidget>
 #include <QWSServer>
 
 #include <linux/input.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 
 #include <HidLib.h>
+#include <SysMgrDefs.h>
 #include "hiddtp_qws.h"
 
+#include "CardWindow.h"
+#include "EventThrottler.h"
+#include "FlickGesture.h"
+#include "ScreenEdgeFlickGesture.h"
+#include "SystemUiController.h"
+#include "TouchTrace.h"
+#include "WebosTapAndHoldGesture.h"
+#include "WindowServer.h"
+
 Q_IMPORT_PLUGIN (hiddtp)
 Q_IMPORT_PLUGIN (hiddkbd)
 
@@ -97,6 +114,196 @@ private:
 
 static GestureWidget* s_widget = 0;
 
+// -------------------------------------------------------------------------
+// Touch trace replay benchmark
+//
+// The traces go in through the touch panel plugin, like the tests above, into the
+// WindowServer itself. Its constructor registers the sysmgr gesture recognizers, and
+// its viewport hands every event to InputManager and the other sysmgr filters before
+// the scene gets it. In the scene, the CardWindowManager holds a few cards, and each
+// trace starts from the card view, where the strokes pan, lift and reorder them.
+// Each frame of the trace is replayed at its time. For every trace, the handling time
+// of each panel report, how long the expected gesture took to be recognized, the touch
+// events the throttler would drop and the cost of painting the scene offscreen are
+// written out as one line of JSON: to stdout, and appended to the file in
+// SYSMGR_TOUCH_BENCH_OUT if set. SYSMGR_TOUCH_TRACE replays a recorded trace too.
+
+static const int kBenchCards = 4;
+
+static int64_t benchTimeUs()
+{
+	struct timespec now;
+	::clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static Qt::GestureType flickGestureType()
+{
+#if (QT_VERSION < QT_VERSION_CHECK(5, 0, 0))
+	return (Qt::GestureType) SysMgrGestureFlick;
+#else
+	return FlickGesture::gestureType();
+#endif
+}
+
+static Qt::GestureType edgeFlickGestureType()
+{
+#if (QT_VERSION < QT_VERSION_CHECK(5, 0, 0))
+	return (Qt::GestureType) SysMgrGestureScreenEdgeFlick;
+#else
+	return ScreenEdgeFlickGesture::gestureType();
+#endif
+}
+
+static Qt::GestureType tapAndHoldGestureType()
+{
+#if (QT_VERSION < QT_VERSION_CHECK(5, 0, 0))
+	return Qt::TapAndHoldGesture;
+#else
+	return WebosTapAndHoldGesture::gestureType();
+#endif
+}
+
+// a card as the card manager sees a native app's: hosted here, with nothing to wait for
+class BenchCard : public CardWindow
+{
+public:
+
+	BenchCard(const QPixmap& pixmap, int index)
+		: CardWindow(WindowType::Type_Card, pixmap)
+	{
+		m_screenPixmap = pixmap;
+
+		QString id = QString("com.palm.sysmgrtst.card%1").arg(index);
+		setAppId(id.toStdString());
+		setName(id.toStdString());
+	}
+
+	virtual bool isHost() const { return true; }
+};
+
+// watches the WindowServer's viewport without taking anything away from it
+class BenchRecorder : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	BenchRecorder(WindowServer* ws)
+		: m_ws(ws)
+		, m_cardMgr(ws->getWindowManagerByClassName("CardWindowManager"))
+		, m_result(0)
+		, m_start(0)
+		, m_dirty(false)
+		, m_frame(ws->size(), QImage::Format_RGB32)
+	{
+		ws->viewport()->installEventFilter(this);
+		connect(ws->scene(), SIGNAL(changed(const QList<QRectF>&)), SLOT(slotSceneChanged()));
+	}
+
+	void addCards()
+	{
+		for (int i = 0; i < kBenchCards; i++) {
+			QPixmap pixmap(m_ws->size());
+			pixmap.fill(QColor(40 * i, 80, 160));
+
+			BenchCard* card = new BenchCard(pixmap, i);
+			m_ws->prepareAddWindow(card);
+			m_ws->addWindow(card);
+			QTest::qWait(500);
+		}
+	}
+
+	// each trace starts from the card view, whatever the one before left up
+	void showCardView()
+	{
+		SystemUiController* sysui = SystemUiController::instance();
+		if (sysui->isLauncherShown())
+			sysui->showOrHideLauncher(false);
+		if (sysui->isCardWindowMaximized())
+			QMetaObject::invokeMethod(m_cardMgr, "slotMinimizeActiveCardWindow");
+
+		QTest::qWait(500);
+	}
+
+	void start(TouchBenchResult* result, Qt::GestureType expected)
+	{
+		m_result = result;
+		m_expected = expected;
+		m_start = benchTimeUs();
+		m_dirty = false;
+	}
+
+	int64_t startTime() const { return m_start; }
+
+	// offscreen, so that it measures the scene and not the screen
+	void paintIfDirty()
+	{
+		if (!m_dirty)
+			return;
+
+		int64_t before = benchTimeUs();
+		QPainter painter(&m_frame);
+		m_ws->scene()->render(&painter);
+		painter.end();
+		m_result->paintUs.push_back(benchTimeUs() - before);
+		m_dirty = false;
+	}
+
+protected:
+
+	bool eventFilter(QObject* obj, QEvent* event)
+	{
+		if (!m_result)
+			return false;
+
+		switch (event->type()) {
+		case QEvent::TouchBegin:
+		case QEvent::TouchUpdate:
+		case QEvent::TouchEnd:
+			m_result->events++;
+			if (EventThrottler::instance()->shouldDropEvent(event))
+				m_result->dropped++;
+			break;
+		case QEvent::Gesture: {
+			QGesture* g = static_cast<QGestureEvent*>(event)->gesture(m_expected);
+			if (g) {
+				int ms = (benchTimeUs() - m_start) / 1000;
+				if (m_result->gestureStartedMs < 0)
+					m_result->gestureStartedMs = ms;
+				if (g->state() == Qt::GestureFinished && m_result->gestureFinishedMs < 0)
+					m_result->gestureFinishedMs = ms;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+
+		return false;
+	}
+
+private Q_SLOTS:
+
+	void slotSceneChanged()
+	{
+		if (m_result)
+			m_dirty = true;
+	}
+
+private:
+
+	WindowServer*		m_ws;
+	QObject*			m_cardMgr;
+	TouchBenchResult*	m_result;
+	Qt::GestureType		m_expected;
+	int64_t				m_start;
+	bool				m_dirty;
+	QImage				m_frame;
+};
+
+static BenchRecorder* s_bench = 0;
+
 // -------------------------------------------------------------------------
 
 class InputTouch : public QObject
@@ -112,12 +319,20 @@ private:
 	void sendTwoTouchUpdate(int x1, int y1, int x2, int y2, int code1=0, int code2=1);
 	void sendTwoTouchUp(int x1, int y1, int x2, int y2, int code1=0, int code2=1);
 
+	void sendFrame(const TouchFrame& prev, const TouchFrame& frame);
+	void initBenchmark();
+	TouchBenchResult replay(const TouchTrace& trace, Qt::GestureType expected, const char* gestureName);
+	void writeResult(const TouchBenchResult& result);
+
 private Q_SLOTS:
 	
 	void initTestCase();
 	void testTap();
 	void testNoTapWithTwoFingers();
 	void testTapAfterTwoTouchDowns();
+
+	void benchmarkSyntheticTraces();
+	void benchmarkRecordedTrace();
 };
 
 void InputTouch::initTestCase()
@@ -469,5 +684,171 @@ void InputTouch::testTapAfterTwoTouchDowns()
 	QVERIFY(s_sawTapGestureFinish);
 }
 
+// the difference between two frames of a trace, as one touch panel report
+void InputTouch::sendFrame(const TouchFrame& prev, const TouchFrame& frame)
+{
+	const int maxEvents = TouchFrame::kMaxFingers * 4 + 1;
+	struct input_event inputEvents[maxEvents];
+	int numEvents = 0;
+
+	struct input_event* ev = 0;
+
+	for (int i = 0; i < TouchFrame::kMaxFingers; i++) {
+		bool down = i < frame.count;
+		bool wasDown = i < prev.count;
+		if (!down && !wasDown)
+			continue;
+
+		ev = &inputEvents[numEvents++];
+		ev->type = EV_FINGERID;
+		ev->value = i;
+		ev->code = i;
+
+		if (down != wasDown) {
+			ev = &inputEvents[numEvents++];
+			ev->type = EV_KEY;
+			ev->value = down ? 1 : 0;
+			ev->code = BTN_TOUCH;
+		}
+
+		ev = &inputEvents[numEvents++];
+		ev->type = EV_ABS;
+		ev->value = down ? frame.x[i] : prev.x[i];
+		ev->code = ABS_X;
+
+		ev = &inputEvents[numEvents++];
+		ev->type = EV_ABS;
+		ev->value = down ? frame.y[i] : prev.y[i];
+		ev->code = ABS_Y;
+	}
+
+	ev = &inputEvents[numEvents++];
+	ev->type = EV_SYN;
+
+	QWSHiddTpHandler* handler = static_cast<QWSHiddTpHandler*>(QWSServer::mouseHandler());
+	handler->pumpHiddData(inputEvents, numEvents);
+}
+
+void InputTouch::initBenchmark()
+{
+	if (s_bench)
+		return;
+
+	s_widget->window()->hide();
+
+	// registers the sysmgr gesture recognizers, and sets up InputManager and the
+	// window managers, as it does at boot
+	WindowServer* ws = WindowServer::instance();
+	ws->show();
+	QApplication::setActiveWindow(ws);
+	QTest::qWaitForWindowShown(ws);
+
+	// the sysmgr filters swallow input until then
+	ws->bootupFinished();
+
+	s_bench = new BenchRecorder(ws);
+	s_bench->addCards();
+}
+
+TouchBenchResult InputTouch::replay(const TouchTrace& trace, Qt::GestureType expected, const char* gestureName)
+{
+	TouchBenchResult result;
+	result.trace = trace.name;
+	result.gesture = gestureName;
+
+	s_bench->showCardView();
+	s_bench->start(&result, expected);
+
+	TouchFrame none;
+	none.count = 0;
+	const TouchFrame* prev = &none;
+	uint32_t traceStart = trace.frames.front().time;
+
+	for (size_t i = 0; i < trace.frames.size(); i++) {
+		const TouchFrame& frame = trace.frames[i];
+
+		// the recognizers and the throttler go by the clock: keep to the trace's timing
+		int waitMs = (int) (frame.time - traceStart) - (int) ((benchTimeUs() - s_bench->startTime()) / 1000);
+		if (waitMs > 0)
+			QTest::qWait(waitMs);
+
+		int64_t before = benchTimeUs();
+		sendFrame(*prev, frame);
+		QCoreApplication::sendPostedEvents();
+		result.handleUs.push_back(benchTimeUs() - before);
+
+		s_bench->paintIfDirty();
+
+		result.frames++;
+		prev = &frame;
+	}
+
+	// let the gestures finish
+	QTest::qWait(50);
+	s_bench->start(0, expected);
+
+	writeResult(result);
+	return result;
+}
+
+void InputTouch::writeResult(const TouchBenchResult& result)
+{
+	std::string line = result.json();
+	printf("%s\n", line.c_str());
+
+	const char* path = getenv("SYSMGR_TOUCH_BENCH_OUT");
+	if (!path)
+		return;
+
+	FILE* f = fopen(path, "a");
+	if (f) {
+		fprintf(f, "%s\n", line.c_str());
+		fclose(f);
+	}
+}
+
+void InputTouch::benchmarkSyntheticTraces()
+{
+	initBenchmark();
+
+	QSize size = QApplication::desktop()->screenGeometry().size();
+	const int sampleMs = 10;
+
+	TouchBenchResult flick = replay(TouchTrace::flick(size.width(), size.height(), sampleMs),
+									flickGestureType(), "flick");
+	QVERIFY(flick.events > 0);
+	QVERIFY(flick.gestureFinishedMs >= 0);
+	QCOMPARE((int) flick.handleUs.size(), flick.frames);
+
+	// slow enough not to be a flick
+	TouchBenchResult drag = replay(TouchTrace::drag(size.width(), size.height(), sampleMs),
+								   flickGestureType(), "flick");
+	QCOMPARE(drag.gestureFinishedMs, -1);
+	QVERIFY(!drag.paintUs.empty());
+
+	TouchBenchResult pinch = replay(TouchTrace::pinch(size.width(), size.height(), sampleMs),
+									Qt::PinchGesture, "pinch");
+	QVERIFY(pinch.gestureStartedMs >= 0);
+
+	replay(TouchTrace::edgeSwipe(size.width(), size.height(), sampleMs), edgeFlickGestureType(), "edgeflick");
+
+	TouchBenchResult hold = replay(TouchTrace::tapAndHold(size.width(), size.height(), sampleMs),
+								   tapAndHoldGestureType(), "tapandhold");
+	QVERIFY(hold.gestureStartedMs >= 0);
+}
+
+void InputTouch::benchmarkRecordedTrace()
+{
+	const char* path = getenv("SYSMGR_TOUCH_TRACE");
+	if (!path)
+		QSKIP("SYSMGR_TOUCH_TRACE not set", SkipSingle);
+
+	TouchTrace trace;
+	QVERIFY2(TouchTrace::read(path, trace), path);
+
+	initBenchmark();
+	replay(trace, flickGestureType(), "flick");
+}
+
 QTEST_MAIN(InputTouch) 
 #include "sysmgrtst_InputTouch.moc"
@@ -0,0 +1,277 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <cjson/json.h>
+#include <limits.h>
+#include <string.h>
+#include <string>
+
+#include "JsonScanner.h"
+
+// payloads as they come from powerd, the telephony service and the keys service
+static const char* s_captured[] = {
+	"{\"percent\":87,\"percent_ui\":88,\"temperature_C\":31,\"current_mA\":-412,\"voltage_mV\":4012,\"capacity_mAh\":1187.5}",
+	"{\"Charging\":true,\"DockConnected\":false,\"DockPower\":false,\"DockSerialNo\":\"NULL\",\"USBConnected\":true,\"USBName\":\"usb\"}",
+	"{\"type\":\"usb\",\"connected\":true,\"name\":\"USB charger\",\"current_mA\":500}",
+	"{\"eventSignal\":{\"bars\":3,\"rssi\":-81,\"value\":3,\"maxBars\":5,\"extended\":{\"ecio\":-9}}}",
+	"{\"returnValue\":true,\"bars\":4,\"rssi\":-72,\"extended\":{\"value\":4,\"value1x\":3,\"valueEvdo\":4,\"bars\":[1,2,3]}}",
+	"{ \"get\" : \"ringer\", \"subscribe\": true }",
+};
+
+static const int kNumCaptured = sizeof(s_captured) / sizeof(s_captured[0]);
+
+// the keys the callbacks look for
+static const char* s_paths[] = {
+	"percent", "percent_ui", "Charging", "DockSerialNo", "USBConnected", "type", "connected",
+	"eventSignal.bars", "returnValue", "bars", "extended.value1x", "get"
+};
+
+static const int kNumPaths = sizeof(s_paths) / sizeof(s_paths[0]);
+
+// what the callbacks did before: a DOM, then lookups; returns an int per path
+static int domLookup(const char* payload, int* values)
+{
+	json_object* root = json_tokener_parse(payload);
+	if (!root || is_error(root))
+		return 0;
+
+	int found = 0;
+	for (int i = 0; i < kNumPaths; i++) {
+		std::string path(s_paths[i]);
+		json_object* obj = root;
+
+		size_t dot = path.find('.');
+		if (dot != std::string::npos) {
+			obj = json_object_object_get(obj, path.substr(0, dot).c_str());
+			path = path.substr(dot + 1);
+		}
+
+		json_object* label = (obj && !is_error(obj)) ? json_object_object_get(obj, path.c_str()) : 0;
+		values[i] = 0;
+		if (label && !is_error(label)) {
+			if (json_object_is_type(label, json_type_string))
+				values[i] = strlen(json_object_get_string(label));
+			else
+				values[i] = json_object_get_int(label);
+			found++;
+		}
+	}
+
+	json_object_put(root);
+	return found;
+}
+
+static int scanLookup(const char* payload, int* values)
+{
+	JsonField fields[kNumPaths];
+	for (int i = 0; i < kNumPaths; i++)
+		fields[i].path = s_paths[i];
+
+	if (!JsonScanner::scan(payload, fields, kNumPaths))
+		return 0;
+
+	int found = 0;
+	for (int i = 0; i < kNumPaths; i++) {
+		values[i] = 0;
+		if (fields[i].found()) {
+			if (fields[i].type == JsonField::String)
+				values[i] = fields[i].length;
+			else
+				values[i] = fields[i].type == JsonField::Boolean ? fields[i].boolean : fields[i].integer;
+			found++;
+		}
+	}
+
+	return found;
+}
+
+// -------------------------------------------------------------------------
+
+class TestJsonScanner : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void types();
+	void outOfRange();
+	void nestedPaths();
+	void strings();
+	void malformed();
+	void stopsWhenFound();
+	void sameAsDom();
+	void benchmarkDom();
+	void benchmarkScan();
+};
+
+void TestJsonScanner::types()
+{
+	JsonField fields[] = {
+		JsonField("b"), JsonField("i"), JsonField("d"), JsonField("s"),
+		JsonField("n"), JsonField("o"), JsonField("a"), JsonField("missing")
+	};
+
+	QVERIFY(JsonScanner::scan("{\"b\":false,\"i\":-42,\"d\":2.5e1,\"s\":\"x\",\"n\":null,\"o\":{},\"a\":[1]}", fields, 8));
+
+	bool b = true;
+	int i = 0;
+	double d = 0;
+	QVERIFY(fields[0].getBool(b));
+	QCOMPARE(b, false);
+	QVERIFY(fields[1].getInt(i));
+	QCOMPARE(i, -42);
+	QVERIFY(!fields[2].getInt(i));
+	QVERIFY(fields[2].getDouble(d));
+	QCOMPARE(d, 25.0);
+	QCOMPARE(fields[3].type, JsonField::String);
+	QCOMPARE(fields[4].type, JsonField::Null);
+	QCOMPARE(fields[5].type, JsonField::Object);
+	QCOMPARE(fields[6].type, JsonField::Array);
+	QVERIFY(!fields[7].found());
+}
+
+void TestJsonScanner::outOfRange()
+{
+	JsonField fields[] = {
+		JsonField("big"), JsonField("small"), JsonField("huge"), JsonField("tiny"), JsonField("frac")
+	};
+
+	QVERIFY(JsonScanner::scan("{\"big\":99999999999,\"small\":-99999999999,\"huge\":1e400,\"tiny\":-1e400,\"frac\":-7.9}",
+							  fields, 5));
+
+	QCOMPARE(fields[0].type, JsonField::Integer);
+	QCOMPARE(fields[0].integer, INT_MAX);
+	QCOMPARE(fields[1].integer, INT_MIN);
+	QCOMPARE(fields[2].type, JsonField::Double);
+	QCOMPARE(fields[2].integer, INT_MAX);
+	QCOMPARE(fields[3].integer, INT_MIN);
+	QCOMPARE(fields[4].integer, -7);
+}
+
+void TestJsonScanner::nestedPaths()
+{
+	JsonField fields[] = { JsonField("eventSignal.bars"), JsonField("bars"), JsonField("eventSignal") };
+
+	QVERIFY(JsonScanner::scan("{\"list\":[{\"bars\":9}],\"eventSignal\":{\"bars\":2},\"bars\":5}", fields, 3));
+
+	// what is in an array doesn't count
+	QCOMPARE(fields[0].integer, 2);
+	QCOMPARE(fields[1].integer, 5);
+	QCOMPARE(fields[2].type, JsonField::Object);
+	QCOMPARE(QByteArray(fields[2].start, fields[2].length), QByteArray("{\"bars\":2}"));
+}
+
+void TestJsonScanner::strings()
+{
+	JsonField field("name");
+	QVERIFY(JsonScanner::scan("{\"name\":\"a\\\"b\\u00e9\\n\"}", &field, 1));
+	QVERIFY(field.escaped);
+	QVERIFY(field.equals("a\"b\xc3\xa9\n"));
+	QVERIFY(!field.equals("a\"b"));
+
+	char buffer[16];
+	QCOMPARE(field.copyString(buffer, sizeof(buffer)), 6);
+	QCOMPARE(QByteArray(buffer), QByteArray("a\"b\xc3\xa9\n"));
+	QCOMPARE(field.copyString(buffer, 4), -1);
+
+	std::string value;
+	QVERIFY(field.getString(value));
+	QCOMPARE(value, std::string("a\"b\xc3\xa9\n"));
+
+	QVERIFY(JsonScanner::scan("{\"name\":\"usb\"}", &field, 1));
+	QVERIFY(!field.escaped);
+	QVERIFY(field.equals("usb"));
+	QVERIFY(!field.equals("us"));
+}
+
+void TestJsonScanner::malformed()
+{
+	JsonField field("x");
+
+	QVERIFY(!JsonScanner::scan(0, &field, 1));
+	QVERIFY(!JsonScanner::scan("", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":}", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":tru}", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":1,}", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":\"unterminated}", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":[1 2]}", &field, 1));
+	QVERIFY(!JsonScanner::scan("{\"a\":1} trailing", &field, 1));
+
+	// what came before the error is there
+	QVERIFY(!JsonScanner::scan("{\"x\":1,\"a\":", &field, 1) || field.found());
+	QVERIFY(!JsonScanner::scan("{\"a\":1,\"x\":2,\"b\":}", &field, 1) || field.found());
+	QVERIFY(JsonScanner::scan(" {\"a\":[1,[2,{}]],\"b\":{\"c\":{}}} ", &field, 1));
+	QVERIFY(!field.found());
+}
+
+void TestJsonScanner::stopsWhenFound()
+{
+	JsonField field("x");
+
+	// the garbage after the field is never looked at
+	QVERIFY(JsonScanner::scan("{\"x\":1, garbage", &field, 1));
+	QCOMPARE(field.integer, 1);
+
+	// the first of duplicate keys
+	QVERIFY(JsonScanner::scan("{\"x\":1,\"x\":2}", &field, 1));
+	QCOMPARE(field.integer, 1);
+}
+
+void TestJsonScanner::sameAsDom()
+{
+	for (int i = 0; i < kNumCaptured; i++) {
+		int dom[kNumPaths];
+		int scan[kNumPaths];
+		QCOMPARE(scanLookup(s_captured[i], scan), domLookup(s_captured[i], dom));
+		for (int j = 0; j < kNumPaths; j++)
+			QCOMPARE(scan[j], dom[j]);
+	}
+}
+
+void TestJsonScanner::benchmarkDom()
+{
+	int values[kNumPaths];
+	int found = 0;
+
+	QBENCHMARK {
+		for (int i = 0; i < kNumCaptured; i++)
+			found += domLookup(s_captured[i], values);
+	}
+
+	QVERIFY(found > 0);
+}
+
+void TestJsonScanner::benchmarkScan()
+{
+	int values[kNumPaths];
+	int found = 0;
+
+	QBENCHMARK {
+		for (int i = 0; i < kNumCaptured; i++)
+			found += scanLookup(s_captured[i], values);
+	}
+
+	QVERIFY(found > 0);
+}
+
+QTEST_MAIN(TestJsonScanner)
+#include "sysmgrtst_JsonScanner.moc"
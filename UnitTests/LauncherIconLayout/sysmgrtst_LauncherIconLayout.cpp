@@ -0,0 +1,173 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <QApplication>
+#include <QList>
+
+#include "reorderablepage.h"
+#include "reorderableiconlayout.h"
+#include "icon.h"
+#include "iconheap.h"
+
+// FIXME: Hacked in here (normally provided by Main.cpp)
+pid_t sysmgrPid;
+pid_t bootAnimPid;
+int   bootAnimPipeFd=-1, sysmgrPipeFd=-1;
+int   WebAppMgrPipeFd=-1, IpcServerPipeFd=-1;
+char  msgOkToContinue = 0xAB;
+
+static const int kNumPages = 10;
+static const int kIconsPerPage = 40;
+
+// -------------------------------------------------------------------------
+
+class TestLauncherIconLayout : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void initTestCase();
+	void cleanupTestCase();
+
+	void findAfterReorder();
+	void findAfterRemove();
+	void benchmarkReorderAndFind();
+
+private:
+
+	ReorderableIconLayout * layoutOf(ReorderablePage * p_page);
+	void reorderAndCommit(ReorderableIconLayout * p_layout,const QPoint& from,const QPoint& to);
+
+	QList<ReorderablePage *> m_pages;
+	QList<QList<IconBase *> > m_icons;
+};
+
+void TestLauncherIconLayout::initTestCase()
+{
+	for (int p=0;p<kNumPages;++p)
+	{
+		ReorderablePage * pPage = new ReorderablePage(QRectF(-160,-200,320,400),0);
+		IconList icons;
+		for (int i=0;i<kIconsPerPage;++i)
+		{
+			IconBase * pIcon = new IconBase(QRectF(-32,-32,64,64),pPage);
+			IconHeap::iconHeap()->addIcon(pIcon);
+			icons << pIcon;
+		}
+		QVERIFY(pPage->layoutFromItemList(icons));
+		m_pages << pPage;
+		m_icons << icons;
+	}
+}
+
+void TestLauncherIconLayout::cleanupTestCase()
+{
+	qDeleteAll(m_pages);
+	m_pages.clear();
+	m_icons.clear();
+}
+
+ReorderableIconLayout * TestLauncherIconLayout::layoutOf(ReorderablePage * p_page)
+{
+	return qobject_cast<ReorderableIconLayout *>(p_page->currentIconLayout());
+}
+
+void TestLauncherIconLayout::reorderAndCommit(ReorderableIconLayout * p_layout,const QPoint& from,const QPoint& to)
+{
+	QList<IconOperation> opList = p_layout->opListForMove(from,to);
+	if (opList.isEmpty())
+	{
+		return;
+	}
+	p_layout->executeOpList(opList);
+	p_layout->commitPendingImmediately();
+}
+
+void TestLauncherIconLayout::findAfterReorder()
+{
+	ReorderableIconLayout * pLayout = layoutOf(m_pages[0]);
+	QVERIFY(pLayout);
+	QVERIFY(pLayout->dbg_verifyIconIndex());
+
+	QPoint gridCoord;
+	IconBase * pFirst = m_icons[0][0];
+	QVERIFY(pLayout->findIconByUid(pFirst->uid(),gridCoord) != 0);
+	QCOMPARE(gridCoord,QPoint(0,0));
+
+	QPoint last = pLayout->lastOccupiedGridPosition();
+	reorderAndCommit(pLayout,QPoint(0,0),last);
+
+	QVERIFY(pLayout->dbg_verifyIconIndex());
+	QVERIFY(pLayout->findIconByUid(pFirst->uid(),gridCoord) != 0);
+	QCOMPARE(pLayout->iconCellAtGridCoordinate(gridCoord)->m_qp_icon.data(),pFirst);
+
+	//and back again, so the later tests start from the original order
+	reorderAndCommit(pLayout,gridCoord,QPoint(0,0));
+	QVERIFY(pLayout->dbg_verifyIconIndex());
+}
+
+void TestLauncherIconLayout::findAfterRemove()
+{
+	ReorderableIconLayout * pLayout = layoutOf(m_pages[1]);
+	QVERIFY(pLayout);
+
+	IconBase * pRemoved = m_icons[1][1];
+	IconBase * pShifted = m_icons[1][2];
+	QPoint gridCoord;
+	QVERIFY(pLayout->findIconByUid(pRemoved->uid(),gridCoord) != 0);
+	QVERIFY(pLayout->removeIconCell(gridCoord));
+
+	QVERIFY(pLayout->findIconByUid(pRemoved->uid(),gridCoord) == 0);
+	QVERIFY(pLayout->findIconByUid(pShifted->uid(),gridCoord) != 0);
+	QCOMPARE(pLayout->iconCellAtGridCoordinate(gridCoord)->m_qp_icon.data(),pShifted);
+	QVERIFY(pLayout->dbg_verifyIconIndex());
+}
+
+// drags the first icon of every page to the end and back, and looks up every icon of the page after each step;
+// this is the pattern a reorder drag produces (trackedIconMovedTo -> executeOpList, then findIconByUid from the page)
+void TestLauncherIconLayout::benchmarkReorderAndFind()
+{
+	QBENCHMARK
+	{
+		for (int p=2;p<kNumPages;++p)
+		{
+			ReorderableIconLayout * pLayout = layoutOf(m_pages[p]);
+			QPoint last = pLayout->lastOccupiedGridPosition();
+			reorderAndCommit(pLayout,QPoint(0,0),last);
+			QPoint gridCoord;
+			for (QList<IconBase *>::const_iterator it = m_icons[p].constBegin();
+					it != m_icons[p].constEnd();++it)
+			{
+				pLayout->findIconByUid((*it)->uid(),gridCoord,true);
+			}
+			reorderAndCommit(pLayout,last,QPoint(0,0));
+		}
+	}
+	for (int p=2;p<kNumPages;++p)
+	{
+		QVERIFY(layoutOf(m_pages[p])->dbg_verifyIconIndex());
+	}
+}
+
+QTEST_MAIN(TestLauncherIconLayout)
+#include "sysmgrtst_LauncherIconLayout.moc"
@@ -0,0 +1,552 @@
+# @@@LICENSE
+#
+#      Copyright (c) 2010-2013 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# LICENSE@@@
+CONFIG += qt no_keywords
+QT += testlib declarative
+CONFIG += link_pkgconfig
+PKGCONFIG = glib-2.0 gthread-2.0 LunaSysMgrIpc
+
+VPATH = ../../Src \
+		../../Src/base \
+		../../Src/base/application \
+		../../Src/base/visual \
+		../../Src/base/gesture \
+		../../Src/base/windowdata \
+		../../Src/base/settings \
+		../../Src/core \
+		../../Src/sound \
+		../../Src/lunaui \
+		../../Src/lunaui/cards \
+		../../Src/lunaui/notifications \
+		../../Src/lunaui/emergency \
+		../../Src/lunaui/lockscreen \
+		../../Src/lunaui/dock \
+		../../Src/minimalui \
+		../../Src/remote \
+		../../Src/lunaui/status-bar \
+		../../Src/ime \
+		../../Src/nyx \
+		../../Src/lunaui/launcher \
+		../../Src/lunaui/launcher/gfx \
+		../../Src/lunaui/launcher/gfx/debug \
+		../../Src/lunaui/launcher/gfx/pixmapobject \
+		../../Src/lunaui/launcher/gfx/effects \
+		../../Src/lunaui/launcher/gfx/processors \
+		../../Src/lunaui/launcher/physics \
+		../../Src/lunaui/launcher/physics/motion \
+		../../Src/lunaui/launcher/elements \
+		../../Src/lunaui/launcher/elements/page \
+		../../Src/lunaui/launcher/elements/page/icon_layouts \
+		../../Src/lunaui/launcher/elements/bars \
+		../../Src/lunaui/launcher/elements/icons \
+		../../Src/lunaui/launcher/elements/util \
+		../../Src/lunaui/launcher/elements/static \
+		../../Src/lunaui/launcher/elements/buttons \
+		../../Src/lunaui/launcher/systeminterface \
+		../../Src/lunaui/launcher/systeminterface/util \
+		../../Src/lunaui/launcher/util \
+		../../Src/lunaui/launcher/test
+
+INCLUDEPATH = $$VPATH
+
+DEFINES += QT_WEBOS SHIPPING_VERSION=0 P_BACKEND=P_BACKEND_SOFT
+
+QMAKE_CXXFLAGS += -fno-rtti -fno-exceptions -Wall -fpermissive
+QMAKE_CXXFLAGS += -DFIX_FOR_QT
+# Override the default (-Wall -W) from g++.conf mkspec (see linux-g++.conf)
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter -Wno-unused-variable -Wno-reorder -Wno-missing-field-initializers -Wno-extra
+
+LIBS += -lcjson -lLunaSysMgrIpc -lluna-service2 -lpbnjson_c -lpbnjson_cpp -lssl -lsqlite3 -lcrypto -lnyx -lLunaSysMgrCommon
+
+linux-g++ {
+	include(../../desktop.pri)
+} else:linux-g++-64 {
+	include(../../desktop.pri)
+} else {
+	include(../../device.pri)
+}
+
+DESTDIR = ./$${BUILD_TYPE}-$${MACHINE_NAME}
+OBJECTS_DIR = $$DESTDIR/.obj
+MOC_DIR = $$DESTDIR/.moc
+
+TARGET = sysmgrtst_LauncherPageSaver
+
+# everything LunaSysMgr builds, minus Main.cpp
+SOURCES += \
+	HeapProfiler.cpp \
+	MallocHooks.cpp \
+	CpuAffinity.cpp \
+	CpuPolicy.cpp \
+	KeywordMap.cpp \
+	Window.cpp \
+	ActiveCallBanner.cpp \
+	BannerMessageEventFactory.cpp \
+	ApplicationDescription.cpp \
+	LaunchPoint.cpp \
+	ApplicationManager.cpp \
+	CmdResourceHandlers.cpp \
+	ApplicationManagerService.cpp \
+	ApplicationInstaller.cpp \
+	WindowManagerBase.cpp \
+	WindowServer.cpp \
+	FpsHistory.cpp \
+	TouchPlot.cpp \
+	WindowServerLuna.cpp \
+	WindowServerMinimal.cpp \
+	WindowManagerMinimal.cpp \
+	MetaKeyManager.cpp \
+	DisplayManager.cpp \
+	DisplayStates.cpp \
+	InactivityDeadline.cpp \
+	AmbientLightSensor.cpp \
+	AlsFilter.cpp \
+	InputManager.cpp \
+	JsonScanner.cpp \
+	EventReporter.cpp \
+	SystemUiController.cpp \
+	BannerMessageHandler.cpp \
+	SystemService.cpp \
+	EventThrottler.cpp \
+	EventThrottlerIme.cpp \
+	PenMoveResampler.cpp \
+	HapticsController.cpp \
+	InitGraph.cpp \
+	StartupTracer.cpp \
+	Preferences.cpp \
+	NotificationPolicy.cpp \
+	PersistentWindowCache.cpp \
+	RoundedCorners.cpp \
+	CoreNaviManager.cpp \
+	CoreNaviLeds.cpp \
+	DeviceInfo.cpp \
+	Security.cpp \
+	EASPolicyManager.cpp \
+	AnimationSettings.cpp \
+	MimeSystem.cpp \
+	IpcServer.cpp \
+	IpcClientHost.cpp \
+	WebAppMgrProxy.cpp \
+	SuspendBlocker.cpp \
+	ApplicationStatus.cpp \
+	FullEraseConfirmationWindow.cpp \
+	SoundPlayerPool.cpp \
+	SoundFeedbackChannel.cpp \
+	SoundWarmPool.cpp \
+	HostWindow.cpp \
+	HostWindowData.cpp \
+	HostWindowDataSoftware.cpp \
+	AlertWindow.cpp \
+	CardWindow.cpp \
+	CardRoundedCorners.cpp \
+	DashboardWindow.cpp \
+	MenuWindow.cpp \
+	CardLoading.cpp \
+	NativeAlertManager.cpp \
+	EmergencyWindowManager.cpp \
+	VolumeControlAlertWindow.cpp \
+	ReticleItem.cpp \
+	TouchToShareGlow.cpp \
+	CardWindowManager.cpp \
+	OverlayWindowManager.cpp \
+	QuicklaunchLayout.cpp \
+	MemoryMonitor.cpp \
+	QmlComponentCache.cpp \
+	MenuWindowManager.cpp \
+	DashboardWindowManager.cpp \
+	GraphicsItemContainer.cpp \
+	CardWindowManagerStates.cpp \
+	DashboardWindowManagerStates.cpp \
+	DashboardWindowContainer.cpp \
+	BannerWindow.cpp \
+	TopLevelWindowManager.cpp \
+	ClockWindow.cpp \
+	ClockFace.cpp \
+	LockWindow.cpp \
+	DockModeWindowManager.cpp \
+	DockModeWindow.cpp \
+	DockModeLaunchPoint.cpp \
+	DockModePositionManager.cpp \
+	DockModeAppMenuContainer.cpp \
+	DockModeClock.cpp \
+	DockModeMenuManager.cpp \
+	CardDropShadowEffect.cpp \
+	CardGroup.cpp \
+	SingleClickGestureRecognizer.cpp \
+	ProgressAnimation.cpp \
+	CardHostWindow.cpp \
+	KineticScroller.cpp \
+	PackageDescription.cpp \
+	ServiceDescription.cpp \
+	AppDirectRenderingArbitrator.cpp \
+	StatusBar.cpp \
+	StatusBarClock.cpp \
+	StatusBarBattery.cpp \
+	StatusBarTitle.cpp \
+	StatusBarServicesConnector.cpp \
+	StatusBarIcon.cpp \
+	StatusBarInfo.cpp \
+	StatusBarModel.cpp \
+	StatusBarRenderCache.cpp \
+	StatusBarItemGroup.cpp \
+	StatusBarNotificationArea.cpp \
+	SystemMenu.cpp \
+	BtDeviceClass.cpp \
+	IMEManager.cpp \
+	InputWindowManager.cpp \
+	IMEView.cpp \
+	SysmgrIMEDataInterface.cpp \
+	IMEController.cpp \
+	KeyLocationRecorder.cpp \
+	VirtualKeyboardPreferences.cpp \
+	GhostCard.cpp \
+	WSOverlayScreenShotAnimation.cpp \
+	InputClient.cpp \
+	QmlAlertWindow.cpp \
+	QtHostWindow.cpp \
+	UiNavigationController.cpp \
+	BackupManager.cpp \
+	LsmUtils.cpp \
+	WebosTapGestureRecognizer.cpp \
+	WebosTapAndHoldGestureRecognizer.cpp \
+	FlickGestureRecognizer.cpp \
+	ScreenEdgeFlickGestureRecognizer.cpp \
+	dimensionsmain.cpp \
+	dimensionslauncher.cpp \
+	quicklaunchbar.cpp \
+	page.cpp \
+	pagemovement.cpp \
+	thing.cpp \
+	thingpaintable.cpp \
+	layoutitem.cpp \
+	dimensionsglobal.cpp \
+	debugglobal.cpp \
+	groupanchoritem.cpp \
+	layoutsettings.cpp \
+	operationalsettings.cpp \
+	dynamicssettings.cpp \
+	pixmapobject.cpp \
+	pixmap9tileobject.cpp \
+	pixmap3htileobject.cpp \
+	pixmap3vtileobject.cpp \
+	pixmaphugeobject.cpp \
+	pixmapjupocobject.cpp \
+	pixmapjupocrefobject.cpp \
+	pixmapfilmstripobject.cpp \
+	pixpager.cpp \
+	gfxsettings.cpp \
+	pixpagerdebugger.cpp \
+	sysmgrdebuggerservice.cpp \
+	qtjsonabstract.cpp \
+	renderedlabel.cpp \
+	scrollableobject.cpp \
+	scrollingsurface.cpp \
+	scrollinglayoutrenderer.cpp \
+	variableanimsignaltransition.cpp \
+	linearmotiontransform.cpp \
+	frictiontransform.cpp \
+	motionintegrator.cpp \
+	pagetabbar.cpp \
+	pagetab.cpp \
+	icon.cpp \
+	iconcmdevents.cpp \
+	icondecorator.cpp \
+	iconlayout.cpp \
+	alphabeticonlayout.cpp \
+	alphabetpage.cpp \
+	reorderableiconlayout.cpp \
+	reorderablepage.cpp \
+	iconreorderanimation.cpp \
+	iconlayoutsettings.cpp \
+	icongeometrysettings.cpp \
+	staticelementsettings.cpp \
+	pixmaploader.cpp \
+	gfxeffectbase.cpp \
+	gfxsepiaeffect.cpp \
+	pixbutton.cpp \
+	labeledbutton.cpp \
+	colorroundrectbutton.cpp \
+	pixbuttonsimple.cpp \
+	pixbutton2state.cpp \
+	horizontaldivider.cpp \
+	horizontallabeleddivider.cpp \
+	testiconfactory.cpp \
+	dotgrid.cpp \
+	externalapp.cpp \
+	webosapp.cpp \
+	appmonitor.cpp \
+	iconheap.cpp \
+	stringtranslator.cpp \
+	appeffector.cpp \
+	pagesaver.cpp \
+	pagesavequeue.cpp \
+	launcherbinarysave.cpp \
+	pagerestore.cpp \
+	filenames.cpp \
+	blacklist.cpp \
+	staticmatchlist.cpp \
+	textbox.cpp \
+	picturebox.cpp \
+	conditionalsignaltransition.cpp \
+	propertysettingsignaltransition.cpp \
+	timedelaytransition.cpp \
+	vcamera.cpp \
+	expblur.cpp \
+	overlaylayer.cpp \
+	safefileops.cpp \
+	SoundPlayerDummy.cpp
+
+HEADERS += \
+	AmbientLightSensor.h \
+	AlsFilter.h \
+	AnimationSettings.h \
+	ApplicationDescription.h \
+	ApplicationInstallerErrors.h \
+	ApplicationInstaller.h \
+	ApplicationManager.h \
+	ApplicationStatus.h \
+	CmdResourceHandlers.h \
+	CoreNaviLeds.h \
+	CoreNaviManager.h \
+	DeviceInfo.h \
+	DisplayManager.h \
+	DisplayStates.h \
+	InactivityDeadline.h \
+	EASPolicyManager.h \
+	EventReporter.h \
+	EventThrottler.h \
+	EventThrottlerIme.h \
+	PenMoveResampler.h \
+	HapticsController.h \
+	CpuPolicy.h \
+	HeapProfiler.h \
+	InitGraph.h \
+	StartupTracer.h \
+	HostWindow.h \
+	HostWindowData.h \
+	HostWindowDataSoftware.h \
+	InputManager.h \
+	JsonScanner.h \
+	LaunchPoint.h \
+	MetaKeyManager.h \
+	MimeSystem.h \
+	Preferences.h \
+	RoundedCorners.h \
+	Security.h \
+	SuspendBlocker.h \
+	SystemService.h \
+	SystemUiController.h \
+	Window.h \
+	WindowManagerBase.h \
+	WindowServer.h \
+	TouchPlot.h \
+	AnimationEquations.h \
+	GraphicsDefs.h \
+	PtrArray.h \
+	SlotTable.h \
+	ActiveCallBanner.h \
+	BannerMessageEventFactory.h \
+	BannerMessageHandler.h \
+	FullEraseConfirmationWindow.h \
+	NotificationPolicy.h \
+	PersistentWindowCache.h \
+	WindowServerLuna.h \
+	WindowManagerMinimal.h \
+	WindowServerMinimal.h \
+	IpcClientHost.h \
+	IpcServer.h \
+	WebAppMgrProxy.h \
+	MessageReplayQueue.h \
+	SoundPlayer.h \
+	SoundPlayerPool.h \
+	SoundFeedbackChannel.h \
+	SoundWarmPool.h \
+	AlertWindow.h \
+	CardWindow.h \
+	CardRoundedCorners.h \
+	DashboardWindow.h \
+	MenuWindow.h \
+	CardLoading.h \
+	NativeAlertManager.h \
+	EmergencyWindowManager.h \
+	VolumeControlAlertWindow.h \
+	ReticleItem.h \
+	TouchToShareGlow.h \
+	CardWindowManager.h \
+	OverlayWindowManager.h \
+	OverlayWindowManager_p.h \
+	QuicklaunchLayout.h \
+	MemoryMonitor.h \
+	QmlComponentCache.h \
+	MenuWindowManager.h \
+	DashboardWindowManager.h \
+	GraphicsItemContainer.h \
+	CardWindowManagerStates.h \
+	DashboardWindowManagerStates.h \
+	DashboardWindowContainer.h \
+	BannerWindow.h \
+	TopLevelWindowManager.h \
+	ClockWindow.h \
+	ClockFace.h \
+	LockWindow.h \
+	DockModeWindowManager.h \
+	DockModeWindow.h \
+	DockModeLaunchPoint.h \
+	DockModePositionManager.h \
+	DockModeAppMenuContainer.h \
+	DockModeClock.h \
+	DockModeMenuManager.h \
+	CardDropShadowEffect.h \
+	CardGroup.h \
+	CardGroupLayout.h \
+	SingleClickGestureRecognizer.h \
+	SingleClickGesture.h \
+	ProgressAnimation.h \
+	CardHostWindow.h \
+	KineticScroller.h \
+	PackageDescription.h \
+	ServiceDescription.h \
+	AppDirectRenderingArbitrator.h \
+	StatusBar.h \
+	StatusBarClock.h \
+	StatusBarBattery.h \
+	StatusBarTitle.h \
+	StatusBarServicesConnector.h \
+	StatusBarIcon.h \
+	StatusBarInfo.h \
+	StatusBarModel.h \
+	StatusBarRenderCache.h \
+	StatusBarItem.h \
+	StatusBarItemGroup.h \
+	StatusBarNotificationArea.h \
+	SystemMenu.h \
+	BtDeviceClass.h \
+	IMEManager.h \
+	InputWindowManager.h \
+	IMEView.h \
+	SysmgrIMEDataInterface.h \
+	IMEController.h \
+	KeyLocationRecorder.h \
+	VirtualKeyboardPreferences.h \
+	GhostCard.h \
+	WSOverlayScreenShotAnimation.h \
+	InputClient.h \
+	CardSmoothEdgeShaderStage.h \
+	CardRoundedCornerShaderStage.h \
+	QmlAlertWindow.h \
+	QtHostWindow.h \
+	BackupManager.h \
+	UiNavigationController.h \
+	LsmUtils.h \
+	WebosTapGestureRecognizer.h \
+	WebosTapAndHoldGestureRecognizer.h \
+	FlickGestureRecognizer.h \
+	FlickGesture.h \
+	ScreenEdgeFlickGesture.h \
+	WebosTapAndHoldGesture.h \
+	ScreenEdgeFlickGestureRecognizer.h \
+	FlickEvent.h \
+	QmlInputItem.h \
+	dimensionsmain.h \
+	dimensionslauncher.h \
+	quicklaunchbar.h \
+	dimensionstypes.h \
+	renderopts.h \
+	page.h \
+	pagemovement.h \
+	thing.h \
+	thingpaintable.h \
+	layoutitem.h \
+	dimensionsglobal.h \
+	debugglobal.h \
+	groupanchoritem.h \
+	layoutsettings.h \
+	operationalsettings.h \
+	dynamicssettings.h \
+	pixmapobject.h \
+	pixmap9tileobject.h \
+	pixmap3htileobject.h \
+	pixmap3vtileobject.h \
+	pixmaphugeobject.h \
+	pixmapjupocobject.h \
+	pixmapjupocrefobject.h \
+	pixmapfilmstripobject.h \
+	pixpager.h \
+	gfxsettings.h \
+	pixpagerdebugger.h \
+	sysmgrdebuggerservice.h \
+	qtjsonabstract.h \
+	renderedlabel.h \
+	scrollableobject.h \
+	scrollingsurface.h \
+	scrollinglayoutrenderer.h \
+	variableanimsignaltransition.h \
+	linearmotiontransform.h \
+	frictiontransform.h \
+	motionintegrator.h \
+	pagetabbar.h \
+	pagetab.h \
+	icon.h \
+	iconcmdevents.h \
+	icondecorator.h \
+	iconlayout.h \
+	alphabeticonlayout.h \
+	alphabetpage.h \
+	reorderableiconlayout.h \
+	reorderablepage.h \
+	iconreorderanimation.h \
+	iconlayoutsettings.h \
+	icongeometrysettings.h \
+	staticelementsettings.h \
+	pixmaploader.h \
+	gfxeffectbase.h \
+	gfxsepiaeffect.h \
+	pixbutton.h \
+	labeledbutton.h \
+	colorroundrectbutton.h \
+	pixbuttonsimple.h \
+	pixbutton2state.h \
+	horizontaldivider.h \
+	horizontallabeleddivider.h \
+	testiconfactory.h \
+	dotgrid.h \
+	externalapp.h \
+	webosapp.h \
+	appmonitor.h \
+	iconheap.h \
+	stringtranslator.h \
+	appeffector.h \
+	pagesaver.h \
+	pagesavequeue.h \
+	launcherbinarysave.h \
+	pagerestore.h \
+	filenames.h \
+	blacklist.h \
+	filterlist.h \
+	staticmatchlist.h \
+	textbox.h \
+	picturebox.h \
+	conditionalsignaltransition.h \
+	propertysettingsignaltransition.h \
+	timedelaytransition.h \
+	vcamera.h \
+	expblur.h \
+	overlaylayer.h \
+	safefileops.h \
+	SoundPlayerDummy.h
+
+SOURCES += sysmgrtst_LauncherPageSaver.cpp
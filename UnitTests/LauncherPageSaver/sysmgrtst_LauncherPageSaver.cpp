@@ -0,0 +1,369 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <QDir>
+#include <QFile>
+#include <QSettings>
+#include <QTime>
+
+#include <unistd.h>
+
+#include "pagesavequeue.h"
+#include "launcherbinarysave.h"
+#include "pagerestore.h"
+
+using namespace DimensionsSystemInterface;
+
+// FIXME: Hacked in here (normally provided by Main.cpp)
+pid_t sysmgrPid;
+pid_t bootAnimPid;
+int   bootAnimPipeFd=-1, sysmgrPipeFd=-1;
+int   WebAppMgrPipeFd=-1, IpcServerPipeFd=-1;
+char  msgOkToContinue = 0xAB;
+
+static const int kNumPages = 12;
+static const int kIconsPerPage = 25;
+
+// -------------------------------------------------------------------------
+
+class TestLauncherPageSaver : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void initTestCase();
+	void cleanupTestCase();
+
+	void onlyChangedPagesWritten();
+	void coalescesWhileWriting();
+	void flushWritesLatest();
+	void benchmarkSynchronousSave();
+	void benchmarkScheduledSave();
+
+	void binaryRoundTrip();
+	void binaryCorruptFallsBackToIni();
+	void binaryStaleAfterIniRestore();
+	void benchmarkRestoreIni();
+	void benchmarkRestoreBinary();
+
+private:
+
+	void makeLauncher(LauncherSaveSnapshot& r_launcher);
+	void reorder(LauncherSaveSnapshot& r_launcher,int pageIndex);
+	bool waitForIdle(PageSaveQueue& queue);
+	QString firstIconIdOnDisk(const PageSaveSnapshot& page);
+
+	QString m_dir;
+	quint32 m_reorderCount;
+};
+
+void TestLauncherPageSaver::initTestCase()
+{
+	m_reorderCount = 0;
+	m_dir = QDir::tempPath() + QString("/sysmgrtst_pagesaver_%1").arg(getpid());
+	QVERIFY(QDir().mkpath(m_dir));
+}
+
+void TestLauncherPageSaver::cleanupTestCase()
+{
+	QDir dir(m_dir);
+	QStringList files = dir.entryList(QDir::Files | QDir::Hidden);
+	for (QStringList::const_iterator it = files.constBegin();it != files.constEnd();++it)
+	{
+		dir.remove(*it);
+	}
+	QDir().rmdir(m_dir);
+}
+
+void TestLauncherPageSaver::makeLauncher(LauncherSaveSnapshot& r_launcher)
+{
+	r_launcher.masterFilepath = m_dir + QString("/launcher_fixed.msave");
+	r_launcher.timeStamp = (quint64)QDateTime::currentMSecsSinceEpoch();
+	r_launcher.pages.clear();
+	for (int p=0;p<kNumPages;++p)
+	{
+		PageSaveSnapshot page;
+		page.pageName = QString("page%1").arg(p);
+		page.pageDesignator = QString("designator%1").arg(p);
+		page.pageType = QString("ReorderablePage");
+		page.pageUid = QUuid::createUuid().toString();
+		page.pageIndex = p;
+		page.filepath = m_dir + QString("/page_ReorderablePage_") + page.pageName + QString("_") + page.pageUid;
+		for (int i=0;i<kIconsPerPage;++i)
+		{
+			PageSaveIconRecord icon;
+			icon.type = QString("WebOSApp");
+			icon.id = QString("com.palm.app.test%1_%2").arg(p).arg(i);
+			icon.hasLaunchPoint = true;
+			icon.launchType = 1;
+			icon.launchId = icon.id + QString("_default");
+			page.icons << icon;
+		}
+		r_launcher.pages << page;
+	}
+}
+
+//the equivalent of dragging the first icon of a page to its end
+void TestLauncherPageSaver::reorder(LauncherSaveSnapshot& r_launcher,int pageIndex)
+{
+	QVector<PageSaveIconRecord>& icons = r_launcher.pages[pageIndex].icons;
+	icons.append(icons.first());
+	icons.remove(0);
+	++m_reorderCount;
+}
+
+bool TestLauncherPageSaver::waitForIdle(PageSaveQueue& queue)
+{
+	QTime t;
+	t.start();
+	while ((!queue.isIdle()) && (t.elapsed() < 5000))
+	{
+		QTest::qWait(5);
+	}
+	return queue.isIdle();
+}
+
+QString TestLauncherPageSaver::firstIconIdOnDisk(const PageSaveSnapshot& page)
+{
+	QSettings settings(page.filepath,QSettings::IniFormat);
+	int n = settings.beginReadArray("icons");
+	QString id;
+	if (n > 0)
+	{
+		settings.setArrayIndex(0);
+		id = settings.value("id").toString();
+	}
+	settings.endArray();
+	return id;
+}
+
+void TestLauncherPageSaver::onlyChangedPagesWritten()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+
+	queue.submit(launcher);
+	QVERIFY(waitForIdle(queue));
+	QCOMPARE(queue.numPagesWritten(),(quint32)kNumPages);
+	QVERIFY(QFile::exists(launcher.masterFilepath));
+
+	reorder(launcher,3);
+	queue.submit(launcher);
+	QVERIFY(waitForIdle(queue));
+	QCOMPARE(queue.numPagesWritten(),(quint32)kNumPages+1);
+	QCOMPARE(firstIconIdOnDisk(launcher.pages[3]),launcher.pages[3].icons[0].id);
+
+	//no change at all -> nothing written
+	queue.submit(launcher);
+	QVERIFY(waitForIdle(queue));
+	QCOMPARE(queue.numPagesWritten(),(quint32)kNumPages+1);
+}
+
+void TestLauncherPageSaver::coalescesWhileWriting()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+
+	for (int i=0;i<50;++i)
+	{
+		reorder(launcher,i % kNumPages);
+		queue.submit(launcher);
+	}
+	QVERIFY(waitForIdle(queue));
+	//the first submit goes straight out, everything after it piles up behind it and is written once
+	QVERIFY(queue.numWritesCompleted() <= 2);
+	for (int p=0;p<kNumPages;++p)
+	{
+		QCOMPARE(firstIconIdOnDisk(launcher.pages[p]),launcher.pages[p].icons[0].id);
+	}
+}
+
+void TestLauncherPageSaver::flushWritesLatest()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+
+	queue.submit(launcher);
+	reorder(launcher,0);
+	queue.submit(launcher);
+	QVERIFY(queue.flush());
+	QVERIFY(queue.isIdle());
+	QCOMPARE(firstIconIdOnDisk(launcher.pages[0]),launcher.pages[0].icons[0].id);
+}
+
+// what a reorder used to cost the gui thread: every page and the master file written synchronously
+void TestLauncherPageSaver::benchmarkSynchronousSave()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	QBENCHMARK
+	{
+		reorder(launcher,m_reorderCount % kNumPages);
+		for (QList<PageSaveSnapshot>::const_iterator it = launcher.pages.constBegin();
+				it != launcher.pages.constEnd();++it)
+		{
+			PageSaveQueue::writePageSnapshot(*it);
+		}
+		PageSaveQueue::writeMasterSnapshot(launcher);
+	}
+}
+
+// what it costs the gui thread now: handing the snapshot to the save thread. The writes themselves are waited out
+// after the measurement
+void TestLauncherPageSaver::benchmarkScheduledSave()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+	QBENCHMARK
+	{
+		reorder(launcher,m_reorderCount % kNumPages);
+		queue.submit(launcher);
+	}
+	QVERIFY(waitForIdle(queue));
+	qDebug("pages written: %u , pages skipped as unchanged: %u , background writes: %u",
+			queue.numPagesWritten(),queue.numPagesSkipped(),queue.numWritesCompleted());
+}
+
+void TestLauncherPageSaver::binaryRoundTrip()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	launcher.pages[1].icons[2].hasLaunchPoint = false;
+	launcher.pages[1].icons[2].launchType = 0;
+	launcher.pages[1].icons[2].launchId = QString();
+
+	QString binaryFilepath = LauncherBinarySave::filepathForMaster(launcher.masterFilepath);
+	QVERIFY(LauncherBinarySave::write(launcher,binaryFilepath));
+
+	LauncherSaveSnapshot restored;
+	QVERIFY(LauncherBinarySave::read(binaryFilepath,restored));
+	QCOMPARE(restored.timeStamp,launcher.timeStamp);
+	QCOMPARE(restored.pages.size(),launcher.pages.size());
+	for (int p=0;p<kNumPages;++p)
+	{
+		QVERIFY(restored.pages[p] == launcher.pages[p]);
+	}
+}
+
+void TestLauncherPageSaver::binaryCorruptFallsBackToIni()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+	QVERIFY(queue.flush(&launcher,true));
+
+	QString binaryFilepath = LauncherBinarySave::filepathForMaster(launcher.masterFilepath);
+	QFile file(binaryFilepath);
+	QVERIFY(file.open(QIODevice::ReadWrite));
+	QVERIFY(file.seek(file.size() - 3));
+	QVERIFY(file.write("xyz",3) == 3);
+	file.close();
+
+	LauncherSaveSnapshot restored;
+	QVERIFY(!LauncherBinarySave::read(binaryFilepath,restored));
+	QVERIFY(PageRestore::readLauncherSave(launcher.masterFilepath,restored));
+	QCOMPARE(restored.pages.size(),launcher.pages.size());
+	QCOMPARE(restored.pages[5].icons[7].id,launcher.pages[5].icons[7].id);
+
+	//...and the binary image was rebuilt from the INI files
+	LauncherSaveSnapshot rebuilt;
+	QVERIFY(LauncherBinarySave::read(binaryFilepath,rebuilt));
+	QVERIFY(rebuilt.pages[5] == restored.pages[5]);
+}
+
+// BackupManager puts the INI files back and knows nothing about the binary image
+void TestLauncherPageSaver::binaryStaleAfterIniRestore()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+
+	//the layout in the backup...
+	reorder(launcher,3);
+	QVERIFY(queue.flush(&launcher,true));
+	QString pageFilepath = launcher.pages[3].filepath;
+	QString backupFilepath = pageFilepath + QString(".backup");
+	QFile::remove(backupFilepath);
+	QVERIFY(QFile::copy(pageFilepath,backupFilepath));
+	QString backupFirstId = launcher.pages[3].icons[0].id;
+
+	//...and the one on the device, binary image included
+	reorder(launcher,3);
+	QVERIFY(queue.flush(&launcher,true));
+
+	QVERIFY(QFile::remove(pageFilepath));
+	QVERIFY(QFile::copy(backupFilepath,pageFilepath));
+	QFile::remove(backupFilepath);
+
+	LauncherSaveSnapshot restored;
+	QVERIFY(PageRestore::readLauncherSave(launcher.masterFilepath,restored));
+	QCOMPARE(restored.pages[3].icons[0].id,backupFirstId);
+
+	//the image was rebuilt from the restored files, and is good again
+	quint64 stamp = 0;
+	LauncherSaveSnapshot rebuilt;
+	QString binaryFilepath = LauncherBinarySave::filepathForMaster(launcher.masterFilepath);
+	QVERIFY(LauncherBinarySave::read(binaryFilepath,rebuilt,&stamp));
+	QCOMPARE(stamp,LauncherBinarySave::iniStamp(launcher.masterFilepath,rebuilt.pages));
+	QCOMPARE(rebuilt.pages[3].icons[0].id,backupFirstId);
+}
+
+// 12 pages x 25 icons, INI master + page files, read the way restoreLauncher() does at boot (before app resolution)
+void TestLauncherPageSaver::benchmarkRestoreIni()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+	QVERIFY(queue.flush(&launcher,true));
+
+	LauncherSaveSnapshot restored;
+	QBENCHMARK
+	{
+		PageRestore::readLauncherIni(launcher.masterFilepath,restored);
+	}
+	QCOMPARE(restored.pages.size(),kNumPages);
+}
+
+// ...and the same layout from the binary image
+void TestLauncherPageSaver::benchmarkRestoreBinary()
+{
+	LauncherSaveSnapshot launcher;
+	makeLauncher(launcher);
+	PageSaveQueue queue;
+	QVERIFY(queue.flush(&launcher,true));
+
+	QString binaryFilepath = LauncherBinarySave::filepathForMaster(launcher.masterFilepath);
+	LauncherSaveSnapshot restored;
+	QBENCHMARK
+	{
+		LauncherBinarySave::read(binaryFilepath,restored);
+	}
+	QCOMPARE(restored.pages.size(),kNumPages);
+}
+
+QTEST_MAIN(TestLauncherPageSaver)
+#include "sysmgrtst_LauncherPageSaver.moc"
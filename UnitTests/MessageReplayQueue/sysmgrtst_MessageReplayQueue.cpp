@@ -0,0 +1,212 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <string>
+
+#include "MessageReplayQueue.h"
+
+// keeps count of live instances, so that leaks and double deletes show
+class FakeMessage
+{
+public:
+	FakeMessage(const std::string& name) : m_name(name) { s_live++; }
+	~FakeMessage() { s_live--; }
+
+	std::string m_name;
+	static int s_live;
+};
+
+int FakeMessage::s_live = 0;
+
+typedef MessageReplayQueue<FakeMessage> Queue;
+
+static std::string popName(Queue& queue)
+{
+	FakeMessage* msg = queue.pop();
+	if (!msg)
+		return std::string();
+
+	std::string name = msg->m_name;
+	delete msg;
+	return name;
+}
+
+// -------------------------------------------------------------------------
+
+class TestMessageReplayQueue : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void init();
+	void cleanup();
+
+	void commandsKeepOrder();
+	void inputIsDropped();
+	void lastResizePerWindow();
+	void lastFocusAndProperty();
+	void globalStateFirstAndCollapsed();
+	void boundedWithoutLosingCommands();
+	void startupBurst();
+};
+
+void TestMessageReplayQueue::init()
+{
+	FakeMessage::s_live = 0;
+}
+
+void TestMessageReplayQueue::cleanup()
+{
+	QCOMPARE(FakeMessage::s_live, 0);
+}
+
+void TestMessageReplayQueue::commandsKeepOrder()
+{
+	Queue queue(16);
+	queue.push(new FakeMessage("launch1"), QueuedMessage::Ordered);
+	queue.push(new FakeMessage("copy"), QueuedMessage::BestEffort);
+	queue.push(new FakeMessage("close"), QueuedMessage::Ordered);
+
+	QCOMPARE(popName(queue), std::string("launch1"));
+	QCOMPARE(popName(queue), std::string("copy"));
+	QCOMPARE(popName(queue), std::string("close"));
+	QVERIFY(queue.empty());
+	QVERIFY(!queue.pop());
+}
+
+void TestMessageReplayQueue::inputIsDropped()
+{
+	Queue queue(16);
+	QVERIFY(!queue.push(new FakeMessage("pen"), QueuedMessage::Input));
+	QVERIFY(!queue.push(new FakeMessage("key"), QueuedMessage::Input));
+	QVERIFY(queue.empty());
+	QCOMPARE(queue.numInputDropped(), 2);
+}
+
+void TestMessageReplayQueue::lastResizePerWindow()
+{
+	Queue queue(16);
+	queue.push(new FakeMessage("resize1a"), QueuedMessage::Resize, 1);
+	queue.push(new FakeMessage("resize2a"), QueuedMessage::Resize, 2);
+	queue.push(new FakeMessage("launch"), QueuedMessage::Ordered);
+	queue.push(new FakeMessage("resize1b"), QueuedMessage::Resize, 1);
+	queue.push(new FakeMessage("resize1c"), QueuedMessage::Resize, 1);
+
+	QCOMPARE(queue.size(), 3);
+	QCOMPARE(queue.numCollapsed(), 2);
+	// the surviving resize takes the place of the last one
+	QCOMPARE(popName(queue), std::string("resize2a"));
+	QCOMPARE(popName(queue), std::string("launch"));
+	QCOMPARE(popName(queue), std::string("resize1c"));
+}
+
+void TestMessageReplayQueue::lastFocusAndProperty()
+{
+	Queue queue(16);
+	queue.push(new FakeMessage("focus1a"), QueuedMessage::Focus, 1);
+	queue.push(new FakeMessage("prop7a"), QueuedMessage::Property, 7);
+	queue.push(new FakeMessage("focus2a"), QueuedMessage::Focus, 2);
+	queue.push(new FakeMessage("focus1b"), QueuedMessage::Focus, 1);
+	queue.push(new FakeMessage("prop7b"), QueuedMessage::Property, 7);
+
+	// keys of different kinds don't collapse into each other
+	queue.push(new FakeMessage("resize1"), QueuedMessage::Resize, 1);
+
+	QCOMPARE(queue.size(), 4);
+	QCOMPARE(popName(queue), std::string("focus2a"));
+	QCOMPARE(popName(queue), std::string("focus1b"));
+	QCOMPARE(popName(queue), std::string("prop7b"));
+	QCOMPARE(popName(queue), std::string("resize1"));
+}
+
+void TestMessageReplayQueue::globalStateFirstAndCollapsed()
+{
+	Queue queue(16);
+	queue.push(new FakeMessage("launch"), QueuedMessage::Ordered);
+	queue.push(new FakeMessage("dims1"), QueuedMessage::UiDimensions);
+	queue.push(new FakeMessage("up"), QueuedMessage::Orientation);
+	queue.push(new FakeMessage("dims2"), QueuedMessage::UiDimensions);
+	queue.push(new FakeMessage("left"), QueuedMessage::Orientation);
+
+	QCOMPARE(queue.size(), 3);
+	QCOMPARE(popName(queue), std::string("dims2"));
+	QCOMPARE(popName(queue), std::string("left"));
+	QCOMPARE(popName(queue), std::string("launch"));
+}
+
+void TestMessageReplayQueue::boundedWithoutLosingCommands()
+{
+	Queue queue(4);
+	queue.push(new FakeMessage("launch1"), QueuedMessage::Ordered);
+	for (int i = 0; i < 10; i++)
+		queue.push(new FakeMessage(QString("paste%1").arg(i).toStdString()), QueuedMessage::BestEffort);
+	queue.push(new FakeMessage("close"), QueuedMessage::Ordered);
+
+	QCOMPARE(queue.size(), 4);
+	QCOMPARE(queue.numOverflowed(), 8);
+	QCOMPARE(queue.numOverCapacity(), 0);
+	QCOMPARE(popName(queue), std::string("launch1"));
+	QCOMPARE(popName(queue), std::string("paste8"));
+	QCOMPARE(popName(queue), std::string("paste9"));
+	QCOMPARE(popName(queue), std::string("close"));
+
+	// nothing droppable: over capacity rather than lose a command
+	for (int i = 0; i < 6; i++)
+		queue.push(new FakeMessage("close"), QueuedMessage::Ordered);
+	QCOMPARE(queue.size(), 6);
+	QCOMPARE(queue.numOverCapacity(), 2);
+	queue.clear();
+}
+
+// what piles up while WebAppMgr starts: boot time launches mixed with a rotating, resizing UI
+void TestMessageReplayQueue::startupBurst()
+{
+	Queue queue(256);
+	int pushed = 0;
+	for (int i = 0; i < 200; i++) {
+		if (i % 40 == 0) {
+			queue.push(new FakeMessage("launch"), QueuedMessage::Ordered);
+			pushed++;
+		}
+		queue.push(new FakeMessage("pen"), QueuedMessage::Input);
+		queue.push(new FakeMessage("resize"), QueuedMessage::Resize, i % 3);
+		queue.push(new FakeMessage("orientation"), QueuedMessage::Orientation);
+		queue.push(new FakeMessage("dims"), QueuedMessage::UiDimensions);
+		pushed += 4;
+	}
+
+	// 5 launches, one resize per window, one of each global
+	QCOMPARE(queue.size(), 5 + 3 + 2);
+	QVERIFY(queue.maxDepth() <= 10);
+	qDebug("%d messages pushed, %d to replay", pushed, queue.size());
+
+	int launches = 0;
+	while (!queue.empty()) {
+		if (popName(queue) == "launch")
+			launches++;
+	}
+	QCOMPARE(launches, 5);
+}
+
+QTEST_MAIN(TestMessageReplayQueue)
+#include "sysmgrtst_MessageReplayQueue.moc"
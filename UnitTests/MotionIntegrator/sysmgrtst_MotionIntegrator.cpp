@@ -0,0 +1,166 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+
+#include "motionintegrator.h"
+
+// All times are made up: the integrator only ever sees the elapsed ms it is given.
+
+static const qreal kFriction = 8e-4;
+
+// frames of the given lengths, over and over, until totalMs
+static qreal runFrames(MotionIntegrator& motion, const qreal* frames, int numFrames, qreal totalMs)
+{
+	qreal t = 0;
+	for (int i = 0; t < totalMs; i = (i + 1) % numFrames) {
+		qreal dt = qMin(frames[i], totalMs - t);
+		motion.advance(dt);
+		t += dt;
+	}
+	return motion.position();
+}
+
+// -------------------------------------------------------------------------
+
+class TestMotionIntegrator : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void frictionClosedForm();
+	void frameIndependent();
+	void springBack();
+	void overshootBounded();
+	void settlesFromRest();
+};
+
+void TestMotionIntegrator::frictionClosedForm()
+{
+	MotionIntegrator motion;
+	motion.setFriction(kFriction);
+	motion.start(100, 1.6);
+
+	// 1.6 px/ms stops after 2000ms and 1600px
+	QCOMPARE(MotionIntegrator::frictionTime(1.6, kFriction), (qreal) 2000);
+	QVERIFY(qAbs(MotionIntegrator::frictionDistance(1.6, kFriction) - 1600) < 1e-6);
+
+	motion.advance(1000);
+	QVERIFY(qAbs(motion.position() - (100 + 1600 - 400)) < 1e-6);
+	QVERIFY(qAbs(motion.velocity() - 0.8) < 1e-9);
+
+	QVERIFY(!motion.advance(1004));
+	QVERIFY(!motion.moving());
+	QVERIFY(qAbs(motion.position() - 1700) < 1e-6);
+
+	// the other way
+	motion.start(0, -1.6);
+	motion.advance(5000);
+	QVERIFY(qAbs(motion.position() + 1600) < 1e-6);
+}
+
+void TestMotionIntegrator::frameIndependent()
+{
+	const qreal steady[] = { 16.67 };
+	const qreal jittery[] = { 16, 33, 9, 17, 50, 1, 24 };
+
+	MotionIntegrator a, b;
+	a.setBounds(0, 500);
+	b.setBounds(0, 500);
+	a.start(300, 2.0);
+	b.start(300, 2.0);
+
+	// through the bound, into the spring, and back
+	for (qreal t = 100; t <= 1500; t += 100) {
+		MotionIntegrator x = a, y = b;
+		qreal p = runFrames(x, steady, 1, t);
+		qreal q = runFrames(y, jittery, 7, t);
+		QVERIFY2(qAbs(p - q) < 1e-6, qPrintable(QString("at %1ms: %2 vs %3").arg(t).arg(p).arg(q)));
+	}
+
+	// one huge frame, as after a stall, lands in the same place too
+	MotionIntegrator x = a, y = a;
+	runFrames(x, steady, 1, 700);
+	y.advance(700);
+	QVERIFY(qAbs(x.position() - y.position()) < 1e-6);
+}
+
+void TestMotionIntegrator::springBack()
+{
+	MotionIntegrator motion;
+	motion.setBounds(0, 500);
+	motion.setSpring(0.015);
+	motion.start(560, 0);
+
+	qreal last = 560;
+	while (motion.advance(16)) {
+		// critically damped: straight back, never past the bound
+		QVERIFY(motion.position() <= last);
+		QVERIFY(motion.position() >= 500);
+		last = motion.position();
+	}
+	QCOMPARE(motion.position(), (qreal) 500);
+	QCOMPARE(motion.velocity(), (qreal) 0);
+}
+
+void TestMotionIntegrator::overshootBounded()
+{
+	const qreal maxOvershoot = 40;
+	const qreal v0 = 3.0;
+
+	MotionIntegrator motion;
+	motion.setFriction(0);
+	motion.setBounds(0, 500);
+	motion.setSpring(MotionIntegrator::springForOvershoot(v0, maxOvershoot));
+	motion.start(500, v0);
+
+	qreal furthest = 500;
+	while (motion.advance(1))
+		furthest = qMax(furthest, motion.position());
+
+	QVERIFY(furthest > 500 + maxOvershoot * 0.9);
+	QVERIFY(furthest <= 500 + maxOvershoot + 1e-6);
+	QCOMPARE(motion.position(), (qreal) 500);
+}
+
+void TestMotionIntegrator::settlesFromRest()
+{
+	MotionIntegrator motion;
+	motion.setBounds(0, 500);
+	motion.start(-100, 0);
+
+	// 7 / omega
+	motion.advance(350);
+	QVERIFY(motion.position() > -5);
+	motion.advance(500);
+	QVERIFY(!motion.moving());
+	QCOMPARE(motion.position(), (qreal) 0);
+
+	// at rest within bounds: nothing to do
+	motion.start(250, 0);
+	QVERIFY(!motion.advance(16));
+	QCOMPARE(motion.position(), (qreal) 250);
+}
+
+QTEST_MAIN(TestMotionIntegrator)
+#include "sysmgrtst_MotionIntegrator.moc"
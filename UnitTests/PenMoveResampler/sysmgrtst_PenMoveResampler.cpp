@@ -0,0 +1,343 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "PenMoveResampler.h"
+
+// A pen trace, as recorded from the touch panel: one sample per line, "time x y",
+// with the time in ms. Set SYSMGR_PEN_TRACE to a file of those to replay it as well
+// as the synthetic traces below.
+
+struct TraceSample
+{
+	uint32_t	time;
+	int			x;
+	int			y;
+};
+
+typedef std::vector<TraceSample> Trace;
+
+static const int kFramesPerSecond = 60;
+
+static Trace circleTrace(int sampleMs, int durationMs)
+{
+	Trace trace;
+	for (int t = 0; t <= durationMs; t += sampleMs) {
+		double a = t * 2 * M_PI / 1000.0;		// once around per second
+		TraceSample s = { (uint32_t) (1000 + t), 240 + (int) (200 * cos(a)), 400 + (int) (200 * sin(a)) };
+		trace.push_back(s);
+	}
+	return trace;
+}
+
+// a flick: speeds up, then slows down and stops
+static Trace flickTrace(int sampleMs)
+{
+	Trace trace;
+	for (int t = 0; t <= 300; t += sampleMs) {
+		double x = t < 150 ? 0.02 * t * t : 450 + 6.0 * (t - 150) - 0.02 * (t - 150) * (t - 150);
+		TraceSample s = { (uint32_t) (1000 + t), 20 + (int) x, 300 };
+		trace.push_back(s);
+	}
+	return trace;
+}
+
+static bool readTrace(const char* path, Trace& trace)
+{
+	FILE* f = fopen(path, "r");
+	if (!f)
+		return false;
+
+	TraceSample s;
+	unsigned int time;
+	while (fscanf(f, "%u %d %d", &time, &s.x, &s.y) == 3) {
+		s.time = time;
+		trace.push_back(s);
+	}
+	fclose(f);
+	return trace.size() > 1;
+}
+
+// where the pen really was, between the samples
+static void truePosition(const Trace& trace, uint32_t time, double* x, double* y)
+{
+	size_t i = 1;
+	while (i + 1 < trace.size() && trace[i].time < time)
+		i++;
+
+	const TraceSample& a = trace[i - 1];
+	const TraceSample& b = trace[i];
+	double f = (double) ((int) (time - a.time)) / (double) (b.time - a.time);
+	f = qBound(0.0, f, 1.0);
+	*x = a.x + (b.x - a.x) * f;
+	*y = a.y + (b.y - a.y) * f;
+}
+
+struct ReplayResult
+{
+	int		frames;
+	double	latencyMs;		// from the sample shown to the frame it is shown in, on average
+	double	meanError;		// from where the pen really is at the frame, in pixels
+	double	maxError;
+};
+
+// Plays the trace to a display running at kFramesPerSecond, the way WebAppMgrProxy sends it:
+// each frame shows the last sample in before its deadline, or, resampled, the
+// position resample() gives for the deadline.
+static ReplayResult replay(const Trace& trace, bool resampled)
+{
+	ReplayResult result = { 0, 0, 0, 0 };
+	PenMoveResampler resampler;
+
+	size_t next = 0;
+	double shownX = trace[0].x, shownY = trace[0].y;
+	uint32_t shownTime = trace[0].time;
+	for (int n = 1; ; n++) {
+		uint32_t frame = trace[0].time + n * 1000 / kFramesPerSecond;
+		if ((int) (frame - trace.back().time) > 0)
+			break;
+
+		while (next < trace.size() && (int) (trace[next].time - frame) <= 0) {
+			const TraceSample& s = trace[next++];
+			resampler.addSample(s.x, s.y, s.time);
+			if (!resampled) {
+				shownX = s.x;
+				shownY = s.y;
+				shownTime = s.time;
+			}
+		}
+
+		if (resampled) {
+			int x, y;
+			if (resampler.resample(frame, &x, &y)) {
+				shownX = x;
+				shownY = y;
+			}
+			// the newest sample, and up to kMaxPredictMs past it
+			const TraceSample& newest = trace[next - 1];
+			shownTime = newest.time + MIN((int) (frame - newest.time), PenMoveResampler::kMaxPredictMs);
+		}
+
+		double x, y;
+		truePosition(trace, frame, &x, &y);
+		double error = sqrt((shownX - x) * (shownX - x) + (shownY - y) * (shownY - y));
+
+		result.frames++;
+		result.latencyMs += (int) (frame - shownTime);
+		result.meanError += error;
+		result.maxError = qMax(result.maxError, error);
+	}
+
+	if (result.frames) {
+		result.latencyMs /= result.frames;
+		result.meanError /= result.frames;
+	}
+	return result;
+}
+
+static void report(const char* name, const Trace& trace, ReplayResult* legacy, ReplayResult* resampled)
+{
+	*legacy = replay(trace, false);
+	*resampled = replay(trace, true);
+
+	qDebug("%s: %d frames, latest sample / resampled: latency %.1f / %.1f ms, "
+		   "error %.1f / %.1f px (max %.1f / %.1f)", name, legacy->frames,
+		   legacy->latencyMs, resampled->latencyMs, legacy->meanError, resampled->meanError,
+		   legacy->maxError, resampled->maxError);
+}
+
+// -------------------------------------------------------------------------
+
+class TestPenMoveResampler : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void interpolates();
+	void predictsVelocity();
+	void predictsAcceleration();
+	void oncePerDeadline();
+	void stationary();
+	void clockReset();
+
+	void replaySynthetic();
+	void replayRecorded();
+};
+
+void TestPenMoveResampler::interpolates()
+{
+	PenMoveResampler r;
+	r.addSample(0, 0, 1000);
+	r.addSample(80, 40, 1008);
+	r.addSample(80, 80, 1016);
+
+	int x, y;
+	QVERIFY(r.resample(1004, &x, &y));
+	QCOMPARE(x, 40);
+	QCOMPARE(y, 20);
+
+	QVERIFY(r.resample(1012, &x, &y));
+	QCOMPARE(x, 80);
+	QCOMPARE(y, 60);
+
+	// older than all of them: the oldest
+	QVERIFY(r.resample(990, &x, &y));
+	QCOMPARE(x, 0);
+	QCOMPARE(y, 0);
+}
+
+void TestPenMoveResampler::predictsVelocity()
+{
+	// 1 px/ms to the right, 0.5 px/ms down
+	PenMoveResampler r;
+	for (int t = 0; t <= 40; t += 8)
+		r.addSample(100 + t, 200 + t / 2, 1000 + t);
+
+	float vx, vy, ax, ay;
+	r.estimate(&vx, &vy, &ax, &ay);
+	QVERIFY(qAbs(vx - 1000) < 1);
+	QVERIFY(qAbs(vy - 500) < 1);
+	QVERIFY(qAbs(ax) < 1 && qAbs(ay) < 1);
+
+	int x, y;
+	QVERIFY(r.resample(1050, &x, &y));
+	QCOMPARE(x, 150);
+	QCOMPARE(y, 225);
+
+	// no further ahead than kMaxPredictMs
+	QVERIFY(r.resample(1080, &x, &y));
+	QCOMPARE(x, 140 + PenMoveResampler::kMaxPredictMs);
+
+	// long after the last sample, the pen has stopped
+	QVERIFY(r.resample(1040 + PenMoveResampler::kFitWindowMs + 1, &x, &y));
+	QCOMPARE(x, 140);
+	QCOMPARE(y, 220);
+}
+
+void TestPenMoveResampler::predictsAcceleration()
+{
+	// x = t^2 / 100: 0.02 px/ms^2, at 0.8 px/ms by the end
+	PenMoveResampler r;
+	for (int t = 0; t <= 40; t += 4)
+		r.addSample(t * t / 100, 0, 1000 + t);
+
+	float vx, vy, ax, ay;
+	r.estimate(&vx, &vy, &ax, &ay);
+	QVERIFY(qAbs(vx - 800) < 150);
+	QVERIFY(ax > 10000);
+
+	// the true position at 1056 is 31, a straight line would say 28
+	int x, y;
+	QVERIFY(r.resample(1056, &x, &y));
+	QVERIFY(qAbs(x - 31) <= 1);
+}
+
+void TestPenMoveResampler::oncePerDeadline()
+{
+	PenMoveResampler r;
+	r.addSample(0, 0, 1000);
+	r.addSample(10, 0, 1008);
+
+	int x, y;
+	QVERIFY(r.resample(1016, &x, &y));
+	r.addSample(20, 0, 1016);
+	QVERIFY(!r.resample(1016, &x, &y));
+
+	QVERIFY(r.resample(1032, &x, &y));
+}
+
+void TestPenMoveResampler::stationary()
+{
+	PenMoveResampler r;
+	for (int t = 0; t <= 40; t += 8)
+		r.addSample(50, 60, 1000 + t);
+
+	int x, y;
+	QVERIFY(r.resample(1048, &x, &y));
+	QCOMPARE(x, 50);
+	QCOMPARE(y, 60);
+
+	// nothing moved, nothing to send
+	r.addSample(50, 60, 1056);
+	QVERIFY(!r.resample(1064, &x, &y));
+	QVERIFY(!r.resample(1080, &x, &y));
+}
+
+void TestPenMoveResampler::clockReset()
+{
+	PenMoveResampler r;
+	r.addSample(0, 0, 5000);
+	r.addSample(10, 0, 5008);
+	r.addSample(10, 10, 5008);
+	QCOMPARE(r.numSamples(), 2);
+
+	r.addSample(30, 30, 100);
+	QCOMPARE(r.numSamples(), 1);
+
+	for (int i = 0; i < 2 * PenMoveResampler::kMaxSamples; i++)
+		r.addSample(i, i, 200 + i);
+	QCOMPARE(r.numSamples(), (int) PenMoveResampler::kMaxSamples);
+
+	r.reset();
+	int x, y;
+	QCOMPARE(r.numSamples(), 0);
+	QVERIFY(!r.resample(300, &x, &y));
+}
+
+void TestPenMoveResampler::replaySynthetic()
+{
+	ReplayResult legacy, resampled;
+
+	// a panel reporting at 125Hz and at 90Hz, against a 60Hz display
+	report("circle, 8ms", circleTrace(8, 2000), &legacy, &resampled);
+	QVERIFY(resampled.latencyMs < legacy.latencyMs);
+	QVERIFY(resampled.meanError < legacy.meanError);
+
+	report("circle, 11ms", circleTrace(11, 2000), &legacy, &resampled);
+	QVERIFY(resampled.latencyMs < legacy.latencyMs);
+	QVERIFY(resampled.meanError < legacy.meanError);
+
+	report("flick, 8ms", flickTrace(8), &legacy, &resampled);
+	QVERIFY(resampled.meanError < legacy.meanError);
+}
+
+void TestPenMoveResampler::replayRecorded()
+{
+	const char* path = getenv("SYSMGR_PEN_TRACE");
+	if (!path)
+		QSKIP("SYSMGR_PEN_TRACE not set", SkipSingle);
+
+	Trace trace;
+	QVERIFY2(readTrace(path, trace), path);
+
+	ReplayResult legacy, resampled;
+	report(path, trace, &legacy, &resampled);
+}
+
+QTEST_MAIN(TestPenMoveResampler)
+#include "sysmgrtst_PenMoveResampler.moc"
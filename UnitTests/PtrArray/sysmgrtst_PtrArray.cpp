@@ -0,0 +1,310 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <stdlib.h>
+#include <vector>
+
+#include "PtrArray.h"
+
+struct Item
+{
+	int id;
+};
+
+// What PtrArray did when it was a GPtrArray, written out plainly: the model the
+// property tests hold the indexed PtrArray to, and the baseline of the benchmarks
+class LinearPtrArray
+{
+public:
+
+	void append(Item* t) { m_items.push_back(t); }
+
+	bool remove(Item* t) {
+		for (size_t i = 0; i < m_items.size(); i++) {
+			if (m_items[i] == t) {
+				m_items.erase(m_items.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void addAfter(Item* t, Item* newT) { addNextTo(t, newT, true); }
+	void addBefore(Item* t, Item* newT) { addNextTo(t, newT, false); }
+
+	int size() const { return m_items.size(); }
+	bool empty() const { return m_items.empty(); }
+	void clear() { m_items.clear(); }
+	Item* operator[](int i) const { return m_items[i]; }
+
+	int position(Item* t) const {
+		for (size_t i = 0; i < m_items.size(); i++) {
+			if (m_items[i] == t)
+				return i;
+		}
+		return -1;
+	}
+
+	bool contains(Item* t) const { return position(t) >= 0; }
+
+private:
+
+	// the whole array rebuilt, newT next to every t
+	void addNextTo(Item* t, Item* newT, bool after) {
+		if (empty() || !contains(t)) {
+			append(newT);
+			return;
+		}
+
+		std::vector<Item*> old;
+		old.swap(m_items);
+		for (size_t i = 0; i < old.size(); i++) {
+			if (!after && old[i] == t)
+				m_items.push_back(newT);
+			m_items.push_back(old[i]);
+			if (after && old[i] == t)
+				m_items.push_back(newT);
+		}
+	}
+
+	std::vector<Item*> m_items;
+};
+
+static const int kPoolSize = 12;
+
+static bool sameAs(const PtrArray<Item>& array, const LinearPtrArray& model, Item* pool)
+{
+	if (array.size() != model.size() || array.empty() != model.empty())
+		return false;
+
+	for (int i = 0; i < model.size(); i++) {
+		if (array[i] != model[i])
+			return false;
+	}
+
+	if (array.first() != (model.empty() ? 0 : model[0])
+		|| array.last() != (model.empty() ? 0 : model[model.size() - 1]))
+		return false;
+
+	for (int i = 0; i < kPoolSize; i++) {
+		if (array.position(&pool[i]) != model.position(&pool[i])
+			|| array.contains(&pool[i]) != model.contains(&pool[i]))
+			return false;
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------
+
+class TestPtrArray : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void basics();
+	void duplicates();
+	void copies();
+	void randomOperations();
+
+	void benchmarkFocusChangesLinear();
+	void benchmarkFocusChangesIndexed();
+};
+
+void TestPtrArray::basics()
+{
+	Item items[4];
+	PtrArray<Item> array;
+
+	QVERIFY(array.empty());
+	QCOMPARE(array.first(), (Item*) 0);
+	QCOMPARE(array.position(&items[0]), -1);
+
+	array.addAfter(&items[0], &items[1]);		// not there: appended
+	array.addBefore(&items[1], &items[0]);
+	array.addAfter(&items[1], &items[3]);
+	array.addBefore(&items[3], &items[2]);
+	QCOMPARE(array.size(), 4);
+	for (int i = 0; i < 4; i++) {
+		QCOMPARE(array[i], &items[i]);
+		QCOMPARE(array.position(&items[i]), i);
+	}
+
+	QVERIFY(array.remove(&items[1]));
+	QVERIFY(!array.remove(&items[1]));
+	QVERIFY(!array.contains(&items[1]));
+	QCOMPARE(array.position(&items[2]), 1);
+	QCOMPARE(array.last(), &items[3]);
+
+	array.clear();
+	QVERIFY(array.empty());
+	QVERIFY(!array.contains(&items[0]));
+}
+
+void TestPtrArray::duplicates()
+{
+	Item items[3];
+	PtrArray<Item> array;
+
+	array.append(&items[0]);
+	array.append(&items[1]);
+	array.append(&items[0]);
+
+	// next to every occurrence, as before
+	array.addAfter(&items[0], &items[2]);
+	QCOMPARE(array.size(), 5);
+	QCOMPARE(array[1], &items[2]);
+	QCOMPARE(array[4], &items[2]);
+
+	// the first occurrence goes
+	QVERIFY(array.remove(&items[0]));
+	QCOMPARE(array.position(&items[0]), 2);
+	QVERIFY(array.remove(&items[0]));
+	QVERIFY(!array.contains(&items[0]));
+
+	// next to itself
+	array.addBefore(&items[1], &items[1]);
+	QCOMPARE(array.size(), 4);
+	QCOMPARE(array.position(&items[1]), 1);
+	QCOMPARE(array[2], &items[1]);
+}
+
+void TestPtrArray::copies()
+{
+	Item items[3];
+	PtrArray<Item> array;
+	for (int i = 0; i < 3; i++)
+		array.append(&items[i]);
+
+	PtrArray<Item> copy(array);
+	copy.remove(&items[0]);
+	QCOMPARE(array.size(), 3);
+	QCOMPARE(copy.position(&items[2]), 1);
+
+	array = copy;
+	QCOMPARE(array.size(), 2);
+	QVERIFY(!array.contains(&items[0]));
+	QCOMPARE(array.position(&items[1]), 0);
+}
+
+// random operations on a small pool of items, so that there are plenty of
+// duplicates and misses, checked against the old behaviour after every one
+void TestPtrArray::randomOperations()
+{
+	Item pool[kPoolSize];
+	for (int i = 0; i < kPoolSize; i++)
+		pool[i].id = i;
+
+	for (unsigned int seed = 1; seed <= 200; seed++) {
+		srand(seed);
+		PtrArray<Item> array;
+		LinearPtrArray model;
+
+		for (int op = 0; op < 300; op++) {
+			Item* t = &pool[rand() % kPoolSize];
+			Item* newT = &pool[rand() % kPoolSize];
+
+			switch (rand() % 16) {
+			case 0: case 1: case 2: case 3:
+				array.append(t);
+				model.append(t);
+				break;
+			case 4: case 5: case 6: case 7:
+				QCOMPARE(array.remove(t), model.remove(t));
+				break;
+			case 8: case 9: case 10:
+				array.addAfter(t, newT);
+				model.addAfter(t, newT);
+				break;
+			case 11: case 12: case 13:
+				array.addBefore(t, newT);
+				model.addBefore(t, newT);
+				break;
+			case 14: {
+				// through a copy now and then
+				PtrArray<Item> copy(array);
+				array = copy;
+				break;
+			}
+			default:
+				if (rand() % 8 == 0) {
+					array.clear();
+					model.clear();
+				}
+				break;
+			}
+
+			// the array must not blow up either
+			if (model.size() > 64) {
+				array.clear();
+				model.clear();
+			}
+
+			QVERIFY2(sameAs(array, model, pool), qPrintable(QString("seed %1, op %2").arg(seed).arg(op)));
+		}
+	}
+}
+
+// what the dock mode window manager does on a focus change: find the window, move it
+// to the front, and look up where the others are
+template<class Array>
+static void focusChanges(Array& array, Item* items, int count, int rounds)
+{
+	for (int r = 0; r < rounds; r++) {
+		Item* focused = &items[(r * 7) % count];
+		if (array.contains(focused)) {
+			array.remove(focused);
+			array.addBefore(array[0], focused);
+		}
+		for (int i = 0; i < 4; i++)
+			array.position(&items[(r * 13 + i * 5) % count]);
+	}
+}
+
+static const int kBenchItems = 256;
+
+void TestPtrArray::benchmarkFocusChangesLinear()
+{
+	std::vector<Item> items(kBenchItems);
+	LinearPtrArray array;
+	for (int i = 0; i < kBenchItems; i++)
+		array.append(&items[i]);
+
+	QBENCHMARK {
+		focusChanges(array, &items[0], kBenchItems, 100);
+	}
+}
+
+void TestPtrArray::benchmarkFocusChangesIndexed()
+{
+	std::vector<Item> items(kBenchItems);
+	PtrArray<Item> array;
+	for (int i = 0; i < kBenchItems; i++)
+		array.append(&items[i]);
+
+	QBENCHMARK {
+		focusChanges(array, &items[0], kBenchItems, 100);
+	}
+}
+
+QTEST_MAIN(TestPtrArray)
+#include "sysmgrtst_PtrArray.moc"
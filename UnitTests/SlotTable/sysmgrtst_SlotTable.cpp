@@ -0,0 +1,122 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include "SlotTable.h"
+
+class TestSlotTable : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void insertAndRemove();
+	void staleHandles();
+	void clear();
+	void iterate();
+};
+
+void TestSlotTable::insertAndRemove()
+{
+	SlotTable<int> table;
+	int a = 1, b = 2;
+
+	SlotHandle ha = table.insert(&a);
+	SlotHandle hb = table.insert(&b);
+	QVERIFY(ha != SlotTable<int>::kInvalidHandle);
+	QVERIFY(ha != hb);
+	QCOMPARE(table.get(ha), &a);
+	QCOMPARE(table.get(hb), &b);
+	QCOMPARE(table.size(), 2);
+
+	QVERIFY(table.remove(ha));
+	QVERIFY(!table.remove(ha));
+	QCOMPARE(table.size(), 1);
+	QVERIFY(!table.get(SlotTable<int>::kInvalidHandle));
+}
+
+void TestSlotTable::staleHandles()
+{
+	SlotTable<int> table;
+	int a = 1, b = 2;
+
+	SlotHandle old = table.insert(&a);
+	table.remove(old);
+
+	// the slot is reused, and the same pointer goes in again: the old handle stays dead
+	SlotHandle reused = table.insert(&a);
+	QCOMPARE(reused & 0xffff, old & 0xffff);
+	QVERIFY(reused != old);
+	QVERIFY(!table.get(old));
+	QVERIFY(!table.contains(old));
+	QCOMPARE(table.get(reused), &a);
+
+	// generations wrap around without ever making the invalid handle
+	for (int i = 0; i < 3 * 0x10000; i++) {
+		SlotHandle h = table.insert(&b);
+		QVERIFY(h != SlotTable<int>::kInvalidHandle);
+		table.remove(h);
+	}
+	QCOMPARE(table.capacity(), 2);
+	QCOMPARE(table.get(reused), &a);
+}
+
+void TestSlotTable::clear()
+{
+	SlotTable<int> table;
+	int a = 1;
+
+	SlotHandle h = table.insert(&a);
+	table.clear();
+	QVERIFY(table.empty());
+	QVERIFY(!table.get(h));
+
+	QVERIFY(table.insert(&a) != h);
+}
+
+void TestSlotTable::iterate()
+{
+	SlotTable<int> table;
+	int values[5] = { 0, 1, 2, 3, 4 };
+	SlotHandle handles[5];
+	for (int i = 0; i < 5; i++)
+		handles[i] = table.insert(&values[i]);
+
+	table.remove(handles[1]);
+	table.remove(handles[3]);
+
+	int sum = 0, count = 0;
+	for (int i = 0; i < table.capacity(); i++) {
+		if (int* v = table.at(i)) {
+			QCOMPARE(table.get(table.handleAt(i)), v);
+			sum += *v;
+			count++;
+		}
+		else {
+			QCOMPARE(table.handleAt(i), SlotTable<int>::kInvalidHandle);
+		}
+	}
+	QCOMPARE(count, 3);
+	QCOMPARE(sum, 0 + 2 + 4);
+}
+
+QTEST_MAIN(TestSlotTable)
+#include "sysmgrtst_SlotTable.moc"
@@ -0,0 +1,150 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <string>
+#include <vector>
+#include <cjson/json.h>
+
+#include "SoundFeedbackChannel.h"
+
+// stands in for com.palm.audio: just remembers what it was asked to play
+class FakeAudioService : public SoundFeedbackSink
+{
+public:
+	virtual bool sendFeedback(const std::string& payload)
+	{
+		m_calls.push_back(payload);
+		return true;
+	}
+
+	std::vector<std::string> m_calls;
+};
+
+static const guint32 kWindowMs = 15;
+
+// -------------------------------------------------------------------------
+
+class TestSoundFeedback : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void payloadMatchesRequest();
+	void coalescesBurst();
+	void differentNamesNotCoalesced();
+	void sinkIsPluggable();
+	void benchmarkPerCallJson();
+	void benchmarkChannel();
+};
+
+void TestSoundFeedback::payloadMatchesRequest()
+{
+	FakeAudioService audio;
+	SoundFeedbackChannel channel(&audio, kWindowMs);
+
+	QVERIFY(channel.post("key", std::string(), 1000));
+	QVERIFY(channel.post("key", "alerts", 1000));
+	QCOMPARE((int)audio.m_calls.size(), 2);
+
+	json_object* json = json_tokener_parse(audio.m_calls[1].c_str());
+	QVERIFY(json && !is_error(json));
+	QCOMPARE(QString(json_object_get_string(json_object_object_get(json, "name"))), QString("key"));
+	QCOMPARE(QString(json_object_get_string(json_object_object_get(json, "sink"))), QString("alerts"));
+	json_object_put(json);
+
+	QCOMPARE(audio.m_calls[0], SoundFeedbackChannel::buildPayload("key", std::string()));
+}
+
+void TestSoundFeedback::coalescesBurst()
+{
+	FakeAudioService audio;
+	SoundFeedbackChannel channel(&audio, kWindowMs);
+
+	// a burst of identical clicks, all within the window of the first one
+	QVERIFY(channel.post("key", std::string(), 1000));
+	QVERIFY(!channel.post("key", std::string(), 1003));
+	QVERIFY(!channel.post("key", std::string(), 1007));
+	QVERIFY(!channel.post("key", std::string(), 1014));
+	QCOMPARE((int)audio.m_calls.size(), 1);
+
+	// normal typing speed: every one of these is played
+	QVERIFY(channel.post("key", std::string(), 1100));
+	QVERIFY(channel.post("key", std::string(), 1200));
+	QCOMPARE((int)audio.m_calls.size(), 3);
+	QCOMPARE(channel.numCoalesced(), (guint32)3);
+	QCOMPARE(channel.numPayloads(), (guint32)1);
+}
+
+void TestSoundFeedback::differentNamesNotCoalesced()
+{
+	FakeAudioService audio;
+	SoundFeedbackChannel channel(&audio, kWindowMs);
+
+	QVERIFY(channel.post("key", std::string(), 1000));
+	QVERIFY(channel.post("space", std::string(), 1001));
+	QVERIFY(channel.post("key", "alerts", 1002));
+	QCOMPARE((int)audio.m_calls.size(), 3);
+}
+
+void TestSoundFeedback::sinkIsPluggable()
+{
+	FakeAudioService first;
+	FakeAudioService second;
+	SoundFeedbackChannel channel(&first, kWindowMs);
+
+	channel.post("key", std::string(), 1000);
+	channel.setSink(&second);
+	channel.post("key", std::string(), 2000);
+	QCOMPARE((int)first.m_calls.size(), 1);
+	QCOMPARE((int)second.m_calls.size(), 1);
+}
+
+// what each keypress used to cost before the call went out: build and serialize the request
+void TestSoundFeedback::benchmarkPerCallJson()
+{
+	FakeAudioService audio;
+	audio.m_calls.reserve(1 << 20);
+	QBENCHMARK {
+		json_object* json = json_object_new_object();
+		json_object_object_add(json, "name", json_object_new_string("key"));
+		audio.sendFeedback(json_object_to_json_string(json));
+		json_object_put(json);
+	}
+}
+
+// ...and through the channel, with keypresses spaced out far enough that every one of them is sent
+void TestSoundFeedback::benchmarkChannel()
+{
+	FakeAudioService audio;
+	audio.m_calls.reserve(1 << 20);
+	SoundFeedbackChannel channel(&audio, kWindowMs);
+	guint64 now = 1000;
+	QBENCHMARK {
+		channel.post("key", std::string(), now);
+		now += 50;
+	}
+	QCOMPARE(channel.numCoalesced(), (guint32)0);
+}
+
+QTEST_MAIN(TestSoundFeedback)
+#include "sysmgrtst_SoundFeedback.moc"
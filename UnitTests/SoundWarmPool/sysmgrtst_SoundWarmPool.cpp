@@ -0,0 +1,286 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <string>
+#include <algorithm>
+
+#include "SoundWarmPool.h"
+
+// stands in for the media server: a virtual clock, and fixed costs for each step of a playback
+class FakeMediaService
+{
+public:
+	FakeMediaService() : m_now(0), m_connectMs(180), m_loadMs(60), m_startMs(15) {}
+
+	guint64 m_now;
+	guint64 m_connectMs;	// bus registration + media session setup
+	guint64 m_loadMs;		// loading a sound
+	guint64 m_startMs;		// from play to the first position update
+};
+
+class FakePlayer : public RefCounted
+{
+public:
+	FakePlayer(FakeMediaService* service)
+		: m_service(service), m_warm(false), m_dead(false), m_connectedAt(0), m_loadedAt(0) {}
+
+	void warmUp(const std::string& streamClass, const std::string& preloadPath)
+	{
+		m_warm = true;
+		m_streamClass = streamClass;
+		m_preloadPath = preloadPath;
+		m_connectedAt = m_service->m_now + m_service->m_connectMs;
+		m_loadedAt = m_connectedAt + (preloadPath.empty() ? 0 : m_service->m_loadMs);
+	}
+
+	// latency from now to the first position update
+	guint64 play(const std::string& filePath)
+	{
+		guint64 now = m_service->m_now;
+		guint64 start;
+		if (!m_warm)
+			start = now + m_service->m_connectMs + m_service->m_loadMs;
+		else if (preloadedPath() == filePath)
+			start = std::max(now, m_loadedAt);
+		else
+			start = std::max(now, m_connectedAt) + m_service->m_loadMs;
+
+		// like SoundPlayer, only skips the load when the preload went out
+		m_loadedPath = (m_warm && preloadedPath() == filePath) ? preloadedPath() : filePath;
+		m_warm = false;
+		return start + m_service->m_startMs - now;
+	}
+
+	bool dead() const { return m_dead; }
+	bool warm() const { return m_warm && m_service->m_now >= m_connectedAt; }
+	const std::string& warmStreamClass() const { return m_streamClass; }
+	// the preload goes out once connected
+	const std::string& preloadedPath() const {
+		static const std::string s_none;
+		return m_service->m_now >= m_connectedAt ? m_preloadPath : s_none;
+	}
+
+	FakeMediaService* m_service;
+	bool m_warm;
+	bool m_dead;
+	std::string m_streamClass;
+	std::string m_preloadPath;
+	std::string m_loadedPath;	// what the media service plays
+	guint64 m_connectedAt;
+	guint64 m_loadedAt;
+};
+
+class FakePlayerFactory : public SoundWarmPool<FakePlayer>::Factory
+{
+public:
+	FakePlayerFactory(FakeMediaService* service) : m_service(service) {}
+
+	virtual sptr<FakePlayer> createWarmPlayer(const std::string& streamClass, const std::string& preloadPath)
+	{
+		m_last = sptr<FakePlayer>(new FakePlayer(m_service));
+		m_last->warmUp(streamClass, preloadPath);
+		return m_last;
+	}
+
+	FakeMediaService* m_service;
+	sptr<FakePlayer> m_last;
+};
+
+static const std::string kTone("/media/internal/ringtones/tone.mp3");
+static const std::string kOtherTone("/media/internal/ringtones/other.mp3");
+
+// -------------------------------------------------------------------------
+
+class TestSoundWarmPool : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void replenishRespectsTargetAndBudget();
+	void takePrefersPreloaded();
+	void deadPlayersReplaced();
+	void preloadChangeDropsStalePlayers();
+	void playWhileConnecting();
+	void warmPlayersStartSooner();
+};
+
+void TestSoundWarmPool::replenishRespectsTargetAndBudget()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+
+	pool.setTarget("notifications", 2);
+	pool.setTarget("alerts", 1);
+	QVERIFY(pool.needsPlayers());
+
+	QCOMPARE(pool.replenish(2), 2);
+	QCOMPARE(pool.size(), 2);
+	QCOMPARE(pool.replenish(5), 1);
+	QCOMPARE(pool.size("notifications"), 2);
+	QCOMPARE(pool.size("alerts"), 1);
+	QVERIFY(!pool.needsPlayers());
+
+	// already full
+	QCOMPARE(pool.replenish(5), 0);
+
+	pool.setTarget("notifications", 1);
+	QCOMPARE(pool.size("notifications"), 1);
+	QCOMPARE(pool.numCreated(), (guint32)3);
+}
+
+void TestSoundWarmPool::takePrefersPreloaded()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+
+	pool.setTarget("notifications", 2);
+	pool.replenish(1);
+	pool.setTarget("alerts", 1);
+	pool.setPreload("notifications", kTone);
+	pool.replenish(2);
+
+	// nothing connected yet: still better than nothing
+	sptr<FakePlayer> connecting = pool.take("alerts", kTone);
+	QVERIFY(connecting.get());
+	QVERIFY(!connecting->warm());
+
+	media.m_now += 1000;
+	sptr<FakePlayer> player = pool.take("notifications", kTone);
+	QVERIFY(player.get());
+	QCOMPARE(player->preloadedPath(), kTone);
+
+	// no player for that class
+	QVERIFY(!pool.take("ringtones", kTone).get());
+	QCOMPARE(pool.numHits(), (guint32)2);
+	QCOMPARE(pool.numMisses(), (guint32)1);
+}
+
+void TestSoundWarmPool::deadPlayersReplaced()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+
+	pool.setTarget("alerts", 1);
+	pool.replenish(1);
+	media.m_now += 1000;
+
+	// a warm player that gives up is neither handed out nor counted
+	factory.m_last->m_dead = true;
+	QVERIFY(pool.needsPlayers());
+	QVERIFY(!pool.take("alerts", std::string()).get());
+
+	QCOMPARE(pool.replenish(1), 1);
+	QCOMPARE(pool.size("alerts"), 1);
+	media.m_now += 1000;
+
+	sptr<FakePlayer> player = pool.take("alerts", std::string());
+	QVERIFY(player.get());
+	QVERIFY(!player->dead());
+	QVERIFY(pool.needsPlayers());
+}
+
+void TestSoundWarmPool::preloadChangeDropsStalePlayers()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+
+	pool.setTarget("notifications", 1);
+	pool.setPreload("notifications", kTone);
+	pool.replenish(1);
+	QCOMPARE(pool.size("notifications"), 1);
+
+	pool.setPreload("notifications", kOtherTone);
+	QCOMPARE(pool.size("notifications"), 0);
+	pool.replenish(1);
+
+	media.m_now += 1000;
+	sptr<FakePlayer> player = pool.take("notifications", kOtherTone);
+	QCOMPARE(player->preloadedPath(), kOtherTone);
+}
+
+void TestSoundWarmPool::playWhileConnecting()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+
+	pool.setTarget("notifications", 1);
+	pool.setPreload("notifications", kTone);
+	pool.replenish(1);
+
+	// handed out before its preload went out: the tone still has to be loaded
+	media.m_now += 100;
+	sptr<FakePlayer> player = pool.take("notifications", kTone);
+	QVERIFY(player.get());
+	QVERIFY(!player->warm());
+	QVERIFY(player->preloadedPath().empty());
+
+	guint64 latency = player->play(kTone);
+	QCOMPARE(player->m_loadedPath, kTone);
+	QCOMPARE(latency, media.m_connectMs - 100 + media.m_loadMs + media.m_startMs);
+}
+
+// play-to-first-position-update latency, cold vs. out of the pool, after the device sat idle
+void TestSoundWarmPool::warmPlayersStartSooner()
+{
+	FakeMediaService media;
+	FakePlayerFactory factory(&media);
+	SoundWarmPool<FakePlayer> pool(&factory);
+	SoundPlayLatencyStats stats;
+
+	pool.setTarget("notifications", 1);
+	pool.setPreload("notifications", kTone);
+
+	for (int i = 0; i < 10; i++) {
+		pool.replenish(1);
+		media.m_now += 60000;
+
+		// the preloaded tone, and another sound on a warm player
+		const std::string& sound = (i % 2) ? kOtherTone : kTone;
+		sptr<FakePlayer> player = pool.take("notifications", sound);
+		QVERIFY(player.get());
+		stats.record("notifications", true, player->play(sound));
+
+		sptr<FakePlayer> cold(new FakePlayer(&media));
+		stats.record("notifications", false, cold->play(sound));
+	}
+
+	SoundPlayLatencyStats::Entry warm = stats.entry("notifications", true);
+	SoundPlayLatencyStats::Entry cold = stats.entry("notifications", false);
+	QCOMPARE(warm.count, (guint32)10);
+	QCOMPARE(cold.count, (guint32)10);
+	QCOMPARE(cold.averageMs(), (guint32)(media.m_connectMs + media.m_loadMs + media.m_startMs));
+	QCOMPARE(warm.maxMs, (guint32)(media.m_loadMs + media.m_startMs));
+	QVERIFY(warm.averageMs() < cold.averageMs());
+
+	std::string report = stats.report();
+	qDebug("%s", report.c_str());
+	QVERIFY(report.find("notifications (warm): 10 plays") != std::string::npos);
+}
+
+QTEST_MAIN(TestSoundWarmPool)
+#include "sysmgrtst_SoundWarmPool.moc"
@@ -0,0 +1,235 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+
+#include <cjson/json.h>
+#include <string.h>
+
+#include "StatusBarModel.h"
+
+static const int kFrameMs = 16;
+
+// StatusBar::IndexRSSI and StatusBar::IndexWiFi
+static const int kRssi0 = 0;
+static const int kWifiBar1 = 3;
+
+// telephony and wifi events, as the status bar got them on a phone going through a
+// tunnel: the signal reading bounces between two values, often several times a frame
+struct CapturedEvent
+{
+	int			ms;
+	const char*	payload;
+};
+
+static const CapturedEvent s_capture[] = {
+	{    0, "{\"eventSignal\":{\"bars\":4,\"rssi\":-71}}" },
+	{    3, "{\"eventSignal\":{\"bars\":4,\"rssi\":-72}}" },
+	{    5, "{\"status\":\"signalStrengthChanged\",\"signalBars\":3}" },
+	{    9, "{\"eventSignal\":{\"bars\":3,\"rssi\":-79}}" },
+	{   11, "{\"eventSignal\":{\"bars\":4,\"rssi\":-74}}" },
+	{   14, "{\"eventSignal\":{\"bars\":3,\"rssi\":-80}}" },
+	{   21, "{\"eventSignal\":{\"bars\":3,\"rssi\":-81}}" },
+	{   24, "{\"status\":\"signalStrengthChanged\",\"signalBars\":3}" },
+	{   29, "{\"eventSignal\":{\"bars\":2,\"rssi\":-88}}" },
+	{   30, "{\"eventSignal\":{\"bars\":3,\"rssi\":-84}}" },
+	{   38, "{\"eventSignal\":{\"bars\":3,\"rssi\":-83}}" },
+	{   40, "{\"status\":\"signalStrengthChanged\",\"signalBars\":2}" },
+	{   47, "{\"eventSignal\":{\"bars\":2,\"rssi\":-90}}" },
+	{   51, "{\"eventSignal\":{\"bars\":2,\"rssi\":-91}}" },
+	{   55, "{\"eventSignal\":{\"bars\":1,\"rssi\":-97}}" },
+	{   56, "{\"eventSignal\":{\"bars\":2,\"rssi\":-92}}" },
+	{   60, "{\"status\":\"signalStrengthChanged\",\"signalBars\":2}" },
+	{   66, "{\"eventSignal\":{\"bars\":1,\"rssi\":-99}}" },
+	{   71, "{\"eventSignal\":{\"bars\":1,\"rssi\":-101}}" },
+	{   75, "{\"eventSignal\":{\"bars\":0,\"rssi\":-109}}" },
+	{   77, "{\"eventSignal\":{\"bars\":1,\"rssi\":-103}}" },
+	{   79, "{\"status\":\"signalStrengthChanged\",\"signalBars\":1}" },
+	{   90, "{\"eventSignal\":{\"bars\":1,\"rssi\":-102}}" },
+	{   94, "{\"eventSignal\":{\"bars\":1,\"rssi\":-100}}" },
+	{  101, "{\"eventSignal\":{\"bars\":2,\"rssi\":-93}}" },
+	{  103, "{\"eventSignal\":{\"bars\":1,\"rssi\":-98}}" },
+	{  112, "{\"status\":\"signalStrengthChanged\",\"signalBars\":1}" },
+	{  127, "{\"eventSignal\":{\"bars\":1,\"rssi\":-99}}" },
+};
+
+static const int kNumCaptured = sizeof(s_capture) / sizeof(s_capture[0]);
+
+// the same decoding StatusBarServicesConnector does for a GSM phone
+static void decode(const char* payload, StatusBarModel& model)
+{
+	json_object* root = json_tokener_parse(payload);
+	if (!root || is_error(root))
+		return;
+
+	json_object* label = json_object_object_get(root, "eventSignal");
+	if (label && !is_error(label)) {
+		label = json_object_object_get(label, "bars");
+		if (label && !is_error(label)) {
+			int bars = json_object_get_int(label);
+			if (bars < 0)
+				bars = 0;
+			model.set(StatusBarModel::IconRSSI, true, kRssi0 + bars);
+		}
+	}
+
+	label = json_object_object_get(root, "signalBars");
+	if (label && !is_error(label)) {
+		int bars = json_object_get_int(label) - 1;
+		if (bars < 0)
+			bars = 0;
+		if (bars > 2)
+			bars = 2;
+		model.set(StatusBarModel::IconWifi, true, kWifiBar1 + bars);
+	}
+
+	json_object_put(root);
+}
+
+// replays the capture a number of times back to back, committing on frame boundaries;
+// returns the number of commits, each of which is a single repaint
+static int replay(StatusBarModel& model, int loops)
+{
+	int commits = 0;
+	int nextFrame = kFrameMs;
+	int length = s_capture[kNumCaptured - 1].ms + kFrameMs;
+
+	for (int loop = 0; loop < loops; loop++) {
+		for (int i = 0; i < kNumCaptured; i++) {
+			int ms = loop * length + s_capture[i].ms;
+			for (; nextFrame <= ms; nextFrame += kFrameMs) {
+				if (model.commit())
+					commits++;
+			}
+			decode(s_capture[i].payload, model);
+		}
+	}
+
+	if (model.commit())
+		commits++;
+
+	return commits;
+}
+
+// -------------------------------------------------------------------------
+
+class TestStatusBarModel : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void diffsAgainstRendered();
+	void hiddenIgnoresIndex();
+	void invalidate();
+	void replayCapture();
+	void replayBenchmark();
+};
+
+void TestStatusBarModel::diffsAgainstRendered()
+{
+	StatusBarModel model;
+	QVERIFY(!model.dirty());
+
+	QVERIFY(model.set(StatusBarModel::IconRSSI, true, 3));
+	QVERIFY(model.set(StatusBarModel::IconWifi, true, 4));
+	QCOMPARE(model.commit(), (1U << StatusBarModel::IconRSSI) | (1U << StatusBarModel::IconWifi));
+	QCOMPARE(model.rendered(StatusBarModel::IconRSSI).index, 3);
+
+	// a service repeating itself
+	QVERIFY(!model.set(StatusBarModel::IconRSSI, true, 3));
+	QCOMPARE(model.commit(), 0U);
+
+	// flapping within a frame
+	QVERIFY(model.set(StatusBarModel::IconRSSI, true, 2));
+	QVERIFY(!model.set(StatusBarModel::IconRSSI, true, 3));
+	QCOMPARE(model.commit(), 0U);
+
+	// only the last state of the frame is rendered
+	model.set(StatusBarModel::IconRSSI, true, 2);
+	model.set(StatusBarModel::IconRSSI, true, 1);
+	QCOMPARE(model.commit(), 1U << StatusBarModel::IconRSSI);
+	QCOMPARE(model.rendered(StatusBarModel::IconRSSI).index, 1);
+
+	QCOMPARE(model.numEvents(), 7U);
+	QCOMPARE(model.numCommits(), 2U);
+	QCOMPARE(model.numChanges(), 3U);
+}
+
+void TestStatusBarModel::hiddenIgnoresIndex()
+{
+	StatusBarModel model;
+
+	QVERIFY(!model.set(StatusBarModel::IconWAN, false, 5));
+	QVERIFY(model.set(StatusBarModel::IconWAN, true, 5));
+	model.commit();
+
+	QVERIFY(model.set(StatusBarModel::IconWAN, false, 0));
+	QCOMPARE(model.commit(), 1U << StatusBarModel::IconWAN);
+	QVERIFY(!model.set(StatusBarModel::IconWAN, false, 7));
+}
+
+void TestStatusBarModel::invalidate()
+{
+	StatusBarModel model;
+	model.set(StatusBarModel::IconMute, true, 0);
+	model.commit();
+
+	// the image behind the index was reloaded
+	model.invalidate(StatusBarModel::IconMute);
+	QVERIFY(model.dirty());
+	QVERIFY(model.set(StatusBarModel::IconMute, true, 0));
+	QCOMPARE(model.commit(), 1U << StatusBarModel::IconMute);
+	QVERIFY(!model.dirty());
+}
+
+void TestStatusBarModel::replayCapture()
+{
+	StatusBarModel model;
+	int commits = replay(model, 1);
+
+	// what the icons end up showing
+	QCOMPARE(model.rendered(StatusBarModel::IconRSSI).index, kRssi0 + 1);
+	QCOMPARE(model.rendered(StatusBarModel::IconWifi).index, kWifiBar1);
+
+	// without the model, every event was a repaint
+	qDebug("%u events, %d repaints, %u icon changes", model.numEvents(), commits, model.numChanges());
+	QCOMPARE((int) model.numEvents(), kNumCaptured);
+	QVERIFY(commits <= (s_capture[kNumCaptured - 1].ms / kFrameMs) + 1);
+	QVERIFY(commits * 2 < kNumCaptured);
+}
+
+void TestStatusBarModel::replayBenchmark()
+{
+	int commits = 0;
+	unsigned int events = 0;
+
+	QBENCHMARK {
+		StatusBarModel model;
+		commits = replay(model, 100);
+		events = model.numEvents();
+	}
+
+	qDebug("%u events, %d repaints", events, commits);
+	QVERIFY(commits * 2 < (int) events);
+}
+
+QTEST_MAIN(TestStatusBarModel)
+#include "sysmgrtst_StatusBarModel.moc"
@@ -0,0 +1,184 @@
+/* @@@LICENSE
+*
+*      Copyright (c) 2010-2013 LG Electronics, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* LICENSE@@@ */
+
+
+
+#include <QtTest/QtTest>
+#include <QPainter>
+
+#include "StatusBarRenderCache.h"
+
+static QImage solidImage(int width, int height, QRgb color)
+{
+	QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+	image.fill(color);
+	return image;
+}
+
+// -------------------------------------------------------------------------
+
+class TestStatusBarRenderCache : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+
+	void packsIcons();
+	void sameFileOnce();
+	void growsInPlace();
+	void glyphsReused();
+	void lettersNotCached();
+	void clearGlyphs();
+};
+
+void TestStatusBarRenderCache::packsIcons()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+
+	QRect red, green;
+	QVERIFY(cache->addIcon(solidImage(20, 16, 0xffff0000), red));
+	QVERIFY(cache->addIcon(solidImage(12, 24, 0xff00ff00), green));
+
+	QCOMPARE(red.size(), QSize(20, 16));
+	QCOMPARE(green.size(), QSize(12, 24));
+	QVERIFY(!red.intersects(green));
+
+	QImage atlas = cache->iconAtlas()->toImage();
+	QCOMPARE(atlas.pixel(red.center()), 0xffff0000);
+	QCOMPARE(atlas.pixel(green.center()), 0xff00ff00);
+}
+
+void TestStatusBarRenderCache::sameFileOnce()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+
+	QString path = QDir::temp().filePath("sysmgrtst_statusbar_icon.png");
+	QVERIFY(solidImage(8, 8, 0xff0000ff).save(path, "PNG"));
+
+	int before = cache->numIcons();
+	QRect first, second;
+	QVERIFY(cache->addIcon(path.toStdString(), first));
+	QVERIFY(cache->addIcon(path.toStdString(), second));
+	QFile::remove(path);
+
+	QCOMPARE(first, second);
+	QCOMPARE(cache->numIcons(), before + 1);
+
+	QRect missing;
+	QVERIFY(!cache->addIcon(std::string("/nonexistent/icon.png"), missing));
+	QVERIFY(missing.isNull());
+}
+
+void TestStatusBarRenderCache::growsInPlace()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+	const QPixmap* atlas = cache->iconAtlas();
+
+	QRect first;
+	QVERIFY(cache->addIcon(solidImage(32, 32, 0xffffff00), first));
+
+	// enough to fill a few rows
+	QRect last;
+	for (int i = 0; i < 64; i++)
+		QVERIFY(cache->addIcon(solidImage(100, 40, 0xff00ffff), last));
+
+	// the pixmap got bigger, but is the same object, and kept what it had
+	QCOMPARE(cache->iconAtlas(), atlas);
+	QVERIFY(atlas->height() > last.bottom());
+	QImage image = atlas->toImage();
+	QCOMPARE(image.pixel(first.center()), 0xffffff00);
+	QCOMPARE(image.pixel(last.center()), 0xff00ffff);
+}
+
+void TestStatusBarRenderCache::glyphsReused()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+	cache->clearGlyphs();
+
+	QFont font;
+	font.setPixelSize(15);
+	font.setBold(true);
+
+	QImage target(100, 30, QImage::Format_ARGB32_Premultiplied);
+	target.fill(0);
+	QPainter painter(&target);
+
+	cache->drawText(&painter, font, Qt::white, QPointF(2, 20), "12:34");
+	QCOMPARE(cache->numGlyphs(), 5);
+
+	// the next minute needs nothing new
+	cache->drawText(&painter, font, Qt::white, QPointF(2, 20), "12:43");
+	QCOMPARE(cache->numGlyphs(), 5);
+	painter.end();
+
+	// something was drawn
+	bool drawn = false;
+	for (int y = 0; y < target.height() && !drawn; y++)
+		for (int x = 0; x < target.width() && !drawn; x++)
+			drawn = qAlpha(target.pixel(x, y)) != 0;
+	QVERIFY(drawn);
+
+	QFontMetrics fontMetrics(font);
+	QCOMPARE(cache->textWidth(font, "12:43"),
+			 fontMetrics.width('1') + fontMetrics.width('2') + fontMetrics.width(':') +
+			 fontMetrics.width('4') + fontMetrics.width('3'));
+}
+
+void TestStatusBarRenderCache::lettersNotCached()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+	cache->clearGlyphs();
+
+	QFont font;
+	font.setPixelSize(15);
+
+	QImage target(120, 30, QImage::Format_ARGB32_Premultiplied);
+	target.fill(0);
+	QPainter painter(&target);
+
+	// laid out as a whole, the way QPainter draws it
+	cache->drawText(&painter, font, Qt::white, QPointF(2, 20), "12:34 PM");
+	painter.end();
+	QCOMPARE(cache->numGlyphs(), 0);
+	QCOMPARE(cache->textWidth(font, "12:34 PM"), QFontMetrics(font).width("12:34 PM"));
+
+	bool drawn = false;
+	for (int y = 0; y < target.height() && !drawn; y++)
+		for (int x = 0; x < target.width() && !drawn; x++)
+			drawn = qAlpha(target.pixel(x, y)) != 0;
+	QVERIFY(drawn);
+}
+
+void TestStatusBarRenderCache::clearGlyphs()
+{
+	StatusBarRenderCache* cache = StatusBarRenderCache::instance();
+
+	QFont font;
+	font.setPixelSize(14);
+	cache->textWidth(font, "100%");
+	QVERIFY(cache->numGlyphs() > 0);
+
+	// icons outlive the glyphs
+	int icons = cache->numIcons();
+	cache->clearGlyphs();
+	QCOMPARE(cache->numGlyphs(), 0);
+	QCOMPARE(cache->numIcons(), icons);
+}
+
+QTEST_MAIN(TestStatusBarRenderCache)
+#include "sysmgrtst_StatusBarRenderCache.moc"
@@ -106,8 +106,10 @@ DEFINES += SHIPPING_VERSION=0
 # DEFINES += QT_USE_FAST_OPERATOR_PLUS
 
 SOURCES = \
+	HeapProfiler.cpp \
 	MallocHooks.cpp \
 	CpuAffinity.cpp \
+	CpuPolicy.cpp \
 	KeywordMap.cpp \
 	Window.cpp \
 	ActiveCallBanner.cpp \
@@ -128,8 +130,11 @@ SOURCES = \
 	MetaKeyManager.cpp \
 	DisplayManager.cpp \
 	DisplayStates.cpp \
+	InactivityDeadline.cpp \
 	AmbientLightSensor.cpp \
+	AlsFilter.cpp \
 	InputManager.cpp \
+	JsonScanner.cpp \
 	EventReporter.cpp \
 	SystemUiController.cpp \
 	BannerMessageHandler.cpp \
@@ -138,7 +143,10 @@ SOURCES = \
 	SystemService.cpp \
 	EventThrottler.cpp \
 	EventThrottlerIme.cpp \
+	PenMoveResampler.cpp \
 	HapticsController.cpp \
+	InitGraph.cpp \
+	StartupTracer.cpp \
 	Preferences.cpp \
 	NotificationPolicy.cpp \
 	PersistentWindowCache.cpp \
@@ -158,11 +166,14 @@ SOURCES = \
 	ApplicationStatus.cpp \
 	FullEraseConfirmationWindow.cpp \
 	SoundPlayerPool.cpp \
+	SoundFeedbackChannel.cpp \
+	SoundWarmPool.cpp \
 	HostWindow.cpp \
 	HostWindowData.cpp \
 	HostWindowDataSoftware.cpp \
 	AlertWindow.cpp \
 	CardWindow.cpp \
+	CardRoundedCorners.cpp \
 	DashboardWindow.cpp \
 	MenuWindow.cpp \
 	CardLoading.cpp \
@@ -175,6 +186,7 @@ SOURCES = \
 	OverlayWindowManager.cpp\
 	QuicklaunchLayout.cpp \
 	MemoryMonitor.cpp \
+	QmlComponentCache.cpp \
 	MenuWindowManager.cpp \
 	DashboardWindowManager.cpp \
 	GraphicsItemContainer.cpp \
@@ -184,6 +196,7 @@ SOURCES = \
 	BannerWindow.cpp \
 	TopLevelWindowManager.cpp \
 	ClockWindow.cpp \
+	ClockFace.cpp \
 	LockWindow.cpp \
 	DockModeWindowManager.cpp \
 	DockModeWindow.cpp \
@@ -209,6 +222,8 @@ SOURCES = \
 	StatusBarServicesConnector.cpp \
 	StatusBarIcon.cpp \
 	StatusBarInfo.cpp \
+	StatusBarModel.cpp \
+	StatusBarRenderCache.cpp \
 	StatusBarItemGroup.cpp \
 	StatusBarNotificationArea.cpp \
 	SystemMenu.cpp \
@@ -237,6 +252,7 @@ SOURCES = \
 
 HEADERS = \
 	AmbientLightSensor.h \
+	AlsFilter.h \
 	AnimationSettings.h \
 	ApplicationDescription.h \
 	ApplicationInstallerErrors.h \
@@ -249,15 +265,22 @@ HEADERS = \
 	DeviceInfo.h \
 	DisplayManager.h \
 	DisplayStates.h \
+	InactivityDeadline.h \
 	EASPolicyManager.h \
 	EventReporter.h \
 	EventThrottler.h \
 	EventThrottlerIme.h \
+	PenMoveResampler.h \
 	HapticsController.h \
+	CpuPolicy.h \
+	HeapProfiler.h \
+	InitGraph.h \
+	StartupTracer.h \
 	HostWindow.h \
 	HostWindowData.h \
 	HostWindowDataSoftware.h \
 	InputManager.h \
+	JsonScanner.h \
 	LaunchPoint.h \
 	MetaKeyManager.h \
 	MimeSystem.h \
@@ -274,6 +297,7 @@ HEADERS = \
 	AnimationEquations.h \
 	GraphicsDefs.h \
 	PtrArray.h \
+	SlotTable.h \
 #	JsSysObjectAnimationRunner.h \
 	ActiveCallBanner.h \
 	BannerMessageEventFactory.h \
@@ -288,10 +312,14 @@ HEADERS = \
 	IpcClientHost.h \
 	IpcServer.h \
 	WebAppMgrProxy.h \
+	MessageReplayQueue.h \
 	SoundPlayer.h \
 	SoundPlayerPool.h \
+	SoundFeedbackChannel.h \
+	SoundWarmPool.h \
 	AlertWindow.h \
 	CardWindow.h \
+	CardRoundedCorners.h \
 	DashboardWindow.h \
 	MenuWindow.h \
 	CardLoading.h \
@@ -305,6 +333,7 @@ HEADERS = \
 	OverlayWindowManager_p.h \
 	QuicklaunchLayout.h \
 	MemoryMonitor.h \
+	QmlComponentCache.h \
 	MenuWindowManager.h \
 	DashboardWindowManager.h \
 	GraphicsItemContainer.h \
@@ -314,6 +343,7 @@ HEADERS = \
 	BannerWindow.h \
 	TopLevelWindowManager.h \
 	ClockWindow.h \
+	ClockFace.h \
 	LockWindow.h \
 	DockModeWindowManager.h \
 	DockModeWindow.h \
@@ -324,6 +354,7 @@ HEADERS = \
 	DockModeMenuManager.h \
 	CardDropShadowEffect.h \
 	CardGroup.h \
+	CardGroupLayout.h \
 	SingleClickGestureRecognizer.h \
 	SingleClickGesture.h \
 #	BootupAnimation.h \
@@ -340,6 +371,8 @@ HEADERS = \
 	StatusBarServicesConnector.h \
 	StatusBarIcon.h \
 	StatusBarInfo.h \
+	StatusBarModel.h \
+	StatusBarRenderCache.h \
 	StatusBarItem.h \
 	StatusBarItemGroup.h \
 	StatusBarNotificationArea.h \
@@ -412,6 +445,7 @@ SOURCES += dimensionsmain.cpp \
 			variableanimsignaltransition.cpp \
 			linearmotiontransform.cpp \
 			frictiontransform.cpp \
+			motionintegrator.cpp \
 			pagetabbar.cpp \
 			pagetab.cpp \
 			icon.cpp \
@@ -445,6 +479,8 @@ SOURCES += dimensionsmain.cpp \
 			stringtranslator.cpp \
 			appeffector.cpp \
 			pagesaver.cpp \
+			pagesavequeue.cpp \
+			launcherbinarysave.cpp \
 			pagerestore.cpp \
 			filenames.cpp \
 			blacklist.cpp \
@@ -495,6 +531,7 @@ HEADERS += dimensionsmain.h \
 			variableanimsignaltransition.h \
 			linearmotiontransform.h \
 			frictiontransform.h \
+			motionintegrator.h \
 			pagetabbar.h \
 			pagetab.h \
 			icon.h \
@@ -528,6 +565,8 @@ HEADERS += dimensionsmain.h \
 			stringtranslator.h \
 			appeffector.h \
 			pagesaver.h \
+			pagesavequeue.h \
+			launcherbinarysave.h \
 			pagerestore.h \
 			filenames.h \
 			blacklist.h \
@@ -50,9 +50,15 @@ Item {
         weekday = getWeekDay();
     }
 
+    // the second hand moves once a second, just after the wall clock turns over
+    function msToNextSecond() {
+        var d = new Date
+        return 1000 - d.getMilliseconds() + 20
+    }
+
     Timer {
-        interval: 100; running: timerRunning; repeat: true;
-        onTriggered: analogclock.timeChanged()
+        interval: 1000; running: timerRunning; repeat: true; triggeredOnStart: true
+        onTriggered: { analogclock.timeChanged(); interval = analogclock.msToNextSecond() }
     }
 
      Image {
@@ -14,9 +14,10 @@ Rectangle {
 
     VisualItemModel{
         id: clockList
-        AnalogClock{glass: 1; timerRunning: mainTimerRunning}
-        DigitalClock{timerRunning: mainTimerRunning}
-        AnalogClock{glass: 0; timerRunning: mainTimerRunning}
+        // only the clock on screen ticks, and the ones coming in while flicking
+        AnalogClock{glass: 1; timerRunning: mainTimerRunning && (flickable.moving || flickable.currentIndex == 0)}
+        DigitalClock{timerRunning: mainTimerRunning && (flickable.moving || flickable.currentIndex == 1)}
+        AnalogClock{glass: 0; timerRunning: mainTimerRunning && (flickable.moving || flickable.currentIndex == 2)}
     }
 
     ListView {
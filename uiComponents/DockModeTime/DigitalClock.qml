@@ -67,9 +67,15 @@ Item {
 
     }
 
+    // only minutes are shown: wake up once a minute, just after the wall clock turns over
+    function msToNextMinute() {
+        var d = new Date
+        return 60000 - (d.getSeconds() * 1000 + d.getMilliseconds()) + 20
+    }
+
     Timer {
-        interval: 100; running: timerRunning; repeat: true;
-        onTriggered: digitalclock.timeChanged()
+        interval: 60000; running: timerRunning; repeat: true; triggeredOnStart: true
+        onTriggered: { digitalclock.timeChanged(); interval = digitalclock.msToNextMinute() }
     }
 
     Row {